@@ -43,9 +43,15 @@ AC_DEFUN([AX_LIBEWF_CHECK_LOCAL],
   dnl Headers included in libewf/libewf_date_time.h
   AC_CHECK_HEADERS([sys/time.h])
 
+  dnl Headers included in libewf/libewf_memory_map.c
+  AC_CHECK_HEADERS([fcntl.h sys/mman.h sys/stat.h unistd.h])
+
   dnl Check for functions
   AC_CHECK_FUNCS([localtime localtime_r memmove mktime])
 
+  dnl Functions used in libewf/libewf_memory_map.c
+  AC_CHECK_FUNCS([mmap munmap])
+
   AS_IF(
     [test "x$ac_cv_func_localtime" != xyes && test "x$ac_cv_func_localtime_r" != xyes],
     [AC_MSG_FAILURE(
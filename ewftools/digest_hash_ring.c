@@ -0,0 +1,789 @@
+/*
+ * Digest hash ring
+ *
+ * Copyright (C) 2006-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "digest_hash_ring.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libhmac.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a digest hash ring
+ * Make sure the value digest_hash_ring is referencing, is set to NULL
+ * A digest context of NULL means that the digest is not calculated
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_ring_initialize(
+     digest_hash_ring_t **digest_hash_ring,
+     libhmac_md5_context_t *md5_context,
+     libhmac_sha1_context_t *sha1_context,
+     libhmac_sha256_context_t *sha256_context,
+     libcerror_error_t **error )
+{
+	digest_hash_ring_digest_t *digest = NULL;
+	static char *function             = "digest_hash_ring_initialize";
+	int digest_type                   = 0;
+	int slot_index                    = 0;
+
+	if( digest_hash_ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_hash_ring != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid digest hash ring value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*digest_hash_ring = memory_allocate_structure(
+	                     digest_hash_ring_t );
+
+	if( *digest_hash_ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create digest hash ring.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *digest_hash_ring,
+	     0,
+	     sizeof( digest_hash_ring_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear digest hash ring.",
+		 function );
+
+		memory_free(
+		 *digest_hash_ring );
+
+		*digest_hash_ring = NULL;
+
+		return( -1 );
+	}
+	( *digest_hash_ring )->digests[ DIGEST_HASH_RING_DIGEST_TYPE_MD5 ].context    = (intptr_t *) md5_context;
+	( *digest_hash_ring )->digests[ DIGEST_HASH_RING_DIGEST_TYPE_SHA1 ].context   = (intptr_t *) sha1_context;
+	( *digest_hash_ring )->digests[ DIGEST_HASH_RING_DIGEST_TYPE_SHA256 ].context = (intptr_t *) sha256_context;
+
+	if( libcthreads_mutex_initialize(
+	     &( ( *digest_hash_ring )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_queue_initialize(
+	     &( ( *digest_hash_ring )->free_slots_queue ),
+	     DIGEST_HASH_RING_NUMBER_OF_SLOTS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create free slots queue.",
+		 function );
+
+		goto on_error;
+	}
+	for( slot_index = 0;
+	     slot_index < DIGEST_HASH_RING_NUMBER_OF_SLOTS;
+	     slot_index++ )
+	{
+		( *digest_hash_ring )->slots[ slot_index ] = memory_allocate_structure(
+		                                              digest_hash_ring_slot_t );
+
+		if( ( *digest_hash_ring )->slots[ slot_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create slot: %d.",
+			 function,
+			 slot_index );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     ( *digest_hash_ring )->slots[ slot_index ],
+		     0,
+		     sizeof( digest_hash_ring_slot_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear slot: %d.",
+			 function,
+			 slot_index );
+
+			goto on_error;
+		}
+		if( libcthreads_queue_push(
+		     ( *digest_hash_ring )->free_slots_queue,
+		     (intptr_t *) ( *digest_hash_ring )->slots[ slot_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push slot: %d onto free slots queue.",
+			 function,
+			 slot_index );
+
+			goto on_error;
+		}
+	}
+	/* Every digest has a single thread so that the slots are consumed in order
+	 */
+	for( digest_type = 0;
+	     digest_type < DIGEST_HASH_RING_NUMBER_OF_DIGEST_TYPES;
+	     digest_type++ )
+	{
+		digest = &( ( *digest_hash_ring )->digests[ digest_type ] );
+
+		digest->digest_hash_ring = *digest_hash_ring;
+		digest->digest_type      = digest_type;
+
+		if( digest->context == NULL )
+		{
+			continue;
+		}
+		if( libcthreads_thread_pool_create(
+		     &( digest->thread_pool ),
+		     NULL,
+		     1,
+		     DIGEST_HASH_RING_NUMBER_OF_SLOTS,
+		     (int (*)(intptr_t *, void *)) &digest_hash_ring_digest_callback,
+		     (void *) digest,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create digest: %d thread pool.",
+			 function,
+			 digest_type );
+
+			goto on_error;
+		}
+		( *digest_hash_ring )->number_of_digests += 1;
+	}
+	return( 1 );
+
+on_error:
+	if( *digest_hash_ring != NULL )
+	{
+		digest_hash_ring_free(
+		 digest_hash_ring,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a digest hash ring
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_ring_free(
+     digest_hash_ring_t **digest_hash_ring,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_ring_free";
+	int digest_type       = 0;
+	int result            = 1;
+	int slot_index        = 0;
+
+	if( digest_hash_ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_hash_ring != NULL )
+	{
+		/* The threads are joined before the slots they consume are freed
+		 */
+		for( digest_type = 0;
+		     digest_type < DIGEST_HASH_RING_NUMBER_OF_DIGEST_TYPES;
+		     digest_type++ )
+		{
+			if( ( *digest_hash_ring )->digests[ digest_type ].thread_pool != NULL )
+			{
+				break;
+			}
+		}
+		if( digest_type < DIGEST_HASH_RING_NUMBER_OF_DIGEST_TYPES )
+		{
+			if( digest_hash_ring_join(
+			     *digest_hash_ring,
+			     NULL ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join threads.",
+				 function );
+
+				result = -1;
+			}
+		}
+		/* The slots are freed separately since not all of them need to be in the queue
+		 */
+		if( ( *digest_hash_ring )->free_slots_queue != NULL )
+		{
+			if( libcthreads_queue_free(
+			     &( ( *digest_hash_ring )->free_slots_queue ),
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free free slots queue.",
+				 function );
+
+				result = -1;
+			}
+		}
+		for( slot_index = 0;
+		     slot_index < DIGEST_HASH_RING_NUMBER_OF_SLOTS;
+		     slot_index++ )
+		{
+			if( ( *digest_hash_ring )->slots[ slot_index ] != NULL )
+			{
+				if( ( *digest_hash_ring )->slots[ slot_index ]->data != NULL )
+				{
+					memory_free(
+					 ( *digest_hash_ring )->slots[ slot_index ]->data );
+				}
+				memory_free(
+				 ( *digest_hash_ring )->slots[ slot_index ] );
+			}
+		}
+		if( ( *digest_hash_ring )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *digest_hash_ring )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *digest_hash_ring );
+
+		*digest_hash_ring = NULL;
+	}
+	return( result );
+}
+
+/* Updates the digest hash(es)
+ * The buffer is copied into a slot of the ring, which blocks until a slot
+ * has been consumed by every digest, hence the buffer can be reused after
+ * this function returns
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_ring_update(
+     digest_hash_ring_t *digest_hash_ring,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	digest_hash_ring_slot_t *slot = NULL;
+	static char *function         = "digest_hash_ring_update";
+	void *reallocation            = NULL;
+	int digest_type               = 0;
+
+	if( digest_hash_ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_hash_ring->has_failed != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update digest hash(es).",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_queue_pop(
+	     digest_hash_ring->free_slots_queue,
+	     (intptr_t **) &slot,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to pop slot from free slots queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( slot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing slot.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > slot->allocated_data_size )
+	{
+		reallocation = memory_reallocate(
+		                slot->data,
+		                sizeof( uint8_t ) * buffer_size );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize slot data.",
+			 function );
+
+			goto on_error;
+		}
+		slot->data                = (uint8_t *) reallocation;
+		slot->allocated_data_size = buffer_size;
+	}
+	if( memory_copy(
+	     slot->data,
+	     buffer,
+	     buffer_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy buffer to slot data.",
+		 function );
+
+		goto on_error;
+	}
+	slot->data_size                 = buffer_size;
+	slot->number_of_pending_digests = digest_hash_ring->number_of_digests;
+
+	/* From here on the slot is released by the digest threads
+	 */
+	for( digest_type = 0;
+	     digest_type < DIGEST_HASH_RING_NUMBER_OF_DIGEST_TYPES;
+	     digest_type++ )
+	{
+		if( digest_hash_ring->digests[ digest_type ].thread_pool == NULL )
+		{
+			continue;
+		}
+		if( libcthreads_thread_pool_push(
+		     digest_hash_ring->digests[ digest_type ].thread_pool,
+		     (intptr_t *) slot,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push slot onto digest: %d thread pool queue.",
+			 function,
+			 digest_type );
+
+			digest_hash_ring->has_failed = 1;
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+
+on_error:
+	libcthreads_queue_push(
+	 digest_hash_ring->free_slots_queue,
+	 (intptr_t *) slot,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Waits for the digest threads to consume the remaining slots and stops them
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_ring_join(
+     digest_hash_ring_t *digest_hash_ring,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_ring_join";
+	int digest_type       = 0;
+	int result            = 1;
+
+	if( digest_hash_ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash ring.",
+		 function );
+
+		return( -1 );
+	}
+	for( digest_type = 0;
+	     digest_type < DIGEST_HASH_RING_NUMBER_OF_DIGEST_TYPES;
+	     digest_type++ )
+	{
+		if( digest_hash_ring->digests[ digest_type ].thread_pool == NULL )
+		{
+			continue;
+		}
+		if( libcthreads_thread_pool_join(
+		     &( digest_hash_ring->digests[ digest_type ].thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join digest: %d thread pool.",
+			 function,
+			 digest_type );
+
+			result = -1;
+		}
+	}
+	if( ( result == 1 )
+	 && ( digest_hash_ring->has_failed != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update digest hash(es).",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Releases a slot after a digest consumed it
+ * The slot is returned to the free slots queue after it was consumed by every digest
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_ring_release_slot(
+     digest_hash_ring_t *digest_hash_ring,
+     digest_hash_ring_slot_t *slot,
+     int result,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_ring_release_slot";
+	int is_consumed       = 0;
+
+	if( digest_hash_ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( slot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid slot.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     digest_hash_ring->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( result != 1 )
+	{
+		digest_hash_ring->has_failed = 1;
+	}
+	slot->number_of_pending_digests -= 1;
+
+	is_consumed = (int) ( slot->number_of_pending_digests <= 0 );
+
+	if( libcthreads_mutex_release(
+	     digest_hash_ring->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( is_consumed != 0 )
+	{
+		if( libcthreads_queue_push(
+		     digest_hash_ring->free_slots_queue,
+		     (intptr_t *) slot,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push slot onto free slots queue.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Updates a digest hash with the data of a slot
+ * Callback function for the thread pool of the digest
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_ring_digest_callback(
+     digest_hash_ring_slot_t *slot,
+     digest_hash_ring_digest_t *digest )
+{
+	digest_hash_ring_t *digest_hash_ring = NULL;
+	libcerror_error_t *error             = NULL;
+	static char *function                = "digest_hash_ring_digest_callback";
+	int result                           = 1;
+
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		goto on_error;
+	}
+	digest_hash_ring = digest->digest_hash_ring;
+
+	if( digest_hash_ring == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid digest - missing digest hash ring.",
+		 function );
+
+		goto on_error;
+	}
+	if( slot == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid slot.",
+		 function );
+
+		goto on_error;
+	}
+	switch( digest->digest_type )
+	{
+		case DIGEST_HASH_RING_DIGEST_TYPE_MD5:
+			result = libhmac_md5_update(
+			          (libhmac_md5_context_t *) digest->context,
+			          slot->data,
+			          slot->data_size,
+			          &error );
+			break;
+
+		case DIGEST_HASH_RING_DIGEST_TYPE_SHA1:
+			result = libhmac_sha1_update(
+			          (libhmac_sha1_context_t *) digest->context,
+			          slot->data,
+			          slot->data_size,
+			          &error );
+			break;
+
+		case DIGEST_HASH_RING_DIGEST_TYPE_SHA256:
+			result = libhmac_sha256_update(
+			          (libhmac_sha256_context_t *) digest->context,
+			          slot->data,
+			          slot->data_size,
+			          &error );
+			break;
+
+		default:
+			result = -1;
+			break;
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update digest: %d hash.",
+		 function,
+		 digest->digest_type );
+
+		result = -1;
+	}
+	if( digest_hash_ring_release_slot(
+	     digest_hash_ring,
+	     slot,
+	     result,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release slot.",
+		 function );
+
+		goto on_error;
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest_hash_ring != NULL )
+	{
+		digest_hash_ring->has_failed = 1;
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,168 @@
+/*
+ * Digest hash ring
+ *
+ * Copyright (C) 2006-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _DIGEST_HASH_RING_H )
+#define _DIGEST_HASH_RING_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libhmac.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The number of buffers in the ring
+ */
+#define DIGEST_HASH_RING_NUMBER_OF_SLOTS	16
+
+/* The digest types
+ */
+enum DIGEST_HASH_RING_DIGEST_TYPES
+{
+	DIGEST_HASH_RING_DIGEST_TYPE_MD5	= 0,
+	DIGEST_HASH_RING_DIGEST_TYPE_SHA1	= 1,
+	DIGEST_HASH_RING_DIGEST_TYPE_SHA256	= 2
+};
+
+#define DIGEST_HASH_RING_NUMBER_OF_DIGEST_TYPES	3
+
+typedef struct digest_hash_ring_slot digest_hash_ring_slot_t;
+
+/* A buffer in the ring that is consumed by every digest thread
+ */
+struct digest_hash_ring_slot
+{
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The allocated data size
+	 */
+	size_t allocated_data_size;
+
+	/* The number of digests that still need to consume the data
+	 */
+	int number_of_pending_digests;
+};
+
+typedef struct digest_hash_ring digest_hash_ring_t;
+
+typedef struct digest_hash_ring_digest digest_hash_ring_digest_t;
+
+/* A digest that consumes the slots of the ring on its own thread
+ */
+struct digest_hash_ring_digest
+{
+	/* The digest hash ring
+	 */
+	digest_hash_ring_t *digest_hash_ring;
+
+	/* The digest type
+	 */
+	int digest_type;
+
+	/* The digest context, which is not managed by the ring
+	 */
+	intptr_t *context;
+
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+};
+
+/* The digest hash ring calculates every digest (hash) on its own thread
+ */
+struct digest_hash_ring
+{
+	/* The digests
+	 */
+	digest_hash_ring_digest_t digests[ DIGEST_HASH_RING_NUMBER_OF_DIGEST_TYPES ];
+
+	/* The number of digests
+	 */
+	int number_of_digests;
+
+	/* The slots
+	 */
+	digest_hash_ring_slot_t *slots[ DIGEST_HASH_RING_NUMBER_OF_SLOTS ];
+
+	/* The queue of slots that have been consumed by every digest
+	 */
+	libcthreads_queue_t *free_slots_queue;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* Value to indicate a digest could not be updated
+	 */
+	int has_failed;
+};
+
+int digest_hash_ring_initialize(
+     digest_hash_ring_t **digest_hash_ring,
+     libhmac_md5_context_t *md5_context,
+     libhmac_sha1_context_t *sha1_context,
+     libhmac_sha256_context_t *sha256_context,
+     libcerror_error_t **error );
+
+int digest_hash_ring_free(
+     digest_hash_ring_t **digest_hash_ring,
+     libcerror_error_t **error );
+
+int digest_hash_ring_update(
+     digest_hash_ring_t *digest_hash_ring,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int digest_hash_ring_join(
+     digest_hash_ring_t *digest_hash_ring,
+     libcerror_error_t **error );
+
+int digest_hash_ring_release_slot(
+     digest_hash_ring_t *digest_hash_ring,
+     digest_hash_ring_slot_t *slot,
+     int result,
+     libcerror_error_t **error );
+
+int digest_hash_ring_digest_callback(
+     digest_hash_ring_slot_t *slot,
+     digest_hash_ring_digest_t *digest );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _DIGEST_HASH_RING_H ) */
+
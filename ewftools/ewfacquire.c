@@ -128,7 +128,8 @@ void ewfacquire_usage_fprint(
 	                 "                  [ -o offset ] [ -p process_buffer_size ]\n"
 	                 "                  [ -P bytes_per_sector ] [ -r read_error_retries ]\n"
 	                 "                  [ -S segment_file_size ] [ -t target ] [ -T toc_file ]\n"
-	                 "                  [ -2 secondary_target ] [ -hqRsuvVwx ] source\n\n" );
+	                 "                  [ -W piecewise_size ] [ -2 secondary_target ]\n"
+	                 "                  [ -hqRsuvVwx ] source\n\n" );
 
 	fprintf( stream, "\tsource: the source file(s) or device\n\n" );
 
@@ -149,7 +150,9 @@ void ewfacquire_usage_fprint(
 	                 "\t        compression method options: deflate (default)\n"
 #endif
 	                 "\t        compression level options: none (default), empty-block,\n"
-	                 "\t        fast or best\n" );
+	                 "\t        fast, best or adaptive (adjusts the level to the throughput),\n"
+	                 "\t        append -skip to fast, best or adaptive to store data that\n"
+	                 "\t        is predicted to be incompressible uncompressed\n" );
 	fprintf( stream, "\t-C:     specify the case number (default is case_number).\n" );
 	fprintf( stream, "\t-d:     calculate additional digest (hash) types besides md5, options:\n"
 	                 "\t        sha1, sha256\n" );
@@ -159,6 +162,10 @@ void ewfacquire_usage_fprint(
 	fprintf( stream, "\t-f:     specify the EWF file format to write to, options: ewf, smart,\n"
 	                 "\t        ftk, encase2, encase3, encase4, encase5, encase6 (default),\n"
 	                 "\t        encase7, encase7-v2, linen5, linen6, linen7, ewfx\n" );
+	fprintf( stream, "\t-F:     specify the first segment file of a previous image of the\n"
+	                 "\t        input, the compressed data of unchanged chunks is copied from\n"
+	                 "\t        the previous image instead of being compressed again (not\n"
+	                 "\t        used with -x)\n" );
 	fprintf( stream, "\t-g      specify the number of sectors to be used as error granularity\n" );
 	fprintf( stream, "\t-h:     shows this help\n" );
 	fprintf( stream, "\t-j:     the number of concurrent processing jobs (threads), where\n"
@@ -208,6 +215,9 @@ void ewfacquire_usage_fprint(
 	fprintf( stream, "\t-v:     verbose output to stderr\n" );
 	fprintf( stream, "\t-V:     print version\n" );
 	fprintf( stream, "\t-w:     zero sectors on read error (mimic EnCase like behavior)\n" );
+	fprintf( stream, "\t-W:     calculate the digest (hash) types per piece of piecewise_size\n"
+	                 "\t        bytes and log them to the log_filename (requires -l, not\n"
+	                 "\t        used with -R)\n" );
 	fprintf( stream, "\t-x:     use the data chunk functions instead of the buffered read and\n"
 	                 "\t        write functions.\n" );
 	fprintf( stream, "\t-2:     specify the secondary target file (without extension) to write\n"
@@ -808,6 +818,10 @@ int ewfacquire_read_input(
 	}
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
+	if( log_handle != NULL )
+	{
+		imaging_handle->piecewise_hash_stream = log_handle->log_stream;
+	}
 	if( imaging_handle_start(
 	     imaging_handle,
 	     print_status_information,
@@ -991,10 +1005,10 @@ int ewfacquire_read_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( imaging_handle->number_of_threads > 0 )
 		{
-			if( libcthreads_thread_pool_push(
-			     imaging_handle->process_thread_pool,
-			     (intptr_t *) storage_media_buffer,
-			     error ) == -1 )
+			if( imaging_handle_push_storage_media_buffer(
+			     imaging_handle,
+			     storage_media_buffer,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
@@ -1145,6 +1159,20 @@ int ewfacquire_read_input(
 
 			goto on_error;
 		}
+		if( imaging_handle_print_compression_levels(
+		     imaging_handle,
+		     imaging_handle->notify_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print compression levels.",
+			 function );
+
+			goto on_error;
+		}
 		if( log_handle != NULL )
 		{
 			if( device_handle_read_errors_fprint(
@@ -1176,6 +1204,34 @@ int ewfacquire_read_input(
 
 				goto on_error;
 			}
+			if( imaging_handle_print_compression_levels(
+			     imaging_handle,
+			     log_handle->log_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print compression levels in log handle.",
+				 function );
+
+				goto on_error;
+			}
+			if( imaging_handle_print_queue_depths(
+			     imaging_handle,
+			     log_handle->log_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print queue depths in log handle.",
+				 function );
+
+				goto on_error;
+			}
 		}
 	}
 	return( 1 );
@@ -1244,7 +1300,9 @@ int main( int argc, char * const argv[] )
 	system_character_t *option_number_of_error_retries   = NULL;
 	system_character_t *option_number_of_jobs            = NULL;
 	system_character_t *option_offset                    = NULL;
+	system_character_t *option_piecewise_size            = NULL;
 	system_character_t *option_process_buffer_size       = NULL;
+	system_character_t *option_reference_filename        = NULL;
 	system_character_t *option_secondary_target_filename = NULL;
 	system_character_t *option_sector_error_granularity  = NULL;
 	system_character_t *option_sectors_per_chunk         = NULL;
@@ -1300,7 +1358,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:g:hj:l:m:M:N:o:p:P:qr:RsS:t:T:uvVwx2:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:F:g:hj:l:m:M:N:o:p:P:qr:RsS:t:T:uvVwW:x2:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -1370,6 +1428,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'F':
+				option_reference_filename = optarg;
+
+				break;
+
 			case (system_integer_t) 'g':
 				option_sector_error_granularity = optarg;
 
@@ -1485,6 +1548,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'W':
+				option_piecewise_size = optarg;
+
+				break;
+
 			case (system_integer_t) 'x':
 				use_data_chunk_functions = 1;
 
@@ -1548,6 +1616,24 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( ( resume_acquiry != 0 )
+	 && ( option_piecewise_size != NULL ) )
+	{
+		fprintf(
+		 stderr,
+		 "Resume acquiry with piecewise hashing not supported.\n" );
+
+		goto on_error;
+	}
+	if( ( option_piecewise_size != NULL )
+	 && ( log_filename == NULL ) )
+	{
+		fprintf(
+		 stderr,
+		 "Piecewise hashing requires a log file.\n" );
+
+		goto on_error;
+	}
 	if( ( option_target_filename != NULL )
 	 && ( option_secondary_target_filename != NULL ) )
 	{
@@ -2212,6 +2298,28 @@ int main( int argc, char * const argv[] )
 			 "Unsupported process buffer size defaulting to: chunk size.\n" );
 		}
 	}
+	if( option_piecewise_size != NULL )
+	{
+		result = imaging_handle_set_piecewise_hash_window_size(
+			  ewfacquire_imaging_handle,
+			  option_piecewise_size,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set piecewise size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported piecewise size disabling piecewise hashing.\n" );
+		}
+	}
 	if( option_number_of_jobs != NULL )
 	{
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
@@ -2229,7 +2337,7 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 		else if( ( result == 0 )
-		      || ( ewfacquire_imaging_handle->number_of_threads > (int) 32 ) )
+		      || ( ewfacquire_imaging_handle->number_of_threads > EWFCOMMON_MAXIMUM_NUMBER_OF_THREADS ) )
 		{
 			ewfacquire_imaging_handle->number_of_threads = 4;
 
@@ -2880,6 +2988,20 @@ int main( int argc, char * const argv[] )
 				goto on_error;
 			}
 		}
+		if( option_reference_filename != NULL )
+		{
+			if( imaging_handle_open_reference(
+			     ewfacquire_imaging_handle,
+			     option_reference_filename,
+			     &error ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to open reference file(s).\n" );
+
+				goto on_error;
+			}
+		}
 		if( device_handle_set_error_values(
 		     ewfacquire_device_handle,
 		     ewfacquire_imaging_handle->sector_error_granularity * ewfacquire_imaging_handle->bytes_per_sector,
@@ -147,7 +147,9 @@ void usage_fprint(
 	                 "\t    compression method options: deflate (default)\n"
 #endif
 	                 "\t    compression level options: none (default), empty-block,\n"
-	                 "\t    fast or best\n" );
+	                 "\t    fast, best or adaptive (adjusts the level to the throughput),\n"
+	                 "\t    append -skip to fast, best or adaptive to store data that\n"
+	                 "\t    is predicted to be incompressible uncompressed\n" );
 	fprintf( stream, "\t-C: specify the case number (default is case_number).\n" );
 	fprintf( stream, "\t-d: calculate additional digest (hash) types besides md5, options:\n"
 	                 "\t    sha1, sha256\n" );
@@ -751,10 +753,10 @@ int ewfacquirestream_read_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( imaging_handle->number_of_threads > 0 )
 		{
-			if( libcthreads_thread_pool_push(
-			     imaging_handle->process_thread_pool,
-			     (intptr_t *) storage_media_buffer,
-			     error ) == -1 )
+			if( imaging_handle_push_storage_media_buffer(
+			     imaging_handle,
+			     storage_media_buffer,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
@@ -835,6 +837,20 @@ int ewfacquirestream_read_input(
 
 			goto on_error;
 		}
+		if( imaging_handle_print_compression_levels(
+		     imaging_handle,
+		     imaging_handle->notify_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print compression levels.",
+			 function );
+
+			goto on_error;
+		}
 		if( log_handle != NULL )
 		{
 			if( imaging_handle_print_hashes(
@@ -851,6 +867,34 @@ int ewfacquirestream_read_input(
 
 				goto on_error;
 			}
+			if( imaging_handle_print_compression_levels(
+			     imaging_handle,
+			     log_handle->log_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print compression levels in log handle.",
+				 function );
+
+				goto on_error;
+			}
+			if( imaging_handle_print_queue_depths(
+			     imaging_handle,
+			     log_handle->log_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print queue depths in log handle.",
+				 function );
+
+				goto on_error;
+			}
 		}
 	}
 	return( 1 );
@@ -1652,7 +1696,7 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 		else if( ( result == 0 )
-		      || ( ewfacquirestream_imaging_handle->number_of_threads > (int) 32 ) )
+		      || ( ewfacquirestream_imaging_handle->number_of_threads > EWFCOMMON_MAXIMUM_NUMBER_OF_THREADS ) )
 		{
 			ewfacquirestream_imaging_handle->number_of_threads = 4;
 
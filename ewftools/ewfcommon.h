@@ -32,6 +32,8 @@
 #define EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_32BIT	INT32_MAX
 #define EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_64BIT	INT64_MAX
 
+#define EWFCOMMON_MAXIMUM_NUMBER_OF_THREADS		1024
+
 /* This definition is intended for automated testing of variable process buffer sizes
  */
 #if !defined( EWFCOMMON_PROCESS_BUFFER_SIZE )
@@ -145,7 +145,9 @@ void usage_fprint(
 	                 "\t           compression method options: deflate (default)\n"
 #endif
 	                 "\t           compression level options: none (default), empty-block,\n"
-	                 "\t           fast or best\n" );
+	                 "\t           fast or best, append -skip to fast or best to store\n"
+	                 "\t           data that is predicted to be incompressible\n"
+	                 "\t           uncompressed\n" );
 	fprintf( stream, "\t-d:        calculate additional digest (hash) types besides md5,\n"
 	                 "\t           options: sha1, sha256 (not used for raw and files format)\n" );
 	fprintf( stream, "\t-f:        specify the output format to write to, options:\n"
@@ -901,7 +903,7 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 		else if( ( result == 0 )
-		      || ( ewfexport_export_handle->number_of_threads > (int) 32 ) )
+		      || ( ewfexport_export_handle->number_of_threads > EWFCOMMON_MAXIMUM_NUMBER_OF_THREADS ) )
 		{
 			ewfexport_export_handle->number_of_threads = 4;
 
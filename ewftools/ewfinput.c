@@ -598,6 +598,27 @@ int ewfinput_determine_compression_values(
 			result             = 1;
 		}
 	}
+	else if( string_length == 9 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "fast-skip" ),
+		     9 ) == 0 )
+		{
+			*compression_level = LIBEWF_COMPRESSION_LEVEL_FAST;
+			*compression_flags = LIBEWF_COMPRESS_FLAG_SKIP_INCOMPRESSIBLE_DATA;
+			result             = 1;
+		}
+		else if( system_string_compare(
+			  string,
+			  _SYSTEM_STRING( "best-skip" ),
+			  9 ) == 0 )
+		{
+			*compression_level = LIBEWF_COMPRESSION_LEVEL_BEST;
+			*compression_flags = LIBEWF_COMPRESS_FLAG_SKIP_INCOMPRESSIBLE_DATA;
+			result             = 1;
+		}
+	}
 	return( result );
 }
 
@@ -71,7 +71,8 @@ void usage_fprint(
 	}
 	fprintf( stream, "Use ewfmount to mount an Expert Witness Compression Format (EWF) image file\n\n" );
 
-	fprintf( stream, "Usage: ewfmount [ -f format ] [ -X extended_options ] [ -hvV ] image mount_point\n\n" );
+	fprintf( stream, "Usage: ewfmount [ -f format ] [ -j jobs ] [ -X extended_options ] [ -hvV ]\n"
+	                 "                image mount_point\n\n" );
 
 	fprintf( stream, "\timage:       an Expert Witness Compression Format (EWF) image file\n\n" );
 	fprintf( stream, "\tmount_point: the directory to serve as mount point\n\n" );
@@ -79,6 +80,10 @@ void usage_fprint(
 	fprintf( stream, "\t-f:          specify the input format, options: raw (default), files (restricted to\n"
 	                 "\t             logical volume files)\n" );
 	fprintf( stream, "\t-h:          shows this help\n" );
+	fprintf( stream, "\t-j:          the number of concurrent read jobs (threads), where a number\n"
+	                 "\t             of 0 represents single-threaded mode (default). Before\n"
+	                 "\t             libfuse 3.12 FUSE determines the number of threads itself\n"
+	                 "\t             and a number greater than 1 only enables multi-threaded mode\n" );
 	fprintf( stream, "\t-v:          verbose output to stderr, while ewfmount will remain running in the\n"
 	                 "\t             foreground\n" );
 	fprintf( stream, "\t-V:          print version\n" );
@@ -146,6 +151,7 @@ int main( int argc, char * const argv[] )
 	system_character_t *mount_point             = NULL;
 	system_character_t *option_extended_options = NULL;
 	system_character_t *option_format           = NULL;
+	system_character_t *option_number_of_jobs   = NULL;
 	const system_character_t *path_prefix       = NULL;
 	system_character_t *program                 = _SYSTEM_STRING( "ewfmount" );
 	system_integer_t option                     = 0;
@@ -173,6 +179,10 @@ int main( int argc, char * const argv[] )
 #endif
 	struct fuse *ewfmount_fuse_handle            = NULL;
 
+#if defined( HAVE_LIBFUSE3 ) && defined( HAVE_FUSE_LOOP_CFG_SET_MAX_THREADS )
+	struct fuse_loop_config *ewfmount_fuse_loop_config = NULL;
+#endif
+
 #elif defined( HAVE_LIBDOKAN )
 	DOKAN_OPERATIONS ewfmount_dokan_operations;
 	DOKAN_OPTIONS ewfmount_dokan_options;
@@ -211,7 +221,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "f:hvVX:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "f:hj:vVX:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -238,6 +248,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'j':
+				option_number_of_jobs = optarg;
+
+				break;
+
 			case (system_integer_t) 'v':
 				verbose = 1;
 
@@ -359,6 +374,40 @@ int main( int argc, char * const argv[] )
 			 "Unsupported input format defaulting to: raw.\n" );
 		}
 	}
+	if( option_number_of_jobs != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		result = mount_handle_set_number_of_threads(
+			  ewfmount_mount_handle,
+			  option_number_of_jobs,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of jobs (threads).\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			ewfmount_mount_handle->number_of_threads = 0;
+
+			fprintf(
+			 stderr,
+			 "Unsupported number of jobs (threads) defaulting to: %d.\n",
+			 ewfmount_mount_handle->number_of_threads );
+		}
+#else
+		ewfmount_mount_handle->number_of_threads = 0;
+
+		fprintf(
+		 stderr,
+		 "Unsupported number of jobs (threads) defaulting to: %d.\n",
+		 ewfmount_mount_handle->number_of_threads );
+#endif
+	}
 #if defined( HAVE_GETRLIMIT )
 	if( getrlimit(
 	     RLIMIT_NOFILE,
@@ -558,8 +607,50 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
-	result = fuse_loop(
-	          ewfmount_fuse_handle );
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ewfmount_mount_handle->number_of_threads > 1 )
+	{
+#if defined( HAVE_LIBFUSE3 ) && defined( HAVE_FUSE_LOOP_CFG_SET_MAX_THREADS )
+		ewfmount_fuse_loop_config = fuse_loop_cfg_create();
+
+		if( ewfmount_fuse_loop_config == NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create fuse loop configuration.\n" );
+
+			goto on_error;
+		}
+		fuse_loop_cfg_set_max_threads(
+		 ewfmount_fuse_loop_config,
+		 (unsigned int) ewfmount_mount_handle->number_of_threads );
+
+		result = fuse_loop_mt(
+		          ewfmount_fuse_handle,
+		          ewfmount_fuse_loop_config );
+
+		fuse_loop_cfg_destroy(
+		 ewfmount_fuse_loop_config );
+
+		ewfmount_fuse_loop_config = NULL;
+
+#elif defined( HAVE_LIBFUSE3 )
+		/* Before libfuse 3.12 the number of threads cannot be set
+		 */
+		result = fuse_loop_mt(
+		          ewfmount_fuse_handle,
+		          0 );
+#else
+		result = fuse_loop_mt(
+		          ewfmount_fuse_handle );
+#endif
+	}
+	else
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+	{
+		result = fuse_loop(
+		          ewfmount_fuse_handle );
+	}
 
 	if( result != 0 )
 	{
@@ -604,9 +695,23 @@ int main( int argc, char * const argv[] )
 	ewfmount_dokan_options.MountPoint = mount_point;
 
 #if DOKAN_MINIMUM_COMPATIBLE_VERSION >= 200
-	ewfmount_dokan_options.SingleThread = TRUE;
+	if( ewfmount_mount_handle->number_of_threads > 1 )
+	{
+		ewfmount_dokan_options.SingleThread = FALSE;
+	}
+	else
+	{
+		ewfmount_dokan_options.SingleThread = TRUE;
+	}
 #else
-	ewfmount_dokan_options.ThreadCount  = 0;
+	if( ewfmount_mount_handle->number_of_threads > 1 )
+	{
+		ewfmount_dokan_options.ThreadCount = (USHORT) ewfmount_mount_handle->number_of_threads;
+	}
+	else
+	{
+		ewfmount_dokan_options.ThreadCount = 0;
+	}
 #endif
 	if( verbose != 0 )
 	{
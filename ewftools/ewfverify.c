@@ -73,7 +73,7 @@ void usage_fprint(
 
 	fprintf( stream, "Usage: ewfverify [ -A codepage ] [ -d digest_type ] [ -f format ]\n"
 	                 "                 [ -j jobs ] [ -l log_filename ] [ -p process_buffer_size ]\n"
-	                 "                 [ -hqvVwx ] ewf_files\n\n" );
+	                 "                 [ -W piecewise_size ] [ -ChqvVwx ] ewf_files\n\n" );
 
 	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files\n\n" );
 
@@ -82,6 +82,9 @@ void usage_fprint(
 	                 "\t           windows-950, windows-1250, windows-1251, windows-1252,\n"
 	                 "\t           windows-1253, windows-1254, windows-1255, windows-1256,\n"
 	                 "\t           windows-1257 or windows-1258\n" );
+	fprintf( stream, "\t-C:        verify the chunks on separate handles concurrently with the\n"
+	                 "\t           digest (hash) calculation, one per job, which reports\n"
+	                 "\t           corrupted chunks early (requires multi-threaded mode)\n" );
 	fprintf( stream, "\t-d:        calculate digest (hash) types, options: md5, sha1, sha256.\n"
 	                 "\t           By default ewfverify will calculate the digest (hash) types\n"
 	                 "\t           that are stored in the EWF segment files or MD5 if none.\n" );
@@ -98,6 +101,9 @@ void usage_fprint(
 	fprintf( stream, "\t-v:        verbose output to stderr\n" );
 	fprintf( stream, "\t-V:        print version\n" );
 	fprintf( stream, "\t-w:        zero sectors on checksum error (mimic EnCase like behavior)\n" );
+	fprintf( stream, "\t-W:        calculate the digest (hash) types per piece of\n"
+	                 "\t           piecewise_size bytes and log them to the log_filename\n"
+	                 "\t           (requires -l)\n" );
 	fprintf( stream, "\t-x:        use the data chunk funcsion instead of the buffered read and\n"
 	                 "\t           write functions.\n" );
 }
@@ -166,12 +172,14 @@ int main( int argc, char * const argv[] )
 	system_character_t *option_format              = NULL;
 	system_character_t *option_header_codepage     = NULL;
 	system_character_t *option_number_of_jobs      = NULL;
+	system_character_t *option_piecewise_size      = NULL;
 	system_character_t *option_process_buffer_size = NULL;
 	system_character_t *program                    = _SYSTEM_STRING( "ewfverify" );
 	system_integer_t option                        = 0;
 	uint8_t print_status_information               = 1;
 	uint8_t use_data_chunk_functions               = 0;
 	uint8_t verbose                                = 0;
+	uint8_t verify_chunks_concurrently             = 0;
 	uint8_t zero_chunk_on_error                    = 0;
 	int number_of_filenames                        = 0;
 	int result                                     = 0;
@@ -213,7 +221,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:d:f:j:hl:p:qvVwx" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:Cd:f:j:hl:p:qvVwW:x" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -234,6 +242,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'C':
+				verify_chunks_concurrently = 1;
+
+				break;
+
 			case (system_integer_t) 'd':
 				option_digest_types = optarg;
 
@@ -286,6 +299,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'W':
+				option_piecewise_size = optarg;
+
+				break;
+
 			case (system_integer_t) 'x':
 				use_data_chunk_functions = 1;
 
@@ -393,6 +411,44 @@ int main( int argc, char * const argv[] )
 			 "Unsupported process buffer size defaulting to: chunk size.\n" );
 		}
 	}
+	if( option_piecewise_size != NULL )
+	{
+		if( log_filename == NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Piecewise hashing requires a log file.\n" );
+
+			goto on_error;
+		}
+		if( ewfverify_verification_handle->input_format == VERIFICATION_HANDLE_INPUT_FORMAT_FILES )
+		{
+			fprintf(
+			 stderr,
+			 "Piecewise hashing with input format: files not supported.\n" );
+
+			goto on_error;
+		}
+		result = verification_handle_set_piecewise_hash_window_size(
+			  ewfverify_verification_handle,
+			  option_piecewise_size,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set piecewise size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported piecewise size disabling piecewise hashing.\n" );
+		}
+	}
 	if( option_number_of_jobs != NULL )
 	{
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
@@ -410,7 +466,7 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 		else if( ( result == 0 )
-		      || ( ewfverify_verification_handle->number_of_threads > (int) 32 ) )
+		      || ( ewfverify_verification_handle->number_of_threads > EWFCOMMON_MAXIMUM_NUMBER_OF_THREADS ) )
 		{
 			ewfverify_verification_handle->number_of_threads = 4;
 
@@ -426,6 +482,26 @@ int main( int argc, char * const argv[] )
 		 stderr,
 		 "Unsupported number of jobs (threads) defaulting to: %d.\n",
 		 ewfverify_verification_handle->number_of_threads );
+#endif
+	}
+	if( verify_chunks_concurrently != 0 )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( verification_handle_set_verify_chunks_concurrently(
+		     ewfverify_verification_handle,
+		     verify_chunks_concurrently,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set verify chunks concurrently.\n" );
+
+			goto on_error;
+		}
+#else
+		fprintf(
+		 stderr,
+		 "Unsupported verify chunks concurrently, multi-threaded mode is not supported.\n" );
 #endif
 	}
 	if( option_digest_types != NULL )
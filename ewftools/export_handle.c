@@ -302,6 +302,24 @@ int export_handle_free(
 				result = -1;
 			}
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *export_handle )->digest_hash_ring != NULL )
+		{
+			if( digest_hash_ring_free(
+			     &( ( *export_handle )->digest_hash_ring ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free digest hash ring.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		if( ( *export_handle )->md5_context != NULL )
 		{
 			if( libhmac_md5_free(
@@ -1378,9 +1396,39 @@ int export_handle_initialize_integrity_hash(
 		}
 		export_handle->sha256_context_initialized = 1;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* When multiple digest hashes are calculated every digest hash is calculated on its own thread
+	 */
+	if( ( export_handle->number_of_threads > 0 )
+	 && ( ( export_handle->calculate_md5 + export_handle->calculate_sha1 + export_handle->calculate_sha256 ) > 1 ) )
+	{
+		if( digest_hash_ring_initialize(
+		     &( export_handle->digest_hash_ring ),
+		     ( export_handle->calculate_md5 != 0 ) ? export_handle->md5_context : NULL,
+		     ( export_handle->calculate_sha1 != 0 ) ? export_handle->sha1_context : NULL,
+		     ( export_handle->calculate_sha256 != 0 ) ? export_handle->sha256_context : NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create digest hash ring.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	return( 1 );
 
 on_error:
+	if( export_handle->sha256_context != NULL )
+	{
+		libhmac_sha256_free(
+		 &( export_handle->sha256_context ),
+		 NULL );
+	}
 	if( export_handle->sha1_context != NULL )
 	{
 		libhmac_sha1_free(
@@ -1441,6 +1489,27 @@ int export_handle_update_integrity_hash(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->digest_hash_ring != NULL )
+	{
+		if( digest_hash_ring_update(
+		     export_handle->digest_hash_ring,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update digest hash ring.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#endif
 	if( export_handle->calculate_md5 != 0 )
 	{
 		if( libhmac_md5_update(
@@ -1522,6 +1591,43 @@ int export_handle_finalize_integrity_hash(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The digest hash ring threads must have consumed all data before the digest hashes are finalized
+	 */
+	if( export_handle->digest_hash_ring != NULL )
+	{
+		if( digest_hash_ring_join(
+		     export_handle->digest_hash_ring,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join digest hash ring.",
+			 function );
+
+			digest_hash_ring_free(
+			 &( export_handle->digest_hash_ring ),
+			 NULL );
+
+			return( -1 );
+		}
+		if( digest_hash_ring_free(
+		     &( export_handle->digest_hash_ring ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free digest hash ring.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	if( export_handle->calculate_md5 != 0 )
 	{
 		if( libhmac_md5_finalize(
@@ -1733,6 +1839,230 @@ int export_handle_get_output_chunk_size(
 	return( 1 );
 }
 
+/* Determines if the packed chunks of the input can be written to the output as-is
+ * This requires EWF (version 1) input and output with the same chunk size and compression values
+ * Returns 1 if the chunks can be passed through, 0 if not or -1 on error
+ */
+int export_handle_determine_pass_through_chunks(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function             = "export_handle_determine_pass_through_chunks";
+	size32_t output_chunk_size        = 0;
+	uint16_t input_compression_method = 0;
+	uint8_t input_compression_flags   = 0;
+	uint8_t input_format              = 0;
+	uint8_t major_version             = 0;
+	uint8_t minor_version             = 0;
+	int8_t input_compression_level    = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->output_format != EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+	{
+		return( 0 );
+	}
+	/* SMART and EWF version 2 chunks are stored differently and are packed again
+	 */
+	if( ( export_handle->ewf_format == LIBEWF_FORMAT_SMART )
+	 || ( export_handle->ewf_format == LIBEWF_FORMAT_V2_ENCASE7 ) )
+	{
+		return( 0 );
+	}
+	if( libewf_handle_get_format(
+	     export_handle->input_handle,
+	     &input_format,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve input format.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_segment_file_version(
+	     export_handle->input_handle,
+	     &major_version,
+	     &minor_version,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve input segment file version.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_format == LIBEWF_FORMAT_SMART )
+	 || ( major_version != 1 ) )
+	{
+		return( 0 );
+	}
+	if( export_handle_get_output_chunk_size(
+	     export_handle,
+	     &output_chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the output chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_chunk_size != export_handle->input_chunk_size )
+	{
+		return( 0 );
+	}
+	if( libewf_handle_get_compression_method(
+	     export_handle->input_handle,
+	     &input_compression_method,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve input compression method.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_compression_values(
+	     export_handle->input_handle,
+	     &input_compression_level,
+	     &input_compression_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve input compression values.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_compression_method != export_handle->compression_method )
+	 || ( input_compression_level != export_handle->compression_level )
+	 || ( input_compression_flags != export_handle->compression_flags ) )
+	{
+		return( 0 );
+	}
+	/* The output chunks must start and end at input chunk boundaries
+	 */
+	if( ( export_handle->export_offset % export_handle->input_chunk_size ) != 0 )
+	{
+		return( 0 );
+	}
+	if( ( ( export_handle->export_size % export_handle->input_chunk_size ) != 0 )
+	 && ( ( export_handle->export_offset + export_handle->export_size ) != export_handle->input_media_size ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Writes the packed chunk of a storage media buffer to the output as-is
+ * Returns 1 if successful, 0 if the chunk needs to be packed again or -1 on error
+ */
+int export_handle_write_packed_chunk(
+     export_handle_t *export_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_write_packed_chunk";
+	ssize_t write_count   = 0;
+	int result            = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->pass_through_chunks == 0 )
+	{
+		return( 0 );
+	}
+	/* A chunk smaller than the chunk size, such as the last chunk, or a corrupted chunk
+	 * was unpacked in the data chunk and is packed again
+	 */
+	if( storage_media_buffer->processed_size != (size_t) export_handle->input_chunk_size )
+	{
+		return( 0 );
+	}
+	result = storage_media_buffer_is_corrupted(
+	          storage_media_buffer,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if storage media buffer is corrupted.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		return( 0 );
+	}
+	write_count = storage_media_buffer_write_to_handle(
+	               storage_media_buffer,
+	               export_handle->ewf_output_handle,
+	               storage_media_buffer->processed_size,
+	               error );
+
+	if( write_count <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write packed chunk.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Prompts the user for a string
  * Returns 1 if successful, 0 if no input was provided or -1 on error
  */
@@ -3187,7 +3517,7 @@ int export_handle_set_number_of_threads(
 		}
 		result = 1;
 
-		if( number_of_threads > 32 )
+		if( number_of_threads > (uint64_t) EWFCOMMON_MAXIMUM_NUMBER_OF_THREADS )
 		{
 			result = 0;
 		}
@@ -4082,7 +4412,10 @@ int export_handle_append_read_error(
 	{
 		number_of_sectors += 1;
 	}
-	if( export_handle->use_data_chunk_functions != 0 )
+	/* The input handle does not track checksum errors of data chunks
+	 */
+	if( ( export_handle->use_data_chunk_functions != 0 )
+	 || ( export_handle->pass_through_chunks != 0 ) )
 	{
 		if( libewf_handle_append_checksum_error(
 		     export_handle->input_handle,
@@ -4510,14 +4843,13 @@ int export_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      export_handle_t *export_handle )
 {
-	libcdata_list_element_t *element                    = NULL;
-	libcdata_list_element_t *next_element               = NULL;
         libcerror_error_t *error                            = NULL;
 	storage_media_buffer_t *output_storage_media_buffer = NULL;
 	uint8_t *data                                       = NULL;
-        static char *function                               = "export_handle_process_storage_media_buffer_callback";
+        static char *function                               = "export_handle_output_storage_media_buffer_callback";
 	size_t data_size                                    = 0;
 	ssize_t write_count                                 = 0;
+	int output_buffer_index                             = 0;
 	int result                                          = 0;
 
 	if( export_handle == NULL )
@@ -4546,75 +4878,43 @@ int export_handle_output_storage_media_buffer_callback(
 	{
 		return( 1 );
 	}
-	if( libcdata_list_insert_value(
-	     export_handle->output_list,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
-	     &error ) != 1 )
+	/* Since the number of storage media buffers is limited to the maximum number of queued buffers
+	 * the sequence numbers of the buffers in flight map onto distinct output buffers
+	 */
+	output_buffer_index = (int) ( storage_media_buffer->sequence_number % (uint64_t) export_handle->maximum_number_of_queued_buffers );
+
+	if( export_handle->output_buffers[ output_buffer_index ] != NULL )
 	{
 		libcerror_error_set(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert storage media buffer into output list.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - output buffer: %d value already set.",
+		 function,
+		 output_buffer_index );
 
 		goto on_error;
 	}
+	export_handle->output_buffers[ output_buffer_index ] = storage_media_buffer;
+
 	storage_media_buffer = NULL;
 
-	if( libcdata_list_get_first_element(
-	     export_handle->output_list,
-	     &element,
-	     &error ) != 1 )
+	while( export_handle->abort == 0 )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
-		 function );
+		output_buffer_index = (int) ( export_handle->next_output_sequence_number % (uint64_t) export_handle->maximum_number_of_queued_buffers );
 
-		goto on_error;
-	}
-	while( element != NULL )
-	{
-		if( export_handle->abort != 0 )
+		if( export_handle->output_buffers[ output_buffer_index ] == NULL )
 		{
 			break;
 		}
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
+		/* The output buffers no longer manage the storage media buffer
+		 */
+		storage_media_buffer = export_handle->output_buffers[ output_buffer_index ];
 
-			storage_media_buffer = NULL;
+		export_handle->output_buffers[ output_buffer_index ] = NULL;
 
-			goto on_error;
-		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
+		export_handle->next_output_sequence_number += 1;
 
-			return( -1 );
-		}
-		if( storage_media_buffer->storage_media_offset != export_handle->last_offset_hashed )
-		{
-			break;
-		}
 		result = storage_media_buffer_is_corrupted(
 		          storage_media_buffer,
 		          &error );
@@ -4628,8 +4928,6 @@ int export_handle_output_storage_media_buffer_callback(
 			 "%s: unable to determine if storage media buffer is corrupted.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
 		else if( result != 0 )
@@ -4649,8 +4947,6 @@ int export_handle_output_storage_media_buffer_callback(
 				 "%s: unable to append read error.",
 				 function );
 
-				storage_media_buffer = NULL;
-
 				goto on_error;
 			}
 		}
@@ -4667,8 +4963,6 @@ int export_handle_output_storage_media_buffer_callback(
 			 "%s: unable to determine storage media buffer data.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
 		/* Swap byte pairs
@@ -4688,8 +4982,6 @@ int export_handle_output_storage_media_buffer_callback(
 				 "%s: unable to swap byte pairs.",
 				 function );
 
-				storage_media_buffer = NULL;
-
 				goto on_error;
 			}
 		}
@@ -4708,13 +5000,29 @@ int export_handle_output_storage_media_buffer_callback(
 			 "%s: unable to update integrity hash(es).",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
 		export_handle->last_offset_hashed = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
 
-		if( export_handle->use_data_chunk_functions != 0 )
+		result = export_handle_write_packed_chunk(
+		          export_handle,
+		          storage_media_buffer,
+		          &error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write packed chunk.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( result == 0 )
+		 && ( ( export_handle->use_data_chunk_functions != 0 )
+		  || ( export_handle->pass_through_chunks != 0 ) ) )
 		{
 			if( storage_media_buffer_initialize(
 			     &output_storage_media_buffer,
@@ -4730,78 +5038,29 @@ int export_handle_output_storage_media_buffer_callback(
 				 "%s: unable to create output storage media buffer.",
 				 function );
 
-				storage_media_buffer = NULL;
-
 				goto on_error;
 			}
 		}
-		write_count = export_handle_write(
-			       export_handle,
-			       storage_media_buffer,
-			       output_storage_media_buffer,
-			       storage_media_buffer->processed_size,
-			       &error );
-
-		if( write_count < 0 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write to export handle.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		if( libcdata_list_remove_element(
-		     export_handle->output_list,
-		     element,
-		     &error ) != 1 )
+		if( result == 0 )
 		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
-
-			storage_media_buffer = NULL;
+			write_count = export_handle_write(
+				       export_handle,
+				       storage_media_buffer,
+				       output_storage_media_buffer,
+				       storage_media_buffer->processed_size,
+				       &error );
 
-			goto on_error;
-		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
+			if( write_count < 0 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write to export handle.",
+				 function );
 
-			goto on_error;
+				goto on_error;
+			}
 		}
 /* TODO: if storage media buffer can be passed on do not release it */
 		if( storage_media_buffer_queue_release_buffer(
@@ -4837,8 +5096,6 @@ int export_handle_output_storage_media_buffer_callback(
 				goto on_error;
 			}
 		}
-		element = next_element;
-
 		if( process_status_update(
 		     export_handle->process_status,
 		     export_handle->last_offset_hashed,
@@ -4905,17 +5162,16 @@ on_error:
 	return( -1 );
 }
 
-/* Empties the output list
+/* Empties the output buffers
  * Returns 1 if successful or -1 on error
  */
-int export_handle_empty_output_list(
+int export_handle_empty_output_buffers(
      export_handle_t *export_handle,
      libcerror_error_t **error )
 {
-	libcdata_list_element_t *element             = NULL;
-	libcdata_list_element_t *next_element        = NULL;
 	storage_media_buffer_t *storage_media_buffer = NULL;
-        static char *function                        = "export_handle_empty_output_list";
+        static char *function                        = "export_handle_empty_output_buffers";
+	int output_buffer_index                      = 0;
 
 	if( export_handle == NULL )
 	{
@@ -4928,47 +5184,29 @@ int export_handle_empty_output_list(
 
 		return( -1 );
 	}
-	if( libcdata_list_get_first_element(
-	     export_handle->output_list,
-	     &element,
-	     error ) != 1 )
+	if( export_handle->output_buffers == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing output buffers.",
 		 function );
 
 		return( -1 );
 	}
-	while( element != NULL )
+	for( output_buffer_index = 0;
+	     output_buffer_index < export_handle->maximum_number_of_queued_buffers;
+	     output_buffer_index++ )
 	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
+		storage_media_buffer = export_handle->output_buffers[ output_buffer_index ];
 
-			return( -1 );
-		}
 		if( storage_media_buffer == NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
-
-			return( -1 );
+			continue;
 		}
+		export_handle->output_buffers[ output_buffer_index ] = NULL;
+
 		if( storage_media_buffer_queue_release_buffer(
 		     export_handle->storage_media_buffer_queue,
 		     storage_media_buffer,
@@ -4981,55 +5219,12 @@ int export_handle_empty_output_list(
 			 "%s: unable to release storage media buffer onto queue.",
 			 function );
 
-			return( -1 );
-		}
-		storage_media_buffer = NULL;
-
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
-
-			return( -1 );
-		}
-		if( libcdata_list_remove_element(
-		     export_handle->output_list,
-		     element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
-
-			return( -1 );
-		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
+			storage_media_buffer_free(
+			 &storage_media_buffer,
+			 NULL );
 
 			return( -1 );
 		}
-		element = next_element;
 	}
 	return( 1 );
 }
@@ -5194,11 +5389,48 @@ int export_handle_export_input(
 		}
 		storage_media_buffer_mode = STORAGE_MEDIA_BUFFER_MODE_BUFFERED;
 	}
+	export_handle->pass_through_chunks = 0;
+
+	if( swap_byte_pairs == 0 )
+	{
+		result = export_handle_determine_pass_through_chunks(
+		          export_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if chunks can be passed through.",
+			 function );
+
+			goto on_error;
+		}
+		export_handle->pass_through_chunks = (uint8_t) result;
+	}
+	if( export_handle->pass_through_chunks != 0 )
+	{
+		/* The input is read in data chunks so that the packed chunks can be
+		 * written as-is and only need to be unpacked for the digest hashes
+		 */
+		export_handle->output_chunk_size = export_handle->input_chunk_size;
+		process_buffer_size              = (size_t) export_handle->input_chunk_size;
+		storage_media_buffer_mode        = STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA;
+	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 	if( export_handle->number_of_threads != 0 )
 	{
 		maximum_number_of_queued_items = 1 + (int) ( EXPORT_HANDLE_MAXIMUM_PROCESS_BUFFERS_SIZE / process_buffer_size );
 
+		/* Make sure every process thread has a storage media buffer to work on
+		 * while previously processed storage media buffers are being written
+		 */
+		if( maximum_number_of_queued_items < ( 2 * export_handle->number_of_threads ) )
+		{
+			maximum_number_of_queued_items = 2 * export_handle->number_of_threads;
+		}
 		if( libcthreads_thread_pool_create(
 		     &( export_handle->input_process_thread_pool ),
 		     NULL,
@@ -5235,19 +5467,38 @@ int export_handle_export_input(
 
 			goto on_error;
 		}
-		if( libcdata_list_initialize(
-		     &( export_handle->output_list ),
-		     error ) != 1 )
+		export_handle->output_buffers = (storage_media_buffer_t **) memory_allocate(
+		                                 sizeof( storage_media_buffer_t * ) * maximum_number_of_queued_items );
+
+		if( export_handle->output_buffers == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create output list.",
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create output buffers.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     export_handle->output_buffers,
+		     0,
+		     sizeof( storage_media_buffer_t * ) * maximum_number_of_queued_items ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear output buffers.",
 			 function );
 
 			goto on_error;
 		}
+		export_handle->maximum_number_of_queued_buffers = maximum_number_of_queued_items;
+		export_handle->next_process_sequence_number     = 0;
+		export_handle->next_output_sequence_number      = 0;
+
 		if( storage_media_buffer_queue_initialize(
 		     &( export_handle->storage_media_buffer_queue ),
 		     export_handle->input_handle,
@@ -5414,6 +5665,12 @@ int export_handle_export_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( export_handle->number_of_threads != 0 )
 		{
+			/* The sequence number is used to output the processed storage media buffers in order
+			 */
+			input_storage_media_buffer->sequence_number = export_handle->next_process_sequence_number;
+
+			export_handle->next_process_sequence_number += 1;
+
 			if( libcthreads_thread_pool_push(
 			     export_handle->input_process_thread_pool,
 			     (intptr_t *) input_storage_media_buffer,
@@ -5541,7 +5798,25 @@ int export_handle_export_input(
 			}
 			export_handle->last_offset_hashed += input_storage_media_buffer->processed_size;
 
-			if( ( export_handle->use_data_chunk_functions != 0 )
+			result = export_handle_write_packed_chunk(
+			          export_handle,
+			          input_storage_media_buffer,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write packed chunk.",
+				 function );
+
+				goto on_error;
+			}
+			if( ( result == 0 )
+			 && ( ( export_handle->use_data_chunk_functions != 0 )
+			  || ( export_handle->pass_through_chunks != 0 ) )
 			 && ( output_storage_media_buffer == NULL ) )
 			{
 				if( storage_media_buffer_initialize(
@@ -5561,23 +5836,26 @@ int export_handle_export_input(
 					goto on_error;
 				}
 			}
-			write_count = export_handle_write(
-			               export_handle,
-			               input_storage_media_buffer,
-			               output_storage_media_buffer,
-			               input_storage_media_buffer->processed_size,
-			               error );
-
-			if( write_count < 0 )
+			if( result == 0 )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write to export handle.",
-				 function );
+				write_count = export_handle_write(
+				               export_handle,
+				               input_storage_media_buffer,
+				               output_storage_media_buffer,
+				               input_storage_media_buffer->processed_size,
+				               error );
+
+				if( write_count < 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write to export handle.",
+					 function );
 
-				goto on_error;
+					goto on_error;
+				}
 			}
 			if( process_status_update(
 			     export_handle->process_status,
@@ -5661,9 +5939,9 @@ int export_handle_export_input(
 			goto on_error;
 		}
 	}
-	if( export_handle->output_list != NULL )
+	if( export_handle->output_buffers != NULL )
 	{
-		if( export_handle_empty_output_list(
+		if( export_handle_empty_output_buffers(
 		     export_handle,
 		     error ) != 1 )
 		{
@@ -5671,25 +5949,15 @@ int export_handle_export_input(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to empty output list.",
+			 "%s: unable to empty output buffers.",
 			 function );
 
 			goto on_error;
 		}
-		if( libcdata_list_free(
-		     &( export_handle->output_list ),
-		     NULL,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output list.",
-			 function );
+		memory_free(
+		 export_handle->output_buffers );
 
-			goto on_error;
-		}
+		export_handle->output_buffers = NULL;
 	}
 	if( export_handle->storage_media_buffer_queue != NULL )
 	{
@@ -5871,15 +6139,15 @@ on_error:
 		 &( export_handle->output_thread_pool ),
 		 NULL );
 	}
-	if( export_handle->output_list != NULL )
+	if( export_handle->output_buffers != NULL )
 	{
-		export_handle_empty_output_list(
+		export_handle_empty_output_buffers(
 		 export_handle,
 		 NULL );
-		libcdata_list_free(
-		 &( export_handle->output_list ),
-		 NULL,
-		 NULL );
+		memory_free(
+		 export_handle->output_buffers );
+
+		export_handle->output_buffers = NULL;
 	}
 	if( export_handle->storage_media_buffer_queue != NULL )
 	{
@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "digest_hash.h"
+#include "digest_hash_ring.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
@@ -151,6 +152,12 @@ struct export_handle
 	 */
 	uint8_t sha256_context_initialized;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The digest hash ring used to calculate the digest hashes concurrently
+	 */
+	digest_hash_ring_t *digest_hash_ring;
+#endif
+
 	/* The calculated SHA256 digest hash string
 	 */
 	char *calculated_sha256_hash_string;
@@ -159,6 +166,10 @@ struct export_handle
 	 */
 	uint8_t use_data_chunk_functions;
 
+	/* Value to indicate if the packed chunks of the input are written to the output as-is
+	 */
+	uint8_t pass_through_chunks;
+
 	/* The process buffer size
 	 */
 	size_t process_buffer_size;
@@ -177,9 +188,22 @@ struct export_handle
 	 */
 	libcthreads_thread_pool_t *output_thread_pool;
 
-	/* The output list
+	/* The output buffers, a reorder buffer of processed storage media buffers
+	 * indexed by sequence number modulo the maximum number of queued storage media buffers
+	 */
+	storage_media_buffer_t **output_buffers;
+
+	/* The maximum number of queued storage media buffers
+	 */
+	int maximum_number_of_queued_buffers;
+
+	/* The sequence number of the next storage media buffer to push onto the process thread pool
 	 */
-	libcdata_list_t *output_list;
+	uint64_t next_process_sequence_number;
+
+	/* The sequence number of the next storage media buffer to output
+	 */
+	uint64_t next_output_sequence_number;
 
 	/* The storage media buffer queue
 	 */
@@ -343,6 +367,15 @@ int export_handle_get_output_chunk_size(
      size32_t *chunk_size,
      libcerror_error_t **error );
 
+int export_handle_determine_pass_through_chunks(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_write_packed_chunk(
+     export_handle_t *export_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error );
+
 int export_handle_prompt_for_string(
      export_handle_t *export_handle,
      const system_character_t *request_string,
@@ -486,7 +519,7 @@ int export_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      export_handle_t *export_handle );
 
-int export_handle_empty_output_list(
+int export_handle_empty_output_buffers(
      export_handle_t *export_handle,
      libcerror_error_t **error );
 
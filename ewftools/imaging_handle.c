@@ -56,6 +56,18 @@
 #define IMAGING_HANDLE_NOTIFY_STREAM			stdout
 #define IMAGING_HANDLE_MAXIMUM_PROCESS_BUFFERS_SIZE	64 * 1024 * 1024
 
+/* The adaptive compression levels ordered from fast to best
+ */
+static int8_t imaging_handle_adaptive_compression_levels[ IMAGING_HANDLE_NUMBER_OF_ADAPTIVE_COMPRESSION_LEVELS ] = {
+	LIBEWF_COMPRESSION_LEVEL_FAST,
+	LIBEWF_COMPRESSION_LEVEL_DEFAULT,
+	LIBEWF_COMPRESSION_LEVEL_BEST };
+
+static const char *imaging_handle_adaptive_compression_level_names[ IMAGING_HANDLE_NUMBER_OF_ADAPTIVE_COMPRESSION_LEVELS ] = {
+	"fast",
+	"default",
+	"best" };
+
 /* Creates an imaging handle
  * Make sure the value imaging_handle is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
@@ -284,6 +296,40 @@ int imaging_handle_free(
 			memory_free(
 			 ( *imaging_handle )->notes );
 		}
+		if( ( *imaging_handle )->piecewise_hash != NULL )
+		{
+			if( piecewise_hash_free(
+			     &( ( *imaging_handle )->piecewise_hash ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free piecewise hash.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *imaging_handle )->digest_hash_ring != NULL )
+		{
+			if( digest_hash_ring_free(
+			     &( ( *imaging_handle )->digest_hash_ring ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free digest hash ring.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		if( ( *imaging_handle )->md5_context != NULL )
 		{
 			if( libhmac_md5_free(
@@ -376,6 +422,22 @@ int imaging_handle_free(
 				result = -1;
 			}
 		}
+		if( ( *imaging_handle )->reference_handle != NULL )
+		{
+			if( libewf_handle_free(
+			     &( ( *imaging_handle )->reference_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free reference handle.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 *imaging_handle );
 
@@ -884,6 +946,217 @@ on_error:
 	return( -1 );
 }
 
+/* Opens a reference image, which contains a previous image of the input
+ * Chunks that are unchanged since the reference image was made are written
+ * using the compressed data of the reference image instead of being compressed again
+ * The output must be opened before the reference image
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_open_reference(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	system_character_t **libewf_filenames = NULL;
+	static char *function                 = "imaging_handle_open_reference";
+	size_t filename_length                = 0;
+	int number_of_filenames               = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->reference_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid imaging handle - reference handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide(
+	     filename,
+	     filename_length,
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &libewf_filenames,
+	     &number_of_filenames,
+	     error ) != 1 )
+#else
+	if( libewf_glob(
+	     filename,
+	     filename_length,
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &libewf_filenames,
+	     &number_of_filenames,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to resolve filename(s).",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_initialize(
+	     &( imaging_handle->reference_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create reference handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     imaging_handle->reference_handle,
+	     libewf_filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     imaging_handle->reference_handle,
+	     libewf_filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open reference file(s).",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide_free(
+	     libewf_filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+#else
+	if( libewf_glob_free(
+	     libewf_filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free globbed filenames.",
+		 function );
+
+		libewf_filenames = NULL;
+
+		goto on_error;
+	}
+	libewf_filenames = NULL;
+
+	if( libewf_handle_set_reference_handle(
+	     imaging_handle->output_handle,
+	     imaging_handle->reference_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set reference handle in output handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( imaging_handle->secondary_output_handle != NULL )
+	{
+		if( libewf_handle_set_reference_handle(
+		     imaging_handle->secondary_output_handle,
+		     imaging_handle->reference_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set reference handle in secondary output handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( imaging_handle->reference_handle != NULL )
+	{
+		libewf_handle_set_reference_handle(
+		 imaging_handle->output_handle,
+		 NULL,
+		 NULL );
+
+		if( imaging_handle->secondary_output_handle != NULL )
+		{
+			libewf_handle_set_reference_handle(
+			 imaging_handle->secondary_output_handle,
+			 NULL,
+			 NULL );
+		}
+		libewf_handle_free(
+		 &( imaging_handle->reference_handle ),
+		 NULL );
+	}
+	if( libewf_filenames != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 libewf_filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 libewf_filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	return( -1 );
+}
+
 /* Opens the output of the imaging handle for resume
  * Returns 1 if successful or -1 on error
  */
@@ -1007,6 +1280,24 @@ int imaging_handle_close(
 			return( -1 );
 		}
 	}
+	/* The reference handle is closed after the output handles that use it
+	 */
+	if( imaging_handle->reference_handle != NULL )
+	{
+		if( libewf_handle_close(
+		     imaging_handle->reference_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close reference handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( 0 );
 }
 
@@ -1346,9 +1637,39 @@ int imaging_handle_initialize_integrity_hash(
 		}
 		imaging_handle->sha256_context_initialized = 1;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* When multiple digest hashes are calculated every digest hash is calculated on its own thread
+	 */
+	if( ( imaging_handle->number_of_threads > 0 )
+	 && ( ( imaging_handle->calculate_md5 + imaging_handle->calculate_sha1 + imaging_handle->calculate_sha256 ) > 1 ) )
+	{
+		if( digest_hash_ring_initialize(
+		     &( imaging_handle->digest_hash_ring ),
+		     ( imaging_handle->calculate_md5 != 0 ) ? imaging_handle->md5_context : NULL,
+		     ( imaging_handle->calculate_sha1 != 0 ) ? imaging_handle->sha1_context : NULL,
+		     ( imaging_handle->calculate_sha256 != 0 ) ? imaging_handle->sha256_context : NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create digest hash ring.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	return( 1 );
 
 on_error:
+	if( imaging_handle->sha256_context != NULL )
+	{
+		libhmac_sha256_free(
+		 &( imaging_handle->sha256_context ),
+		 NULL );
+	}
 	if( imaging_handle->sha1_context != NULL )
 	{
 		libhmac_sha1_free(
@@ -1409,6 +1730,27 @@ int imaging_handle_update_integrity_hash(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->digest_hash_ring != NULL )
+	{
+		if( digest_hash_ring_update(
+		     imaging_handle->digest_hash_ring,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update digest hash ring.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#endif
 	if( imaging_handle->calculate_md5 != 0 )
 	{
 		if( libhmac_md5_update(
@@ -1490,6 +1832,43 @@ int imaging_handle_finalize_integrity_hash(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The digest hash ring threads must have consumed all data before the digest hashes are finalized
+	 */
+	if( imaging_handle->digest_hash_ring != NULL )
+	{
+		if( digest_hash_ring_join(
+		     imaging_handle->digest_hash_ring,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join digest hash ring.",
+			 function );
+
+			digest_hash_ring_free(
+			 &( imaging_handle->digest_hash_ring ),
+			 NULL );
+
+			return( -1 );
+		}
+		if( digest_hash_ring_free(
+		     &( imaging_handle->digest_hash_ring ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free digest hash ring.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	if( imaging_handle->calculate_md5 != 0 )
 	{
 		if( libhmac_md5_finalize(
@@ -1622,6 +2001,13 @@ int imaging_handle_threads_start(
 	}
 	maximum_number_of_queued_items = 1 + (int) ( IMAGING_HANDLE_MAXIMUM_PROCESS_BUFFERS_SIZE / process_buffer_size );
 
+	/* Make sure every process thread has a storage media buffer to work on
+	 * while previously processed storage media buffers are being written
+	 */
+	if( maximum_number_of_queued_items < ( 2 * imaging_handle->number_of_threads ) )
+	{
+		maximum_number_of_queued_items = 2 * imaging_handle->number_of_threads;
+	}
 	if( libcthreads_thread_pool_create(
 	     &( imaging_handle->process_thread_pool ),
 	     NULL,
@@ -1658,19 +2044,37 @@ int imaging_handle_threads_start(
 
 		goto on_error;
 	}
-	if( libcdata_list_initialize(
-	     &( imaging_handle->output_list ),
-	     error ) != 1 )
+	imaging_handle->output_buffers = (storage_media_buffer_t **) memory_allocate(
+	                                  sizeof( storage_media_buffer_t * ) * maximum_number_of_queued_items );
+
+	if( imaging_handle->output_buffers == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create output list.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create output buffers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     imaging_handle->output_buffers,
+	     0,
+	     sizeof( storage_media_buffer_t * ) * maximum_number_of_queued_items ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear output buffers.",
 		 function );
 
 		goto on_error;
 	}
+	imaging_handle->next_process_sequence_number = 0;
+	imaging_handle->next_output_sequence_number  = 0;
+
 	if( storage_media_buffer_queue_initialize(
 	     &( imaging_handle->storage_media_buffer_queue ),
 	     imaging_handle->output_handle,
@@ -1688,6 +2092,31 @@ int imaging_handle_threads_start(
 
 		goto on_error;
 	}
+	if( libcthreads_mutex_initialize(
+	     &( imaging_handle->queue_depths_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize queue depths mutex.",
+		 function );
+
+		goto on_error;
+	}
+	imaging_handle->maximum_number_of_queued_buffers    = maximum_number_of_queued_items;
+	imaging_handle->number_of_buffers_to_process        = 0;
+	imaging_handle->number_of_buffers_to_output         = 0;
+	imaging_handle->process_queue_depth_sum             = 0;
+	imaging_handle->output_queue_depth_sum              = 0;
+	imaging_handle->number_of_queue_depth_samples       = 0;
+	imaging_handle->maximum_process_queue_depth         = 0;
+	imaging_handle->maximum_output_queue_depth          = 0;
+	imaging_handle->total_process_queue_depth_sum       = 0;
+	imaging_handle->total_output_queue_depth_sum        = 0;
+	imaging_handle->total_number_of_queue_depth_samples = 0;
+
 	return( 1 );
 
 on_error:
@@ -1703,15 +2132,15 @@ on_error:
 		 &( imaging_handle->output_thread_pool ),
 		 NULL );
 	}
-	if( imaging_handle->output_list != NULL )
+	if( imaging_handle->output_buffers != NULL )
 	{
-		imaging_handle_empty_output_list(
+		imaging_handle_empty_output_buffers(
 		 imaging_handle,
 		 NULL );
-		libcdata_list_free(
-		 &( imaging_handle->output_list ),
-		 NULL,
-		 NULL );
+		memory_free(
+		 imaging_handle->output_buffers );
+
+		imaging_handle->output_buffers = NULL;
 	}
 	if( imaging_handle->storage_media_buffer_queue != NULL )
 	{
@@ -1719,6 +2148,12 @@ on_error:
 		 &( imaging_handle->storage_media_buffer_queue ),
 		 NULL );
 	}
+	if( imaging_handle->queue_depths_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( imaging_handle->queue_depths_mutex ),
+		 NULL );
+	}
 	return( -1 );
 }
 
@@ -1775,9 +2210,9 @@ int imaging_handle_threads_stop(
 			result = -1;
 		}
 	}
-	if( imaging_handle->output_list != NULL )
+	if( imaging_handle->output_buffers != NULL )
 	{
-		if( imaging_handle_empty_output_list(
+		if( imaging_handle_empty_output_buffers(
 		     imaging_handle,
 		     error ) != 1 )
 		{
@@ -1785,37 +2220,43 @@ int imaging_handle_threads_stop(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to empty output list.",
+			 "%s: unable to empty output buffers.",
 			 function );
 
 			result = -1;
 		}
-		if( libcdata_list_free(
-		     &( imaging_handle->output_list ),
-		     NULL,
+		memory_free(
+		 imaging_handle->output_buffers );
+
+		imaging_handle->output_buffers = NULL;
+	}
+	if( imaging_handle->storage_media_buffer_queue != NULL )
+	{
+		if( storage_media_buffer_queue_free(
+		     &( imaging_handle->storage_media_buffer_queue ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output list.",
+			 "%s: unable to free storage media buffer queue.",
 			 function );
 
 			result = -1;
 		}
 	}
-	if( imaging_handle->storage_media_buffer_queue != NULL )
+	if( imaging_handle->queue_depths_mutex != NULL )
 	{
-		if( storage_media_buffer_queue_free(
-		     &( imaging_handle->storage_media_buffer_queue ),
+		if( libcthreads_mutex_free(
+		     &( imaging_handle->queue_depths_mutex ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free storage media buffer queue.",
+			 "%s: unable to free queue depths mutex.",
 			 function );
 
 			result = -1;
@@ -1833,7 +2274,9 @@ int imaging_handle_process_storage_media_buffer_callback(
      imaging_handle_t *imaging_handle )
 {
         libcerror_error_t *error = NULL;
+	uint8_t *data            = NULL;
         static char *function    = "imaging_handle_process_storage_media_buffer_callback";
+	size_t data_size         = 0;
 	ssize_t process_count    = 0;
 
 	if( storage_media_buffer == NULL )
@@ -1849,8 +2292,52 @@ int imaging_handle_process_storage_media_buffer_callback(
 	}
 	if( imaging_handle->abort != 0 )
 	{
+		/* Wake up the process threads that are waiting for this storage media buffer to be hashed
+		 */
+		if( imaging_handle->piecewise_hash != NULL )
+		{
+			piecewise_hash_signal_abort(
+			 imaging_handle->piecewise_hash,
+			 NULL );
+		}
 		return( 1 );
 	}
+	/* The piecewise hashes are calculated on the unpacked data, before the storage media buffer is packed
+	 */
+	if( imaging_handle->piecewise_hash != NULL )
+	{
+		if( storage_media_buffer_get_data(
+		     storage_media_buffer,
+		     &data,
+		     &data_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve storage media buffer data.",
+			 function );
+
+			goto on_error;
+		}
+		if( piecewise_hash_update(
+		     imaging_handle->piecewise_hash,
+		     storage_media_buffer->storage_media_offset,
+		     data,
+		     data_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to update piecewise hash.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	process_count = storage_media_buffer_write_process(
 			 storage_media_buffer,
 			 &error );
@@ -1866,6 +2353,38 @@ int imaging_handle_process_storage_media_buffer_callback(
 
 		goto on_error;
 	}
+	if( imaging_handle->queue_depths_mutex != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     imaging_handle->queue_depths_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab queue depths mutex.",
+			 function );
+
+			goto on_error;
+		}
+		imaging_handle->number_of_buffers_to_process -= 1;
+		imaging_handle->number_of_buffers_to_output  += 1;
+
+		if( libcthreads_mutex_release(
+		     imaging_handle->queue_depths_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release queue depths mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libcthreads_thread_pool_push(
 	     imaging_handle->output_thread_pool,
 	     (intptr_t *) storage_media_buffer,
@@ -1916,6 +2435,12 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( imaging_handle->piecewise_hash != NULL )
+	{
+		piecewise_hash_signal_abort(
+		 imaging_handle->piecewise_hash,
+		 NULL );
+	}
 	if( imaging_handle->abort == 0 )
 	{
 		imaging_handle_signal_abort(
@@ -1933,12 +2458,11 @@ int imaging_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      imaging_handle_t *imaging_handle )
 {
-	libcdata_list_element_t *element      = NULL;
-	libcdata_list_element_t *next_element = NULL;
-        libcerror_error_t *error              = NULL;
-        static char *function                 = "imaging_handle_output_storage_media_buffer_callback";
-	ssize_t write_count                   = 0;
-	int result                            = 0;
+        libcerror_error_t *error = NULL;
+        static char *function    = "imaging_handle_output_storage_media_buffer_callback";
+	ssize_t write_count      = 0;
+	int output_buffer_index  = 0;
+	int result               = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -1966,75 +2490,41 @@ int imaging_handle_output_storage_media_buffer_callback(
 	{
 		return( 1 );
 	}
-	if( libcdata_list_insert_value(
-	     imaging_handle->output_list,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
-	     &error ) != 1 )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert storage media buffer into output list.",
-		 function );
-
-		goto on_error;
-	}
-	storage_media_buffer = NULL;
+	/* Since the number of storage media buffers is limited to the maximum number of queued buffers
+	 * the sequence numbers of the buffers in flight map onto distinct output buffers
+	 */
+	output_buffer_index = (int) ( storage_media_buffer->sequence_number % (uint64_t) imaging_handle->maximum_number_of_queued_buffers );
 
-	if( libcdata_list_get_first_element(
-	     imaging_handle->output_list,
-	     &element,
-	     &error ) != 1 )
+	if( imaging_handle->output_buffers[ output_buffer_index ] != NULL )
 	{
 		libcerror_error_set(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid imaging handle - output buffer: %d value already set.",
+		 function,
+		 output_buffer_index );
 
 		goto on_error;
 	}
-	while( element != NULL )
-	{
-		if( imaging_handle->abort != 0 )
-		{
-			break;
-		}
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
+	imaging_handle->output_buffers[ output_buffer_index ] = storage_media_buffer;
 
-			storage_media_buffer = NULL;
+	storage_media_buffer = NULL;
 
-			goto on_error;
-		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
+	while( imaging_handle->abort == 0 )
+	{
+		output_buffer_index = (int) ( imaging_handle->next_output_sequence_number % (uint64_t) imaging_handle->maximum_number_of_queued_buffers );
 
-			return( -1 );
-		}
-		if( storage_media_buffer->storage_media_offset != imaging_handle->last_offset_written )
+		if( imaging_handle->output_buffers[ output_buffer_index ] == NULL )
 		{
 			break;
 		}
+		/* The output buffers no longer manage the storage media buffer
+		 */
+		storage_media_buffer = imaging_handle->output_buffers[ output_buffer_index ];
+
+		imaging_handle->output_buffers[ output_buffer_index ] = NULL;
+
 		write_count = imaging_handle_write_storage_media_buffer(
 			       imaging_handle,
 			       storage_media_buffer,
@@ -2050,62 +2540,59 @@ int imaging_handle_output_storage_media_buffer_callback(
 			 "%s: unable to write storage media buffer.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		imaging_handle->last_offset_written = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
+		imaging_handle->last_offset_written         = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
+		imaging_handle->next_output_sequence_number += 1;
 
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     &error ) != 1 )
+		/* The windows that end in the storage media buffer have been hashed by the process threads
+		 */
+		if( imaging_handle->piecewise_hash != NULL )
 		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
-
-			storage_media_buffer = NULL;
+			if( piecewise_hash_fprint(
+			     imaging_handle->piecewise_hash,
+			     imaging_handle->piecewise_hash_stream,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print piecewise hash.",
+				 function );
 
-			goto on_error;
+				goto on_error;
+			}
 		}
-		if( libcdata_list_remove_element(
-		     imaging_handle->output_list,
-		     element,
+
+		if( libcthreads_mutex_grab(
+		     imaging_handle->queue_depths_mutex,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab queue depths mutex.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
+		imaging_handle->number_of_buffers_to_output -= 1;
+
+		if( libcthreads_mutex_release(
+		     imaging_handle->queue_depths_mutex,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release queue depths mutex.",
 			 function );
 
 			goto on_error;
 		}
-		element = next_element;
-
 		if( storage_media_buffer_queue_release_buffer(
 		     imaging_handle->storage_media_buffer_queue,
 		     storage_media_buffer,
@@ -2192,17 +2679,16 @@ on_error:
 	return( -1 );
 }
 
-/* Empties the output list
+/* Empties the output buffers
  * Returns 1 if successful or -1 on error
  */
-int imaging_handle_empty_output_list(
+int imaging_handle_empty_output_buffers(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error )
 {
-	libcdata_list_element_t *element             = NULL;
-	libcdata_list_element_t *next_element        = NULL;
 	storage_media_buffer_t *storage_media_buffer = NULL;
-        static char *function                        = "imaging_handle_empty_output_list";
+        static char *function                        = "imaging_handle_empty_output_buffers";
+	int output_buffer_index                      = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -2215,47 +2701,29 @@ int imaging_handle_empty_output_list(
 
 		return( -1 );
 	}
-	if( libcdata_list_get_first_element(
-	     imaging_handle->output_list,
-	     &element,
-	     error ) != 1 )
+	if( imaging_handle->output_buffers == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid imaging handle - missing output buffers.",
 		 function );
 
 		return( -1 );
 	}
-	while( element != NULL )
+	for( output_buffer_index = 0;
+	     output_buffer_index < imaging_handle->maximum_number_of_queued_buffers;
+	     output_buffer_index++ )
 	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
+		storage_media_buffer = imaging_handle->output_buffers[ output_buffer_index ];
 
-			return( -1 );
-		}
 		if( storage_media_buffer == NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
-
-			return( -1 );
+			continue;
 		}
+		imaging_handle->output_buffers[ output_buffer_index ] = NULL;
+
 		if( storage_media_buffer_queue_release_buffer(
 		     imaging_handle->storage_media_buffer_queue,
 		     storage_media_buffer,
@@ -2268,61 +2736,279 @@ int imaging_handle_empty_output_list(
 			 "%s: unable to release storage media buffer onto queue.",
 			 function );
 
+			storage_media_buffer_free(
+			 &storage_media_buffer,
+			 NULL );
+
 			return( -1 );
 		}
-		storage_media_buffer = NULL;
+	}
+	return( 1 );
+}
+
+/* Pushes a storage media buffer onto the process thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_push_storage_media_buffer(
+     imaging_handle_t *imaging_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_push_storage_media_buffer";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	/* The sequence number is used to write the processed storage media buffers in order
+	 */
+	storage_media_buffer->sequence_number = imaging_handle->next_process_sequence_number;
+
+	imaging_handle->next_process_sequence_number += 1;
+
+	if( libcthreads_mutex_grab(
+	     imaging_handle->queue_depths_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab queue depths mutex.",
+		 function );
+
+		return( -1 );
+	}
+	imaging_handle->number_of_buffers_to_process += 1;
 
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
+	if( imaging_handle->number_of_buffers_to_process > imaging_handle->maximum_process_queue_depth )
+	{
+		imaging_handle->maximum_process_queue_depth = imaging_handle->number_of_buffers_to_process;
+	}
+	if( imaging_handle->number_of_buffers_to_output > imaging_handle->maximum_output_queue_depth )
+	{
+		imaging_handle->maximum_output_queue_depth = imaging_handle->number_of_buffers_to_output;
+	}
+	imaging_handle->total_process_queue_depth_sum       += (uint64_t) imaging_handle->number_of_buffers_to_process;
+	imaging_handle->total_output_queue_depth_sum        += (uint64_t) imaging_handle->number_of_buffers_to_output;
+	imaging_handle->total_number_of_queue_depth_samples += 1;
+
+	if( imaging_handle->use_adaptive_compression_level != 0 )
+	{
+		imaging_handle->process_queue_depth_sum       += imaging_handle->number_of_buffers_to_process;
+		imaging_handle->output_queue_depth_sum        += imaging_handle->number_of_buffers_to_output;
+		imaging_handle->number_of_queue_depth_samples += 1;
+	}
+	if( libcthreads_mutex_release(
+	     imaging_handle->queue_depths_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release queue depths mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->number_of_queue_depth_samples >= IMAGING_HANDLE_ADAPTIVE_COMPRESSION_INTERVAL )
+	{
+		if( imaging_handle_adjust_compression_level(
+		     imaging_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to adjust compression level.",
 			 function );
 
 			return( -1 );
 		}
-		if( libcdata_list_remove_element(
-		     imaging_handle->output_list,
-		     element,
+	}
+	if( libcthreads_thread_pool_push(
+	     imaging_handle->process_thread_pool,
+	     (intptr_t *) storage_media_buffer,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push storage media buffer onto process thread pool queue.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Adjusts the compression level to the throughput of the imaging pipeline
+ * The compression level is lowered when the process thread pool cannot keep up
+ * and raised when writing the output cannot keep up, so that the input can be
+ * read at its maximum rate
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_adjust_compression_level(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error )
+{
+	static char *function                = "imaging_handle_adjust_compression_level";
+	int adaptive_compression_level_index = 0;
+	int queue_depth_threshold            = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->number_of_queue_depth_samples == 0 )
+	{
+		return( 1 );
+	}
+	adaptive_compression_level_index = imaging_handle->adaptive_compression_level_index;
+
+	/* A queue is considered congested when on average it holds at least half of the storage media buffers
+	 */
+	queue_depth_threshold = imaging_handle->number_of_queue_depth_samples * imaging_handle->maximum_number_of_queued_buffers;
+
+	if( ( 2 * imaging_handle->process_queue_depth_sum ) >= queue_depth_threshold )
+	{
+		if( adaptive_compression_level_index > 0 )
+		{
+			adaptive_compression_level_index--;
+		}
+	}
+	else if( ( 2 * imaging_handle->output_queue_depth_sum ) >= queue_depth_threshold )
+	{
+		if( adaptive_compression_level_index < ( IMAGING_HANDLE_NUMBER_OF_ADAPTIVE_COMPRESSION_LEVELS - 1 ) )
+		{
+			adaptive_compression_level_index++;
+		}
+	}
+	imaging_handle->process_queue_depth_sum       = 0;
+	imaging_handle->output_queue_depth_sum        = 0;
+	imaging_handle->number_of_queue_depth_samples = 0;
+
+	if( adaptive_compression_level_index != imaging_handle->adaptive_compression_level_index )
+	{
+		if( imaging_handle_set_adaptive_compression_level(
+		     imaging_handle,
+		     adaptive_compression_level_index,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set adaptive compression level.",
 			 function );
 
 			return( -1 );
 		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Sets the adaptive compression level used to compress the chunks that are written next
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_set_adaptive_compression_level(
+     imaging_handle_t *imaging_handle,
+     int adaptive_compression_level_index,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_set_adaptive_compression_level";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( adaptive_compression_level_index < 0 )
+	 || ( adaptive_compression_level_index >= IMAGING_HANDLE_NUMBER_OF_ADAPTIVE_COMPRESSION_LEVELS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid adaptive compression level index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_set_chunk_compression_level(
+	     imaging_handle->output_handle,
+	     imaging_handle_adaptive_compression_levels[ adaptive_compression_level_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk compression level.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->secondary_output_handle != NULL )
+	{
+		if( libewf_handle_set_chunk_compression_level(
+		     imaging_handle->secondary_output_handle,
+		     imaging_handle_adaptive_compression_levels[ adaptive_compression_level_index ],
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk compression level in secondary output handle.",
 			 function );
 
 			return( -1 );
 		}
-		element = next_element;
 	}
+	imaging_handle->adaptive_compression_level_index = adaptive_compression_level_index;
+
+	imaging_handle->number_of_adaptive_compression_level_changes += 1;
+
 	return( 1 );
 }
 
-#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
-
 /* Retrieves the process buffer size
  * Returns 1 if successful or -1 on error
  */
@@ -3793,22 +4479,53 @@ int imaging_handle_set_compression_values(
 
 		goto on_error;
 	}
-	result = ewfinput_determine_compression_values(
-	          string_segment,
-	          &( imaging_handle->compression_level ),
-	          &( imaging_handle->compression_flags ),
-	          error );
+	/* The adaptive compression level starts with fast compression
+	 */
+	if( ( string_segment_size == 9 )
+	 && ( system_string_compare(
+	       string_segment,
+	       _SYSTEM_STRING( "adaptive" ),
+	       8 ) == 0 ) )
+	{
+		imaging_handle->compression_level              = LIBEWF_COMPRESSION_LEVEL_FAST;
+		imaging_handle->compression_flags              = 0;
+		imaging_handle->use_adaptive_compression_level = 1;
+
+		result = 1;
+	}
+	else if( ( string_segment_size == 14 )
+	      && ( system_string_compare(
+	            string_segment,
+	            _SYSTEM_STRING( "adaptive-skip" ),
+	            13 ) == 0 ) )
+	{
+		imaging_handle->compression_level              = LIBEWF_COMPRESSION_LEVEL_FAST;
+		imaging_handle->compression_flags              = LIBEWF_COMPRESS_FLAG_SKIP_INCOMPRESSIBLE_DATA;
+		imaging_handle->use_adaptive_compression_level = 1;
 
-	if( result == -1 )
+		result = 1;
+	}
+	else
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine compression values.",
-		 function );
+		imaging_handle->use_adaptive_compression_level = 0;
 
-		goto on_error;
+		result = ewfinput_determine_compression_values(
+		          string_segment,
+		          &( imaging_handle->compression_level ),
+		          &( imaging_handle->compression_flags ),
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine compression values.",
+			 function );
+
+			goto on_error;
+		}
 	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libcsplit_wide_split_string_free(
@@ -4420,6 +5137,67 @@ int imaging_handle_set_process_buffer_size(
 	return( result );
 }
 
+/* Sets the piecewise hash window size
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int imaging_handle_set_piecewise_hash_window_size(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function  = "imaging_handle_set_piecewise_hash_window_size";
+	size_t string_length   = 0;
+	uint64_t size_variable = 0;
+	int result             = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	result = byte_size_string_convert(
+	          string,
+	          string_length,
+	          &size_variable,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine piecewise hash window size.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( ( size_variable == 0 )
+		 || ( size_variable > (uint64_t) SSIZE_MAX ) )
+		{
+			imaging_handle->piecewise_hash_window_size = 0;
+
+			result = 0;
+		}
+		else
+		{
+			imaging_handle->piecewise_hash_window_size = (size_t) size_variable;
+		}
+	}
+	return( result );
+}
+
 /* Sets the number of threads
  * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
@@ -4469,7 +5247,7 @@ int imaging_handle_set_number_of_threads(
 		}
 		result = 1;
 
-		if( number_of_threads > 32 )
+		if( number_of_threads > (uint64_t) EWFCOMMON_MAXIMUM_NUMBER_OF_THREADS )
 		{
 			result = 0;
 		}
@@ -5976,6 +6754,51 @@ int imaging_handle_start(
 
 		goto on_error;
         }
+	if( imaging_handle->piecewise_hash_window_size != 0 )
+	{
+		if( imaging_handle->piecewise_hash_stream == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid imaging handle - missing piecewise hash stream.",
+			 function );
+
+			goto on_error;
+		}
+		if( piecewise_hash_initialize(
+		     &( imaging_handle->piecewise_hash ),
+		     imaging_handle->piecewise_hash_window_size,
+		     imaging_handle->calculate_md5,
+		     imaging_handle->calculate_sha1,
+		     imaging_handle->calculate_sha256,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create piecewise hash.",
+			 function );
+
+			goto on_error;
+		}
+		if( piecewise_hash_header_fprint(
+		     imaging_handle->piecewise_hash,
+		     imaging_handle->piecewise_hash_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print piecewise hash header.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( process_status_initialize(
 	     &( imaging_handle->process_status ),
 	     _SYSTEM_STRING( "Acquiry" ),
@@ -6010,6 +6833,20 @@ int imaging_handle_start(
 	return( 1 );
 
 on_error:
+	if( imaging_handle->piecewise_hash != NULL )
+	{
+		piecewise_hash_free(
+		 &( imaging_handle->piecewise_hash ),
+		 NULL );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->digest_hash_ring != NULL )
+	{
+		digest_hash_ring_free(
+		 &( imaging_handle->digest_hash_ring ),
+		 NULL );
+	}
+#endif
 	if( imaging_handle->sha1_context != NULL )
 	{
 		libhmac_sha1_free(
@@ -6124,6 +6961,47 @@ int imaging_handle_update(
 
 		return( -1 );
 	}
+	/* With threads the piecewise hashes are calculated by the process threads
+	 */
+	if( ( imaging_handle->piecewise_hash != NULL )
+	 && ( imaging_handle->number_of_threads == 0 ) )
+	{
+		if( piecewise_hash_update(
+		     imaging_handle->piecewise_hash,
+		     storage_media_buffer->storage_media_offset,
+		     data,
+		     (size_t) read_count,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to update piecewise hash.",
+			 function );
+
+			return( -1 );
+		}
+		if( piecewise_hash_fprint(
+		     imaging_handle->piecewise_hash,
+		     imaging_handle->piecewise_hash_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print piecewise hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( imaging_handle->use_adaptive_compression_level != 0 )
+	 && ( imaging_handle->last_offset_written >= resume_acquiry_offset ) )
+	{
+		imaging_handle->adaptive_compression_level_sizes[ imaging_handle->adaptive_compression_level_index ] += (size64_t) read_count;
+	}
 	if( imaging_handle->last_offset_written < resume_acquiry_offset )
 	{
 		imaging_handle->last_offset_written += (off64_t) read_count;
@@ -6363,6 +7241,36 @@ int imaging_handle_stop(
 
 		return( -1 );
 	}
+	if( imaging_handle->piecewise_hash != NULL )
+	{
+		if( piecewise_hash_finalize(
+		     imaging_handle->piecewise_hash,
+		     imaging_handle->piecewise_hash_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize piecewise hash.",
+			 function );
+
+			return( -1 );
+		}
+		if( piecewise_hash_free(
+		     &( imaging_handle->piecewise_hash ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free piecewise hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( 1 );
 }
 
@@ -6771,7 +7679,13 @@ int imaging_handle_print_parameters(
 	 imaging_handle->notify_stream,
 	 "Compression level:\t\t\t" );
 
-	if( imaging_handle->compression_level == LIBEWF_COMPRESSION_LEVEL_FAST )
+	if( imaging_handle->use_adaptive_compression_level != 0 )
+	{
+		fprintf(
+		 imaging_handle->notify_stream,
+		 "adaptive" );
+	}
+	else if( imaging_handle->compression_level == LIBEWF_COMPRESSION_LEVEL_FAST )
 	{
 		fprintf(
 		 imaging_handle->notify_stream,
@@ -6798,6 +7712,12 @@ int imaging_handle_print_parameters(
 			 "none" );
 		}
 	}
+	if( ( imaging_handle->compression_flags & LIBEWF_COMPRESS_FLAG_SKIP_INCOMPRESSIBLE_DATA ) != 0 )
+	{
+		fprintf(
+		 imaging_handle->notify_stream,
+		 "-skip" );
+	}
 	fprintf(
 	 imaging_handle->notify_stream,
 	 "\n" );
@@ -7020,3 +7940,123 @@ int imaging_handle_print_hashes(
 	return( 1 );
 }
 
+/* Print the compression levels used by the adaptive compression level to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_print_compression_levels(
+     imaging_handle_t *imaging_handle,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	static char *function                = "imaging_handle_print_compression_levels";
+	int adaptive_compression_level_index = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->use_adaptive_compression_level == 0 )
+	{
+		return( 1 );
+	}
+	fprintf(
+	 stream,
+	 "Adaptive compression levels used:\n" );
+
+	for( adaptive_compression_level_index = 0;
+	     adaptive_compression_level_index < IMAGING_HANDLE_NUMBER_OF_ADAPTIVE_COMPRESSION_LEVELS;
+	     adaptive_compression_level_index++ )
+	{
+		fprintf(
+		 stream,
+		 "\t%s:\t\t\t\t%" PRIu64 " bytes\n",
+		 imaging_handle_adaptive_compression_level_names[ adaptive_compression_level_index ],
+		 imaging_handle->adaptive_compression_level_sizes[ adaptive_compression_level_index ] );
+	}
+	fprintf(
+	 stream,
+	 "Number of compression level changes:\t%d\n\n",
+	 imaging_handle->number_of_adaptive_compression_level_changes );
+
+	return( 1 );
+}
+
+/* Print the queue depths of the multi-threaded imaging pipeline to a stream
+ * A process queue that is mostly full indicates that processing (compression) is
+ * the bottleneck, an output queue that is mostly full that writing is the bottleneck
+ * and both queues being mostly empty that reading the input is the bottleneck
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_print_queue_depths(
+     imaging_handle_t *imaging_handle,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_print_queue_depths";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( imaging_handle->number_of_threads == 0 )
+	 || ( imaging_handle->total_number_of_queue_depth_samples == 0 ) )
+	{
+		return( 1 );
+	}
+	fprintf(
+	 stream,
+	 "Queue depths of %d storage media buffers:\n",
+	 imaging_handle->maximum_number_of_queued_buffers );
+
+	fprintf(
+	 stream,
+	 "\tProcess:\t\t\t\taverage: %" PRIu64 ", maximum: %d\n",
+	 imaging_handle->total_process_queue_depth_sum / imaging_handle->total_number_of_queue_depth_samples,
+	 imaging_handle->maximum_process_queue_depth );
+
+	fprintf(
+	 stream,
+	 "\tOutput:\t\t\t\t\taverage: %" PRIu64 ", maximum: %d\n\n",
+	 imaging_handle->total_output_queue_depth_sum / imaging_handle->total_number_of_queue_depth_samples,
+	 imaging_handle->maximum_output_queue_depth );
+#endif
+	return( 1 );
+}
+
@@ -26,11 +26,13 @@
 #include <file_stream.h>
 #include <types.h>
 
+#include "digest_hash_ring.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
 #include "ewftools_libhmac.h"
+#include "piecewise_hash.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
 
@@ -38,6 +40,14 @@
 extern "C" {
 #endif
 
+/* The adaptive compression levels: fast, default and best
+ */
+#define IMAGING_HANDLE_NUMBER_OF_ADAPTIVE_COMPRESSION_LEVELS	3
+
+/* The number of storage media buffers after which the adaptive compression level is reassessed
+ */
+#define IMAGING_HANDLE_ADAPTIVE_COMPRESSION_INTERVAL		16
+
 typedef struct imaging_handle imaging_handle_t;
 
 struct imaging_handle
@@ -118,6 +128,22 @@ struct imaging_handle
 	 */
 	uint8_t compression_flags;
 
+	/* Value to indicate the compression level should be adapted to the throughput of the imaging pipeline
+	 */
+	uint8_t use_adaptive_compression_level;
+
+	/* The index of the current adaptive compression level
+	 */
+	int adaptive_compression_level_index;
+
+	/* The number of bytes acquired per adaptive compression level
+	 */
+	size64_t adaptive_compression_level_sizes[ IMAGING_HANDLE_NUMBER_OF_ADAPTIVE_COMPRESSION_LEVELS ];
+
+	/* The number of adaptive compression level changes
+	 */
+	int number_of_adaptive_compression_level_changes;
+
 	/* The EWF format
 	 */
 	uint8_t ewf_format;
@@ -198,6 +224,12 @@ struct imaging_handle
 	 */
 	uint8_t sha256_context_initialized;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The digest hash ring used to calculate the digest hashes concurrently
+	 */
+	digest_hash_ring_t *digest_hash_ring;
+#endif
+
 	/* The calculated SHA256 digest hash string
 	 */
 	char *calculated_sha256_hash_string;
@@ -210,6 +242,18 @@ struct imaging_handle
 	 */
 	size_t process_buffer_size;
 
+	/* The piecewise hash window size
+	 */
+	size_t piecewise_hash_window_size;
+
+	/* The piecewise hash
+	 */
+	piecewise_hash_t *piecewise_hash;
+
+	/* The piecewise hash output stream
+	 */
+	FILE *piecewise_hash_stream;
+
 	/* The number of threads in the process thread pool
 	 */
 	int number_of_threads;
@@ -224,14 +268,71 @@ struct imaging_handle
 	 */
 	libcthreads_thread_pool_t *output_thread_pool;
 
-	/* The output list
+	/* The output buffers, a reorder buffer of processed storage media buffers
+	 * indexed by sequence number modulo the maximum number of queued storage media buffers
+	 */
+	storage_media_buffer_t **output_buffers;
+
+	/* The sequence number of the next storage media buffer to push onto the process thread pool
+	 */
+	uint64_t next_process_sequence_number;
+
+	/* The sequence number of the next storage media buffer to write
 	 */
-	libcdata_list_t *output_list;
+	uint64_t next_output_sequence_number;
 
 	/* The storage media buffer queue
 	 */
 	libcthreads_queue_t *storage_media_buffer_queue;
 
+	/* The maximum number of queued storage media buffers
+	 */
+	int maximum_number_of_queued_buffers;
+
+	/* The queue depths mutex
+	 */
+	libcthreads_mutex_t *queue_depths_mutex;
+
+	/* The number of storage media buffers pushed onto the process thread pool that were not processed yet
+	 */
+	int number_of_buffers_to_process;
+
+	/* The number of processed storage media buffers that were not written yet
+	 */
+	int number_of_buffers_to_output;
+
+	/* The sum of the sampled number of storage media buffers to process since the last compression level adjustment
+	 */
+	int process_queue_depth_sum;
+
+	/* The sum of the sampled number of storage media buffers to output since the last compression level adjustment
+	 */
+	int output_queue_depth_sum;
+
+	/* The number of queue depth samples since the last compression level adjustment
+	 */
+	int number_of_queue_depth_samples;
+
+	/* The maximum sampled number of storage media buffers to process
+	 */
+	int maximum_process_queue_depth;
+
+	/* The maximum sampled number of storage media buffers to output
+	 */
+	int maximum_output_queue_depth;
+
+	/* The total sum of the sampled number of storage media buffers to process
+	 */
+	uint64_t total_process_queue_depth_sum;
+
+	/* The total sum of the sampled number of storage media buffers to output
+	 */
+	uint64_t total_output_queue_depth_sum;
+
+	/* The total number of queue depth samples
+	 */
+	uint64_t total_number_of_queue_depth_samples;
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 	/* The libewf output handle
@@ -242,6 +343,10 @@ struct imaging_handle
 	 */
 	libewf_handle_t *secondary_output_handle;
 
+	/* The libewf reference handle, which contains a previous image of the input
+	 */
+	libewf_handle_t *reference_handle;
+
 	/* The input media size
 	 */
 	size64_t input_media_size;
@@ -294,6 +399,11 @@ int imaging_handle_open_secondary_output(
      uint8_t resume,
      libcerror_error_t **error );
 
+int imaging_handle_open_reference(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
 int imaging_handle_open_output_resume(
      imaging_handle_t *imaging_handle,
      const system_character_t *filename,
@@ -360,12 +470,26 @@ int imaging_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      imaging_handle_t *imaging_handle );
 
-int imaging_handle_empty_output_list(
+int imaging_handle_empty_output_buffers(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error );
+
+int imaging_handle_push_storage_media_buffer(
+     imaging_handle_t *imaging_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error );
+
+int imaging_handle_adjust_compression_level(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error );
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
+int imaging_handle_set_adaptive_compression_level(
+     imaging_handle_t *imaging_handle,
+     int adaptive_compression_level_index,
+     libcerror_error_t **error );
+
 int imaging_handle_get_process_buffer_size(
      imaging_handle_t *imaging_handle,
      uint8_t use_data_chunk_functions,
@@ -505,6 +629,11 @@ int imaging_handle_set_process_buffer_size(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int imaging_handle_set_piecewise_hash_window_size(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int imaging_handle_set_number_of_threads(
      imaging_handle_t *imaging_handle,
      const system_character_t *string,
@@ -596,6 +725,16 @@ int imaging_handle_print_hashes(
      FILE *stream,
      libcerror_error_t **error );
 
+int imaging_handle_print_compression_levels(
+     imaging_handle_t *imaging_handle,
+     FILE *stream,
+     libcerror_error_t **error );
+
+int imaging_handle_print_queue_depths(
+     imaging_handle_t *imaging_handle,
+     FILE *stream,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
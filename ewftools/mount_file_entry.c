@@ -1138,7 +1138,10 @@ ssize_t mount_file_entry_read_buffer_at_offset(
 	}
 	else
 	{
-		read_count = libewf_handle_read_buffer_at_offset(
+		/* The concurrent read does not change the current offset of the handle,
+		 * hence multiple file system threads can read from the same handle
+		 */
+		read_count = libewf_handle_read_buffer_at_offset_concurrent(
 		              file_entry->ewf_handle,
 		              buffer,
 		              buffer_size,
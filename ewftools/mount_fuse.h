@@ -30,8 +30,11 @@
 #if !defined( FUSE_USE_VERSION ) && !defined( CYGFUSE )
 
 /* Ensure FUSE_USE_VERSION is defined before including fuse.h
+ * The loop configuration functions require libfuse 3.12 or later
  */
-#if defined( HAVE_LIBFUSE3 )
+#if defined( HAVE_LIBFUSE3 ) && defined( HAVE_FUSE_LOOP_CFG_SET_MAX_THREADS )
+#define FUSE_USE_VERSION	312
+#elif defined( HAVE_LIBFUSE3 )
 #define FUSE_USE_VERSION	30
 #else
 #define FUSE_USE_VERSION	26
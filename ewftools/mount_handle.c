@@ -26,9 +26,11 @@
 #include <types.h>
 #include <wide_string.h>
 
+#include "ewfcommon.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcpath.h"
 #include "ewftools_libewf.h"
+#include "ewftools_system_string.h"
 #include "mount_file_entry.h"
 #include "mount_file_system.h"
 #include "mount_handle.h"
@@ -278,6 +280,75 @@ int mount_handle_set_maximum_number_of_open_handles(
 	return( 1 );
 }
 
+/* Sets the number of concurrent reader threads
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int mount_handle_set_number_of_threads(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function      = "mount_handle_set_number_of_threads";
+	size_t string_length       = 0;
+	uint64_t number_of_threads = 0;
+	int result                 = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string[ 0 ] != (system_character_t) '-' )
+	{
+		string_length = system_string_length(
+		                 string );
+
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine number of threads.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+
+		if( number_of_threads > (uint64_t) EWFCOMMON_MAXIMUM_NUMBER_OF_THREADS )
+		{
+			result = 0;
+		}
+		else
+		{
+			mount_handle->number_of_threads = (int) number_of_threads;
+		}
+	}
+	return( result );
+}
+
 /* Sets the path prefix
  * Returns 1 if successful or -1 on error
  */
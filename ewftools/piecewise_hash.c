@@ -0,0 +1,2037 @@
+/*
+ * Piecewise hash
+ *
+ * Copyright (C) 2006-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "digest_hash.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libhmac.h"
+#include "piecewise_hash.h"
+
+/* Creates a window
+ * Make sure the value window is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int piecewise_hash_window_initialize(
+     piecewise_hash_window_t **window,
+     piecewise_hash_t *piecewise_hash,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	static char *function = "piecewise_hash_window_initialize";
+
+	if( window == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid window.",
+		 function );
+
+		return( -1 );
+	}
+	if( *window != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid window value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( piecewise_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid piecewise hash.",
+		 function );
+
+		return( -1 );
+	}
+	*window = memory_allocate_structure(
+	           piecewise_hash_window_t );
+
+	if( *window == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create window.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *window,
+	     0,
+	     sizeof( piecewise_hash_window_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear window.",
+		 function );
+
+		memory_free(
+		 *window );
+
+		*window = NULL;
+
+		return( -1 );
+	}
+	if( piecewise_hash->calculate_md5 != 0 )
+	{
+		if( libhmac_md5_initialize(
+		     &( ( *window )->md5_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize MD5 context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( piecewise_hash->calculate_sha1 != 0 )
+	{
+		if( libhmac_sha1_initialize(
+		     &( ( *window )->sha1_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA1 context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( piecewise_hash->calculate_sha256 != 0 )
+	{
+		if( libhmac_sha256_initialize(
+		     &( ( *window )->sha256_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA256 context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	( *window )->offset = offset;
+
+	return( 1 );
+
+on_error:
+	if( *window != NULL )
+	{
+		piecewise_hash_window_free(
+		 window,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a window
+ * Returns 1 if successful or -1 on error
+ */
+int piecewise_hash_window_free(
+     piecewise_hash_window_t **window,
+     libcerror_error_t **error )
+{
+	static char *function = "piecewise_hash_window_free";
+	int result            = 1;
+
+	if( window == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid window.",
+		 function );
+
+		return( -1 );
+	}
+	if( *window != NULL )
+	{
+		if( ( *window )->md5_context != NULL )
+		{
+			if( libhmac_md5_free(
+			     &( ( *window )->md5_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free MD5 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *window )->sha1_context != NULL )
+		{
+			if( libhmac_sha1_free(
+			     &( ( *window )->sha1_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free SHA1 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *window )->sha256_context != NULL )
+		{
+			if( libhmac_sha256_free(
+			     &( ( *window )->sha256_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free SHA256 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *window );
+
+		*window = NULL;
+	}
+	return( result );
+}
+
+/* Updates the digest contexts of a window
+ * Returns 1 if successful or -1 on error
+ */
+int piecewise_hash_window_update(
+     piecewise_hash_window_t *window,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "piecewise_hash_window_update";
+
+	if( window == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid window.",
+		 function );
+
+		return( -1 );
+	}
+	if( window->md5_context != NULL )
+	{
+		if( libhmac_md5_update(
+		     window->md5_context,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update MD5 hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( window->sha1_context != NULL )
+	{
+		if( libhmac_sha1_update(
+		     window->sha1_context,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA1 hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( window->sha256_context != NULL )
+	{
+		if( libhmac_sha256_update(
+		     window->sha256_context,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Finalizes the digest contexts of a window into the digests
+ * Returns 1 if successful or -1 on error
+ */
+int piecewise_hash_window_finalize(
+     piecewise_hash_window_t *window,
+     piecewise_hash_digests_t *digests,
+     size_t window_index,
+     libcerror_error_t **error )
+{
+	static char *function = "piecewise_hash_window_finalize";
+
+	if( window == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid window.",
+		 function );
+
+		return( -1 );
+	}
+	if( digests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digests.",
+		 function );
+
+		return( -1 );
+	}
+	if( window_index >= digests->number_of_windows )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid window index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( window->md5_context != NULL )
+	 && ( digests->md5_hashes != NULL ) )
+	{
+		if( libhmac_md5_finalize(
+		     window->md5_context,
+		     &( digests->md5_hashes[ window_index * LIBHMAC_MD5_HASH_SIZE ] ),
+		     LIBHMAC_MD5_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize MD5 hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( window->sha1_context != NULL )
+	 && ( digests->sha1_hashes != NULL ) )
+	{
+		if( libhmac_sha1_finalize(
+		     window->sha1_context,
+		     &( digests->sha1_hashes[ window_index * LIBHMAC_SHA1_HASH_SIZE ] ),
+		     LIBHMAC_SHA1_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA1 hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( window->sha256_context != NULL )
+	 && ( digests->sha256_hashes != NULL ) )
+	{
+		if( libhmac_sha256_finalize(
+		     window->sha256_context,
+		     &( digests->sha256_hashes[ window_index * LIBHMAC_SHA256_HASH_SIZE ] ),
+		     LIBHMAC_SHA256_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA256 hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Creates digests
+ * The digests hold the digest hashes of the windows that cover size bytes from offset
+ * Make sure the value digests is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int piecewise_hash_digests_initialize(
+     piecewise_hash_digests_t **digests,
+     piecewise_hash_t *piecewise_hash,
+     off64_t offset,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function    = "piecewise_hash_digests_initialize";
+	size_t number_of_windows = 0;
+
+	if( digests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digests.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digests != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid digests value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( piecewise_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid piecewise hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_windows = size / piecewise_hash->window_size;
+
+	if( ( size % piecewise_hash->window_size ) != 0 )
+	{
+		number_of_windows += 1;
+	}
+	*digests = memory_allocate_structure(
+	            piecewise_hash_digests_t );
+
+	if( *digests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create digests.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *digests,
+	     0,
+	     sizeof( piecewise_hash_digests_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear digests.",
+		 function );
+
+		memory_free(
+		 *digests );
+
+		*digests = NULL;
+
+		return( -1 );
+	}
+	if( piecewise_hash->calculate_md5 != 0 )
+	{
+		( *digests )->md5_hashes = (uint8_t *) memory_allocate(
+		                                        sizeof( uint8_t ) * LIBHMAC_MD5_HASH_SIZE * number_of_windows );
+
+		if( ( *digests )->md5_hashes == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create MD5 hashes.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( piecewise_hash->calculate_sha1 != 0 )
+	{
+		( *digests )->sha1_hashes = (uint8_t *) memory_allocate(
+		                                         sizeof( uint8_t ) * LIBHMAC_SHA1_HASH_SIZE * number_of_windows );
+
+		if( ( *digests )->sha1_hashes == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create SHA1 hashes.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( piecewise_hash->calculate_sha256 != 0 )
+	{
+		( *digests )->sha256_hashes = (uint8_t *) memory_allocate(
+		                                           sizeof( uint8_t ) * LIBHMAC_SHA256_HASH_SIZE * number_of_windows );
+
+		if( ( *digests )->sha256_hashes == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create SHA256 hashes.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	( *digests )->offset            = offset;
+	( *digests )->size              = size;
+	( *digests )->number_of_windows = number_of_windows;
+
+	return( 1 );
+
+on_error:
+	if( *digests != NULL )
+	{
+		piecewise_hash_digests_free(
+		 digests,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees digests
+ * Returns 1 if successful or -1 on error
+ */
+int piecewise_hash_digests_free(
+     piecewise_hash_digests_t **digests,
+     libcerror_error_t **error )
+{
+	static char *function = "piecewise_hash_digests_free";
+
+	if( digests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digests.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digests != NULL )
+	{
+		if( ( *digests )->sha256_hashes != NULL )
+		{
+			memory_free(
+			 ( *digests )->sha256_hashes );
+		}
+		if( ( *digests )->sha1_hashes != NULL )
+		{
+			memory_free(
+			 ( *digests )->sha1_hashes );
+		}
+		if( ( *digests )->md5_hashes != NULL )
+		{
+			memory_free(
+			 ( *digests )->md5_hashes );
+		}
+		memory_free(
+		 *digests );
+
+		*digests = NULL;
+	}
+	return( 1 );
+}
+
+/* Prints the digest hash(es) of every window of the digests to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int piecewise_hash_digests_fprint(
+     piecewise_hash_digests_t *digests,
+     size_t window_size,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	char md5_hash_string[ 33 ];
+	char sha1_hash_string[ 41 ];
+	char sha256_hash_string[ 65 ];
+
+	static char *function = "piecewise_hash_digests_fprint";
+	size_t window_index   = 0;
+	size_t window_offset  = 0;
+	size_t data_size      = 0;
+
+	if( digests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digests.",
+		 function );
+
+		return( -1 );
+	}
+	if( window_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid window size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	for( window_index = 0;
+	     window_index < digests->number_of_windows;
+	     window_index++ )
+	{
+		data_size = digests->size - window_offset;
+
+		if( data_size > window_size )
+		{
+			data_size = window_size;
+		}
+		fprintf(
+		 stream,
+		 "%" PRIi64 " - %" PRIi64 " (size: %" PRIzd ")",
+		 digests->offset + (off64_t) window_offset,
+		 digests->offset + (off64_t) window_offset + (off64_t) data_size - 1,
+		 data_size );
+
+		if( digests->md5_hashes != NULL )
+		{
+			if( digest_hash_copy_to_string(
+			     &( digests->md5_hashes[ window_index * LIBHMAC_MD5_HASH_SIZE ] ),
+			     LIBHMAC_MD5_HASH_SIZE,
+			     md5_hash_string,
+			     33,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set MD5 hash string.",
+				 function );
+
+				return( -1 );
+			}
+			fprintf(
+			 stream,
+			 "\tMD5: %s",
+			 md5_hash_string );
+		}
+		if( digests->sha1_hashes != NULL )
+		{
+			if( digest_hash_copy_to_string(
+			     &( digests->sha1_hashes[ window_index * LIBHMAC_SHA1_HASH_SIZE ] ),
+			     LIBHMAC_SHA1_HASH_SIZE,
+			     sha1_hash_string,
+			     41,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set SHA1 hash string.",
+				 function );
+
+				return( -1 );
+			}
+			fprintf(
+			 stream,
+			 "\tSHA1: %s",
+			 sha1_hash_string );
+		}
+		if( digests->sha256_hashes != NULL )
+		{
+			if( digest_hash_copy_to_string(
+			     &( digests->sha256_hashes[ window_index * LIBHMAC_SHA256_HASH_SIZE ] ),
+			     LIBHMAC_SHA256_HASH_SIZE,
+			     sha256_hash_string,
+			     65,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set SHA256 hash string.",
+				 function );
+
+				return( -1 );
+			}
+			fprintf(
+			 stream,
+			 "\tSHA256: %s",
+			 sha256_hash_string );
+		}
+		fprintf(
+		 stream,
+		 "\n" );
+
+		window_offset += data_size;
+	}
+	return( 1 );
+}
+
+/* Creates a piecewise hash
+ * Make sure the value piecewise_hash is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int piecewise_hash_initialize(
+     piecewise_hash_t **piecewise_hash,
+     size_t window_size,
+     uint8_t calculate_md5,
+     uint8_t calculate_sha1,
+     uint8_t calculate_sha256,
+     libcerror_error_t **error )
+{
+	static char *function = "piecewise_hash_initialize";
+
+	if( piecewise_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid piecewise hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( *piecewise_hash != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid piecewise hash value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( window_size == 0 )
+	 || ( window_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid window size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*piecewise_hash = memory_allocate_structure(
+	                   piecewise_hash_t );
+
+	if( *piecewise_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create piecewise hash.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *piecewise_hash,
+	     0,
+	     sizeof( piecewise_hash_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear piecewise hash.",
+		 function );
+
+		memory_free(
+		 *piecewise_hash );
+
+		*piecewise_hash = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *piecewise_hash )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *piecewise_hash )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *piecewise_hash )->window_size      = window_size;
+	( *piecewise_hash )->calculate_md5    = calculate_md5;
+	( *piecewise_hash )->calculate_sha1   = calculate_sha1;
+	( *piecewise_hash )->calculate_sha256 = calculate_sha256;
+
+	return( 1 );
+
+on_error:
+	if( *piecewise_hash != NULL )
+	{
+		piecewise_hash_free(
+		 piecewise_hash,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a piecewise hash
+ * Returns 1 if successful or -1 on error
+ */
+int piecewise_hash_free(
+     piecewise_hash_t **piecewise_hash,
+     libcerror_error_t **error )
+{
+	piecewise_hash_digests_t *digests = NULL;
+	piecewise_hash_window_t *window   = NULL;
+	static char *function             = "piecewise_hash_free";
+	int result                        = 1;
+
+	if( piecewise_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid piecewise hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( *piecewise_hash != NULL )
+	{
+		while( ( *piecewise_hash )->windows != NULL )
+		{
+			window = ( *piecewise_hash )->windows;
+
+			( *piecewise_hash )->windows = window->next_window;
+
+			if( piecewise_hash_window_free(
+			     &window,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free window.",
+				 function );
+
+				result = -1;
+			}
+		}
+		while( ( *piecewise_hash )->digests != NULL )
+		{
+			digests = ( *piecewise_hash )->digests;
+
+			( *piecewise_hash )->digests = digests->next_digests;
+
+			if( piecewise_hash_digests_free(
+			     &digests,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free digests.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *piecewise_hash )->condition != NULL )
+		{
+			if( libcthreads_condition_free(
+			     &( ( *piecewise_hash )->condition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *piecewise_hash )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *piecewise_hash )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		memory_free(
+		 *piecewise_hash );
+
+		*piecewise_hash = NULL;
+	}
+	return( result );
+}
+
+/* Signals the piecewise hash to abort
+ * Wakes up the threads that are waiting to update a window
+ * Returns 1 if successful or -1 on error
+ */
+int piecewise_hash_signal_abort(
+     piecewise_hash_t *piecewise_hash,
+     libcerror_error_t **error )
+{
+	static char *function = "piecewise_hash_signal_abort";
+
+	if( piecewise_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid piecewise hash.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     piecewise_hash->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	piecewise_hash->abort = 1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_condition_broadcast(
+	     piecewise_hash->condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		libcthreads_mutex_release(
+		 piecewise_hash->mutex,
+		 NULL );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_release(
+	     piecewise_hash->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Appends digests to the digests that have not been printed
+ * The digests are kept sorted by offset
+ * Returns 1 if successful or -1 on error
+ */
+int piecewise_hash_append_digests(
+     piecewise_hash_t *piecewise_hash,
+     piecewise_hash_digests_t *digests,
+     libcerror_error_t **error )
+{
+	piecewise_hash_digests_t **previous_next_digests = NULL;
+	static char *function                            = "piecewise_hash_append_digests";
+
+	if( piecewise_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid piecewise hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( digests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digests.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     piecewise_hash->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	previous_next_digests = &( piecewise_hash->digests );
+
+	while( ( *previous_next_digests != NULL )
+	    && ( ( *previous_next_digests )->offset < digests->offset ) )
+	{
+		previous_next_digests = &( ( *previous_next_digests )->next_digests );
+	}
+	digests->next_digests  = *previous_next_digests;
+	*previous_next_digests = digests;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     piecewise_hash->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Updates a window that is covered by more than one buffer
+ * The data at data_offset in the window is hashed once all data before it has been hashed
+ * If the data completes the window, its digest hashes are stored in the digests at window_index
+ * Returns 1 if successful or -1 on error
+ */
+int piecewise_hash_update_window(
+     piecewise_hash_t *piecewise_hash,
+     off64_t window_offset,
+     size_t data_offset,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     piecewise_hash_digests_t *digests,
+     size_t window_index,
+     libcerror_error_t **error )
+{
+	piecewise_hash_window_t **previous_next_window = NULL;
+	piecewise_hash_window_t *window                = NULL;
+	static char *function                          = "piecewise_hash_update_window";
+	int is_complete                                = 0;
+
+	if( piecewise_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid piecewise hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_offset + buffer_size ) > piecewise_hash->window_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     piecewise_hash->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	window = piecewise_hash->windows;
+
+	while( ( window != NULL )
+	    && ( window->offset != window_offset ) )
+	{
+		window = window->next_window;
+	}
+	/* The window is created by the first buffer that covers it,
+	 * which is not necessarily the buffer with the start of the window
+	 */
+	if( window == NULL )
+	{
+		if( piecewise_hash_window_initialize(
+		     &window,
+		     piecewise_hash,
+		     window_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create window.",
+			 function );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+			libcthreads_mutex_release(
+			 piecewise_hash->mutex,
+			 NULL );
+#endif
+			return( -1 );
+		}
+		window->next_window     = piecewise_hash->windows;
+		piecewise_hash->windows = window;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The buffers are handed to the process threads in media order,
+	 * hence the buffers with the data before data_offset are already being hashed
+	 */
+	while( ( piecewise_hash->abort == 0 )
+	    && ( window->data_size != data_offset ) )
+	{
+		if( libcthreads_condition_wait(
+		     piecewise_hash->condition,
+		     piecewise_hash->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 piecewise_hash->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_release(
+	     piecewise_hash->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#else
+	if( window->data_size != data_offset )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( piecewise_hash->abort != 0 )
+	{
+		return( 1 );
+	}
+	/* Only this thread can update the window until its data size is changed
+	 */
+	if( piecewise_hash_window_update(
+	     window,
+	     buffer,
+	     buffer_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update window.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     piecewise_hash->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	window->data_size += buffer_size;
+
+	if( window->data_size == piecewise_hash->window_size )
+	{
+		previous_next_window = &( piecewise_hash->windows );
+
+		while( *previous_next_window != window )
+		{
+			previous_next_window = &( ( *previous_next_window )->next_window );
+		}
+		*previous_next_window = window->next_window;
+		window->next_window   = NULL;
+
+		is_complete = 1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_condition_broadcast(
+	     piecewise_hash->condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		libcthreads_mutex_release(
+		 piecewise_hash->mutex,
+		 NULL );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_release(
+	     piecewise_hash->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( is_complete == 0 )
+	{
+		return( 1 );
+	}
+	if( piecewise_hash_window_finalize(
+	     window,
+	     digests,
+	     window_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize window.",
+		 function );
+
+		goto on_error;
+	}
+	if( piecewise_hash_window_free(
+	     &window,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free window.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( is_complete != 0 )
+	{
+		piecewise_hash_window_free(
+		 &window,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Updates the piecewise hash
+ * The buffers can be hashed concurrently as long as they are handed to the threads in media order
+ * The windows that are completed by the buffer are stored until they are printed
+ * Returns 1 if successful or -1 on error
+ */
+int piecewise_hash_update(
+     piecewise_hash_t *piecewise_hash,
+     off64_t offset,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	piecewise_hash_digests_t *digests = NULL;
+	piecewise_hash_window_t *window   = NULL;
+	static char *function             = "piecewise_hash_update";
+	off64_t first_window_offset       = 0;
+	off64_t window_offset             = 0;
+	size_t buffer_offset              = 0;
+	size_t first_data_size            = 0;
+	size_t first_window_data_offset   = 0;
+	size_t last_data_size             = 0;
+	size_t number_of_windows          = 0;
+	size_t window_index               = 0;
+
+	if( piecewise_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid piecewise hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size == 0 )
+	{
+		return( 1 );
+	}
+	first_window_data_offset = (size_t) ( (size64_t) offset % piecewise_hash->window_size );
+	first_window_offset      = offset - (off64_t) first_window_data_offset;
+
+	/* The buffer completes the windows that end within it
+	 */
+	number_of_windows = ( first_window_data_offset + buffer_size ) / piecewise_hash->window_size;
+
+	if( first_window_data_offset != 0 )
+	{
+		first_data_size = piecewise_hash->window_size - first_window_data_offset;
+
+		if( first_data_size > buffer_size )
+		{
+			first_data_size = buffer_size;
+		}
+	}
+	buffer_offset = first_data_size;
+	window_offset = first_window_offset;
+
+	if( first_data_size != 0 )
+	{
+		window_offset += (off64_t) piecewise_hash->window_size;
+		window_index  += 1;
+	}
+	if( number_of_windows > 0 )
+	{
+		if( piecewise_hash_digests_initialize(
+		     &digests,
+		     piecewise_hash,
+		     first_window_offset,
+		     number_of_windows * piecewise_hash->window_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create digests.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* The windows that are covered by this buffer only do not need to wait for other buffers
+	 */
+	while( ( buffer_size - buffer_offset ) >= piecewise_hash->window_size )
+	{
+		if( piecewise_hash->abort != 0 )
+		{
+			break;
+		}
+		if( piecewise_hash_window_initialize(
+		     &window,
+		     piecewise_hash,
+		     window_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create window.",
+			 function );
+
+			goto on_error;
+		}
+		if( piecewise_hash_window_update(
+		     window,
+		     &( buffer[ buffer_offset ] ),
+		     piecewise_hash->window_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update window.",
+			 function );
+
+			goto on_error;
+		}
+		if( piecewise_hash_window_finalize(
+		     window,
+		     digests,
+		     window_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize window.",
+			 function );
+
+			goto on_error;
+		}
+		if( piecewise_hash_window_free(
+		     &window,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free window.",
+			 function );
+
+			goto on_error;
+		}
+		buffer_offset += piecewise_hash->window_size;
+		window_offset += (off64_t) piecewise_hash->window_size;
+		window_index  += 1;
+	}
+	/* The start of the last window is hashed before the end of the first window,
+	 * since the buffer after this one might be waiting for it
+	 */
+	last_data_size = buffer_size - buffer_offset;
+
+	if( last_data_size > 0 )
+	{
+		if( piecewise_hash_update_window(
+		     piecewise_hash,
+		     window_offset,
+		     0,
+		     &( buffer[ buffer_offset ] ),
+		     last_data_size,
+		     digests,
+		     window_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update last window.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( first_data_size > 0 )
+	{
+		if( piecewise_hash_update_window(
+		     piecewise_hash,
+		     first_window_offset,
+		     first_window_data_offset,
+		     buffer,
+		     first_data_size,
+		     digests,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update first window.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* The digests of an aborted update are incomplete
+	 */
+	if( piecewise_hash->abort != 0 )
+	{
+		if( digests != NULL )
+		{
+			if( piecewise_hash_digests_free(
+			     &digests,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free digests.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		return( 1 );
+	}
+	if( digests != NULL )
+	{
+		if( piecewise_hash_append_digests(
+		     piecewise_hash,
+		     digests,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append digests.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( window != NULL )
+	{
+		piecewise_hash_window_free(
+		 &window,
+		 NULL );
+	}
+	if( digests != NULL )
+	{
+		piecewise_hash_digests_free(
+		 &digests,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Prints the digest hash(es) of the finalized windows to a stream
+ * The windows are printed in media order, up to the first window that has not been finalized
+ * Returns 1 if successful or -1 on error
+ */
+int piecewise_hash_fprint(
+     piecewise_hash_t *piecewise_hash,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	piecewise_hash_digests_t *digests = NULL;
+	static char *function             = "piecewise_hash_fprint";
+	int has_digests                   = 0;
+
+	if( piecewise_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid piecewise hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     piecewise_hash->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		digests     = piecewise_hash->digests;
+		has_digests = 0;
+
+		if( ( digests != NULL )
+		 && ( digests->offset == piecewise_hash->print_offset ) )
+		{
+			piecewise_hash->digests       = digests->next_digests;
+			piecewise_hash->print_offset += (off64_t) digests->size;
+
+			digests->next_digests = NULL;
+
+			has_digests = 1;
+		}
+		else
+		{
+			digests = NULL;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     piecewise_hash->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		if( digests != NULL )
+		{
+			if( piecewise_hash_digests_fprint(
+			     digests,
+			     piecewise_hash->window_size,
+			     stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print digests.",
+				 function );
+
+				goto on_error;
+			}
+			if( piecewise_hash_digests_free(
+			     &digests,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free digests.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	while( has_digests != 0 );
+
+	return( 1 );
+
+on_error:
+	if( digests != NULL )
+	{
+		piecewise_hash_digests_free(
+		 &digests,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Finalizes the piecewise hash
+ * The last window is finalized if it contains data and the remaining windows are printed to the stream
+ * Returns 1 if successful or -1 on error
+ */
+int piecewise_hash_finalize(
+     piecewise_hash_t *piecewise_hash,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	piecewise_hash_digests_t *digests = NULL;
+	piecewise_hash_window_t *window   = NULL;
+	static char *function             = "piecewise_hash_finalize";
+
+	if( piecewise_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid piecewise hash.",
+		 function );
+
+		return( -1 );
+	}
+	/* The hashing threads have been stopped, hence the windows are no longer updated
+	 * The windows of an aborted piecewise hash are incomplete
+	 */
+	while( ( piecewise_hash->abort == 0 )
+	    && ( piecewise_hash->windows != NULL ) )
+	{
+		window = piecewise_hash->windows;
+
+		piecewise_hash->windows = window->next_window;
+		window->next_window     = NULL;
+
+		if( window->data_size > 0 )
+		{
+			if( piecewise_hash_digests_initialize(
+			     &digests,
+			     piecewise_hash,
+			     window->offset,
+			     window->data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create digests.",
+				 function );
+
+				goto on_error;
+			}
+			if( piecewise_hash_window_finalize(
+			     window,
+			     digests,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to finalize window.",
+				 function );
+
+				goto on_error;
+			}
+			if( piecewise_hash_append_digests(
+			     piecewise_hash,
+			     digests,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append digests.",
+				 function );
+
+				goto on_error;
+			}
+			digests = NULL;
+		}
+		if( piecewise_hash_window_free(
+		     &window,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free window.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( piecewise_hash_fprint(
+	     piecewise_hash,
+	     stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print windows.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( digests != NULL )
+	{
+		piecewise_hash_digests_free(
+		 &digests,
+		 NULL );
+	}
+	if( window != NULL )
+	{
+		piecewise_hash_window_free(
+		 &window,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Prints the piecewise hash header to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int piecewise_hash_header_fprint(
+     piecewise_hash_t *piecewise_hash,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	static char *function = "piecewise_hash_header_fprint";
+
+	if( piecewise_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid piecewise hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 stream,
+	 "Piecewise hashes calculated over windows of: %" PRIzd " bytes\n",
+	 piecewise_hash->window_size );
+
+	return( 1 );
+}
+
@@ -0,0 +1,251 @@
+/*
+ * Piecewise hash
+ *
+ * Copyright (C) 2006-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _PIECEWISE_HASH_H )
+#define _PIECEWISE_HASH_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libhmac.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct piecewise_hash_window piecewise_hash_window_t;
+
+/* A window that is covered by more than one buffer
+ * The buffers that cover the window update its digest contexts in media order
+ */
+struct piecewise_hash_window
+{
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The size of the data that has been hashed
+	 */
+	size_t data_size;
+
+	/* The MD5 digest context
+	 */
+	libhmac_md5_context_t *md5_context;
+
+	/* The SHA1 digest context
+	 */
+	libhmac_sha1_context_t *sha1_context;
+
+	/* The SHA256 digest context
+	 */
+	libhmac_sha256_context_t *sha256_context;
+
+	/* The next window
+	 */
+	piecewise_hash_window_t *next_window;
+};
+
+typedef struct piecewise_hash_digests piecewise_hash_digests_t;
+
+/* The digest hashes of consecutive windows
+ */
+struct piecewise_hash_digests
+{
+	/* The offset of the first window
+	 */
+	off64_t offset;
+
+	/* The size of the data of the windows
+	 */
+	size_t size;
+
+	/* The number of windows
+	 */
+	size_t number_of_windows;
+
+	/* The MD5 digest hashes
+	 */
+	uint8_t *md5_hashes;
+
+	/* The SHA1 digest hashes
+	 */
+	uint8_t *sha1_hashes;
+
+	/* The SHA256 digest hashes
+	 */
+	uint8_t *sha256_hashes;
+
+	/* The next digests
+	 */
+	piecewise_hash_digests_t *next_digests;
+};
+
+typedef struct piecewise_hash piecewise_hash_t;
+
+/* The piecewise hash calculates the digest hashes per fixed-size window of the media
+ * The buffers can be hashed concurrently and in any size, the windows are printed in media order
+ */
+struct piecewise_hash
+{
+	/* The window size
+	 */
+	size_t window_size;
+
+	/* Value to indicate if the MD5 digest hash should be calculated
+	 */
+	uint8_t calculate_md5;
+
+	/* Value to indicate if the SHA1 digest hash should be calculated
+	 */
+	uint8_t calculate_sha1;
+
+	/* Value to indicate if the SHA256 digest hash should be calculated
+	 */
+	uint8_t calculate_sha256;
+
+	/* The windows that are covered by more than one buffer and have not been finalized
+	 */
+	piecewise_hash_window_t *windows;
+
+	/* The digests of the finalized windows that have not been printed, sorted by offset
+	 */
+	piecewise_hash_digests_t *digests;
+
+	/* The offset of the next window to print
+	 */
+	off64_t print_offset;
+
+	/* Value to indicate the piecewise hash should abort
+	 */
+	int abort;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when a window has been updated
+	 */
+	libcthreads_condition_t *condition;
+#endif
+};
+
+int piecewise_hash_window_initialize(
+     piecewise_hash_window_t **window,
+     piecewise_hash_t *piecewise_hash,
+     off64_t offset,
+     libcerror_error_t **error );
+
+int piecewise_hash_window_free(
+     piecewise_hash_window_t **window,
+     libcerror_error_t **error );
+
+int piecewise_hash_window_update(
+     piecewise_hash_window_t *window,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int piecewise_hash_window_finalize(
+     piecewise_hash_window_t *window,
+     piecewise_hash_digests_t *digests,
+     size_t window_index,
+     libcerror_error_t **error );
+
+int piecewise_hash_digests_initialize(
+     piecewise_hash_digests_t **digests,
+     piecewise_hash_t *piecewise_hash,
+     off64_t offset,
+     size_t size,
+     libcerror_error_t **error );
+
+int piecewise_hash_digests_free(
+     piecewise_hash_digests_t **digests,
+     libcerror_error_t **error );
+
+int piecewise_hash_digests_fprint(
+     piecewise_hash_digests_t *digests,
+     size_t window_size,
+     FILE *stream,
+     libcerror_error_t **error );
+
+int piecewise_hash_initialize(
+     piecewise_hash_t **piecewise_hash,
+     size_t window_size,
+     uint8_t calculate_md5,
+     uint8_t calculate_sha1,
+     uint8_t calculate_sha256,
+     libcerror_error_t **error );
+
+int piecewise_hash_free(
+     piecewise_hash_t **piecewise_hash,
+     libcerror_error_t **error );
+
+int piecewise_hash_signal_abort(
+     piecewise_hash_t *piecewise_hash,
+     libcerror_error_t **error );
+
+int piecewise_hash_append_digests(
+     piecewise_hash_t *piecewise_hash,
+     piecewise_hash_digests_t *digests,
+     libcerror_error_t **error );
+
+int piecewise_hash_update_window(
+     piecewise_hash_t *piecewise_hash,
+     off64_t window_offset,
+     size_t data_offset,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     piecewise_hash_digests_t *digests,
+     size_t window_index,
+     libcerror_error_t **error );
+
+int piecewise_hash_update(
+     piecewise_hash_t *piecewise_hash,
+     off64_t offset,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int piecewise_hash_fprint(
+     piecewise_hash_t *piecewise_hash,
+     FILE *stream,
+     libcerror_error_t **error );
+
+int piecewise_hash_finalize(
+     piecewise_hash_t *piecewise_hash,
+     FILE *stream,
+     libcerror_error_t **error );
+
+int piecewise_hash_header_fprint(
+     piecewise_hash_t *piecewise_hash,
+     FILE *stream,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _PIECEWISE_HASH_H ) */
+
@@ -50,6 +50,10 @@
 #define VERIFICATION_HANDLE_NOTIFY_STREAM			stdout
 #define VERIFICATION_HANDLE_MAXIMUM_PROCESS_BUFFERS_SIZE	64 * 1024 * 1024
 
+/* The number of chunks a chunk verification thread verifies before it picks up the next range
+ */
+#define VERIFICATION_HANDLE_NUMBER_OF_CHUNKS_PER_VERIFICATION_RANGE	256
+
 /* Creates a verification handle
  * Make sure the value verification_handle is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
@@ -254,6 +258,40 @@ int verification_handle_free(
 	}
 	if( *verification_handle != NULL )
 	{
+		if( ( *verification_handle )->piecewise_hash != NULL )
+		{
+			if( piecewise_hash_free(
+			     &( ( *verification_handle )->piecewise_hash ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free piecewise hash.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *verification_handle )->chunk_verification_handles != NULL )
+		{
+			if( verification_handle_close_chunk_verification_handles(
+			     *verification_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to close chunk verification handles.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		if( ( ( *verification_handle )->input_handle != NULL )
 		 && ( libewf_handle_free(
 		       &( ( *verification_handle )->input_handle ),
@@ -268,6 +306,24 @@ int verification_handle_free(
 
 			result = -1;
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *verification_handle )->digest_hash_ring != NULL )
+		{
+			if( digest_hash_ring_free(
+			     &( ( *verification_handle )->digest_hash_ring ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free digest hash ring.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		if( ( *verification_handle )->md5_context != NULL )
 		{
 			if( libhmac_md5_free(
@@ -363,6 +419,10 @@ int verification_handle_signal_abort(
 {
 	static char *function = "verification_handle_signal_abort";
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int handle_index      = 0;
+#endif
+
 	if( verification_handle == NULL )
 	{
 		libcerror_error_set(
@@ -390,6 +450,27 @@ int verification_handle_signal_abort(
 			return( -1 );
 		}
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	for( handle_index = 0;
+	     handle_index < verification_handle->number_of_chunk_verification_handles;
+	     handle_index++ )
+	{
+		if( libewf_handle_signal_abort(
+		     verification_handle->chunk_verification_handles[ handle_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal chunk verification handle: %d to abort.",
+			 function,
+			 handle_index );
+
+			return( -1 );
+		}
+	}
+#endif
 	verification_handle->abort = 1;
 
 	return( 1 );
@@ -430,6 +511,8 @@ int verification_handle_set_maximum_number_of_open_handles(
 
 		return( -1 );
 	}
+	verification_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+
 	return( 1 );
 }
 
@@ -555,6 +638,26 @@ int verification_handle_open_input(
 
 		goto on_error;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->verify_chunks_concurrently != 0 )
+	{
+		if( verification_handle_open_chunk_verification_handles(
+		     verification_handle,
+		     filenames,
+		     number_of_filenames,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open chunk verification handles.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	if( libewf_filenames != NULL )
 	{
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -662,9 +765,246 @@ int verification_handle_close(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle_close_chunk_verification_handles(
+	     verification_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close chunk verification handles.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	return( 0 );
 }
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Opens the additional handles used to verify the chunks concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_open_chunk_verification_handles(
+     verification_handle_t *verification_handle,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *ewf_handle        = NULL;
+	static char *function              = "verification_handle_open_chunk_verification_handles";
+	int handle_index                   = 0;
+	int maximum_number_of_open_handles = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->chunk_verification_handles != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verification handle - chunk verification handles value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->number_of_threads <= 0 )
+	{
+		return( 1 );
+	}
+	/* The input handle and the chunk verification handles share the maximum number of open handles
+	 */
+	maximum_number_of_open_handles = verification_handle->maximum_number_of_open_handles;
+
+	if( maximum_number_of_open_handles > 0 )
+	{
+		maximum_number_of_open_handles /= verification_handle->number_of_threads + 1;
+
+		if( maximum_number_of_open_handles == 0 )
+		{
+			maximum_number_of_open_handles = 1;
+		}
+	}
+	verification_handle->chunk_verification_handles = (libewf_handle_t **) memory_allocate(
+	                                                                        sizeof( libewf_handle_t * ) * verification_handle->number_of_threads );
+
+	if( verification_handle->chunk_verification_handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk verification handles.",
+		 function );
+
+		goto on_error;
+	}
+	for( handle_index = 0;
+	     handle_index < verification_handle->number_of_threads;
+	     handle_index++ )
+	{
+		if( libewf_handle_initialize(
+		     &ewf_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize chunk verification handle: %d.",
+			 function,
+			 handle_index );
+
+			goto on_error;
+		}
+		if( libewf_handle_set_maximum_number_of_open_handles(
+		     ewf_handle,
+		     maximum_number_of_open_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles in chunk verification handle: %d.",
+			 function,
+			 handle_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libewf_handle_open_wide(
+		     ewf_handle,
+		     filenames,
+		     number_of_filenames,
+		     LIBEWF_OPEN_READ,
+		     error ) != 1 )
+#else
+		if( libewf_handle_open(
+		     ewf_handle,
+		     filenames,
+		     number_of_filenames,
+		     LIBEWF_OPEN_READ,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open chunk verification handle: %d.",
+			 function,
+			 handle_index );
+
+			goto on_error;
+		}
+		verification_handle->chunk_verification_handles[ handle_index ] = ewf_handle;
+
+		verification_handle->number_of_chunk_verification_handles += 1;
+
+		ewf_handle = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( ewf_handle != NULL )
+	{
+		libewf_handle_free(
+		 &ewf_handle,
+		 NULL );
+	}
+	if( verification_handle->chunk_verification_handles != NULL )
+	{
+		verification_handle_close_chunk_verification_handles(
+		 verification_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes the additional handles used to verify the chunks concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_close_chunk_verification_handles(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_close_chunk_verification_handles";
+	int handle_index      = 0;
+	int result            = 1;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->chunk_verification_handles == NULL )
+	{
+		return( 1 );
+	}
+	for( handle_index = 0;
+	     handle_index < verification_handle->number_of_chunk_verification_handles;
+	     handle_index++ )
+	{
+		if( libewf_handle_close(
+		     verification_handle->chunk_verification_handles[ handle_index ],
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close chunk verification handle: %d.",
+			 function,
+			 handle_index );
+
+			result = -1;
+		}
+		if( libewf_handle_free(
+		     &( verification_handle->chunk_verification_handles[ handle_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk verification handle: %d.",
+			 function,
+			 handle_index );
+
+			result = -1;
+		}
+	}
+	memory_free(
+	 verification_handle->chunk_verification_handles );
+
+	verification_handle->chunk_verification_handles           = NULL;
+	verification_handle->number_of_chunk_verification_handles = 0;
+
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 /* Initializes the integrity hash(es)
  * Returns 1 if successful or -1 on error
  */
@@ -748,9 +1088,39 @@ int verification_handle_initialize_integrity_hash(
 		}
 		verification_handle->sha256_context_initialized = 1;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* When multiple digest hashes are calculated every digest hash is calculated on its own thread
+	 */
+	if( ( verification_handle->number_of_threads > 0 )
+	 && ( ( verification_handle->calculate_md5 + verification_handle->calculate_sha1 + verification_handle->calculate_sha256 ) > 1 ) )
+	{
+		if( digest_hash_ring_initialize(
+		     &( verification_handle->digest_hash_ring ),
+		     ( verification_handle->calculate_md5 != 0 ) ? verification_handle->md5_context : NULL,
+		     ( verification_handle->calculate_sha1 != 0 ) ? verification_handle->sha1_context : NULL,
+		     ( verification_handle->calculate_sha256 != 0 ) ? verification_handle->sha256_context : NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create digest hash ring.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	return( 1 );
 
 on_error:
+	if( verification_handle->sha256_context != NULL )
+	{
+		libhmac_sha256_free(
+		 &( verification_handle->sha256_context ),
+		 NULL );
+	}
 	if( verification_handle->sha1_context != NULL )
 	{
 		libhmac_sha1_free(
@@ -811,6 +1181,27 @@ int verification_handle_update_integrity_hash(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->digest_hash_ring != NULL )
+	{
+		if( digest_hash_ring_update(
+		     verification_handle->digest_hash_ring,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update digest hash ring.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#endif
 	if( verification_handle->calculate_md5 != 0 )
 	{
 		if( libhmac_md5_update(
@@ -892,6 +1283,43 @@ int verification_handle_finalize_integrity_hash(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The digest hash ring threads must have consumed all data before the digest hashes are finalized
+	 */
+	if( verification_handle->digest_hash_ring != NULL )
+	{
+		if( digest_hash_ring_join(
+		     verification_handle->digest_hash_ring,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join digest hash ring.",
+			 function );
+
+			digest_hash_ring_free(
+			 &( verification_handle->digest_hash_ring ),
+			 NULL );
+
+			return( -1 );
+		}
+		if( digest_hash_ring_free(
+		     &( verification_handle->digest_hash_ring ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free digest hash ring.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	if( verification_handle->calculated_md5_hash_string != NULL )
 	{
 		libcerror_error_set(
@@ -1146,7 +1574,9 @@ int verification_handle_process_storage_media_buffer_callback(
      verification_handle_t *verification_handle )
 {
         libcerror_error_t *error = NULL;
+	uint8_t *data            = NULL;
         static char *function    = "verification_handle_process_storage_media_buffer_callback";
+	size_t data_size         = 0;
 	ssize_t process_count    = 0;
 
 	if( storage_media_buffer == NULL )
@@ -1162,6 +1592,14 @@ int verification_handle_process_storage_media_buffer_callback(
 	}
 	if( verification_handle->abort != 0 )
 	{
+		/* Wake up the process threads that are waiting for this storage media buffer to be hashed
+		 */
+		if( verification_handle->piecewise_hash != NULL )
+		{
+			piecewise_hash_signal_abort(
+			 verification_handle->piecewise_hash,
+			 NULL );
+		}
 		return( 1 );
 	}
 	process_count = storage_media_buffer_read_process(
@@ -1184,6 +1622,45 @@ int verification_handle_process_storage_media_buffer_callback(
 		process_count = verification_handle->chunk_size;
 
 		storage_media_buffer->is_corrupted = 1;
+
+		/* Keep the size consistent with the media range of the storage media buffer
+		 * since the piecewise hash waits for every byte of a window
+		 */
+		storage_media_buffer->processed_size = storage_media_buffer->requested_size;
+	}
+	if( verification_handle->piecewise_hash != NULL )
+	{
+		if( storage_media_buffer_get_data(
+		     storage_media_buffer,
+		     &data,
+		     &data_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine storage media buffer data.",
+			 function );
+
+			goto on_error;
+		}
+		if( piecewise_hash_update(
+		     verification_handle->piecewise_hash,
+		     storage_media_buffer->storage_media_offset,
+		     data,
+		     storage_media_buffer->processed_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to update piecewise hash.",
+			 function );
+
+			goto on_error;
+		}
 	}
 	if( libcthreads_thread_pool_push(
 	     verification_handle->output_thread_pool,
@@ -1235,6 +1712,12 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( verification_handle->piecewise_hash != NULL )
+	{
+		piecewise_hash_signal_abort(
+		 verification_handle->piecewise_hash,
+		 NULL );
+	}
 	if( verification_handle->abort == 0 )
 	{
 		verification_handle_signal_abort(
@@ -1252,13 +1735,12 @@ int verification_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      verification_handle_t *verification_handle )
 {
-	libcdata_list_element_t *element      = NULL;
-	libcdata_list_element_t *next_element = NULL;
-        libcerror_error_t *error              = NULL;
-	uint8_t *data                         = NULL;
-        static char *function                 = "verification_handle_process_storage_media_buffer_callback";
-	size_t data_size                      = 0;
-	int result                            = 0;
+        libcerror_error_t *error = NULL;
+	uint8_t *data            = NULL;
+        static char *function    = "verification_handle_output_storage_media_buffer_callback";
+	size_t data_size         = 0;
+	int output_buffer_index  = 0;
+	int result               = 0;
 
 	if( verification_handle == NULL )
 	{
@@ -1286,75 +1768,43 @@ int verification_handle_output_storage_media_buffer_callback(
 	{
 		return( 1 );
 	}
-	if( libcdata_list_insert_value(
-	     verification_handle->output_list,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
-	     &error ) != 1 )
+	/* Since the number of storage media buffers is limited to the maximum number of queued buffers
+	 * the sequence numbers of the buffers in flight map onto distinct output buffers
+	 */
+	output_buffer_index = (int) ( storage_media_buffer->sequence_number % (uint64_t) verification_handle->maximum_number_of_queued_buffers );
+
+	if( verification_handle->output_buffers[ output_buffer_index ] != NULL )
 	{
 		libcerror_error_set(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert storage media buffer into output list.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verification handle - output buffer: %d value already set.",
+		 function,
+		 output_buffer_index );
 
 		goto on_error;
 	}
+	verification_handle->output_buffers[ output_buffer_index ] = storage_media_buffer;
+
 	storage_media_buffer = NULL;
 
-	if( libcdata_list_get_first_element(
-	     verification_handle->output_list,
-	     &element,
-	     &error ) != 1 )
+	while( verification_handle->abort == 0 )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
-		 function );
+		output_buffer_index = (int) ( verification_handle->next_output_sequence_number % (uint64_t) verification_handle->maximum_number_of_queued_buffers );
 
-		goto on_error;
-	}
-	while( element != NULL )
-	{
-		if( verification_handle->abort != 0 )
+		if( verification_handle->output_buffers[ output_buffer_index ] == NULL )
 		{
 			break;
 		}
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
+		/* The output buffers no longer manage the storage media buffer
+		 */
+		storage_media_buffer = verification_handle->output_buffers[ output_buffer_index ];
 
-			storage_media_buffer = NULL;
+		verification_handle->output_buffers[ output_buffer_index ] = NULL;
 
-			goto on_error;
-		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
+		verification_handle->next_output_sequence_number += 1;
 
-			goto on_error;
-		}
-		if( storage_media_buffer->storage_media_offset != verification_handle->last_offset_hashed )
-		{
-			break;
-		}
 		result = storage_media_buffer_is_corrupted(
 		          storage_media_buffer,
 		          &error );
@@ -1368,8 +1818,6 @@ int verification_handle_output_storage_media_buffer_callback(
 			 "%s: unable to determine if storage media buffer is corrupted.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
 		else if( result != 0 )
@@ -1389,8 +1837,6 @@ int verification_handle_output_storage_media_buffer_callback(
 				 "%s: unable to append read error.",
 				 function );
 
-				storage_media_buffer = NULL;
-
 				goto on_error;
 			}
 		}
@@ -1407,8 +1853,6 @@ int verification_handle_output_storage_media_buffer_callback(
 			 "%s: unable to determine storage media buffer data.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
 		if( verification_handle_update_integrity_hash(
@@ -1424,61 +1868,28 @@ int verification_handle_output_storage_media_buffer_callback(
 			 "%s: unable to update integrity hash(es).",
 			 function );
 
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		verification_handle->last_offset_hashed = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
-
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		if( libcdata_list_remove_element(
-		     verification_handle->output_list,
-		     element,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
-
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     &error ) != 1 )
+		if( verification_handle->piecewise_hash != NULL )
 		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
+			/* The windows that end in the storage media buffer have been hashed by the process threads
+			 */
+			if( piecewise_hash_fprint(
+			     verification_handle->piecewise_hash,
+			     verification_handle->piecewise_hash_stream,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print piecewise hash.",
+				 function );
 
-			goto on_error;
+				goto on_error;
+			}
 		}
-		element = next_element;
+		verification_handle->last_offset_hashed = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
 
 		if( storage_media_buffer_queue_release_buffer(
 		     verification_handle->storage_media_buffer_queue,
@@ -1555,17 +1966,16 @@ on_error:
 	return( -1 );
 }
 
-/* Empties the output list
+/* Empties the output buffers
  * Returns 1 if successful or -1 on error
  */
-int verification_handle_empty_output_list(
+int verification_handle_empty_output_buffers(
      verification_handle_t *verification_handle,
      libcerror_error_t **error )
 {
-	libcdata_list_element_t *element             = NULL;
-	libcdata_list_element_t *next_element        = NULL;
 	storage_media_buffer_t *storage_media_buffer = NULL;
-        static char *function                        = "verification_handle_empty_output_list";
+        static char *function                        = "verification_handle_empty_output_buffers";
+	int output_buffer_index                      = 0;
 
 	if( verification_handle == NULL )
 	{
@@ -1578,47 +1988,29 @@ int verification_handle_empty_output_list(
 
 		return( -1 );
 	}
-	if( libcdata_list_get_first_element(
-	     verification_handle->output_list,
-	     &element,
-	     error ) != 1 )
+	if( verification_handle->output_buffers == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid verification handle - missing output buffers.",
 		 function );
 
 		return( -1 );
 	}
-	while( element != NULL )
+	for( output_buffer_index = 0;
+	     output_buffer_index < verification_handle->maximum_number_of_queued_buffers;
+	     output_buffer_index++ )
 	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
+		storage_media_buffer = verification_handle->output_buffers[ output_buffer_index ];
 
-			return( -1 );
-		}
 		if( storage_media_buffer == NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
-
-			return( -1 );
+			continue;
 		}
+		verification_handle->output_buffers[ output_buffer_index ] = NULL;
+
 		if( storage_media_buffer_queue_release_buffer(
 		     verification_handle->storage_media_buffer_queue,
 		     storage_media_buffer,
@@ -1631,57 +2023,582 @@ int verification_handle_empty_output_list(
 			 "%s: unable to release storage media buffer onto queue.",
 			 function );
 
+			storage_media_buffer_free(
+			 &storage_media_buffer,
+			 NULL );
+
 			return( -1 );
 		}
-		storage_media_buffer = NULL;
+	}
+	return( 1 );
+}
 
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
+/* Starts verifying the chunks on the chunk verification handles
+ * The chunks are verified concurrently with, and independent of, the digest (hash) calculation
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_start_chunk_verification(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_start_chunk_verification";
+	int handle_index      = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->chunk_verification_handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid verification handle - missing chunk verification handles.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid verification handle - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	verification_handle->next_chunk_to_verify       = 0;
+	verification_handle->number_of_chunks_to_verify = verification_handle->media_size / verification_handle->chunk_size;
+	verification_handle->number_of_corrupted_chunks = 0;
+
+	if( ( verification_handle->media_size % verification_handle->chunk_size ) != 0 )
+	{
+		verification_handle->number_of_chunks_to_verify += 1;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( verification_handle->chunk_verification_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize chunk verification mutex.",
+		 function );
+
+		goto on_error;
+	}
+	verification_handle->number_of_active_chunk_verification_threads = verification_handle->number_of_chunk_verification_handles;
+
+	if( libcthreads_thread_pool_create(
+	     &( verification_handle->chunk_verification_thread_pool ),
+	     NULL,
+	     verification_handle->number_of_chunk_verification_handles,
+	     verification_handle->number_of_chunk_verification_handles,
+	     (int (*)(intptr_t *, void *)) &verification_handle_verify_chunks_callback,
+	     (void *) verification_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize chunk verification thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	/* Every thread verifies ranges of chunks using its own handle
+	 */
+	for( handle_index = 0;
+	     handle_index < verification_handle->number_of_chunk_verification_handles;
+	     handle_index++ )
+	{
+		if( libcthreads_thread_pool_push(
+		     verification_handle->chunk_verification_thread_pool,
+		     (intptr_t *) verification_handle->chunk_verification_handles[ handle_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push chunk verification handle: %d onto thread pool queue.",
+			 function,
+			 handle_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( verification_handle->chunk_verification_thread_pool != NULL )
+	{
+		verification_handle->abort = 1;
+
+		libcthreads_thread_pool_join(
+		 &( verification_handle->chunk_verification_thread_pool ),
+		 NULL );
+	}
+	if( verification_handle->chunk_verification_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( verification_handle->chunk_verification_mutex ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Stops verifying the chunks on the chunk verification handles
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_stop_chunk_verification(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_stop_chunk_verification";
+	int result            = 1;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->chunk_verification_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( verification_handle->chunk_verification_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join chunk verification thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( verification_handle->chunk_verification_mutex != NULL )
+	{
+		if( libcthreads_mutex_free(
+		     &( verification_handle->chunk_verification_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk verification mutex.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Verifies ranges of chunks using a chunk verification handle
+ * The ranges are handed out in order so that corrupted chunks are reported early
+ * Callback function for the chunk verification thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_verify_chunks_callback(
+     libewf_handle_t *chunk_verification_handle,
+     verification_handle_t *verification_handle )
+{
+	libewf_data_chunk_t *data_chunk = NULL;
+	libcerror_error_t *error        = NULL;
+	uint8_t *chunk_buffer           = NULL;
+	static char *function           = "verification_handle_verify_chunks_callback";
+	off64_t chunk_offset            = 0;
+	ssize_t read_count              = 0;
+	uint64_t chunk_index            = 0;
+	uint64_t last_chunk_index       = 0;
+	int is_corrupted                = 0;
+	int number_of_active_threads    = 0;
+	int read_failed                 = 0;
+
+	if( chunk_verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk verification handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		goto on_error;
+	}
+	chunk_buffer = (uint8_t *) memory_allocate(
+	                            sizeof( uint8_t ) * verification_handle->chunk_size );
+
+	if( chunk_buffer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_data_chunk(
+	     chunk_verification_handle,
+	     &data_chunk,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create data chunk.",
+		 function );
+
+		goto on_error;
+	}
+	while( verification_handle->abort == 0 )
+	{
+		if( libcthreads_mutex_grab(
+		     verification_handle->chunk_verification_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab chunk verification mutex.",
+			 function );
+
+			goto on_error;
+		}
+		chunk_index = verification_handle->next_chunk_to_verify;
+
+		if( chunk_index < verification_handle->number_of_chunks_to_verify )
+		{
+			verification_handle->next_chunk_to_verify += VERIFICATION_HANDLE_NUMBER_OF_CHUNKS_PER_VERIFICATION_RANGE;
+
+			if( verification_handle->next_chunk_to_verify > verification_handle->number_of_chunks_to_verify )
+			{
+				verification_handle->next_chunk_to_verify = verification_handle->number_of_chunks_to_verify;
+			}
+		}
+		last_chunk_index = verification_handle->next_chunk_to_verify;
+
+		if( libcthreads_mutex_release(
+		     verification_handle->chunk_verification_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release chunk verification mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( chunk_index >= last_chunk_index )
+		{
+			break;
+		}
+		chunk_offset = (off64_t) chunk_index * verification_handle->chunk_size;
+
+		if( libewf_handle_seek_offset(
+		     chunk_verification_handle,
+		     chunk_offset,
+		     SEEK_SET,
+		     &error ) == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: %" PRIi64 ".",
+			 function,
+			 chunk_offset );
+
+			goto on_error;
+		}
+		while( ( chunk_index < last_chunk_index )
+		    && ( verification_handle->abort == 0 ) )
+		{
+			read_count = libewf_handle_read_data_chunk(
+			              chunk_verification_handle,
+			              data_chunk,
+			              &error );
+
+			/* A chunk that cannot be read is reported as corrupted
+			 */
+			read_failed = 0;
+
+			if( read_count <= 0 )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				if( ( libcnotify_verbose != 0 )
+				 && ( error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 error );
+				}
+#endif
+				libcerror_error_free(
+				 &error );
+
+				read_failed = 1;
+			}
+			else
+			{
+				/* Unpacking the chunk data validates the checksum
+				 */
+				read_count = libewf_data_chunk_read_buffer(
+				              data_chunk,
+				              chunk_buffer,
+				              (size_t) verification_handle->chunk_size,
+				              &error );
+			}
+			if( read_failed != 0 )
+			{
+				is_corrupted = 1;
+			}
+			else if( read_count == -1 )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				if( ( libcnotify_verbose != 0 )
+				 && ( error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 error );
+				}
+#endif
+				libcerror_error_free(
+				 &error );
+
+				is_corrupted = 1;
+			}
+			else
+			{
+				is_corrupted = libewf_data_chunk_is_corrupted(
+				                data_chunk,
+				                &error );
+
+				if( is_corrupted == -1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to determine if chunk: %" PRIu64 " is corrupted.",
+					 function,
+					 chunk_index );
+
+					goto on_error;
+				}
+			}
+			if( is_corrupted != 0 )
+			{
+				if( libcthreads_mutex_grab(
+				     verification_handle->chunk_verification_mutex,
+				     &error ) != 1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to grab chunk verification mutex.",
+					 function );
+
+					goto on_error;
+				}
+				verification_handle->number_of_corrupted_chunks += 1;
+
+				if( read_failed != 0 )
+				{
+					fprintf(
+					 verification_handle->notify_stream,
+					 "Read error in chunk: %" PRIu64 " at offset: %" PRIi64 " (0x%08" PRIx64 ").\n",
+					 chunk_index,
+					 (off64_t) chunk_index * verification_handle->chunk_size,
+					 (off64_t) chunk_index * verification_handle->chunk_size );
+				}
+				else
+				{
+					fprintf(
+					 verification_handle->notify_stream,
+					 "Checksum error in chunk: %" PRIu64 " at offset: %" PRIi64 " (0x%08" PRIx64 ").\n",
+					 chunk_index,
+					 (off64_t) chunk_index * verification_handle->chunk_size,
+					 (off64_t) chunk_index * verification_handle->chunk_size );
+				}
+
+				if( libcthreads_mutex_release(
+				     verification_handle->chunk_verification_mutex,
+				     &error ) != 1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to release chunk verification mutex.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			chunk_index++;
+
+			/* A failed read does not advance the offset
+			 */
+			if( ( read_failed != 0 )
+			 && ( chunk_index < last_chunk_index ) )
+			{
+				chunk_offset = (off64_t) chunk_index * verification_handle->chunk_size;
+
+				if( libewf_handle_seek_offset(
+				     chunk_verification_handle,
+				     chunk_offset,
+				     SEEK_SET,
+				     &error ) == -1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_SEEK_FAILED,
+					 "%s: unable to seek offset: %" PRIi64 ".",
+					 function,
+					 chunk_offset );
+
+					goto on_error;
+				}
+			}
+		}
+	}
+	if( libewf_data_chunk_free(
+	     &data_chunk,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free data chunk.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 chunk_buffer );
+
+	chunk_buffer = NULL;
+
+	if( libcthreads_mutex_grab(
+	     verification_handle->chunk_verification_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk verification mutex.",
+		 function );
+
+		goto on_error;
+	}
+	verification_handle->number_of_active_chunk_verification_threads -= 1;
+
+	number_of_active_threads = verification_handle->number_of_active_chunk_verification_threads;
+
+	/* The last thread to finish reports the result of the chunk verification
+	 * while the digest (hash) calculation can still be in progress
+	 */
+	if( ( number_of_active_threads == 0 )
+	 && ( verification_handle->abort == 0 ) )
+	{
+		fprintf(
+		 verification_handle->notify_stream,
+		 "Chunk verification completed: %" PRIu64 " of %" PRIu64 " chunks corrupted.\n",
+		 verification_handle->number_of_corrupted_chunks,
+		 verification_handle->number_of_chunks_to_verify );
+	}
+	if( libcthreads_mutex_release(
+	     verification_handle->chunk_verification_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk verification mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
 
-			return( -1 );
-		}
-		if( libcdata_list_remove_element(
-		     verification_handle->output_list,
-		     element,
-		     error ) != 1 )
+on_error:
+	if( data_chunk != NULL )
+	{
+		libewf_data_chunk_free(
+		 &data_chunk,
+		 NULL );
+	}
+	if( chunk_buffer != NULL )
+	{
+		memory_free(
+		 chunk_buffer );
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
-
-			return( -1 );
+			libcnotify_print_error_backtrace(
+			 error );
 		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     error ) != 1 )
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( verification_handle != NULL )
+	{
+		if( verification_handle->abort == 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
-
-			return( -1 );
+			verification_handle_signal_abort(
+			 verification_handle,
+			 NULL );
 		}
-		element = next_element;
 	}
-	return( 1 );
+	return( -1 );
 }
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
@@ -1808,6 +2725,13 @@ int verification_handle_verify_input(
 	{
 		maximum_number_of_queued_items = 1 + (int) ( VERIFICATION_HANDLE_MAXIMUM_PROCESS_BUFFERS_SIZE / process_buffer_size );
 
+		/* Make sure every process thread has a storage media buffer to work on
+		 * while previously processed storage media buffers are being hashed
+		 */
+		if( maximum_number_of_queued_items < ( 2 * verification_handle->number_of_threads ) )
+		{
+			maximum_number_of_queued_items = 2 * verification_handle->number_of_threads;
+		}
 		if( libcthreads_thread_pool_create(
 		     &( verification_handle->process_thread_pool ),
 		     NULL,
@@ -1844,19 +2768,38 @@ int verification_handle_verify_input(
 
 			goto on_error;
 		}
-		if( libcdata_list_initialize(
-		     &( verification_handle->output_list ),
-		     error ) != 1 )
+		verification_handle->output_buffers = (storage_media_buffer_t **) memory_allocate(
+		                                       sizeof( storage_media_buffer_t * ) * maximum_number_of_queued_items );
+
+		if( verification_handle->output_buffers == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create output list.",
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create output buffers.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     verification_handle->output_buffers,
+		     0,
+		     sizeof( storage_media_buffer_t * ) * maximum_number_of_queued_items ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear output buffers.",
 			 function );
 
 			goto on_error;
 		}
+		verification_handle->maximum_number_of_queued_buffers = maximum_number_of_queued_items;
+		verification_handle->next_process_sequence_number     = 0;
+		verification_handle->next_output_sequence_number      = 0;
+
 		if( storage_media_buffer_queue_initialize(
 		     &( verification_handle->storage_media_buffer_queue ),
 		     verification_handle->input_handle,
@@ -1906,6 +2849,53 @@ int verification_handle_verify_input(
 
 		goto on_error;
 	}
+	if( verification_handle->piecewise_hash_window_size != 0 )
+	{
+		if( log_handle == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid log handle.",
+			 function );
+
+			goto on_error;
+		}
+		verification_handle->piecewise_hash_stream = log_handle->log_stream;
+
+		if( piecewise_hash_initialize(
+		     &( verification_handle->piecewise_hash ),
+		     verification_handle->piecewise_hash_window_size,
+		     verification_handle->calculate_md5,
+		     verification_handle->calculate_sha1,
+		     verification_handle->calculate_sha256,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create piecewise hash.",
+			 function );
+
+			goto on_error;
+		}
+		if( piecewise_hash_header_fprint(
+		     verification_handle->piecewise_hash,
+		     verification_handle->piecewise_hash_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print piecewise hash header.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( process_status_initialize(
 	     &( verification_handle->process_status ),
 	     _SYSTEM_STRING( "Verify" ),
@@ -1937,6 +2927,24 @@ int verification_handle_verify_input(
 
 		goto on_error;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->chunk_verification_handles != NULL )
+	{
+		if( verification_handle_start_chunk_verification(
+		     verification_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start chunk verification.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	if( verification_handle->number_of_threads == 0 )
 	{
 		if( storage_media_buffer_initialize(
@@ -2037,6 +3045,12 @@ int verification_handle_verify_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( verification_handle->number_of_threads != 0 )
 		{
+			/* The sequence number is used to hash the processed storage media buffers in order
+			 */
+			storage_media_buffer->sequence_number = verification_handle->next_process_sequence_number;
+
+			verification_handle->next_process_sequence_number += 1;
+
 			if( libcthreads_thread_pool_push(
 			     verification_handle->process_thread_pool,
 			     (intptr_t *) storage_media_buffer,
@@ -2076,6 +3090,8 @@ int verification_handle_verify_input(
 				process_count = verification_handle->chunk_size;
 
 				storage_media_buffer->is_corrupted = 1;
+
+				storage_media_buffer->processed_size = storage_media_buffer->requested_size;
 			}
 			result = storage_media_buffer_is_corrupted(
 			          storage_media_buffer,
@@ -2142,6 +3158,39 @@ int verification_handle_verify_input(
 
 				goto on_error;
 			}
+			if( verification_handle->piecewise_hash != NULL )
+			{
+				if( piecewise_hash_update(
+				     verification_handle->piecewise_hash,
+				     verification_handle->last_offset_hashed,
+				     data,
+				     storage_media_buffer->processed_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to update piecewise hash.",
+					 function );
+
+					goto on_error;
+				}
+				if( piecewise_hash_fprint(
+				     verification_handle->piecewise_hash,
+				     verification_handle->piecewise_hash_stream,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+					 "%s: unable to print piecewise hash.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			verification_handle->last_offset_hashed += (off64_t) process_count;
 
 			if( process_status_update(
@@ -2178,6 +3227,19 @@ int verification_handle_verify_input(
 		}
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle_stop_chunk_verification(
+	     verification_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to stop chunk verification.",
+		 function );
+
+		goto on_error;
+	}
 	if( verification_handle->process_thread_pool != NULL )
 	{
 		if( libcthreads_thread_pool_join(
@@ -2210,9 +3272,9 @@ int verification_handle_verify_input(
 			goto on_error;
 		}
 	}
-	if( verification_handle->output_list != NULL )
+	if( verification_handle->output_buffers != NULL )
 	{
-		if( verification_handle_empty_output_list(
+		if( verification_handle_empty_output_buffers(
 		     verification_handle,
 		     error ) != 1 )
 		{
@@ -2220,25 +3282,15 @@ int verification_handle_verify_input(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to empty output list.",
+			 "%s: unable to empty output buffers.",
 			 function );
 
 			goto on_error;
 		}
-		if( libcdata_list_free(
-		     &( verification_handle->output_list ),
-		     NULL,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output list.",
-			 function );
+		memory_free(
+		 verification_handle->output_buffers );
 
-			goto on_error;
-		}
+		verification_handle->output_buffers = NULL;
 	}
 	if( verification_handle->storage_media_buffer_queue != NULL )
 	{
@@ -2303,6 +3355,36 @@ int verification_handle_verify_input(
 
 		goto on_error;
 	}
+	if( verification_handle->piecewise_hash != NULL )
+	{
+		if( piecewise_hash_finalize(
+		     verification_handle->piecewise_hash,
+		     verification_handle->piecewise_hash_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize piecewise hash.",
+			 function );
+
+			goto on_error;
+		}
+		if( piecewise_hash_free(
+		     &( verification_handle->piecewise_hash ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free piecewise hash.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( verification_handle->abort == 0 )
 	{
 		fprintf(
@@ -2486,6 +3568,14 @@ on_error:
 		 NULL );
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->chunk_verification_thread_pool != NULL )
+	{
+		verification_handle->abort = 1;
+	}
+	verification_handle_stop_chunk_verification(
+	 verification_handle,
+	 NULL );
+
 	if( verification_handle->process_thread_pool != NULL )
 	{
 		libcthreads_thread_pool_join(
@@ -2498,15 +3588,15 @@ on_error:
 		 &( verification_handle->output_thread_pool ),
 		 NULL );
 	}
-	if( verification_handle->output_list != NULL )
+	if( verification_handle->output_buffers != NULL )
 	{
-		verification_handle_empty_output_list(
+		verification_handle_empty_output_buffers(
 		 verification_handle,
 		 NULL );
-		libcdata_list_free(
-		 &( verification_handle->output_list ),
-		 NULL,
-		 NULL );
+		memory_free(
+		 verification_handle->output_buffers );
+
+		verification_handle->output_buffers = NULL;
 	}
 	if( verification_handle->storage_media_buffer_queue != NULL )
 	{
@@ -2516,6 +3606,12 @@ on_error:
 	}
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
+	if( verification_handle->piecewise_hash != NULL )
+	{
+		piecewise_hash_free(
+		 &( verification_handle->piecewise_hash ),
+		 NULL );
+	}
 	return( -1 );
 }
 
@@ -3683,6 +4779,65 @@ int verification_handle_set_process_buffer_size(
 	return( result );
 }
 
+/* Sets the piecewise hash window size
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int verification_handle_set_piecewise_hash_window_size(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function  = "verification_handle_set_piecewise_hash_window_size";
+	size_t string_length   = 0;
+	uint64_t size_variable = 0;
+	int result             = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	result = byte_size_string_convert(
+	          string,
+	          string_length,
+	          &size_variable,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine piecewise hash window size.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( ( size_variable == 0 )
+		 || ( size_variable > (uint64_t) SSIZE_MAX ) )
+		{
+			result = 0;
+		}
+		else
+		{
+			verification_handle->piecewise_hash_window_size = (size_t) size_variable;
+		}
+	}
+	return( result );
+}
+
 /* Sets the number of threads
  * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
@@ -3732,7 +4887,7 @@ int verification_handle_set_number_of_threads(
 		}
 		result = 1;
 
-		if( number_of_threads > 32 )
+		if( number_of_threads > (uint64_t) EWFCOMMON_MAXIMUM_NUMBER_OF_THREADS )
 		{
 			result = 0;
 		}
@@ -4077,6 +5232,33 @@ int verification_handle_set_zero_chunk_on_error(
 	return( 1 );
 }
 
+/* Sets if the chunks should be verified on separate handles concurrently with the digest (hash) calculation
+ * This requires multi-threading and must be set before the input is opened
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_set_verify_chunks_concurrently(
+     verification_handle_t *verification_handle,
+     uint8_t verify_chunks_concurrently,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_set_verify_chunks_concurrently";
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	verification_handle->verify_chunks_concurrently = verify_chunks_concurrently;
+
+	return( 1 );
+}
+
 /* Appends a read error to the output handle
  * Returns 1 if successful or -1 on error
  */
@@ -26,12 +26,14 @@
 #include <types.h>
 
 #include "digest_hash.h"
+#include "digest_hash_ring.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
 #include "ewftools_libhmac.h"
 #include "log_handle.h"
+#include "piecewise_hash.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
 
@@ -121,6 +123,12 @@ struct verification_handle
 	 */
 	uint8_t sha256_context_initialized;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The digest hash ring used to calculate the digest hashes concurrently
+	 */
+	digest_hash_ring_t *digest_hash_ring;
+#endif
+
 	/* The calculated SHA256 digest hash string
 	 */
 	char *calculated_sha256_hash_string;
@@ -141,10 +149,31 @@ struct verification_handle
 	 */
 	size_t process_buffer_size;
 
+	/* The piecewise hash window size
+	 */
+	size_t piecewise_hash_window_size;
+
+	/* The piecewise hash
+	 */
+	piecewise_hash_t *piecewise_hash;
+
+	/* The piecewise hash output stream
+	 */
+	FILE *piecewise_hash_stream;
+
 	/* The number of threads in the process thread pool
 	 */
 	int number_of_threads;
 
+	/* Value to indicate the chunks should be verified on separate handles
+	 * concurrently with the digest (hash) calculation
+	 */
+	uint8_t verify_chunks_concurrently;
+
+	/* The maximum number of (concurrent) open file handles
+	 */
+	int maximum_number_of_open_handles;
+
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
 	/* The process thread pool
@@ -155,14 +184,59 @@ struct verification_handle
 	 */
 	libcthreads_thread_pool_t *output_thread_pool;
 
-	/* The output list
+	/* The output buffers, a reorder buffer of processed storage media buffers
+	 * indexed by sequence number modulo the maximum number of queued storage media buffers
+	 */
+	storage_media_buffer_t **output_buffers;
+
+	/* The maximum number of queued storage media buffers
 	 */
-	libcdata_list_t *output_list;
+	int maximum_number_of_queued_buffers;
+
+	/* The sequence number of the next storage media buffer to push onto the process thread pool
+	 */
+	uint64_t next_process_sequence_number;
+
+	/* The sequence number of the next storage media buffer to output
+	 */
+	uint64_t next_output_sequence_number;
 
 	/* The storage media buffer queue
 	 */
 	libcthreads_queue_t *storage_media_buffer_queue;
 
+	/* The chunk verification handles
+	 */
+	libewf_handle_t **chunk_verification_handles;
+
+	/* The number of chunk verification handles
+	 */
+	int number_of_chunk_verification_handles;
+
+	/* The chunk verification thread pool
+	 */
+	libcthreads_thread_pool_t *chunk_verification_thread_pool;
+
+	/* The chunk verification mutex
+	 */
+	libcthreads_mutex_t *chunk_verification_mutex;
+
+	/* The index of the next chunk to verify
+	 */
+	uint64_t next_chunk_to_verify;
+
+	/* The number of chunks to verify
+	 */
+	uint64_t number_of_chunks_to_verify;
+
+	/* The number of corrupted chunks found by the chunk verification
+	 */
+	uint64_t number_of_corrupted_chunks;
+
+	/* The number of chunk verification threads that have not finished
+	 */
+	int number_of_active_chunk_verification_threads;
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 	/* The libewf input handle
@@ -226,6 +300,20 @@ int verification_handle_close(
      verification_handle_t *verification_handle,
      libcerror_error_t **error );
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int verification_handle_open_chunk_verification_handles(
+     verification_handle_t *verification_handle,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     libcerror_error_t **error );
+
+int verification_handle_close_chunk_verification_handles(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 ssize_t verification_handle_process_storage_media_buffer(
          verification_handle_t *verification_handle,
          storage_media_buffer_t *storage_media_buffer,
@@ -255,10 +343,22 @@ int verification_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      verification_handle_t *verification_handle );
 
-int verification_handle_empty_output_list(
+int verification_handle_empty_output_buffers(
      verification_handle_t *verification_handle,
      libcerror_error_t **error );
 
+int verification_handle_start_chunk_verification(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error );
+
+int verification_handle_stop_chunk_verification(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error );
+
+int verification_handle_verify_chunks_callback(
+     libewf_handle_t *chunk_verification_handle,
+     verification_handle_t *verification_handle );
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 int verification_handle_verify_input(
@@ -313,6 +413,11 @@ int verification_handle_set_process_buffer_size(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int verification_handle_set_piecewise_hash_window_size(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int verification_handle_set_number_of_threads(
      verification_handle_t *verification_handle,
      const system_character_t *string,
@@ -328,6 +433,11 @@ int verification_handle_set_zero_chunk_on_error(
      uint8_t zero_chunk_on_error,
      libcerror_error_t **error );
 
+int verification_handle_set_verify_chunks_concurrently(
+     verification_handle_t *verification_handle,
+     uint8_t verify_chunks_concurrently,
+     libcerror_error_t **error );
+
 int verification_handle_append_read_error(
       verification_handle_t *verification_handle,
       off64_t start_offset,
@@ -0,0 +1,691 @@
+/*
+ * Asynchronous read functions
+ *
+ * Copyright (C) 2006-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_async_read.h"
+#include "libewf_chunk_table.h"
+#include "libewf_definitions.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_media_values.h"
+#include "libewf_segment_table.h"
+#include "libewf_types.h"
+#include "libewf_vectored_read.h"
+
+/* Creates an asynchronous read
+ * Make sure the value async_read is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_read_initialize(
+     libewf_async_read_t **async_read,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_async_read_initialize";
+
+	if( async_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous read.",
+		 function );
+
+		return( -1 );
+	}
+	if( *async_read != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid asynchronous read value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*async_read = memory_allocate_structure(
+	               libewf_async_read_t );
+
+	if( *async_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create asynchronous read.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *async_read,
+	     0,
+	     sizeof( libewf_async_read_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear asynchronous read.",
+		 function );
+
+		memory_free(
+		 *async_read );
+
+		*async_read = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *async_read )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *async_read )->push_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize push condition.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *async_read != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *async_read )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *async_read )->mutex ),
+			 NULL );
+		}
+#endif
+		memory_free(
+		 *async_read );
+
+		*async_read = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an asynchronous read
+ * Waits for the submitted requests to complete
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_read_free(
+     libewf_async_read_t **async_read,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_async_read_free";
+	int result            = 1;
+
+	if( async_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous read.",
+		 function );
+
+		return( -1 );
+	}
+	if( *async_read != NULL )
+	{
+		if( libewf_async_read_wait(
+		     *async_read,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to wait for submitted requests.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_condition_free(
+		     &( ( *async_read )->push_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free push condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *async_read )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *async_read );
+
+		*async_read = NULL;
+	}
+	return( result );
+}
+
+/* Submits an asynchronous read request
+ * The request is read by a worker thread, after which the callback is called
+ * with the number of bytes read or -1 on error. The buffer must remain valid
+ * until the callback has been called
+ * Without multi-thread support the request is read before this function returns
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_read_submit(
+     libewf_async_read_t *async_read,
+     libewf_handle_t *handle,
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     int number_of_threads,
+     uint8_t *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback)(
+            libewf_handle_t *handle,
+            void *buffer,
+            off64_t offset,
+            ssize_t read_count,
+            void *callback_data ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	libewf_async_read_request_t *async_read_request = NULL;
+	static char *function                           = "libewf_async_read_submit";
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *thread_pool          = NULL;
+	int result                                      = 1;
+#endif
+
+	if( async_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous read.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads < 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback.",
+		 function );
+
+		return( -1 );
+	}
+	async_read_request = memory_allocate_structure(
+	                      libewf_async_read_request_t );
+
+	if( async_read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create asynchronous read request.",
+		 function );
+
+		return( -1 );
+	}
+	async_read_request->handle        = handle;
+	async_read_request->buffer        = buffer;
+	async_read_request->buffer_size   = buffer_size;
+	async_read_request->offset        = offset;
+	async_read_request->callback      = callback;
+	async_read_request->callback_data = callback_data;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     async_read->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		memory_free(
+		 async_read_request );
+
+		return( -1 );
+	}
+	if( async_read->thread_pool == NULL )
+	{
+		async_read->chunk_table   = chunk_table;
+		async_read->io_handle     = io_handle;
+		async_read->file_io_pool  = file_io_pool;
+		async_read->media_values  = media_values;
+		async_read->segment_table = segment_table;
+
+		if( libcthreads_thread_pool_create(
+		     &( async_read->thread_pool ),
+		     NULL,
+		     number_of_threads,
+		     LIBEWF_ASYNC_READ_MAXIMUM_NUMBER_OF_QUEUED_REQUESTS,
+		     (int (*)(intptr_t *, void *)) &libewf_async_read_request_callback,
+		     (void *) async_read,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		thread_pool = async_read->thread_pool;
+
+		async_read->number_of_pushes += 1;
+	}
+	if( libcthreads_mutex_release(
+	     async_read->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		result = -1;
+	}
+	if( thread_pool == NULL )
+	{
+		memory_free(
+		 async_read_request );
+
+		return( -1 );
+	}
+	/* Pushing a request blocks while the queue is full, hence the mutex
+	 * is not held so that a completion callback can submit a request.
+	 * The number of pushes keeps the thread pool from being joined
+	 * while the request is pushed
+	 */
+	if( result == 1 )
+	{
+		if( libcthreads_thread_pool_push(
+		     thread_pool,
+		     (intptr_t *) async_read_request,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push asynchronous read request onto thread pool queue.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result != 1 )
+	{
+		memory_free(
+		 async_read_request );
+	}
+	if( libcthreads_mutex_grab(
+	     async_read->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	async_read->number_of_pushes -= 1;
+
+	if( async_read->number_of_pushes == 0 )
+	{
+		if( libcthreads_condition_broadcast(
+		     async_read->push_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast push condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     async_read->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+#else
+	async_read->chunk_table   = chunk_table;
+	async_read->io_handle     = io_handle;
+	async_read->file_io_pool  = file_io_pool;
+	async_read->media_values  = media_values;
+	async_read->segment_table = segment_table;
+
+	/* A read error is reported to the callback
+	 */
+	libewf_async_read_request_read(
+	 async_read_request,
+	 async_read );
+
+	return( 1 );
+#endif
+}
+
+/* Waits for the submitted requests to complete
+ * Requests that are submitted while waiting, e.g. by a completion callback,
+ * are not waited for. This function cannot be called from a completion callback
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_read_wait(
+     libewf_async_read_t *async_read,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *thread_pool = NULL;
+#endif
+
+	static char *function                  = "libewf_async_read_wait";
+
+	if( async_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous read.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The thread pool is detached so that other threads can submit requests
+	 * to a new thread pool while the current one is joined
+	 */
+	if( libcthreads_mutex_grab(
+	     async_read->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	thread_pool = async_read->thread_pool;
+
+	async_read->thread_pool = NULL;
+
+	/* Wait for the requests that are being pushed onto the thread pool
+	 */
+	while( async_read->number_of_pushes > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     async_read->push_condition,
+		     async_read->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for push condition.",
+			 function );
+
+			async_read->thread_pool = thread_pool;
+
+			libcthreads_mutex_release(
+			 async_read->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_release(
+	     async_read->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	return( 1 );
+}
+
+/* Reads an asynchronous read request and calls its completion callback
+ * Frees the request
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_read_request_read(
+     libewf_async_read_request_t *async_read_request,
+     libewf_async_read_t *async_read )
+{
+	libcerror_error_t *error = NULL;
+	ssize_t read_count       = 0;
+	int result               = 1;
+
+	if( async_read_request == NULL )
+	{
+		return( -1 );
+	}
+	if( async_read == NULL )
+	{
+		memory_free(
+		 async_read_request );
+
+		return( -1 );
+	}
+	if( libewf_vectored_read_buffers_at_offsets(
+	     async_read->chunk_table,
+	     async_read->io_handle,
+	     async_read->file_io_pool,
+	     async_read->media_values,
+	     async_read->segment_table,
+	     &( async_read_request->buffer ),
+	     &( async_read_request->buffer_size ),
+	     &( async_read_request->offset ),
+	     &read_count,
+	     1,
+	     &error ) == -1 )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+
+		read_count = -1;
+		result     = -1;
+	}
+	async_read_request->callback(
+	 async_read_request->handle,
+	 (void *) async_read_request->buffer,
+	 async_read_request->offset,
+	 read_count,
+	 async_read_request->callback_data );
+
+	memory_free(
+	 async_read_request );
+
+	return( result );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Reads an asynchronous read request
+ * Callback function for the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_read_request_callback(
+     libewf_async_read_request_t *async_read_request,
+     libewf_async_read_t *async_read )
+{
+	return( libewf_async_read_request_read(
+	         async_read_request,
+	         async_read ) );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
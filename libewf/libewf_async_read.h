@@ -0,0 +1,171 @@
+/*
+ * Asynchronous read functions
+ *
+ * Copyright (C) 2006-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_ASYNC_READ_H )
+#define _LIBEWF_ASYNC_READ_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_table.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_media_values.h"
+#include "libewf_segment_table.h"
+#include "libewf_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_async_read_request libewf_async_read_request_t;
+
+struct libewf_async_read_request
+{
+	/* The handle
+	 */
+	libewf_handle_t *handle;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The (storage media) offset
+	 */
+	off64_t offset;
+
+	/* The completion callback
+	 */
+	void (*callback)(
+	       libewf_handle_t *handle,
+	       void *buffer,
+	       off64_t offset,
+	       ssize_t read_count,
+	       void *callback_data );
+
+	/* The completion callback data
+	 */
+	void *callback_data;
+};
+
+typedef struct libewf_async_read libewf_async_read_t;
+
+/* The asynchronous read reads submitted requests on worker threads
+ * and reports their completion by callback
+ */
+struct libewf_async_read
+{
+	/* The chunk table
+	 */
+	libewf_chunk_table_t *chunk_table;
+
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The file IO pool
+	 */
+	libbfio_pool_t *file_io_pool;
+
+	/* The media values
+	 */
+	libewf_media_values_t *media_values;
+
+	/* The segment table
+	 */
+	libewf_segment_table_t *segment_table;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The number of requests that are being pushed onto a thread pool
+	 */
+	int number_of_pushes;
+
+	/* The condition that is signalled when no requests are being pushed
+	 */
+	libcthreads_condition_t *push_condition;
+#endif
+};
+
+int libewf_async_read_initialize(
+     libewf_async_read_t **async_read,
+     libcerror_error_t **error );
+
+int libewf_async_read_free(
+     libewf_async_read_t **async_read,
+     libcerror_error_t **error );
+
+int libewf_async_read_submit(
+     libewf_async_read_t *async_read,
+     libewf_handle_t *handle,
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     int number_of_threads,
+     uint8_t *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback)(
+            libewf_handle_t *handle,
+            void *buffer,
+            off64_t offset,
+            ssize_t read_count,
+            void *callback_data ),
+     void *callback_data,
+     libcerror_error_t **error );
+
+int libewf_async_read_wait(
+     libewf_async_read_t *async_read,
+     libcerror_error_t **error );
+
+int libewf_async_read_request_read(
+     libewf_async_read_request_t *async_read_request,
+     libewf_async_read_t *async_read );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_async_read_request_callback(
+     libewf_async_read_request_t *async_read_request,
+     libewf_async_read_t *async_read );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_ASYNC_READ_H ) */
+
@@ -19,6 +19,7 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <byte_stream.h>
 #include <common.h>
 #include <memory.h>
 #include <types.h>
@@ -185,6 +186,74 @@ int libewf_bit_stream_free(
 	return( 1 );
 }
 
+/* Reads bits from the byte stream into the bit buffer
+ * The bit buffer is filled as far as possible, for a byte back to front storage type
+ * with a single 64-bit read when at least 8 bytes of the byte stream remain
+ * Returns 1 on success or -1 on error
+ */
+int libewf_bit_stream_read(
+     libewf_bit_stream_t *bit_stream,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_bit_stream_read";
+	size_t read_size      = 0;
+	uint64_t value_64bit  = 0;
+
+	if( bit_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bit stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( bit_stream->bit_buffer_size > 56 )
+	{
+		return( 1 );
+	}
+	if( ( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
+	 && ( bit_stream->byte_stream_offset < bit_stream->byte_stream_size )
+	 && ( ( bit_stream->byte_stream_size - bit_stream->byte_stream_offset ) >= 8 ) )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 &( bit_stream->byte_stream[ bit_stream->byte_stream_offset ] ),
+		 value_64bit );
+
+		/* Only read the whole bytes that fit in the bit buffer
+		 */
+		read_size = (size_t) ( 64 - bit_stream->bit_buffer_size ) / 8;
+
+		if( read_size < 8 )
+		{
+			value_64bit &= ~( (uint64_t) 0xffffffffffffffffULL << ( read_size * 8 ) );
+		}
+		bit_stream->bit_buffer         |= value_64bit << bit_stream->bit_buffer_size;
+		bit_stream->bit_buffer_size    += (uint8_t) ( read_size * 8 );
+		bit_stream->byte_stream_offset += read_size;
+
+		return( 1 );
+	}
+	while( ( bit_stream->bit_buffer_size <= 56 )
+	    && ( bit_stream->byte_stream_offset < bit_stream->byte_stream_size ) )
+	{
+		if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
+		{
+			bit_stream->bit_buffer |= (uint64_t) bit_stream->byte_stream[ bit_stream->byte_stream_offset ] << bit_stream->bit_buffer_size;
+		}
+		else if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_FRONT_TO_BACK )
+		{
+			bit_stream->bit_buffer <<= 8;
+			bit_stream->bit_buffer  |= bit_stream->byte_stream[ bit_stream->byte_stream_offset ];
+		}
+		bit_stream->bit_buffer_size    += 8;
+		bit_stream->byte_stream_offset += 1;
+	}
+	return( 1 );
+}
+
 /* Retrieves a value from the bit stream
  * Returns 1 on success or -1 on error
  */
@@ -194,11 +263,8 @@ int libewf_bit_stream_get_value(
      uint32_t *value_32bit,
      libcerror_error_t **error )
 {
-	static char *function            = "libewf_bit_stream_get_value";
-	uint32_t read_value_32bit        = 0;
-	uint32_t safe_value_32bit        = 0;
-	uint8_t read_number_of_bits      = 0;
-	uint8_t remaining_number_of_bits = 0;
+	static char *function = "libewf_bit_stream_get_value";
+	uint64_t value_64bit  = 0;
 
 	if( bit_stream == NULL )
 	{
@@ -233,80 +299,60 @@ int libewf_bit_stream_get_value(
 
 		return( -1 );
 	}
-	remaining_number_of_bits = number_of_bits;
-
-	while( remaining_number_of_bits > 0 )
+	/* Only read the bytes needed for the value
+	 */
+	while( bit_stream->bit_buffer_size < number_of_bits )
 	{
-		while( ( remaining_number_of_bits > bit_stream->bit_buffer_size )
-		    && ( bit_stream->bit_buffer_size <= 24 ) )
+		if( bit_stream->byte_stream_offset >= bit_stream->byte_stream_size )
 		{
-			if( bit_stream->byte_stream_offset >= bit_stream->byte_stream_size )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-				 "%s: invalid byte stream offset value out of bounds.",
-				 function );
-
-				return( -1 );
-			}
-			if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
-			{
-				bit_stream->bit_buffer |= (uint32_t) bit_stream->byte_stream[ bit_stream->byte_stream_offset ] << bit_stream->bit_buffer_size;
-			}
-			else if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_FRONT_TO_BACK )
-			{
-				bit_stream->bit_buffer <<= 8;
-				bit_stream->bit_buffer  |= bit_stream->byte_stream[ bit_stream->byte_stream_offset ];
-			}
-			bit_stream->bit_buffer_size    += 8;
-			bit_stream->byte_stream_offset += 1;
-		}
-		if( remaining_number_of_bits < bit_stream->bit_buffer_size )
-		{
-			read_number_of_bits = remaining_number_of_bits;
-		}
-		else
-		{
-			read_number_of_bits = bit_stream->bit_buffer_size;
-		}
-		read_value_32bit = bit_stream->bit_buffer;
-
-		if( remaining_number_of_bits < number_of_bits )
-		{
-			safe_value_32bit <<= remaining_number_of_bits;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid byte stream offset value out of bounds.",
+			 function );
+
+			return( -1 );
 		}
 		if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
 		{
-			if( read_number_of_bits < 32 )
-			{
-				/* On VS 2008 32-bit "~( 0xfffffffUL << 32 )" does not behave as expected
-				 */
-				read_value_32bit &= ~( 0xffffffffUL << read_number_of_bits );
-
-				bit_stream->bit_buffer >>= read_number_of_bits;
-			}
-			bit_stream->bit_buffer_size -= read_number_of_bits;
+			bit_stream->bit_buffer |= (uint64_t) bit_stream->byte_stream[ bit_stream->byte_stream_offset ] << bit_stream->bit_buffer_size;
 		}
 		else if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_FRONT_TO_BACK )
 		{
-			bit_stream->bit_buffer_size -= read_number_of_bits;
-			read_value_32bit           >>= bit_stream->bit_buffer_size;
-
-			if( bit_stream->bit_buffer_size > 0 )
-			{
-				bit_stream->bit_buffer &= 0xffffffffUL >> ( 32 - bit_stream->bit_buffer_size );
-			}
-		}
-		if( bit_stream->bit_buffer_size == 0 )
-		{
-			bit_stream->bit_buffer = 0;
+			bit_stream->bit_buffer <<= 8;
+			bit_stream->bit_buffer  |= bit_stream->byte_stream[ bit_stream->byte_stream_offset ];
 		}
-		safe_value_32bit         |= read_value_32bit;
-		remaining_number_of_bits -= read_number_of_bits;
+		bit_stream->bit_buffer_size    += 8;
+		bit_stream->byte_stream_offset += 1;
+	}
+	if( number_of_bits == 0 )
+	{
+		*value_32bit = 0;
+
+		return( 1 );
+	}
+	if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
+	{
+		value_64bit = bit_stream->bit_buffer;
+
+		bit_stream->bit_buffer >>= number_of_bits;
+	}
+	else if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_FRONT_TO_BACK )
+	{
+		value_64bit = bit_stream->bit_buffer >> ( bit_stream->bit_buffer_size - number_of_bits );
+	}
+	bit_stream->bit_buffer_size -= number_of_bits;
+
+	if( bit_stream->bit_buffer_size == 0 )
+	{
+		bit_stream->bit_buffer = 0;
+	}
+	else if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_FRONT_TO_BACK )
+	{
+		bit_stream->bit_buffer &= ~( (uint64_t) 0xffffffffffffffffULL << bit_stream->bit_buffer_size );
 	}
-	*value_32bit = safe_value_32bit;
+	*value_32bit = (uint32_t) ( value_64bit & ~( (uint64_t) 0xffffffffffffffffULL << number_of_bits ) );
 
 	return( 1 );
 }
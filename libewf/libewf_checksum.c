@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <byte_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
@@ -28,13 +29,532 @@
 #endif
 
 #include "libewf_checksum.h"
+#include "libewf_deflate.h"
 #include "libewf_libcerror.h"
 #include "libewf_types.h"
 
-#if defined( HAVE_ZLIB_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+#if defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD_SUPPORT )
+#include <immintrin.h>
+
+/* The Adler-32 modulus
+ */
+#define LIBEWF_CHECKSUM_ADLER32_BASE		65521
+
+/* The number of 32-byte blocks that can be processed before
+ * the 32-bit sums must be reduced by the modulus.
+ * The largest n such that 255 * n * (n + 1) / 2 + (n + 1) * (BASE - 1) fits
+ * in 32-bit is 5552, hence 5552 / 32 = 173 blocks
+ */
+#define LIBEWF_CHECKSUM_ADLER32_MAXIMUM_NUMBER_OF_BLOCKS	173
+
+/* Calculates the Adler-32 of the remaining bytes of a buffer
+ * Returns the Adler-32
+ */
+static uint32_t libewf_checksum_calculate_adler32_remainder(
+                 const uint8_t *buffer,
+                 size_t size,
+                 uint32_t lower_word,
+                 uint32_t upper_word )
+{
+	while( size > 0 )
+	{
+		lower_word += *buffer;
+		upper_word += lower_word;
+
+		buffer++;
+		size--;
+	}
+	lower_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+	upper_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+
+	return( ( upper_word << 16 ) | lower_word );
+}
+
+/* Calculates the Adler-32 of a buffer using SSE2 instructions
+ * The buffer and size are not checked
+ * Returns the Adler-32
+ */
+__attribute__((target("sse2")))
+uint32_t libewf_checksum_calculate_adler32_sse2(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value )
+{
+	__m128i block1;
+	__m128i block2;
+	__m128i previous_lower_words;
+	__m128i sum;
+	__m128i upper_words;
+	__m128i lower_words;
+
+	const __m128i weights1 = _mm_setr_epi16( 32, 31, 30, 29, 28, 27, 26, 25 );
+	const __m128i weights2 = _mm_setr_epi16( 24, 23, 22, 21, 20, 19, 18, 17 );
+	const __m128i weights3 = _mm_setr_epi16( 16, 15, 14, 13, 12, 11, 10, 9 );
+	const __m128i weights4 = _mm_setr_epi16( 8, 7, 6, 5, 4, 3, 2, 1 );
+	const __m128i zero     = _mm_setzero_si128();
+
+	size_t number_of_blocks = size / 32;
+	uint32_t lower_word     = initial_value & 0xffff;
+	uint32_t upper_word     = ( initial_value >> 16 ) & 0xffff;
+	size_t block_index      = 0;
+
+	size -= number_of_blocks * 32;
+
+	while( number_of_blocks > 0 )
+	{
+		block_index = number_of_blocks;
+
+		if( block_index > LIBEWF_CHECKSUM_ADLER32_MAXIMUM_NUMBER_OF_BLOCKS )
+		{
+			block_index = LIBEWF_CHECKSUM_ADLER32_MAXIMUM_NUMBER_OF_BLOCKS;
+		}
+		number_of_blocks -= block_index;
+
+		previous_lower_words = _mm_cvtsi32_si128( (int) ( lower_word * block_index ) );
+		upper_words          = _mm_cvtsi32_si128( (int) upper_word );
+		lower_words          = zero;
+
+		while( block_index > 0 )
+		{
+			block1 = _mm_loadu_si128( (const __m128i *) buffer );
+			block2 = _mm_loadu_si128( (const __m128i *) &( buffer[ 16 ] ) );
+
+			previous_lower_words = _mm_add_epi32( previous_lower_words, lower_words );
+
+			lower_words = _mm_add_epi32( lower_words, _mm_sad_epu8( block1, zero ) );
+			lower_words = _mm_add_epi32( lower_words, _mm_sad_epu8( block2, zero ) );
+
+			upper_words = _mm_add_epi32( upper_words, _mm_madd_epi16( _mm_unpacklo_epi8( block1, zero ), weights1 ) );
+			upper_words = _mm_add_epi32( upper_words, _mm_madd_epi16( _mm_unpackhi_epi8( block1, zero ), weights2 ) );
+			upper_words = _mm_add_epi32( upper_words, _mm_madd_epi16( _mm_unpacklo_epi8( block2, zero ), weights3 ) );
+			upper_words = _mm_add_epi32( upper_words, _mm_madd_epi16( _mm_unpackhi_epi8( block2, zero ), weights4 ) );
+
+			buffer      += 32;
+			block_index -= 1;
+		}
+		upper_words = _mm_add_epi32( upper_words, _mm_slli_epi32( previous_lower_words, 5 ) );
+
+		sum = _mm_add_epi32( lower_words, _mm_shuffle_epi32( lower_words, 0x4e ) );
+		sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, 0xb1 ) );
+
+		lower_word += (uint32_t) _mm_cvtsi128_si32( sum );
+
+		sum = _mm_add_epi32( upper_words, _mm_shuffle_epi32( upper_words, 0x4e ) );
+		sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, 0xb1 ) );
+
+		upper_word = (uint32_t) _mm_cvtsi128_si32( sum );
+
+		lower_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+		upper_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+	}
+	return( libewf_checksum_calculate_adler32_remainder(
+	         buffer,
+	         size,
+	         lower_word,
+	         upper_word ) );
+}
+
+/* Calculates the Adler-32 of a buffer using SSSE3 instructions
+ * The buffer and size are not checked
+ * Returns the Adler-32
+ */
+__attribute__((target("ssse3")))
+uint32_t libewf_checksum_calculate_adler32_ssse3(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value )
+{
+	__m128i block1;
+	__m128i block2;
+	__m128i previous_lower_words;
+	__m128i sum;
+	__m128i upper_words;
+	__m128i lower_words;
+
+	const __m128i ones     = _mm_set1_epi16( 1 );
+	const __m128i weights1 = _mm_setr_epi8( 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17 );
+	const __m128i weights2 = _mm_setr_epi8( 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+	const __m128i zero     = _mm_setzero_si128();
+
+	size_t number_of_blocks = size / 32;
+	uint32_t lower_word     = initial_value & 0xffff;
+	uint32_t upper_word     = ( initial_value >> 16 ) & 0xffff;
+	size_t block_index      = 0;
+
+	size -= number_of_blocks * 32;
+
+	while( number_of_blocks > 0 )
+	{
+		block_index = number_of_blocks;
+
+		if( block_index > LIBEWF_CHECKSUM_ADLER32_MAXIMUM_NUMBER_OF_BLOCKS )
+		{
+			block_index = LIBEWF_CHECKSUM_ADLER32_MAXIMUM_NUMBER_OF_BLOCKS;
+		}
+		number_of_blocks -= block_index;
+
+		previous_lower_words = _mm_cvtsi32_si128( (int) ( lower_word * block_index ) );
+		upper_words          = _mm_cvtsi32_si128( (int) upper_word );
+		lower_words          = zero;
+
+		while( block_index > 0 )
+		{
+			block1 = _mm_loadu_si128( (const __m128i *) buffer );
+			block2 = _mm_loadu_si128( (const __m128i *) &( buffer[ 16 ] ) );
+
+			previous_lower_words = _mm_add_epi32( previous_lower_words, lower_words );
+
+			lower_words = _mm_add_epi32( lower_words, _mm_sad_epu8( block1, zero ) );
+			lower_words = _mm_add_epi32( lower_words, _mm_sad_epu8( block2, zero ) );
+
+			upper_words = _mm_add_epi32( upper_words, _mm_madd_epi16( _mm_maddubs_epi16( block1, weights1 ), ones ) );
+			upper_words = _mm_add_epi32( upper_words, _mm_madd_epi16( _mm_maddubs_epi16( block2, weights2 ), ones ) );
+
+			buffer      += 32;
+			block_index -= 1;
+		}
+		upper_words = _mm_add_epi32( upper_words, _mm_slli_epi32( previous_lower_words, 5 ) );
+
+		sum = _mm_add_epi32( lower_words, _mm_shuffle_epi32( lower_words, 0x4e ) );
+		sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, 0xb1 ) );
+
+		lower_word += (uint32_t) _mm_cvtsi128_si32( sum );
+
+		sum = _mm_add_epi32( upper_words, _mm_shuffle_epi32( upper_words, 0x4e ) );
+		sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, 0xb1 ) );
+
+		upper_word = (uint32_t) _mm_cvtsi128_si32( sum );
+
+		lower_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+		upper_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+	}
+	return( libewf_checksum_calculate_adler32_remainder(
+	         buffer,
+	         size,
+	         lower_word,
+	         upper_word ) );
+}
+
+/* Calculates the Adler-32 of a buffer and compares the buffer against its first 64-bit
+ * using SSSE3 instructions in a single pass
+ * The buffer and size are not checked, the size must be 8 or more
+ * Returns the Adler-32
+ */
+__attribute__((target("ssse3")))
+uint32_t libewf_checksum_calculate_adler32_and_compare_64_bit_pattern_ssse3(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value,
+          uint8_t *pattern_matches )
+{
+	__m128i block1;
+	__m128i block2;
+	__m128i pattern_differences;
+	__m128i previous_lower_words;
+	__m128i sum;
+	__m128i upper_words;
+	__m128i lower_words;
+	__m128i pattern;
+
+	const __m128i ones     = _mm_set1_epi16( 1 );
+	const __m128i weights1 = _mm_setr_epi8( 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17 );
+	const __m128i weights2 = _mm_setr_epi8( 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+	const __m128i zero     = _mm_setzero_si128();
+
+	const uint8_t *buffer_start = buffer;
+	size_t number_of_blocks     = size / 32;
+	uint32_t lower_word         = initial_value & 0xffff;
+	uint32_t upper_word         = ( initial_value >> 16 ) & 0xffff;
+	size_t block_index          = 0;
+	size_t buffer_offset        = 0;
+
+	pattern             = _mm_loadl_epi64( (const __m128i *) buffer );
+	pattern             = _mm_unpacklo_epi64( pattern, pattern );
+	pattern_differences = zero;
+
+	size -= number_of_blocks * 32;
+
+	while( number_of_blocks > 0 )
+	{
+		block_index = number_of_blocks;
+
+		if( block_index > LIBEWF_CHECKSUM_ADLER32_MAXIMUM_NUMBER_OF_BLOCKS )
+		{
+			block_index = LIBEWF_CHECKSUM_ADLER32_MAXIMUM_NUMBER_OF_BLOCKS;
+		}
+		number_of_blocks -= block_index;
+
+		previous_lower_words = _mm_cvtsi32_si128( (int) ( lower_word * block_index ) );
+		upper_words          = _mm_cvtsi32_si128( (int) upper_word );
+		lower_words          = zero;
+
+		while( block_index > 0 )
+		{
+			block1 = _mm_loadu_si128( (const __m128i *) buffer );
+			block2 = _mm_loadu_si128( (const __m128i *) &( buffer[ 16 ] ) );
+
+			pattern_differences = _mm_or_si128( pattern_differences, _mm_xor_si128( block1, pattern ) );
+			pattern_differences = _mm_or_si128( pattern_differences, _mm_xor_si128( block2, pattern ) );
+
+			previous_lower_words = _mm_add_epi32( previous_lower_words, lower_words );
+
+			lower_words = _mm_add_epi32( lower_words, _mm_sad_epu8( block1, zero ) );
+			lower_words = _mm_add_epi32( lower_words, _mm_sad_epu8( block2, zero ) );
+
+			upper_words = _mm_add_epi32( upper_words, _mm_madd_epi16( _mm_maddubs_epi16( block1, weights1 ), ones ) );
+			upper_words = _mm_add_epi32( upper_words, _mm_madd_epi16( _mm_maddubs_epi16( block2, weights2 ), ones ) );
+
+			buffer      += 32;
+			block_index -= 1;
+		}
+		upper_words = _mm_add_epi32( upper_words, _mm_slli_epi32( previous_lower_words, 5 ) );
+
+		sum = _mm_add_epi32( lower_words, _mm_shuffle_epi32( lower_words, 0x4e ) );
+		sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, 0xb1 ) );
+
+		lower_word += (uint32_t) _mm_cvtsi128_si32( sum );
+
+		sum = _mm_add_epi32( upper_words, _mm_shuffle_epi32( upper_words, 0x4e ) );
+		sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, 0xb1 ) );
+
+		upper_word = (uint32_t) _mm_cvtsi128_si32( sum );
+
+		lower_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+		upper_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+
+		/* Once the pattern does not match only the Adler-32 needs to be calculated
+		 */
+		if( _mm_movemask_epi8( _mm_cmpeq_epi8( pattern_differences, zero ) ) != 0xffff )
+		{
+			*pattern_matches = 0;
+
+			return( libewf_checksum_calculate_adler32_ssse3(
+			         buffer,
+			         ( number_of_blocks * 32 ) + size,
+			         ( upper_word << 16 ) | lower_word ) );
+		}
+	}
+	*pattern_matches = 1;
+
+	buffer_offset = (size_t) ( buffer - buffer_start );
+
+	for( block_index = 0;
+	     block_index < size;
+	     block_index++ )
+	{
+		if( buffer[ block_index ] != buffer_start[ ( buffer_offset + block_index ) % 8 ] )
+		{
+			*pattern_matches = 0;
+
+			break;
+		}
+	}
+	return( libewf_checksum_calculate_adler32_remainder(
+	         buffer,
+	         size,
+	         lower_word,
+	         upper_word ) );
+}
+
+/* Calculates the Adler-32 of a buffer using AVX2 instructions
+ * The buffer and size are not checked
+ * Returns the Adler-32
+ */
+__attribute__((target("avx2")))
+uint32_t libewf_checksum_calculate_adler32_avx2(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value )
+{
+	__m256i block;
+	__m256i previous_lower_words;
+	__m256i upper_words;
+	__m256i lower_words;
+	__m128i sum;
+
+	const __m256i ones    = _mm256_set1_epi16( 1 );
+	const __m256i weights = _mm256_setr_epi8( 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+	const __m256i zero    = _mm256_setzero_si256();
+
+	size_t number_of_blocks = size / 32;
+	uint32_t lower_word     = initial_value & 0xffff;
+	uint32_t upper_word     = ( initial_value >> 16 ) & 0xffff;
+	size_t block_index      = 0;
+
+	size -= number_of_blocks * 32;
+
+	while( number_of_blocks > 0 )
+	{
+		block_index = number_of_blocks;
+
+		if( block_index > LIBEWF_CHECKSUM_ADLER32_MAXIMUM_NUMBER_OF_BLOCKS )
+		{
+			block_index = LIBEWF_CHECKSUM_ADLER32_MAXIMUM_NUMBER_OF_BLOCKS;
+		}
+		number_of_blocks -= block_index;
+
+		previous_lower_words = _mm256_setr_epi32( (int) ( lower_word * block_index ), 0, 0, 0, 0, 0, 0, 0 );
+		upper_words          = _mm256_setr_epi32( (int) upper_word, 0, 0, 0, 0, 0, 0, 0 );
+		lower_words          = zero;
+
+		while( block_index > 0 )
+		{
+			block = _mm256_loadu_si256( (const __m256i *) buffer );
+
+			previous_lower_words = _mm256_add_epi32( previous_lower_words, lower_words );
+
+			lower_words = _mm256_add_epi32( lower_words, _mm256_sad_epu8( block, zero ) );
+			upper_words = _mm256_add_epi32( upper_words, _mm256_madd_epi16( _mm256_maddubs_epi16( block, weights ), ones ) );
+
+			buffer      += 32;
+			block_index -= 1;
+		}
+		upper_words = _mm256_add_epi32( upper_words, _mm256_slli_epi32( previous_lower_words, 5 ) );
+
+		sum = _mm_add_epi32( _mm256_castsi256_si128( lower_words ), _mm256_extracti128_si256( lower_words, 1 ) );
+		sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, 0x4e ) );
+		sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, 0xb1 ) );
+
+		lower_word += (uint32_t) _mm_cvtsi128_si32( sum );
+
+		sum = _mm_add_epi32( _mm256_castsi256_si128( upper_words ), _mm256_extracti128_si256( upper_words, 1 ) );
+		sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, 0x4e ) );
+		sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, 0xb1 ) );
+
+		upper_word = (uint32_t) _mm_cvtsi128_si32( sum );
+
+		lower_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+		upper_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+	}
+	return( libewf_checksum_calculate_adler32_remainder(
+	         buffer,
+	         size,
+	         lower_word,
+	         upper_word ) );
+}
+
+/* Calculates the Adler-32 of a buffer and compares the buffer against its first 64-bit
+ * using AVX2 instructions in a single pass
+ * The buffer and size are not checked, the size must be 8 or more
+ * Returns the Adler-32
+ */
+__attribute__((target("avx2")))
+uint32_t libewf_checksum_calculate_adler32_and_compare_64_bit_pattern_avx2(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value,
+          uint8_t *pattern_matches )
+{
+	__m256i block;
+	__m256i pattern;
+	__m256i pattern_differences;
+	__m256i previous_lower_words;
+	__m256i upper_words;
+	__m256i lower_words;
+	__m128i sum;
+
+	const __m256i ones    = _mm256_set1_epi16( 1 );
+	const __m256i weights = _mm256_setr_epi8( 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+	const __m256i zero    = _mm256_setzero_si256();
+
+	const uint8_t *buffer_start = buffer;
+	size_t number_of_blocks     = size / 32;
+	uint32_t lower_word         = initial_value & 0xffff;
+	uint32_t upper_word         = ( initial_value >> 16 ) & 0xffff;
+	size_t block_index          = 0;
+	size_t buffer_offset        = 0;
+
+	pattern             = _mm256_broadcastq_epi64( _mm_loadl_epi64( (const __m128i *) buffer ) );
+	pattern_differences = zero;
+
+	size -= number_of_blocks * 32;
+
+	while( number_of_blocks > 0 )
+	{
+		block_index = number_of_blocks;
+
+		if( block_index > LIBEWF_CHECKSUM_ADLER32_MAXIMUM_NUMBER_OF_BLOCKS )
+		{
+			block_index = LIBEWF_CHECKSUM_ADLER32_MAXIMUM_NUMBER_OF_BLOCKS;
+		}
+		number_of_blocks -= block_index;
+
+		previous_lower_words = _mm256_setr_epi32( (int) ( lower_word * block_index ), 0, 0, 0, 0, 0, 0, 0 );
+		upper_words          = _mm256_setr_epi32( (int) upper_word, 0, 0, 0, 0, 0, 0, 0 );
+		lower_words          = zero;
+
+		while( block_index > 0 )
+		{
+			block = _mm256_loadu_si256( (const __m256i *) buffer );
+
+			pattern_differences = _mm256_or_si256( pattern_differences, _mm256_xor_si256( block, pattern ) );
+
+			previous_lower_words = _mm256_add_epi32( previous_lower_words, lower_words );
+
+			lower_words = _mm256_add_epi32( lower_words, _mm256_sad_epu8( block, zero ) );
+			upper_words = _mm256_add_epi32( upper_words, _mm256_madd_epi16( _mm256_maddubs_epi16( block, weights ), ones ) );
+
+			buffer      += 32;
+			block_index -= 1;
+		}
+		upper_words = _mm256_add_epi32( upper_words, _mm256_slli_epi32( previous_lower_words, 5 ) );
+
+		sum = _mm_add_epi32( _mm256_castsi256_si128( lower_words ), _mm256_extracti128_si256( lower_words, 1 ) );
+		sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, 0x4e ) );
+		sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, 0xb1 ) );
+
+		lower_word += (uint32_t) _mm_cvtsi128_si32( sum );
+
+		sum = _mm_add_epi32( _mm256_castsi256_si128( upper_words ), _mm256_extracti128_si256( upper_words, 1 ) );
+		sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, 0x4e ) );
+		sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, 0xb1 ) );
+
+		upper_word = (uint32_t) _mm_cvtsi128_si32( sum );
+
+		lower_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+		upper_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+
+		/* Once the pattern does not match only the Adler-32 needs to be calculated
+		 */
+		if( _mm256_testz_si256( pattern_differences, pattern_differences ) == 0 )
+		{
+			*pattern_matches = 0;
+
+			return( libewf_checksum_calculate_adler32_avx2(
+			         buffer,
+			         ( number_of_blocks * 32 ) + size,
+			         ( upper_word << 16 ) | lower_word ) );
+		}
+	}
+	*pattern_matches = 1;
+
+	buffer_offset = (size_t) ( buffer - buffer_start );
+
+	for( block_index = 0;
+	     block_index < size;
+	     block_index++ )
+	{
+		if( buffer[ block_index ] != buffer_start[ ( buffer_offset + block_index ) % 8 ] )
+		{
+			*pattern_matches = 0;
+
+			break;
+		}
+	}
+	return( libewf_checksum_calculate_adler32_remainder(
+	         buffer,
+	         size,
+	         lower_word,
+	         upper_word ) );
+}
+
+#endif /* defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD_SUPPORT ) */
 
 /* Calculates the little-endian Adler-32 of a buffer
  * It uses the initial value to calculate a new Adler-32
+ * The implementation is selected at run-time based on the CPU features,
+ * if no SIMD implementation is supported zlib or the built-in deflate
+ * implementation is used
  * Returns 1 if successful or -1 on error
  */
 int libewf_checksum_calculate_adler32(
@@ -68,8 +588,49 @@ int libewf_checksum_calculate_adler32(
 
 		return( -1 );
 	}
-	if( ( size > (size_t) UINT_MAX )
-	 || ( size > (size_t) SSIZE_MAX ) )
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD_SUPPORT )
+	if( __builtin_cpu_supports( "avx2" ) )
+	{
+		*checksum_value = libewf_checksum_calculate_adler32_avx2(
+		                   buffer,
+		                   size,
+		                   initial_value );
+
+		return( 1 );
+	}
+	else if( __builtin_cpu_supports( "ssse3" ) )
+	{
+		*checksum_value = libewf_checksum_calculate_adler32_ssse3(
+		                   buffer,
+		                   size,
+		                   initial_value );
+
+		return( 1 );
+	}
+	else if( __builtin_cpu_supports( "sse2" ) )
+	{
+		*checksum_value = libewf_checksum_calculate_adler32_sse2(
+		                   buffer,
+		                   size,
+		                   initial_value );
+
+		return( 1 );
+	}
+#endif /* defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD_SUPPORT ) */
+
+#if defined( HAVE_ZLIB_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+	if( size > (size_t) UINT_MAX )
 	{
 		libcerror_error_set(
 		 error,
@@ -86,7 +647,197 @@ int libewf_checksum_calculate_adler32(
 	                   (uInt) size );
 
 	return( 1 );
+#else
+	return( libewf_deflate_calculate_adler32(
+	         checksum_value,
+	         buffer,
+	         size,
+	         initial_value,
+	         error ) );
+#endif /* defined( HAVE_ZLIB_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) */
 }
 
-#endif /* defined( HAVE_ZLIB_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) */
+/* Calculates the little-endian Adler-32 of a buffer and compares the buffer against
+ * the 64-bit pattern in its first 8 bytes in a single pass over the buffer
+ * It uses the initial value to calculate a new Adler-32
+ * Pattern matches is set to 1 if every byte equals the byte at the same offset modulo 8
+ * within the first 8 bytes, which is always the case for a buffer of 8 bytes or less
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_checksum_calculate_adler32_and_compare_64_bit_pattern(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value,
+     uint8_t *pattern_matches,
+     libcerror_error_t **error )
+{
+	static char *function        = "libewf_checksum_calculate_adler32_and_compare_64_bit_pattern";
+	size_t block_size            = 0;
+	size_t buffer_offset         = 0;
+	uint32_t safe_checksum_value = 0;
+	uint8_t safe_pattern_matches = 0;
 
+	if( checksum_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checksum value.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( pattern_matches == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pattern matches.",
+		 function );
+
+		return( -1 );
+	}
+	/* Most data does not contain a fill pattern, which can be determined from
+	 * the start of the buffer without the overhead of the combined pass
+	 */
+	if( size > 8 )
+	{
+		block_size = size;
+
+		if( block_size > 64 )
+		{
+			block_size = 64;
+		}
+		if( memory_compare(
+		     buffer,
+		     &( buffer[ 8 ] ),
+		     block_size - 8 ) != 0 )
+		{
+			if( libewf_checksum_calculate_adler32(
+			     checksum_value,
+			     buffer,
+			     size,
+			     initial_value,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to calculate checksum.",
+				 function );
+
+				return( -1 );
+			}
+			*pattern_matches = 0;
+
+			return( 1 );
+		}
+	}
+#if defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD_SUPPORT )
+	if( size >= 8 )
+	{
+		if( __builtin_cpu_supports( "avx2" ) )
+		{
+			*checksum_value = libewf_checksum_calculate_adler32_and_compare_64_bit_pattern_avx2(
+			                   buffer,
+			                   size,
+			                   initial_value,
+			                   pattern_matches );
+
+			return( 1 );
+		}
+		else if( __builtin_cpu_supports( "ssse3" ) )
+		{
+			*checksum_value = libewf_checksum_calculate_adler32_and_compare_64_bit_pattern_ssse3(
+			                   buffer,
+			                   size,
+			                   initial_value,
+			                   pattern_matches );
+
+			return( 1 );
+		}
+	}
+#endif /* defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD_SUPPORT ) */
+
+	/* Process the buffer in blocks that fit in the CPU cache, so that the buffer
+	 * is only read once from memory, every byte is compared against the byte
+	 * 8 bytes before it while the pattern matches
+	 */
+	safe_checksum_value  = initial_value;
+	safe_pattern_matches = 1;
+
+	while( buffer_offset < size )
+	{
+		block_size = size - buffer_offset;
+
+		if( block_size > LIBEWF_CHECKSUM_CACHE_BLOCK_SIZE )
+		{
+			block_size = LIBEWF_CHECKSUM_CACHE_BLOCK_SIZE;
+		}
+		if( ( safe_pattern_matches != 0 )
+		 && ( ( buffer_offset + block_size ) > 8 ) )
+		{
+			if( buffer_offset == 0 )
+			{
+				safe_pattern_matches = (uint8_t) ( memory_compare(
+				                                    buffer,
+				                                    &( buffer[ 8 ] ),
+				                                    block_size - 8 ) == 0 );
+			}
+			else
+			{
+				safe_pattern_matches = (uint8_t) ( memory_compare(
+				                                    &( buffer[ buffer_offset - 8 ] ),
+				                                    &( buffer[ buffer_offset ] ),
+				                                    block_size ) == 0 );
+			}
+		}
+		if( libewf_checksum_calculate_adler32(
+		     &safe_checksum_value,
+		     &( buffer[ buffer_offset ] ),
+		     block_size,
+		     safe_checksum_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to calculate checksum.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset += block_size;
+	}
+	*checksum_value  = safe_checksum_value;
+	*pattern_matches = safe_pattern_matches;
+
+	return( 1 );
+}
@@ -32,7 +32,47 @@
 extern "C" {
 #endif
 
-#if defined( HAVE_ZLIB_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+/* The size of the blocks in which a buffer is processed to keep it in the CPU cache
+ */
+#define LIBEWF_CHECKSUM_CACHE_BLOCK_SIZE		4096
+
+/* The Adler-32 SIMD implementations require GCC 4.9 or later or Clang on x86
+ */
+#if defined( __GNUC__ ) && ( defined( __i386__ ) || defined( __x86_64__ ) ) \
+ && ( defined( __clang__ ) || ( __GNUC__ > 4 ) || ( ( __GNUC__ == 4 ) && ( __GNUC_MINOR__ >= 9 ) ) )
+#define HAVE_LIBEWF_CHECKSUM_X86_SIMD_SUPPORT	1
+#endif
+
+#if defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD_SUPPORT )
+
+uint32_t libewf_checksum_calculate_adler32_sse2(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value );
+
+uint32_t libewf_checksum_calculate_adler32_ssse3(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value );
+
+uint32_t libewf_checksum_calculate_adler32_avx2(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value );
+
+uint32_t libewf_checksum_calculate_adler32_and_compare_64_bit_pattern_ssse3(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value,
+          uint8_t *pattern_matches );
+
+uint32_t libewf_checksum_calculate_adler32_and_compare_64_bit_pattern_avx2(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value,
+          uint8_t *pattern_matches );
+
+#endif /* defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD_SUPPORT ) */
 
 int libewf_checksum_calculate_adler32(
      uint32_t *checksum_value,
@@ -41,11 +81,13 @@ int libewf_checksum_calculate_adler32(
      uint32_t initial_value,
      libcerror_error_t **error );
 
-#else
-#define libewf_checksum_calculate_adler32( checksum_value, buffer, size, initial_value, error ) \
-	libewf_deflate_calculate_adler32( checksum_value, buffer, size, initial_value, error )
-
-#endif /* defined( HAVE_ZLIB_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) */
+int libewf_checksum_calculate_adler32_and_compare_64_bit_pattern(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value,
+     uint8_t *pattern_matches,
+     libcerror_error_t **error );
 
 #if defined( __cplusplus )
 }
@@ -0,0 +1,1499 @@
+/*
+ * Chunk cache functions
+ *
+ * Copyright (C) 2006-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_cache.h"
+#include "libewf_chunk_data.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+/* Creates a chunk cache
+ * Make sure the value chunk_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_initialize(
+     libewf_chunk_cache_t **chunk_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_initialize";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_cache = memory_allocate_structure(
+	                libewf_chunk_cache_t );
+
+	if( *chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_cache,
+	     0,
+	     sizeof( libewf_chunk_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk cache.",
+		 function );
+
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+
+		return( -1 );
+	}
+	if( libewf_chunk_cache_allocate_entries(
+	     *chunk_cache,
+	     maximum_number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to allocate entries.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *chunk_cache )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *chunk_cache != NULL )
+	{
+		if( ( *chunk_cache )->ghost_hash_table != NULL )
+		{
+			memory_free(
+			 ( *chunk_cache )->ghost_hash_table );
+		}
+		if( ( *chunk_cache )->ghost_entries != NULL )
+		{
+			memory_free(
+			 ( *chunk_cache )->ghost_entries );
+		}
+		if( ( *chunk_cache )->hash_table != NULL )
+		{
+			memory_free(
+			 ( *chunk_cache )->hash_table );
+		}
+		if( ( *chunk_cache )->entries != NULL )
+		{
+			memory_free(
+			 ( *chunk_cache )->entries );
+		}
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_free(
+     libewf_chunk_cache_t **chunk_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_free";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *chunk_cache )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		for( entry_index = 0;
+		     entry_index < ( *chunk_cache )->maximum_number_of_entries;
+		     entry_index++ )
+		{
+			if( ( *chunk_cache )->entries[ entry_index ].chunk_data != NULL )
+			{
+				if( libewf_chunk_data_free(
+				     &( ( *chunk_cache )->entries[ entry_index ].chunk_data ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free chunk data of entry: %d.",
+					 function,
+					 entry_index );
+
+					result = -1;
+				}
+			}
+		}
+		memory_free(
+		 ( *chunk_cache )->ghost_hash_table );
+
+		memory_free(
+		 ( *chunk_cache )->ghost_entries );
+
+		memory_free(
+		 ( *chunk_cache )->hash_table );
+
+		memory_free(
+		 ( *chunk_cache )->entries );
+
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+	}
+	return( result );
+}
+
+/* Allocates the entries, hash table, ghost entries and ghost hash table of a chunk cache
+ * All entries are added to the free list. Previously allocated entries are not freed.
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_allocate_entries(
+     libewf_chunk_cache_t *chunk_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entries             = NULL;
+	libewf_chunk_cache_ghost_entry_t *ghost_entries = NULL;
+	int *ghost_hash_table                           = NULL;
+	int *hash_table                                 = NULL;
+	static char *function                           = "libewf_chunk_cache_allocate_entries";
+	size_t entries_size                             = 0;
+	size_t ghost_entries_size                       = 0;
+	size_t ghost_hash_table_size                    = 0;
+	size_t hash_table_size                          = 0;
+	int entry_index                                 = 0;
+	int ghost_entry_index                           = 0;
+	int maximum_number_of_ghost_entries             = 0;
+	int queue_type                                  = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_entries <= 0 )
+	 || ( (size_t) maximum_number_of_entries > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libewf_chunk_cache_entry_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	maximum_number_of_ghost_entries = maximum_number_of_entries / 2;
+
+	if( maximum_number_of_ghost_entries == 0 )
+	{
+		maximum_number_of_ghost_entries = 1;
+	}
+	entries_size          = sizeof( libewf_chunk_cache_entry_t ) * (size_t) maximum_number_of_entries;
+	hash_table_size       = sizeof( int ) * (size_t) maximum_number_of_entries;
+	ghost_entries_size    = sizeof( libewf_chunk_cache_ghost_entry_t ) * (size_t) maximum_number_of_ghost_entries;
+	ghost_hash_table_size = sizeof( int ) * (size_t) maximum_number_of_ghost_entries;
+
+	entries = (libewf_chunk_cache_entry_t *) memory_allocate(
+	                                          entries_size );
+
+	if( entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     entries,
+	     0,
+	     entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		goto on_error;
+	}
+	hash_table = (int *) memory_allocate(
+	                      hash_table_size );
+
+	if( hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hash table.",
+		 function );
+
+		goto on_error;
+	}
+	ghost_entries = (libewf_chunk_cache_ghost_entry_t *) memory_allocate(
+	                                                    ghost_entries_size );
+
+	if( ghost_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create ghost entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ghost_entries,
+	     0,
+	     ghost_entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear ghost entries.",
+		 function );
+
+		goto on_error;
+	}
+	ghost_hash_table = (int *) memory_allocate(
+	                            ghost_hash_table_size );
+
+	if( ghost_hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create ghost hash table.",
+		 function );
+
+		goto on_error;
+	}
+	for( entry_index = 0;
+	     entry_index < maximum_number_of_entries;
+	     entry_index++ )
+	{
+		hash_table[ entry_index ] = -1;
+
+		entries[ entry_index ].previous_entry_index  = -1;
+		entries[ entry_index ].next_entry_index      = entry_index + 1;
+		entries[ entry_index ].next_hash_entry_index = -1;
+	}
+	entries[ maximum_number_of_entries - 1 ].next_entry_index = -1;
+
+	for( ghost_entry_index = 0;
+	     ghost_entry_index < maximum_number_of_ghost_entries;
+	     ghost_entry_index++ )
+	{
+		ghost_hash_table[ ghost_entry_index ] = -1;
+
+		ghost_entries[ ghost_entry_index ].next_hash_entry_index = -1;
+	}
+	for( queue_type = 0;
+	     queue_type < 3;
+	     queue_type++ )
+	{
+		chunk_cache->first_entry_index[ queue_type ] = -1;
+		chunk_cache->last_entry_index[ queue_type ]  = -1;
+		chunk_cache->number_of_entries[ queue_type ] = 0;
+	}
+	chunk_cache->entries                         = entries;
+	chunk_cache->maximum_number_of_entries       = maximum_number_of_entries;
+	chunk_cache->hash_table                      = hash_table;
+	chunk_cache->first_free_entry_index          = 0;
+	chunk_cache->ghost_entries                   = ghost_entries;
+	chunk_cache->ghost_hash_table                = ghost_hash_table;
+	chunk_cache->maximum_number_of_ghost_entries = maximum_number_of_ghost_entries;
+	chunk_cache->ghost_entry_index               = 0;
+
+	return( 1 );
+
+on_error:
+	if( ghost_hash_table != NULL )
+	{
+		memory_free(
+		 ghost_hash_table );
+	}
+	if( ghost_entries != NULL )
+	{
+		memory_free(
+		 ghost_entries );
+	}
+	if( hash_table != NULL )
+	{
+		memory_free(
+		 hash_table );
+	}
+	if( entries != NULL )
+	{
+		memory_free(
+		 entries );
+	}
+	return( -1 );
+}
+
+/* Resizes a chunk cache
+ * Unreferenced entries are evicted when the cache shrinks, it is not possible
+ * to shrink the cache below the number of referenced entries
+ * The remaining entries keep their queue and order, the ghost entries are discarded
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_resize(
+     libewf_chunk_cache_t *chunk_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entries             = NULL;
+	libewf_chunk_cache_entry_t *entry               = NULL;
+	libewf_chunk_cache_ghost_entry_t *ghost_entries = NULL;
+	int *ghost_hash_table                           = NULL;
+	int *hash_table                                 = NULL;
+	static char *function                           = "libewf_chunk_cache_resize";
+	int entry_index                                 = 0;
+	int first_entry_index[ 3 ]                      = { -1, -1, -1 };
+	int new_entry_index                             = 0;
+	int number_of_entries                           = 0;
+	int result                                      = 1;
+	uint8_t queue_type                              = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_entries <= 0 )
+	 || ( (size_t) maximum_number_of_entries > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libewf_chunk_cache_entry_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	number_of_entries = chunk_cache->number_of_entries[ LIBEWF_CHUNK_CACHE_QUEUE_TYPE_PROBATIONARY ]
+	                  + chunk_cache->number_of_entries[ LIBEWF_CHUNK_CACHE_QUEUE_TYPE_PROTECTED ];
+
+	while( number_of_entries > maximum_number_of_entries )
+	{
+		entry_index = libewf_chunk_cache_get_eviction_entry_index(
+		               chunk_cache );
+
+		if( entry_index == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: unable to shrink cache below the number of referenced entries.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		if( libewf_chunk_cache_evict_entry(
+		     chunk_cache,
+		     entry_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to evict entry: %d.",
+			 function,
+			 entry_index );
+
+			result = -1;
+
+			break;
+		}
+		number_of_entries--;
+	}
+	if( result == 1 )
+	{
+		entries          = chunk_cache->entries;
+		hash_table       = chunk_cache->hash_table;
+		ghost_entries    = chunk_cache->ghost_entries;
+		ghost_hash_table = chunk_cache->ghost_hash_table;
+
+		first_entry_index[ LIBEWF_CHUNK_CACHE_QUEUE_TYPE_PROBATIONARY ] = chunk_cache->first_entry_index[ LIBEWF_CHUNK_CACHE_QUEUE_TYPE_PROBATIONARY ];
+		first_entry_index[ LIBEWF_CHUNK_CACHE_QUEUE_TYPE_PROTECTED ]    = chunk_cache->first_entry_index[ LIBEWF_CHUNK_CACHE_QUEUE_TYPE_PROTECTED ];
+
+		if( libewf_chunk_cache_allocate_entries(
+		     chunk_cache,
+		     maximum_number_of_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to allocate entries.",
+			 function );
+
+			/* The previous entries are left untouched on failure
+			 */
+			result = -1;
+		}
+		else
+		{
+			for( queue_type = LIBEWF_CHUNK_CACHE_QUEUE_TYPE_PROBATIONARY;
+			     queue_type <= LIBEWF_CHUNK_CACHE_QUEUE_TYPE_PROTECTED;
+			     queue_type++ )
+			{
+				entry_index = first_entry_index[ queue_type ];
+
+				while( entry_index != -1 )
+				{
+					entry = &( entries[ entry_index ] );
+
+					new_entry_index = libewf_chunk_cache_append_entry(
+					                   chunk_cache,
+					                   entry->chunk_index,
+					                   entry->chunk_data,
+					                   queue_type );
+
+					chunk_cache->entries[ new_entry_index ].number_of_references = entry->number_of_references;
+
+					entry_index = entry->next_entry_index;
+				}
+			}
+			memory_free(
+			 ghost_hash_table );
+
+			memory_free(
+			 ghost_entries );
+
+			memory_free(
+			 hash_table );
+
+			memory_free(
+			 entries );
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Empties a chunk cache
+ * Chunk data that is still referenced remains in the cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_empty(
+     libewf_chunk_cache_t *chunk_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_empty";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( entry_index = 0;
+	     entry_index < chunk_cache->maximum_number_of_entries;
+	     entry_index++ )
+	{
+		if( ( chunk_cache->entries[ entry_index ].queue_type != 0 )
+		 && ( chunk_cache->entries[ entry_index ].number_of_references == 0 ) )
+		{
+			if( libewf_chunk_cache_evict_entry(
+			     chunk_cache,
+			     entry_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to evict entry: %d.",
+				 function,
+				 entry_index );
+
+				result = -1;
+			}
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the chunk data of a specific chunk
+ * The chunk data is referenced and must be released with libewf_chunk_cache_release_chunk_data
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_chunk_cache_get_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	static char *function             = "libewf_chunk_cache_get_chunk_data";
+	int entry_index                   = 0;
+	int result                        = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	entry_index = libewf_chunk_cache_find_entry(
+	               chunk_cache,
+	               chunk_index );
+
+	if( entry_index != -1 )
+	{
+		entry = &( chunk_cache->entries[ entry_index ] );
+
+		/* Probationary entries are kept in insertion order so that repeated
+		 * access to the same chunk during a sequential read does not promote it
+		 */
+		if( entry->queue_type == LIBEWF_CHUNK_CACHE_QUEUE_TYPE_PROTECTED )
+		{
+			libewf_chunk_cache_queue_remove(
+			 chunk_cache,
+			 entry_index );
+
+			libewf_chunk_cache_queue_append(
+			 chunk_cache,
+			 entry_index,
+			 LIBEWF_CHUNK_CACHE_QUEUE_TYPE_PROTECTED );
+		}
+		entry->number_of_references += 1;
+
+		*chunk_data = entry->chunk_data;
+
+		result = 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the chunk data of a specific chunk
+ * If successful the cache takes over the management of the chunk data. When the cache
+ * already contains chunk data of the chunk the provided chunk data is freed instead.
+ * On return chunk data refers to the cached chunk data, which is referenced and must be
+ * released with libewf_chunk_cache_release_chunk_data
+ * Returns 1 if successful, 0 if no entry is available or -1 on error
+ */
+int libewf_chunk_cache_set_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_set_chunk_data";
+	int entry_index       = 0;
+	int result            = 1;
+	uint8_t queue_type    = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: missing chunk data.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	entry_index = libewf_chunk_cache_find_entry(
+	               chunk_cache,
+	               chunk_index );
+
+	if( entry_index != -1 )
+	{
+		/* Another thread has already cached the same chunk
+		 */
+		if( libewf_chunk_data_free(
+		     chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data.",
+			 function );
+
+			result = -1;
+		}
+		else if( chunk_cache->entries[ entry_index ].queue_type == LIBEWF_CHUNK_CACHE_QUEUE_TYPE_PROTECTED )
+		{
+			libewf_chunk_cache_queue_remove(
+			 chunk_cache,
+			 entry_index );
+
+			libewf_chunk_cache_queue_append(
+			 chunk_cache,
+			 entry_index,
+			 LIBEWF_CHUNK_CACHE_QUEUE_TYPE_PROTECTED );
+		}
+	}
+	else
+	{
+		if( chunk_cache->first_free_entry_index == -1 )
+		{
+			entry_index = libewf_chunk_cache_get_eviction_entry_index(
+			               chunk_cache );
+
+			if( entry_index == -1 )
+			{
+				/* All entries are referenced, the caller retains the chunk data
+				 */
+				result = 0;
+			}
+			else if( libewf_chunk_cache_evict_entry(
+			          chunk_cache,
+			          entry_index,
+			          error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to evict entry: %d.",
+				 function,
+				 entry_index );
+
+				result = -1;
+			}
+		}
+		if( result == 1 )
+		{
+			/* A chunk that was recently evicted from the probationary queue
+			 * is part of the working set and goes into the protected queue
+			 */
+			if( libewf_chunk_cache_remove_ghost_entry(
+			     chunk_cache,
+			     chunk_index ) != 0 )
+			{
+				queue_type = LIBEWF_CHUNK_CACHE_QUEUE_TYPE_PROTECTED;
+			}
+			else
+			{
+				queue_type = LIBEWF_CHUNK_CACHE_QUEUE_TYPE_PROBATIONARY;
+			}
+			entry_index = libewf_chunk_cache_append_entry(
+			               chunk_cache,
+			               chunk_index,
+			               *chunk_data,
+			               queue_type );
+		}
+	}
+	if( result == 1 )
+	{
+		chunk_cache->entries[ entry_index ].number_of_references += 1;
+
+		*chunk_data = chunk_cache->entries[ entry_index ].chunk_data;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Releases a reference to cached chunk data
+ * Returns 1 if successful, 0 if the chunk data is not cached or -1 on error
+ */
+int libewf_chunk_cache_release_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	static char *function             = "libewf_chunk_cache_release_chunk_data";
+	int entry_index                   = 0;
+	int result                        = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	entry_index = libewf_chunk_cache_find_entry(
+	               chunk_cache,
+	               chunk_data->chunk_index );
+
+	if( ( entry_index != -1 )
+	 && ( chunk_cache->entries[ entry_index ].chunk_data != chunk_data ) )
+	{
+		entry_index = -1;
+	}
+	/* Fall back to a full scan when the chunk index of the chunk data
+	 * does not correspond with the chunk index it was cached under
+	 */
+	if( entry_index == -1 )
+	{
+		for( entry_index = chunk_cache->maximum_number_of_entries - 1;
+		     entry_index >= 0;
+		     entry_index-- )
+		{
+			if( chunk_cache->entries[ entry_index ].chunk_data == chunk_data )
+			{
+				break;
+			}
+		}
+	}
+	if( entry_index != -1 )
+	{
+		entry = &( chunk_cache->entries[ entry_index ] );
+
+		if( entry->number_of_references <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid entry: %d - number of references value out of bounds.",
+			 function,
+			 entry_index );
+
+			result = -1;
+		}
+		else
+		{
+			entry->number_of_references -= 1;
+
+			result = 1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Finds the entry of a specific chunk
+ * This function is not multi-thread safe acquire the mutex before call
+ * Returns the entry index or -1 if not available
+ */
+int libewf_chunk_cache_find_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index )
+{
+	int entry_index = 0;
+
+	entry_index = chunk_cache->hash_table[ chunk_index % (uint64_t) chunk_cache->maximum_number_of_entries ];
+
+	while( entry_index != -1 )
+	{
+		if( chunk_cache->entries[ entry_index ].chunk_index == chunk_index )
+		{
+			break;
+		}
+		entry_index = chunk_cache->entries[ entry_index ].next_hash_entry_index;
+	}
+	return( entry_index );
+}
+
+/* Appends an entry to the end (newest side) of a queue
+ * This function is not multi-thread safe acquire the mutex before call
+ */
+void libewf_chunk_cache_queue_append(
+      libewf_chunk_cache_t *chunk_cache,
+      int entry_index,
+      uint8_t queue_type )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	int last_entry_index              = 0;
+
+	entry            = &( chunk_cache->entries[ entry_index ] );
+	last_entry_index = chunk_cache->last_entry_index[ queue_type ];
+
+	entry->queue_type           = queue_type;
+	entry->previous_entry_index = last_entry_index;
+	entry->next_entry_index     = -1;
+
+	if( last_entry_index == -1 )
+	{
+		chunk_cache->first_entry_index[ queue_type ] = entry_index;
+	}
+	else
+	{
+		chunk_cache->entries[ last_entry_index ].next_entry_index = entry_index;
+	}
+	chunk_cache->last_entry_index[ queue_type ] = entry_index;
+
+	chunk_cache->number_of_entries[ queue_type ] += 1;
+}
+
+/* Removes an entry from its queue
+ * This function is not multi-thread safe acquire the mutex before call
+ */
+void libewf_chunk_cache_queue_remove(
+      libewf_chunk_cache_t *chunk_cache,
+      int entry_index )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	uint8_t queue_type                = 0;
+
+	entry      = &( chunk_cache->entries[ entry_index ] );
+	queue_type = entry->queue_type;
+
+	if( entry->previous_entry_index == -1 )
+	{
+		chunk_cache->first_entry_index[ queue_type ] = entry->next_entry_index;
+	}
+	else
+	{
+		chunk_cache->entries[ entry->previous_entry_index ].next_entry_index = entry->next_entry_index;
+	}
+	if( entry->next_entry_index == -1 )
+	{
+		chunk_cache->last_entry_index[ queue_type ] = entry->previous_entry_index;
+	}
+	else
+	{
+		chunk_cache->entries[ entry->next_entry_index ].previous_entry_index = entry->previous_entry_index;
+	}
+	entry->previous_entry_index = -1;
+	entry->next_entry_index     = -1;
+
+	chunk_cache->number_of_entries[ queue_type ] -= 1;
+}
+
+/* Appends an entry to the cache using the first free entry
+ * The chunk data is not referenced
+ * This function is not multi-thread safe acquire the mutex before call
+ * Returns the entry index or -1 if no free entry is available
+ */
+int libewf_chunk_cache_append_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     uint8_t queue_type )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	int entry_index                   = 0;
+	int hash_index                    = 0;
+
+	entry_index = chunk_cache->first_free_entry_index;
+
+	if( entry_index == -1 )
+	{
+		return( -1 );
+	}
+	entry = &( chunk_cache->entries[ entry_index ] );
+
+	chunk_cache->first_free_entry_index = entry->next_entry_index;
+
+	hash_index = (int) ( chunk_index % (uint64_t) chunk_cache->maximum_number_of_entries );
+
+	entry->chunk_index           = chunk_index;
+	entry->chunk_data            = chunk_data;
+	entry->number_of_references  = 0;
+	entry->next_hash_entry_index = chunk_cache->hash_table[ hash_index ];
+
+	chunk_cache->hash_table[ hash_index ] = entry_index;
+
+	libewf_chunk_cache_queue_append(
+	 chunk_cache,
+	 entry_index,
+	 queue_type );
+
+	return( entry_index );
+}
+
+/* Removes an entry from the cache and adds it to the free list
+ * The chunk data is not freed
+ * This function is not multi-thread safe acquire the mutex before call
+ */
+void libewf_chunk_cache_remove_entry(
+      libewf_chunk_cache_t *chunk_cache,
+      int entry_index )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	int hash_entry_index              = 0;
+	int hash_index                    = 0;
+
+	entry = &( chunk_cache->entries[ entry_index ] );
+
+	libewf_chunk_cache_queue_remove(
+	 chunk_cache,
+	 entry_index );
+
+	hash_index       = (int) ( entry->chunk_index % (uint64_t) chunk_cache->maximum_number_of_entries );
+	hash_entry_index = chunk_cache->hash_table[ hash_index ];
+
+	if( hash_entry_index == entry_index )
+	{
+		chunk_cache->hash_table[ hash_index ] = entry->next_hash_entry_index;
+	}
+	else
+	{
+		while( hash_entry_index != -1 )
+		{
+			if( chunk_cache->entries[ hash_entry_index ].next_hash_entry_index == entry_index )
+			{
+				chunk_cache->entries[ hash_entry_index ].next_hash_entry_index = entry->next_hash_entry_index;
+
+				break;
+			}
+			hash_entry_index = chunk_cache->entries[ hash_entry_index ].next_hash_entry_index;
+		}
+	}
+	entry->chunk_index           = 0;
+	entry->chunk_data            = NULL;
+	entry->number_of_references  = 0;
+	entry->queue_type            = 0;
+	entry->next_hash_entry_index = -1;
+	entry->next_entry_index      = chunk_cache->first_free_entry_index;
+
+	chunk_cache->first_free_entry_index = entry_index;
+}
+
+/* Determines the index of the entry to evict
+ * The oldest probationary entry is evicted while the probationary queue exceeds
+ * a quarter of the cache, otherwise the least recently used protected entry is
+ * evicted. Referenced entries are never evicted.
+ * This function is not multi-thread safe acquire the mutex before call
+ * Returns the entry index or -1 if no entry can be evicted
+ */
+int libewf_chunk_cache_get_eviction_entry_index(
+     libewf_chunk_cache_t *chunk_cache )
+{
+	int maximum_number_of_probationary_entries = 0;
+	int probationary_entry_index               = 0;
+	int protected_entry_index                  = 0;
+
+	probationary_entry_index = chunk_cache->first_entry_index[ LIBEWF_CHUNK_CACHE_QUEUE_TYPE_PROBATIONARY ];
+
+	while( ( probationary_entry_index != -1 )
+	    && ( chunk_cache->entries[ probationary_entry_index ].number_of_references != 0 ) )
+	{
+		probationary_entry_index = chunk_cache->entries[ probationary_entry_index ].next_entry_index;
+	}
+	protected_entry_index = chunk_cache->first_entry_index[ LIBEWF_CHUNK_CACHE_QUEUE_TYPE_PROTECTED ];
+
+	while( ( protected_entry_index != -1 )
+	    && ( chunk_cache->entries[ protected_entry_index ].number_of_references != 0 ) )
+	{
+		protected_entry_index = chunk_cache->entries[ protected_entry_index ].next_entry_index;
+	}
+	maximum_number_of_probationary_entries = chunk_cache->maximum_number_of_entries / 4;
+
+	if( maximum_number_of_probationary_entries == 0 )
+	{
+		maximum_number_of_probationary_entries = 1;
+	}
+	if( ( probationary_entry_index != -1 )
+	 && ( ( chunk_cache->number_of_entries[ LIBEWF_CHUNK_CACHE_QUEUE_TYPE_PROBATIONARY ] > maximum_number_of_probationary_entries )
+	  ||  ( protected_entry_index == -1 ) ) )
+	{
+		return( probationary_entry_index );
+	}
+	if( protected_entry_index != -1 )
+	{
+		return( protected_entry_index );
+	}
+	return( probationary_entry_index );
+}
+
+/* Evicts an entry
+ * The chunk index of an evicted probationary entry is remembered as a ghost entry
+ * This function is not multi-thread safe acquire the mutex before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_evict_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     int entry_index,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	static char *function             = "libewf_chunk_cache_evict_entry";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_index < 0 )
+	 || ( entry_index >= chunk_cache->maximum_number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	entry = &( chunk_cache->entries[ entry_index ] );
+
+	if( entry->queue_type == 0 )
+	{
+		return( 1 );
+	}
+	if( entry->number_of_references != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry: %d - number of references value out of bounds.",
+		 function,
+		 entry_index );
+
+		return( -1 );
+	}
+	if( libewf_chunk_data_free(
+	     &( entry->chunk_data ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free chunk data of entry: %d.",
+		 function,
+		 entry_index );
+
+		return( -1 );
+	}
+	if( entry->queue_type == LIBEWF_CHUNK_CACHE_QUEUE_TYPE_PROBATIONARY )
+	{
+		libewf_chunk_cache_append_ghost_entry(
+		 chunk_cache,
+		 entry->chunk_index );
+	}
+	libewf_chunk_cache_remove_entry(
+	 chunk_cache,
+	 entry_index );
+
+	return( 1 );
+}
+
+/* Appends a ghost entry
+ * The oldest ghost entry is overwritten when all ghost entries are used
+ * This function is not multi-thread safe acquire the mutex before call
+ */
+void libewf_chunk_cache_append_ghost_entry(
+      libewf_chunk_cache_t *chunk_cache,
+      uint64_t chunk_index )
+{
+	libewf_chunk_cache_ghost_entry_t *ghost_entry = NULL;
+	int ghost_entry_index                         = 0;
+	int hash_index                                = 0;
+
+	ghost_entry_index = chunk_cache->ghost_entry_index;
+	ghost_entry       = &( chunk_cache->ghost_entries[ ghost_entry_index ] );
+
+	if( ghost_entry->chunk_index != 0 )
+	{
+		libewf_chunk_cache_unlink_ghost_entry(
+		 chunk_cache,
+		 ghost_entry_index );
+	}
+	hash_index = (int) ( chunk_index % (uint64_t) chunk_cache->maximum_number_of_ghost_entries );
+
+	ghost_entry->chunk_index           = chunk_index + 1;
+	ghost_entry->next_hash_entry_index = chunk_cache->ghost_hash_table[ hash_index ];
+
+	chunk_cache->ghost_hash_table[ hash_index ] = ghost_entry_index;
+
+	chunk_cache->ghost_entry_index += 1;
+
+	if( chunk_cache->ghost_entry_index >= chunk_cache->maximum_number_of_ghost_entries )
+	{
+		chunk_cache->ghost_entry_index = 0;
+	}
+}
+
+/* Unlinks a used ghost entry from the ghost hash table and marks it as unused
+ * This function is not multi-thread safe acquire the mutex before call
+ */
+void libewf_chunk_cache_unlink_ghost_entry(
+      libewf_chunk_cache_t *chunk_cache,
+      int ghost_entry_index )
+{
+	libewf_chunk_cache_ghost_entry_t *ghost_entry = NULL;
+	int hash_entry_index                          = 0;
+	int hash_index                                = 0;
+
+	ghost_entry = &( chunk_cache->ghost_entries[ ghost_entry_index ] );
+
+	hash_index       = (int) ( ( ghost_entry->chunk_index - 1 ) % (uint64_t) chunk_cache->maximum_number_of_ghost_entries );
+	hash_entry_index = chunk_cache->ghost_hash_table[ hash_index ];
+
+	if( hash_entry_index == ghost_entry_index )
+	{
+		chunk_cache->ghost_hash_table[ hash_index ] = ghost_entry->next_hash_entry_index;
+	}
+	else
+	{
+		while( hash_entry_index != -1 )
+		{
+			if( chunk_cache->ghost_entries[ hash_entry_index ].next_hash_entry_index == ghost_entry_index )
+			{
+				chunk_cache->ghost_entries[ hash_entry_index ].next_hash_entry_index = ghost_entry->next_hash_entry_index;
+
+				break;
+			}
+			hash_entry_index = chunk_cache->ghost_entries[ hash_entry_index ].next_hash_entry_index;
+		}
+	}
+	ghost_entry->chunk_index           = 0;
+	ghost_entry->next_hash_entry_index = -1;
+}
+
+/* Removes a ghost entry
+ * This function is not multi-thread safe acquire the mutex before call
+ * Returns 1 if successful or 0 if no such ghost entry
+ */
+int libewf_chunk_cache_remove_ghost_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index )
+{
+	int ghost_entry_index = 0;
+
+	ghost_entry_index = chunk_cache->ghost_hash_table[ chunk_index % (uint64_t) chunk_cache->maximum_number_of_ghost_entries ];
+
+	while( ghost_entry_index != -1 )
+	{
+		if( chunk_cache->ghost_entries[ ghost_entry_index ].chunk_index == ( chunk_index + 1 ) )
+		{
+			libewf_chunk_cache_unlink_ghost_entry(
+			 chunk_cache,
+			 ghost_entry_index );
+
+			return( 1 );
+		}
+		ghost_entry_index = chunk_cache->ghost_entries[ ghost_entry_index ].next_hash_entry_index;
+	}
+	return( 0 );
+}
@@ -0,0 +1,233 @@
+/*
+ * Chunk cache functions
+ *
+ * Copyright (C) 2006-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_CACHE_H )
+#define _LIBEWF_CHUNK_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_chunk_cache_entry libewf_chunk_cache_entry_t;
+
+struct libewf_chunk_cache_entry
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The chunk data
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The number of references (pins)
+	 */
+	int number_of_references;
+
+	/* The queue type, 0 if the entry is not used
+	 */
+	uint8_t queue_type;
+
+	/* The index of the previous entry in the queue
+	 */
+	int previous_entry_index;
+
+	/* The index of the next entry in the queue or in the free list
+	 */
+	int next_entry_index;
+
+	/* The index of the next entry with the same hash
+	 */
+	int next_hash_entry_index;
+};
+
+typedef struct libewf_chunk_cache_ghost_entry libewf_chunk_cache_ghost_entry_t;
+
+struct libewf_chunk_cache_ghost_entry
+{
+	/* The chunk index + 1, where 0 represents an unused ghost entry
+	 */
+	uint64_t chunk_index;
+
+	/* The index of the next ghost entry with the same hash
+	 */
+	int next_hash_entry_index;
+};
+
+typedef struct libewf_chunk_cache libewf_chunk_cache_t;
+
+/* The chunk cache uses a 2Q replacement policy
+ * New chunks enter the probationary queue, which is evicted in insertion order.
+ * A chunk that is read again shortly after it was evicted from the probationary
+ * queue enters the protected queue, which is evicted in least recently used order.
+ * A sequential read therefore only cycles through the probationary queue and
+ * does not flush the working set in the protected queue.
+ */
+struct libewf_chunk_cache
+{
+	/* The entries
+	 */
+	libewf_chunk_cache_entry_t *entries;
+
+	/* The maximum number of entries
+	 */
+	int maximum_number_of_entries;
+
+	/* The hash table, contains the index of the first entry per hash
+	 */
+	int *hash_table;
+
+	/* The index of the first free entry
+	 */
+	int first_free_entry_index;
+
+	/* The index of the first (oldest) entry per queue type
+	 */
+	int first_entry_index[ 3 ];
+
+	/* The index of the last (newest) entry per queue type
+	 */
+	int last_entry_index[ 3 ];
+
+	/* The number of entries per queue type
+	 */
+	int number_of_entries[ 3 ];
+
+	/* The ghost entries, the chunk indexes of recently evicted probationary entries
+	 * The ghost entries are used as a ring buffer, where the oldest ghost entry is overwritten
+	 */
+	libewf_chunk_cache_ghost_entry_t *ghost_entries;
+
+	/* The ghost hash table, contains the index of the first ghost entry per hash
+	 */
+	int *ghost_hash_table;
+
+	/* The maximum number of ghost entries
+	 */
+	int maximum_number_of_ghost_entries;
+
+	/* The next ghost entry index
+	 */
+	int ghost_entry_index;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libewf_chunk_cache_initialize(
+     libewf_chunk_cache_t **chunk_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_free(
+     libewf_chunk_cache_t **chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_allocate_entries(
+     libewf_chunk_cache_t *chunk_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_resize(
+     libewf_chunk_cache_t *chunk_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_empty(
+     libewf_chunk_cache_t *chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_set_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_release_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_find_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index );
+
+void libewf_chunk_cache_queue_append(
+      libewf_chunk_cache_t *chunk_cache,
+      int entry_index,
+      uint8_t queue_type );
+
+void libewf_chunk_cache_queue_remove(
+      libewf_chunk_cache_t *chunk_cache,
+      int entry_index );
+
+int libewf_chunk_cache_append_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     uint8_t queue_type );
+
+void libewf_chunk_cache_remove_entry(
+      libewf_chunk_cache_t *chunk_cache,
+      int entry_index );
+
+int libewf_chunk_cache_get_eviction_entry_index(
+     libewf_chunk_cache_t *chunk_cache );
+
+int libewf_chunk_cache_evict_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     int entry_index,
+     libcerror_error_t **error );
+
+void libewf_chunk_cache_append_ghost_entry(
+      libewf_chunk_cache_t *chunk_cache,
+      uint64_t chunk_index );
+
+void libewf_chunk_cache_unlink_ghost_entry(
+      libewf_chunk_cache_t *chunk_cache,
+      int ghost_entry_index );
+
+int libewf_chunk_cache_remove_ghost_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_CACHE_H ) */
+
@@ -26,12 +26,13 @@
 
 #include "libewf_checksum.h"
 #include "libewf_chunk_data.h"
-#include "libewf_compression.h"
+#include "libewf_compression_context.h"
 #include "libewf_definitions.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
 #include "libewf_libcnotify.h"
 #include "libewf_libfdata.h"
+#include "libewf_libhmac.h"
 #include "libewf_types.h"
 #include "libewf_unused.h"
 
@@ -399,6 +400,70 @@ ssize_t libewf_chunk_data_write_buffer(
 	return( (ssize_t) buffer_size );
 }
 
+/* Calculates the digest of the chunk data
+ * The digest is calculated over the unpacked chunk data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_calculate_digest(
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_calculate_digest";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk data - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk data - data is packed.",
+		 function );
+
+		return( -1 );
+	}
+	if( libhmac_sha256_calculate(
+	     chunk_data->data,
+	     chunk_data->data_size,
+	     chunk_data->digest,
+	     LIBEWF_CHUNK_DATA_DIGEST_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate digest.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_data->digest_is_set = 1;
+
+	return( 1 );
+}
+
 /* Determines the pack flags as part of packing the chunk data
  * Returns 1 if successful or -1 on error
  */
@@ -410,6 +475,9 @@ int libewf_chunk_data_pack_determine_pack_flags(
 {
 	static char *function   = "libewf_chunk_data_pack_determine_pack_flags";
 	uint64_t fill_pattern   = 0;
+	size_t compare_size     = 0;
+	uint32_t checksum       = 0;
+	uint8_t pattern_matches = 0;
 	uint8_t safe_pack_flags = 0;
 	int result              = 0;
 
@@ -468,10 +536,75 @@ int libewf_chunk_data_pack_determine_pack_flags(
 
 		return( -1 );
 	}
-	safe_pack_flags = *pack_flags;
+	safe_pack_flags = *pack_flags & ~( LIBEWF_PACK_FLAG_CHECKSUM_CALCULATED );
+
+	/* Without compression the checksum is needed for every chunk that is not
+	 * an empty block or pattern fill, hence the checksum is calculated in the
+	 * same pass over the chunk data as the fill pattern check
+	 */
+	if( ( ( safe_pack_flags & LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM ) != 0 )
+	 && ( io_handle->compression_level == LIBEWF_COMPRESSION_LEVEL_NONE )
+	 && ( ( io_handle->compression_flags & ( LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION | LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION ) ) != 0 ) )
+	{
+		if( libewf_checksum_calculate_adler32_and_compare_64_bit_pattern(
+		     &checksum,
+		     chunk_data->data,
+		     chunk_data->data_size,
+		     1,
+		     &pattern_matches,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if chunk data contains a fill pattern.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION ) != 0 )
+		 && ( ( chunk_data->data_size % 8 ) == 0 ) )
+		{
+			if( ( pattern_matches != 0 )
+			 && ( chunk_data->data_size > 8 ) )
+			{
+				safe_pack_flags &= ~( LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM | LIBEWF_PACK_FLAG_ADD_ALIGNMENT_PADDING );
+				safe_pack_flags |= LIBEWF_PACK_FLAG_FORCE_COMPRESSION | LIBEWF_PACK_FLAG_USE_PATTERN_FILL_COMPRESSION;
+			}
+		}
+		else if( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) != 0 )
+		{
+			/* The chunk data is an empty block if it repeats its first 8 bytes
+			 * and these are all the same
+			 */
+			compare_size = chunk_data->data_size;
+
+			if( compare_size > 8 )
+			{
+				compare_size = 8;
+			}
+			if( ( pattern_matches != 0 )
+			 && ( compare_size > 0 )
+			 && ( chunk_data->data[ 0 ] == 0 )
+			 && ( memory_compare(
+			       chunk_data->data,
+			       &( chunk_data->data[ 1 ] ),
+			       compare_size - 1 ) == 0 ) )
+			{
+				safe_pack_flags &= ~( LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM );
+				safe_pack_flags |= LIBEWF_PACK_FLAG_FORCE_COMPRESSION | LIBEWF_PACK_FLAG_USE_EMPTY_BLOCK_COMPRESSION;
+			}
+		}
+		if( ( safe_pack_flags & LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM ) != 0 )
+		{
+			chunk_data->checksum = checksum;
 
-	if( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION ) != 0 )
-	 && ( ( chunk_data->data_size % 8 ) == 0 ) )
+			safe_pack_flags |= LIBEWF_PACK_FLAG_CHECKSUM_CALCULATED;
+		}
+	}
+	else if( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION ) != 0 )
+	      && ( ( chunk_data->data_size % 8 ) == 0 ) )
 	{
 		result = libewf_chunk_data_check_for_64_bit_pattern_fill(
 			  chunk_data->data,
@@ -839,6 +972,7 @@ int libewf_chunk_data_pack_with_compression(
 {
 	static char *function            = "libewf_chunk_data_pack_with_compression";
 	size_t safe_compressed_data_size = 0;
+	int8_t chunk_compression_level   = 0;
 	int8_t compression_level         = 0;
 	int result                       = 0;
 
@@ -887,8 +1021,6 @@ int libewf_chunk_data_pack_with_compression(
 
 		return( -1 );
 	}
-/* TODO add a light weight entropy test to assess if compression makes sense */
-
 	chunk_data->compressed_data_size = chunk_data->chunk_size;
 
 	/* EWF-S01 allows to have compressed chunks larger than the chunk size, a factor 2 should suffice
@@ -917,12 +1049,33 @@ int libewf_chunk_data_pack_with_compression(
 	 */
 	compression_level = io_handle->compression_level;
 
+	/* The chunk compression level can be changed by another thread while packing
+	 */
+	if( libewf_io_handle_get_chunk_compression_level(
+	     io_handle,
+	     &chunk_compression_level,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk compression level.",
+		 function );
+
+		goto on_error;
+	}
+	if( chunk_compression_level != LIBEWF_COMPRESSION_LEVEL_NONE )
+	{
+		compression_level = chunk_compression_level;
+	}
 	if( ( io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
 	 && ( compression_level == LIBEWF_COMPRESSION_LEVEL_NONE ) )
 	{
 		compression_level = LIBEWF_COMPRESSION_LEVEL_DEFAULT;
 	}
-	result = libewf_compress_data(
+	result = libewf_compression_context_pool_compress_data(
+		  io_handle->compression_context_pool,
 		  chunk_data->compressed_data,
 		  &safe_compressed_data_size,
 		  io_handle->compression_method,
@@ -1067,6 +1220,27 @@ int libewf_chunk_data_pack(
 
 		goto on_error;
 	}
+	/* The digest is only needed for chunk data that is not stored as
+	 * an empty block or pattern fill
+	 */
+	if( ( ( pack_flags & LIBEWF_PACK_FLAG_CALCULATE_DIGEST ) != 0 )
+	 && ( ( pack_flags & ( LIBEWF_PACK_FLAG_USE_EMPTY_BLOCK_COMPRESSION | LIBEWF_PACK_FLAG_USE_PATTERN_FILL_COMPRESSION ) ) == 0 )
+	 && ( chunk_data->digest_is_set == 0 ) )
+	{
+		if( libewf_chunk_data_calculate_digest(
+		     chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to calculate digest.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	/* Make sure range flags are cleared before usage.
 	 */
 	chunk_data->range_flags = 0;
@@ -1112,11 +1286,42 @@ int libewf_chunk_data_pack(
 		}
 		else
 		{
-			result = libewf_chunk_data_pack_with_compression(
-			          chunk_data,
-			          io_handle,
-			          error );
+			/* Unless compression is forced, skip compression of chunk data
+			 * that is predicted to be incompressible, such as encrypted data
+			 */
+			if( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_SKIP_INCOMPRESSIBLE_DATA ) != 0 )
+			 && ( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) == 0 ) )
+			{
+				result = libewf_chunk_data_check_for_incompressible_data(
+				          chunk_data->data,
+				          chunk_data->data_size,
+				          error );
 
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to determine if chunk data is incompressible.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( result == 1 )
+			{
+				/* Store the chunk data uncompressed
+				 */
+				result = 0;
+			}
+			else
+			{
+				result = libewf_chunk_data_pack_with_compression(
+				          chunk_data,
+				          io_handle,
+				          error );
+			}
 			if( result == -1 )
 			{
 				libcerror_error_set(
@@ -1167,21 +1372,24 @@ int libewf_chunk_data_pack(
 	}
 	else if( ( pack_flags & LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM ) != 0 )
 	{
-		if( libewf_checksum_calculate_adler32(
-		     &( chunk_data->checksum ),
-		     chunk_data->data,
-		     chunk_data->data_size,
-		     1,
-		     error ) != 1 )
+		if( ( pack_flags & LIBEWF_PACK_FLAG_CHECKSUM_CALCULATED ) == 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to calculate checksum.",
-			 function );
+			if( libewf_checksum_calculate_adler32(
+			     &( chunk_data->checksum ),
+			     chunk_data->data,
+			     chunk_data->data_size,
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to calculate checksum.",
+				 function );
 
-			goto on_error;
+				goto on_error;
+			}
 		}
 		if( ( chunk_data->data_size + 4 ) <= chunk_data->allocated_data_size )
 		{
@@ -1249,17 +1457,28 @@ on_error:
 	return( -1 );
 }
 
-/* Unpacks the chunk data
- * This function either validates the checksum or decompresses the chunk data
- * Returns 1 if successful or -1 on error
+/* Packs the chunk data using the compressed data of a reference chunk data
+ * The reference chunk data is the packed chunk data read from another image
+ * of the same media, its compressed data is only used when it unpacks into
+ * data that is identical to the chunk data. The Adler-32 checksum stored in
+ * the zlib stream of the reference chunk data is used to reject chunk data
+ * that differs without decompressing the reference chunk data.
+ * Returns 1 if the chunk data was packed, 0 if the reference chunk data cannot be used or -1 on error
  */
-int libewf_chunk_data_unpack(
+int libewf_chunk_data_pack_from_reference(
      libewf_chunk_data_t *chunk_data,
      libewf_io_handle_t *io_handle,
+     libewf_chunk_data_t *reference_chunk_data,
+     libewf_io_handle_t *reference_io_handle,
+     uint8_t pack_flags,
      libcerror_error_t **error )
 {
-	static char *function        = "libewf_chunk_data_unpack";
+	uint8_t *reference_data      = NULL;
+	static char *function        = "libewf_chunk_data_pack_from_reference";
+	size_t padding_size          = 0;
 	uint32_t calculated_checksum = 0;
+	uint32_t stored_checksum     = 0;
+	int result                   = 0;
 
 	if( chunk_data == NULL )
 	{
@@ -1294,64 +1513,349 @@ int libewf_chunk_data_unpack(
 
 		return( -1 );
 	}
-	if( ( chunk_data->chunk_size == 0 )
-	 || ( chunk_data->chunk_size > (size32_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE - 16 ) ) )
+	if( reference_chunk_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid chunk size value out of bounds.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reference chunk data.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) == 0 )
+	if( reference_chunk_data->data == NULL )
 	{
-		return( 1 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid reference chunk data - missing data.",
+		 function );
+
+		return( -1 );
 	}
-	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+	if( reference_io_handle == NULL )
 	{
-		if( chunk_data->compressed_data != NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: invalid chunk data - compressed data value already set.",
-			 function );
-
-			return( -1 );
-		}
-		chunk_data->compressed_data      = chunk_data->data;
-		chunk_data->compressed_data_size = chunk_data->data_size;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reference IO handle.",
+		 function );
 
-		/* Reserve 4 bytes for the checksum
-		 */
-		chunk_data->allocated_data_size = (size_t) ( chunk_data->chunk_size + 4 );
+		return( -1 );
+	}
+	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 )
+	{
+		return( 0 );
+	}
+	/* Only compressed data of a full chunk that uses the same compression method can be reused
+	 */
+	if( ( io_handle->compression_level == LIBEWF_COMPRESSION_LEVEL_NONE )
+	 || ( io_handle->compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
+	 || ( reference_io_handle->compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE ) )
+	{
+		return( 0 );
+	}
+	if( ( chunk_data->chunk_size != reference_chunk_data->chunk_size )
+	 || ( chunk_data->data_size != (size_t) chunk_data->chunk_size ) )
+	{
+		return( 0 );
+	}
+	if( ( reference_chunk_data->range_flags & ( LIBEWF_RANGE_FLAG_IS_PACKED | LIBEWF_RANGE_FLAG_IS_COMPRESSED | LIBEWF_RANGE_FLAG_USES_PATTERN_FILL | LIBEWF_RANGE_FLAG_IS_CORRUPTED ) ) != ( LIBEWF_RANGE_FLAG_IS_PACKED | LIBEWF_RANGE_FLAG_IS_COMPRESSED ) )
+	{
+		return( 0 );
+	}
+	/* The compressed data must fit in the chunk data including the alignment padding
+	 */
+	if( ( reference_chunk_data->data_size < 6 )
+	 || ( reference_chunk_data->data_size > ( chunk_data->allocated_data_size - 16 ) ) )
+	{
+		return( 0 );
+	}
+	/* Empty block and pattern fill chunk data are cheaper to pack than to compare
+	 */
+	if( libewf_chunk_data_pack_determine_pack_flags(
+	     chunk_data,
+	     io_handle,
+	     &pack_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine pack flags.",
+		 function );
 
-		/* The allocated data size should be rounded to the next 16-byte increment
-		 */
-		if( ( chunk_data->allocated_data_size % 16 ) != 0 )
-		{
-			chunk_data->allocated_data_size += 16;
-		}
-		chunk_data->allocated_data_size = ( chunk_data->allocated_data_size / 16 ) * 16;
+		goto on_error;
+	}
+	if( ( pack_flags & ( LIBEWF_PACK_FLAG_USE_EMPTY_BLOCK_COMPRESSION | LIBEWF_PACK_FLAG_USE_PATTERN_FILL_COMPRESSION ) ) != 0 )
+	{
+		return( 0 );
+	}
+	/* The zlib stream ends with the big-endian Adler-32 of the uncompressed data
+	 */
+	byte_stream_copy_to_uint32_big_endian(
+	 &( ( reference_chunk_data->data )[ reference_chunk_data->data_size - 4 ] ),
+	 stored_checksum );
 
-		chunk_data->data = (uint8_t *) memory_allocate(
-		                                sizeof( uint8_t ) * chunk_data->allocated_data_size );
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     chunk_data->data,
+	     chunk_data->data_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
 
-		if( chunk_data->data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create data.",
-			 function );
+		goto on_error;
+	}
+	if( stored_checksum != calculated_checksum )
+	{
+		return( 0 );
+	}
+	reference_data = (uint8_t *) memory_allocate(
+	                              sizeof( uint8_t ) * (size_t) reference_chunk_data->chunk_size );
+
+	if( reference_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create reference data.",
+		 function );
+
+		goto on_error;
+	}
+	result = libewf_chunk_data_unpack_to_buffer(
+	          reference_chunk_data,
+	          reference_io_handle,
+	          reference_data,
+	          (size_t) reference_chunk_data->chunk_size,
+	          error );
+
+	/* Reference chunk data that cannot be unpacked is not used
+	 */
+	if( result == -1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to unpack reference chunk data.\n",
+			 function );
+		}
+#endif
+		libcerror_error_free(
+		 error );
+
+		result = 0;
+	}
+	else if( result != 0 )
+	{
+		if( memory_compare(
+		     chunk_data->data,
+		     reference_data,
+		     chunk_data->data_size ) != 0 )
+		{
+			result = 0;
+		}
+	}
+	memory_free(
+	 reference_data );
+
+	reference_data = NULL;
+
+	if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( ( ( pack_flags & LIBEWF_PACK_FLAG_CALCULATE_DIGEST ) != 0 )
+	 && ( chunk_data->digest_is_set == 0 ) )
+	{
+		if( libewf_chunk_data_calculate_digest(
+		     chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to calculate digest.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( memory_copy(
+	     chunk_data->data,
+	     reference_chunk_data->data,
+	     reference_chunk_data->data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy reference chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	chunk_data->data_size = reference_chunk_data->data_size;
+
+	if( ( pack_flags & LIBEWF_PACK_FLAG_ADD_ALIGNMENT_PADDING ) != 0 )
+	{
+		padding_size = chunk_data->data_size % 16;
+
+		if( padding_size != 0 )
+		{
+			padding_size = 16 - padding_size;
+		}
+		if( memory_set(
+		     &( ( chunk_data->data )[ chunk_data->data_size ] ),
+		     0,
+		     padding_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear alignment padding.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	chunk_data->padding_size = padding_size;
+	chunk_data->range_flags  = LIBEWF_RANGE_FLAG_IS_COMPRESSED | LIBEWF_RANGE_FLAG_IS_PACKED;
+
+	return( 1 );
+
+on_error:
+	if( reference_data != NULL )
+	{
+		memory_free(
+		 reference_data );
+	}
+	return( -1 );
+}
+
+/* Unpacks the chunk data
+ * This function either validates the checksum or decompresses the chunk data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_unpack(
+     libewf_chunk_data_t *chunk_data,
+     libewf_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function        = "libewf_chunk_data_unpack";
+	uint32_t calculated_checksum = 0;
+	uint8_t data_flags           = 0;
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk data - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_data->chunk_size == 0 )
+	 || ( chunk_data->chunk_size > (size32_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE - 16 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) == 0 )
+	{
+		return( 1 );
+	}
+	data_flags = chunk_data->flags;
+
+	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+	{
+		if( chunk_data->compressed_data != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid chunk data - compressed data value already set.",
+			 function );
+
+			return( -1 );
+		}
+		chunk_data->compressed_data      = chunk_data->data;
+		chunk_data->compressed_data_size = chunk_data->data_size;
+
+		/* Reserve 4 bytes for the checksum
+		 */
+		chunk_data->allocated_data_size = (size_t) ( chunk_data->chunk_size + 4 );
+
+		/* The allocated data size should be rounded to the next 16-byte increment
+		 */
+		if( ( chunk_data->allocated_data_size % 16 ) != 0 )
+		{
+			chunk_data->allocated_data_size += 16;
+		}
+		chunk_data->allocated_data_size = ( chunk_data->allocated_data_size / 16 ) * 16;
+
+		chunk_data->data = (uint8_t *) memory_allocate(
+		                                sizeof( uint8_t ) * chunk_data->allocated_data_size );
+
+		if( chunk_data->data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create data.",
+			 function );
+
+			goto on_error;
+		}
+		chunk_data->flags |= LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
 
-			goto on_error;
-		}
 		if( memory_set(
 		     chunk_data->data,
 		     0,
@@ -1386,7 +1890,8 @@ int libewf_chunk_data_unpack(
 		}
 		else
 		{
-			if( libewf_decompress_data(
+			if( libewf_compression_context_pool_decompress_data(
+			     io_handle->compression_context_pool,
 			     chunk_data->compressed_data,
 			     chunk_data->compressed_data_size,
 			     io_handle->compression_method,
@@ -1419,6 +1924,13 @@ int libewf_chunk_data_unpack(
 				chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
 			}
 		}
+		/* The compressed data is not owned by the chunk data when it is memory mapped
+		 */
+		if( ( data_flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) == 0 )
+		{
+			chunk_data->compressed_data      = NULL;
+			chunk_data->compressed_data_size = 0;
+		}
 	}
 	else if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
 	{
@@ -1483,6 +1995,26 @@ int libewf_chunk_data_unpack(
 			libcerror_error_free(
 			 error );
 
+			/* Memory mapped data cannot be extended to the chunk size or zeroed
+			 */
+			if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) == 0 )
+			{
+				chunk_data->data_size += 4;
+
+				if( libewf_chunk_data_copy_to_managed_data(
+				     chunk_data,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+					 "%s: unable to copy chunk data to managed data.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			chunk_data->data_size    = (size_t) chunk_data->chunk_size;
 			chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
 		}
@@ -1519,6 +2051,7 @@ on_error:
 		}
 		chunk_data->data      = chunk_data->compressed_data;
 		chunk_data->data_size = chunk_data->compressed_data_size;
+		chunk_data->flags     = data_flags;
 
 		chunk_data->compressed_data      = NULL;
 		chunk_data->compressed_data_size = 0;
@@ -1526,6 +2059,180 @@ on_error:
 	return( -1 );
 }
 
+/* Unpacks the chunk data directly into a buffer
+ * The buffer must be able to contain the chunk size
+ * The chunk data itself is not modified, if 0 is returned the chunk data
+ * should be unpacked with libewf_chunk_data_unpack, for example when the
+ * data is corrupted or uses pattern fill
+ * Returns 1 if successful, 0 if the chunk data cannot be unpacked into the buffer or -1 on error
+ */
+int libewf_chunk_data_unpack_to_buffer(
+     libewf_chunk_data_t *chunk_data,
+     libewf_io_handle_t *io_handle,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *decompress_error = NULL;
+	static char *function               = "libewf_chunk_data_unpack_to_buffer";
+	size_t data_size                    = 0;
+	uint32_t calculated_checksum        = 0;
+	uint32_t stored_checksum            = 0;
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk data - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_data->chunk_size == 0 )
+	 || ( buffer_size < (size_t) chunk_data->chunk_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) == 0 )
+	{
+		return( 0 );
+	}
+	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+	{
+		if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) != 0 )
+		{
+			return( 0 );
+		}
+		data_size = (size_t) chunk_data->chunk_size;
+
+		if( libewf_compression_context_pool_decompress_data(
+		     io_handle->compression_context_pool,
+		     chunk_data->data,
+		     chunk_data->data_size,
+		     io_handle->compression_method,
+		     buffer,
+		     &data_size,
+		     &decompress_error ) != 1 )
+		{
+			libcerror_error_free(
+			 &decompress_error );
+
+			return( 0 );
+		}
+	}
+	else if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
+	{
+		if( chunk_data->data_size < 4 )
+		{
+			return( 0 );
+		}
+		data_size = chunk_data->data_size - 4;
+
+		if( data_size > (size_t) chunk_data->chunk_size )
+		{
+			return( 0 );
+		}
+		if( ( chunk_data->chunk_io_flags & LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET ) != 0 )
+		{
+			stored_checksum = chunk_data->checksum;
+		}
+		else
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 &( ( chunk_data->data )[ data_size ] ),
+			 stored_checksum );
+		}
+		if( libewf_checksum_calculate_adler32(
+		     &calculated_checksum,
+		     chunk_data->data,
+		     data_size,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to calculate checksum.",
+			 function );
+
+			return( -1 );
+		}
+		if( stored_checksum != calculated_checksum )
+		{
+			return( 0 );
+		}
+		if( memory_copy(
+		     buffer,
+		     chunk_data->data,
+		     data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		return( 0 );
+	}
+	/* A chunk that does not unpack to the full chunk size is handled
+	 * by libewf_chunk_data_unpack
+	 */
+	if( data_size != (size_t) chunk_data->chunk_size )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
 /* Checks if a buffer containing the chunk data is filled with same value bytes (empty-block)
  * Returns 1 if an empty block was found, 0 if not or -1 on error
  */
@@ -1663,34 +2370,145 @@ int libewf_chunk_data_check_for_64_bit_pattern_fill(
 		aligned_data_start = (libewf_aligned_t *) data_start;
 		aligned_data_index = (libewf_aligned_t *) data_index;
 
-		while( data_size > sizeof( libewf_aligned_t ) )
-		{
-			if( *aligned_data_start != *aligned_data_index )
-			{
-				return( 0 );
-			}
-			aligned_data_start++;
-			aligned_data_index++;
+		while( data_size > sizeof( libewf_aligned_t ) )
+		{
+			if( *aligned_data_start != *aligned_data_index )
+			{
+				return( 0 );
+			}
+			aligned_data_start++;
+			aligned_data_index++;
+
+			data_size -= sizeof( libewf_aligned_t );
+		}
+		data_start = (uint8_t *) aligned_data_start;
+		data_index = (uint8_t *) aligned_data_index;
+	}
+	while( data_size != 0 )
+	{
+		if( *data_start != *data_index )
+		{
+			return( 0 );
+		}
+		data_start++;
+		data_index++;
+		data_size--;
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 data,
+	 *pattern );
+
+	return( 1 );
+}
+
+/* Checks if a buffer containing the chunk data is predicted to be incompressible
+ * The prediction is based on the byte distribution of evenly spread samples of the data,
+ * where the sum of the squared byte value counts of uniformly distributed data, such as
+ * encrypted or already compressed data, approximates: size + ( size * ( size - 1 ) / 256 )
+ * Returns 1 if the data is predicted to be incompressible, 0 if not or -1 on error
+ */
+int libewf_chunk_data_check_for_incompressible_data(
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint32_t byte_value_counts[ 256 ];
+
+	static char *function           = "libewf_chunk_data_check_for_incompressible_data";
+	size_t data_offset              = 0;
+	size_t number_of_sampled_bytes  = 0;
+	size_t sample_offset            = 0;
+	size_t sample_size              = 0;
+	size_t sample_stride            = 0;
+	uint64_t sum_of_squared_counts  = 0;
+	uint64_t threshold              = 0;
+	uint16_t byte_value             = 0;
+	int number_of_samples           = 0;
+	int sample_index                = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* Too few bytes to reliably predict the compressibility
+	 */
+	if( data_size < ( 2 * LIBEWF_CHUNK_DATA_INCOMPRESSIBLE_DATA_SAMPLE_SIZE ) )
+	{
+		return( 0 );
+	}
+	if( memory_set(
+	     byte_value_counts,
+	     0,
+	     sizeof( uint32_t ) * 256 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear byte value counts.",
+		 function );
 
-			data_size -= sizeof( libewf_aligned_t );
-		}
-		data_start = (uint8_t *) aligned_data_start;
-		data_index = (uint8_t *) aligned_data_index;
+		return( -1 );
 	}
-	while( data_size != 0 )
+	if( data_size <= ( LIBEWF_CHUNK_DATA_INCOMPRESSIBLE_DATA_NUMBER_OF_SAMPLES * LIBEWF_CHUNK_DATA_INCOMPRESSIBLE_DATA_SAMPLE_SIZE ) )
 	{
-		if( *data_start != *data_index )
+		number_of_samples = 1;
+		sample_size       = data_size;
+		sample_stride     = data_size;
+	}
+	else
+	{
+		number_of_samples = LIBEWF_CHUNK_DATA_INCOMPRESSIBLE_DATA_NUMBER_OF_SAMPLES;
+		sample_size       = LIBEWF_CHUNK_DATA_INCOMPRESSIBLE_DATA_SAMPLE_SIZE;
+		sample_stride     = data_size / LIBEWF_CHUNK_DATA_INCOMPRESSIBLE_DATA_NUMBER_OF_SAMPLES;
+	}
+	for( sample_index = 0;
+	     sample_index < number_of_samples;
+	     sample_index++ )
+	{
+		for( sample_offset = 0;
+		     sample_offset < sample_size;
+		     sample_offset++ )
 		{
-			return( 0 );
+			byte_value_counts[ data[ data_offset + sample_offset ] ] += 1;
 		}
-		data_start++;
-		data_index++;
-		data_size--;
+		data_offset += sample_stride;
 	}
-	byte_stream_copy_to_uint64_little_endian(
-	 data,
-	 *pattern );
+	number_of_sampled_bytes = (size_t) number_of_samples * sample_size;
+
+	for( byte_value = 0;
+	     byte_value < 256;
+	     byte_value++ )
+	{
+		sum_of_squared_counts += (uint64_t) byte_value_counts[ byte_value ] * byte_value_counts[ byte_value ];
+	}
+	/* Allow for a deviation of 1/8 of the expected sum of uniformly distributed data,
+	 * which corresponds to data that deflate can only compress by a fraction of a percent
+	 */
+	threshold = (uint64_t) number_of_sampled_bytes * ( number_of_sampled_bytes + 255 ) * 9;
 
+	if( ( sum_of_squared_counts * 256 * 8 ) > threshold )
+	{
+		return( 0 );
+	}
 	return( 1 );
 }
 
@@ -1781,6 +2599,100 @@ ssize_t libewf_chunk_data_write(
 	return( total_write_count );
 }
 
+/* Copies the data of a chunk, as it is written, to a buffer
+ * Returns the number of bytes copied or -1 on error
+ */
+ssize_t libewf_chunk_data_copy_to_buffer(
+         libewf_chunk_data_t *chunk_data,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_copy_to_buffer";
+	size_t copy_size      = 0;
+	size_t write_size     = 0;
+	uint8_t copy_checksum = 0;
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	write_size = chunk_data->data_size + chunk_data->padding_size;
+	copy_size  = write_size;
+
+	/* Check if the chunk and checksum buffers are aligned
+	 * if not the checksum needs to be copied separately
+	 */
+	if( ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) == 0 )
+	 && ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
+	 && ( ( chunk_data->chunk_io_flags & LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET ) != 0 ) )
+	{
+		copy_checksum = 1;
+		copy_size    += 4;
+	}
+	if( copy_size > buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid buffer size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     buffer,
+	     chunk_data->data,
+	     write_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( copy_checksum != 0 )
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 &( buffer[ write_size ] ),
+		 chunk_data->checksum );
+	}
+	return( (ssize_t) copy_size );
+}
+
 /* Retrieves the write size of the chunk
  * Returns 1 if successful or -1 on error
  */
@@ -2058,6 +2970,180 @@ ssize_t libewf_chunk_data_read_from_file_io_pool(
 	return( read_count );
 }
 
+/* Reads chunk data from memory mapped data
+ * The chunk data references the memory mapped data instead of copying it,
+ * the memory mapped data must remain mapped for the lifetime of the chunk data
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_chunk_data_read_from_memory_map(
+         libewf_chunk_data_t *chunk_data,
+         const uint8_t *mapped_data,
+         size_t mapped_data_size,
+         uint32_t chunk_data_flags,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_read_from_memory_map";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data->compressed_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk data - compressed data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( mapped_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mapped_data_size == 0 )
+	 || ( mapped_data_size > chunk_data->allocated_data_size )
+	 || ( mapped_data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid mapped data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) != 0 )
+	{
+		if( chunk_data->data != NULL )
+		{
+			memory_free(
+			 chunk_data->data );
+		}
+		chunk_data->flags &= ~( LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA );
+	}
+	chunk_data->data      = (uint8_t *) mapped_data;
+	chunk_data->data_size = mapped_data_size;
+
+	chunk_data->range_flags = ( chunk_data_flags | LIBEWF_RANGE_FLAG_IS_PACKED )
+	                        & ~( LIBEWF_RANGE_FLAG_IS_TAINTED | LIBEWF_RANGE_FLAG_IS_CORRUPTED );
+
+	return( (ssize_t) mapped_data_size );
+}
+
+/* Copies data that is not owned by the chunk data, such as memory mapped data, into managed data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_copy_to_managed_data(
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error )
+{
+	uint8_t *data         = NULL;
+	static char *function = "libewf_chunk_data_copy_to_managed_data";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) != 0 )
+	{
+		return( 1 );
+	}
+	if( ( chunk_data->allocated_data_size == 0 )
+	 || ( chunk_data->allocated_data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	 || ( chunk_data->data_size > chunk_data->allocated_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk data - allocated data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * chunk_data->allocated_data_size );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     data,
+	     0,
+	     sizeof( uint8_t ) * chunk_data->allocated_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data.",
+		 function );
+
+		memory_free(
+		 data );
+
+		return( -1 );
+	}
+	if( ( chunk_data->data != NULL )
+	 && ( chunk_data->data_size > 0 ) )
+	{
+		if( memory_copy(
+		     data,
+		     chunk_data->data,
+		     chunk_data->data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data.",
+			 function );
+
+			memory_free(
+			 data );
+
+			return( -1 );
+		}
+	}
+	chunk_data->data   = data;
+	chunk_data->flags |= LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+
+	return( 1 );
+}
+
 /* Reads chunk data
  * Callback function for the chunks list
  * Returns 1 if successful or -1 on error
@@ -34,6 +34,16 @@
 extern "C" {
 #endif
 
+/* The number of samples and the size of a sample used to predict
+ * if chunk data is incompressible
+ */
+#define LIBEWF_CHUNK_DATA_INCOMPRESSIBLE_DATA_NUMBER_OF_SAMPLES	16
+#define LIBEWF_CHUNK_DATA_INCOMPRESSIBLE_DATA_SAMPLE_SIZE	256
+
+/* The size of the digest of the chunk data used for chunk deduplication
+ */
+#define LIBEWF_CHUNK_DATA_DIGEST_SIZE				32
+
 typedef struct libewf_chunk_data libewf_chunk_data_t;
 
 struct libewf_chunk_data
@@ -97,6 +107,14 @@ struct libewf_chunk_data
 	/* The range end offset
 	 */
 	off64_t range_end_offset;
+
+	/* The SHA-256 digest of the unpacked chunk data
+	 */
+	uint8_t digest[ LIBEWF_CHUNK_DATA_DIGEST_SIZE ];
+
+	/* Value to indicate the digest was calculated
+	 */
+	uint8_t digest_is_set;
 };
 
 int libewf_chunk_data_initialize(
@@ -121,6 +139,10 @@ ssize_t libewf_chunk_data_write_buffer(
          size_t buffer_size,
          libcerror_error_t **error );
 
+int libewf_chunk_data_calculate_digest(
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error );
+
 int libewf_chunk_data_pack_determine_pack_flags(
      libewf_chunk_data_t *chunk_data,
      libewf_io_handle_t *io_handle,
@@ -154,11 +176,26 @@ int libewf_chunk_data_pack(
      uint8_t pack_flags,
      libcerror_error_t **error );
 
+int libewf_chunk_data_pack_from_reference(
+     libewf_chunk_data_t *chunk_data,
+     libewf_io_handle_t *io_handle,
+     libewf_chunk_data_t *reference_chunk_data,
+     libewf_io_handle_t *reference_io_handle,
+     uint8_t pack_flags,
+     libcerror_error_t **error );
+
 int libewf_chunk_data_unpack(
      libewf_chunk_data_t *chunk_data,
      libewf_io_handle_t *io_handle,
      libcerror_error_t **error );
 
+int libewf_chunk_data_unpack_to_buffer(
+     libewf_chunk_data_t *chunk_data,
+     libewf_io_handle_t *io_handle,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
 int libewf_chunk_data_check_for_empty_block(
      const uint8_t *data,
      size_t data_size,
@@ -170,12 +207,23 @@ int libewf_chunk_data_check_for_64_bit_pattern_fill(
      uint64_t *pattern,
      libcerror_error_t **error );
 
+int libewf_chunk_data_check_for_incompressible_data(
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
 ssize_t libewf_chunk_data_write(
          libewf_chunk_data_t *chunk_data,
          libbfio_pool_t *file_io_pool,
          int file_io_pool_entry,
          libcerror_error_t **error );
 
+ssize_t libewf_chunk_data_copy_to_buffer(
+         libewf_chunk_data_t *chunk_data,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
 int libewf_chunk_data_get_write_size(
      libewf_chunk_data_t *chunk_data,
      uint32_t *write_size,
@@ -196,6 +244,17 @@ ssize_t libewf_chunk_data_read_from_file_io_pool(
          uint32_t chunk_data_flags,
          libcerror_error_t **error );
 
+ssize_t libewf_chunk_data_read_from_memory_map(
+         libewf_chunk_data_t *chunk_data,
+         const uint8_t *mapped_data,
+         size_t mapped_data_size,
+         uint32_t chunk_data_flags,
+         libcerror_error_t **error );
+
+int libewf_chunk_data_copy_to_managed_data(
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error );
+
 int libewf_chunk_data_read_element_data(
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
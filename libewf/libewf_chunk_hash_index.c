@@ -0,0 +1,432 @@
+/*
+ * Chunk hash index functions
+ *
+ * Copyright (C) 2006-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_hash_index.h"
+#include "libewf_libcerror.h"
+
+/* Creates a chunk hash index
+ * Make sure the value chunk_hash_index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_hash_index_initialize(
+     libewf_chunk_hash_index_t **chunk_hash_index,
+     int maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function  = "libewf_chunk_hash_index_initialize";
+	size_t entries_size    = 0;
+	size_t hash_table_size = 0;
+	int entry_index        = 0;
+
+	if( chunk_hash_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk hash index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_hash_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk hash index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_entries <= 0 )
+	 || ( (size_t) maximum_number_of_entries > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libewf_chunk_hash_index_entry_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_hash_index = memory_allocate_structure(
+	                     libewf_chunk_hash_index_t );
+
+	if( *chunk_hash_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk hash index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_hash_index,
+	     0,
+	     sizeof( libewf_chunk_hash_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk hash index.",
+		 function );
+
+		memory_free(
+		 *chunk_hash_index );
+
+		*chunk_hash_index = NULL;
+
+		return( -1 );
+	}
+	entries_size    = sizeof( libewf_chunk_hash_index_entry_t ) * (size_t) maximum_number_of_entries;
+	hash_table_size = sizeof( int ) * (size_t) maximum_number_of_entries;
+
+	( *chunk_hash_index )->entries = (libewf_chunk_hash_index_entry_t *) memory_allocate(
+	                                                                      entries_size );
+
+	if( ( *chunk_hash_index )->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_hash_index )->entries,
+	     0,
+	     entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		goto on_error;
+	}
+	( *chunk_hash_index )->hash_table = (int *) memory_allocate(
+	                                             hash_table_size );
+
+	if( ( *chunk_hash_index )->hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hash table.",
+		 function );
+
+		goto on_error;
+	}
+	for( entry_index = 0;
+	     entry_index < maximum_number_of_entries;
+	     entry_index++ )
+	{
+		( *chunk_hash_index )->hash_table[ entry_index ] = -1;
+
+		( *chunk_hash_index )->entries[ entry_index ].next_hash_entry_index = -1;
+	}
+	( *chunk_hash_index )->maximum_number_of_entries = maximum_number_of_entries;
+
+	return( 1 );
+
+on_error:
+	if( *chunk_hash_index != NULL )
+	{
+		if( ( *chunk_hash_index )->entries != NULL )
+		{
+			memory_free(
+			 ( *chunk_hash_index )->entries );
+		}
+		memory_free(
+		 *chunk_hash_index );
+
+		*chunk_hash_index = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk hash index
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_hash_index_free(
+     libewf_chunk_hash_index_t **chunk_hash_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_hash_index_free";
+
+	if( chunk_hash_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk hash index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_hash_index != NULL )
+	{
+		memory_free(
+		 ( *chunk_hash_index )->hash_table );
+
+		memory_free(
+		 ( *chunk_hash_index )->entries );
+
+		memory_free(
+		 *chunk_hash_index );
+
+		*chunk_hash_index = NULL;
+	}
+	return( 1 );
+}
+
+/* Retrieves the entry of chunk data with a specific digest in a specific segment file
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_chunk_hash_index_get_entry_by_digest(
+     libewf_chunk_hash_index_t *chunk_hash_index,
+     const uint8_t *digest,
+     uint32_t segment_number,
+     libewf_chunk_hash_index_entry_t **entry,
+     libcerror_error_t **error )
+{
+	libewf_chunk_hash_index_entry_t *safe_entry = NULL;
+	static char *function                       = "libewf_chunk_hash_index_get_entry_by_digest";
+	int entry_index                             = 0;
+	int hash_index                              = 0;
+
+	if( chunk_hash_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk hash index.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	hash_index = libewf_chunk_hash_index_get_hash_index(
+	              chunk_hash_index,
+	              digest );
+
+	entry_index = chunk_hash_index->hash_table[ hash_index ];
+
+	while( entry_index != -1 )
+	{
+		safe_entry = &( chunk_hash_index->entries[ entry_index ] );
+
+		if( ( safe_entry->segment_number == segment_number )
+		 && ( memory_compare(
+		       safe_entry->digest,
+		       digest,
+		       LIBEWF_CHUNK_DATA_DIGEST_SIZE ) == 0 ) )
+		{
+			*entry = safe_entry;
+
+			return( 1 );
+		}
+		entry_index = safe_entry->next_hash_entry_index;
+	}
+	return( 0 );
+}
+
+/* Inserts an entry into the chunk hash index
+ * If the index is full the oldest entry is replaced
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_hash_index_insert_entry(
+     libewf_chunk_hash_index_t *chunk_hash_index,
+     const uint8_t *digest,
+     uint32_t segment_number,
+     off64_t data_offset,
+     size64_t data_size,
+     uint32_t range_flags,
+     libcerror_error_t **error )
+{
+	libewf_chunk_hash_index_entry_t *entry = NULL;
+	static char *function                  = "libewf_chunk_hash_index_insert_entry";
+	int entry_index                        = 0;
+	int hash_index                         = 0;
+
+	if( chunk_hash_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk hash index.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	entry_index = chunk_hash_index->next_entry_index;
+
+	if( chunk_hash_index->number_of_entries < chunk_hash_index->maximum_number_of_entries )
+	{
+		chunk_hash_index->number_of_entries += 1;
+	}
+	else
+	{
+		libewf_chunk_hash_index_remove_entry(
+		 chunk_hash_index,
+		 entry_index );
+	}
+	entry = &( chunk_hash_index->entries[ entry_index ] );
+
+	if( memory_copy(
+	     entry->digest,
+	     digest,
+	     LIBEWF_CHUNK_DATA_DIGEST_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy digest.",
+		 function );
+
+		return( -1 );
+	}
+	hash_index = libewf_chunk_hash_index_get_hash_index(
+	              chunk_hash_index,
+	              digest );
+
+	entry->segment_number        = segment_number;
+	entry->data_offset           = data_offset;
+	entry->data_size             = data_size;
+	entry->range_flags           = range_flags;
+	entry->next_hash_entry_index = chunk_hash_index->hash_table[ hash_index ];
+
+	chunk_hash_index->hash_table[ hash_index ] = entry_index;
+
+	chunk_hash_index->next_entry_index = ( entry_index + 1 ) % chunk_hash_index->maximum_number_of_entries;
+
+	return( 1 );
+}
+
+/* Determines the hash table index of a digest
+ * Returns the hash table index
+ */
+int libewf_chunk_hash_index_get_hash_index(
+     libewf_chunk_hash_index_t *chunk_hash_index,
+     const uint8_t *digest )
+{
+	uint32_t value_32bit = 0;
+
+	byte_stream_copy_to_uint32_little_endian(
+	 digest,
+	 value_32bit );
+
+	return( (int) ( value_32bit % (uint32_t) chunk_hash_index->maximum_number_of_entries ) );
+}
+
+/* Removes an entry from the hash table
+ */
+void libewf_chunk_hash_index_remove_entry(
+      libewf_chunk_hash_index_t *chunk_hash_index,
+      int entry_index )
+{
+	libewf_chunk_hash_index_entry_t *entry = NULL;
+	int hash_entry_index                   = 0;
+	int hash_index                         = 0;
+
+	entry = &( chunk_hash_index->entries[ entry_index ] );
+
+	hash_index = libewf_chunk_hash_index_get_hash_index(
+	              chunk_hash_index,
+	              entry->digest );
+
+	hash_entry_index = chunk_hash_index->hash_table[ hash_index ];
+
+	if( hash_entry_index == entry_index )
+	{
+		chunk_hash_index->hash_table[ hash_index ] = entry->next_hash_entry_index;
+	}
+	else
+	{
+		while( hash_entry_index != -1 )
+		{
+			if( chunk_hash_index->entries[ hash_entry_index ].next_hash_entry_index == entry_index )
+			{
+				chunk_hash_index->entries[ hash_entry_index ].next_hash_entry_index = entry->next_hash_entry_index;
+
+				break;
+			}
+			hash_entry_index = chunk_hash_index->entries[ hash_entry_index ].next_hash_entry_index;
+		}
+	}
+	entry->next_hash_entry_index = -1;
+}
+
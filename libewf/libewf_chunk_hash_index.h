@@ -0,0 +1,131 @@
+/*
+ * Chunk hash index functions
+ *
+ * Copyright (C) 2006-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_HASH_INDEX_H )
+#define _LIBEWF_CHUNK_HASH_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_chunk_hash_index_entry libewf_chunk_hash_index_entry_t;
+
+struct libewf_chunk_hash_index_entry
+{
+	/* The digest of the (uncompressed) chunk data
+	 */
+	uint8_t digest[ LIBEWF_CHUNK_DATA_DIGEST_SIZE ];
+
+	/* The number of the segment file that contains the chunk
+	 */
+	uint32_t segment_number;
+
+	/* The offset of the chunk data in the segment file
+	 */
+	off64_t data_offset;
+
+	/* The size of the chunk data in the segment file
+	 */
+	size64_t data_size;
+
+	/* The chunk data range flags
+	 */
+	uint32_t range_flags;
+
+	/* The index of the next entry with the same hash
+	 */
+	int next_hash_entry_index;
+};
+
+typedef struct libewf_chunk_hash_index libewf_chunk_hash_index_t;
+
+/* The chunk hash index maps the digest of chunk data to the location
+ * where the chunk was written. When the index is full the oldest entry
+ * is replaced.
+ */
+struct libewf_chunk_hash_index
+{
+	/* The entries
+	 */
+	libewf_chunk_hash_index_entry_t *entries;
+
+	/* The maximum number of entries
+	 */
+	int maximum_number_of_entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The index of the entry that is used next
+	 */
+	int next_entry_index;
+
+	/* The hash table, contains the index of the first entry per hash
+	 */
+	int *hash_table;
+};
+
+int libewf_chunk_hash_index_initialize(
+     libewf_chunk_hash_index_t **chunk_hash_index,
+     int maximum_number_of_entries,
+     libcerror_error_t **error );
+
+int libewf_chunk_hash_index_free(
+     libewf_chunk_hash_index_t **chunk_hash_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_hash_index_get_entry_by_digest(
+     libewf_chunk_hash_index_t *chunk_hash_index,
+     const uint8_t *digest,
+     uint32_t segment_number,
+     libewf_chunk_hash_index_entry_t **entry,
+     libcerror_error_t **error );
+
+int libewf_chunk_hash_index_insert_entry(
+     libewf_chunk_hash_index_t *chunk_hash_index,
+     const uint8_t *digest,
+     uint32_t segment_number,
+     off64_t data_offset,
+     size64_t data_size,
+     uint32_t range_flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_hash_index_get_hash_index(
+     libewf_chunk_hash_index_t *chunk_hash_index,
+     const uint8_t *digest );
+
+void libewf_chunk_hash_index_remove_entry(
+      libewf_chunk_hash_index_t *chunk_hash_index,
+      int entry_index );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_HASH_INDEX_H ) */
+
@@ -24,15 +24,19 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libewf_chunk_cache.h"
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_group.h"
 #include "libewf_chunk_table.h"
 #include "libewf_definitions.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
+#include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
+#include "libewf_memory_map.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
 
@@ -127,7 +131,21 @@ int libewf_chunk_table_initialize(
 		goto on_error;
 	}
 	if( libfcache_cache_initialize(
-	     &( ( *chunk_table )->chunk_data_cache ),
+	     &( ( *chunk_table )->single_chunk_data_cache ),
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create single chunk data cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_chunk_cache_initialize(
+	     &( ( *chunk_table )->chunk_cache ),
 	     LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS,
 	     error ) != 1 )
 	{
@@ -135,25 +153,40 @@ int libewf_chunk_table_initialize(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create chunk data cache.",
+		 "%s: unable to create chunk cache.",
 		 function );
 
 		goto on_error;
 	}
-	if( libfcache_cache_initialize(
-	     &( ( *chunk_table )->single_chunk_data_cache ),
-	     1,
+	if( libcdata_array_initialize(
+	     &( ( *chunk_table )->pinned_chunk_data ),
+	     0,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create single chunk data cache.",
+		 "%s: unable to create pinned chunk data array.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *chunk_table )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
 		 function );
 
 		goto on_error;
 	}
+#endif
 	( *chunk_table )->io_handle = io_handle;
 
 	return( 1 );
@@ -161,10 +194,23 @@ int libewf_chunk_table_initialize(
 on_error:
 	if( *chunk_table != NULL )
 	{
-		if( ( *chunk_table )->chunk_data_cache != NULL )
+		if( ( *chunk_table )->pinned_chunk_data != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *chunk_table )->pinned_chunk_data ),
+			 NULL,
+			 NULL );
+		}
+		if( ( *chunk_table )->chunk_cache != NULL )
+		{
+			libewf_chunk_cache_free(
+			 &( ( *chunk_table )->chunk_cache ),
+			 NULL );
+		}
+		if( ( *chunk_table )->single_chunk_data_cache != NULL )
 		{
 			libfcache_cache_free(
-			 &( ( *chunk_table )->chunk_data_cache ),
+			 &( ( *chunk_table )->single_chunk_data_cache ),
 			 NULL );
 		}
 		memory_free(
@@ -213,31 +259,106 @@ int libewf_chunk_table_free(
 			result = -1;
 		}
 		if( libfcache_cache_free(
-		     &( ( *chunk_table )->chunk_data_cache ),
+		     &( ( *chunk_table )->single_chunk_data_cache ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk data cache.",
+			 "%s: unable to free single chunk data cache.",
 			 function );
 
 			result = -1;
 		}
-		if( libfcache_cache_free(
-		     &( ( *chunk_table )->single_chunk_data_cache ),
+		if( libewf_chunk_table_release_chunk_data_concurrent(
+		     *chunk_table,
+		     &( ( *chunk_table )->cached_chunk_data ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free single chunk data cache.",
+			 "%s: unable to release cached chunk data.",
+			 function );
+
+			result = -1;
+		}
+		if( libewf_chunk_table_unpin_all_chunk_data(
+		     *chunk_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to unpin chunk data.",
+			 function );
+
+			result = -1;
+		}
+		if( libcdata_array_free(
+		     &( ( *chunk_table )->pinned_chunk_data ),
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free pinned chunk data array.",
+			 function );
+
+			result = -1;
+		}
+		if( libewf_chunk_cache_free(
+		     &( ( *chunk_table )->chunk_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk cache.",
+			 function );
+
+			result = -1;
+		}
+		/* The memory maps are freed last since the chunk data can reference the mapped data
+		 */
+		if( ( *chunk_table )->memory_maps != NULL )
+		{
+			if( libcdata_array_free(
+			     &( ( *chunk_table )->memory_maps ),
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_memory_map_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free memory maps array.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *chunk_table )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
 			 function );
 
 			result = -1;
 		}
+#endif
 		memory_free(
 		 *chunk_table );
 
@@ -319,9 +440,16 @@ int libewf_chunk_table_clone(
 	}
 	( *destination_chunk_table )->current_chunk_group     = NULL;
 	( *destination_chunk_table )->current_chunk_data      = NULL;
+	( *destination_chunk_table )->cached_chunk_data       = NULL;
 	( *destination_chunk_table )->checksum_errors         = NULL;
-	( *destination_chunk_table )->chunk_data_cache        = NULL;
 	( *destination_chunk_table )->single_chunk_data_cache = NULL;
+	( *destination_chunk_table )->chunk_cache             = NULL;
+	( *destination_chunk_table )->pinned_chunk_data       = NULL;
+	( *destination_chunk_table )->memory_maps             = NULL;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	( *destination_chunk_table )->mutex = NULL;
+#endif
 
 	if( libcdata_range_list_clone(
 	     &( ( *destination_chunk_table )->checksum_errors ),
@@ -340,42 +468,84 @@ int libewf_chunk_table_clone(
 		goto on_error;
 	}
 	if( libfcache_cache_clone(
-	     &( ( *destination_chunk_table )->chunk_data_cache ),
-	     source_chunk_table->chunk_data_cache,
+	     &( ( *destination_chunk_table )->single_chunk_data_cache ),
+	     source_chunk_table->single_chunk_data_cache,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create destination chunk data cache.",
+		 "%s: unable to create destination single chunk data cache.",
 		 function );
 
 		goto on_error;
 	}
-	if( libfcache_cache_clone(
-	     &( ( *destination_chunk_table )->single_chunk_data_cache ),
-	     source_chunk_table->single_chunk_data_cache,
+	if( libewf_chunk_cache_initialize(
+	     &( ( *destination_chunk_table )->chunk_cache ),
+	     source_chunk_table->chunk_cache->maximum_number_of_entries,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create destination single chunk data cache.",
+		 "%s: unable to create destination chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &( ( *destination_chunk_table )->pinned_chunk_data ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination pinned chunk data array.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *destination_chunk_table )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize destination mutex.",
 		 function );
 
 		goto on_error;
 	}
+#endif
 	return( 1 );
 
 on_error:
 	if( *destination_chunk_table != NULL )
 	{
-		if( ( *destination_chunk_table )->chunk_data_cache != NULL )
+		if( ( *destination_chunk_table )->pinned_chunk_data != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *destination_chunk_table )->pinned_chunk_data ),
+			 NULL,
+			 NULL );
+		}
+		if( ( *destination_chunk_table )->chunk_cache != NULL )
+		{
+			libewf_chunk_cache_free(
+			 &( ( *destination_chunk_table )->chunk_cache ),
+			 NULL );
+		}
+		if( ( *destination_chunk_table )->single_chunk_data_cache != NULL )
 		{
 			libfcache_cache_free(
-			 &( ( *destination_chunk_table )->chunk_data_cache ),
+			 &( ( *destination_chunk_table )->single_chunk_data_cache ),
 			 NULL );
 		}
 		if( ( *destination_chunk_table )->checksum_errors != NULL )
@@ -393,16 +563,21 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves the number of checksum errors
- * Returns 1 if successful or -1 on error
+/* Memory maps the segment file of a specific file IO pool entry
+ * Chunk data read from the file IO pool entry will reference the mapped data
+ * This function is not multi-thread safe and should only be called when opening a handle
+ * Returns 1 if successful, 0 if the segment file cannot be mapped or -1 on error
  */
-int libewf_chunk_table_get_number_of_checksum_errors(
+int libewf_chunk_table_set_memory_map(
      libewf_chunk_table_t *chunk_table,
-     uint32_t *number_of_errors,
+     int file_io_pool_entry,
+     const char *filename,
      libcerror_error_t **error )
 {
-	static char *function  = "libewf_chunk_table_get_number_of_checksum_errors";
-	int number_of_elements = 0;
+	libewf_memory_map_t *memory_map = NULL;
+	static char *function           = "libewf_chunk_table_set_memory_map";
+	int number_of_memory_maps       = 0;
+	int result                      = 0;
 
 	if( chunk_table == NULL )
 	{
@@ -415,92 +590,194 @@ int libewf_chunk_table_get_number_of_checksum_errors(
 
 		return( -1 );
 	}
-	if( number_of_errors == NULL )
+	if( file_io_pool_entry < 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid number of errors.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid file IO pool entry value less than zero.",
 		 function );
 
 		return( -1 );
 	}
-	if( libcdata_range_list_get_number_of_elements(
-	     chunk_table->checksum_errors,
-	     &number_of_elements,
+	if( chunk_table->memory_maps == NULL )
+	{
+		if( libcdata_array_initialize(
+		     &( chunk_table->memory_maps ),
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create memory maps array.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcdata_array_get_number_of_entries(
+	     chunk_table->memory_maps,
+	     &number_of_memory_maps,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of elements from range list.",
+		 "%s: unable to retrieve number of memory maps.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	*number_of_errors = (uint32_t) number_of_elements;
+	if( file_io_pool_entry < number_of_memory_maps )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     chunk_table->memory_maps,
+		     file_io_pool_entry,
+		     (intptr_t **) &memory_map,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve memory map: %d.",
+			 function,
+			 file_io_pool_entry );
 
-	return( 1 );
-}
+			memory_map = NULL;
 
-/* Retrieves a checksum error
- * Returns 1 if successful or -1 on error
- */
-int libewf_chunk_table_get_checksum_error(
-     libewf_chunk_table_t *chunk_table,
-     uint32_t error_index,
-     uint64_t *start_sector,
-     uint64_t *number_of_sectors,
-     libcerror_error_t **error )
-{
-	static char *function = "libewf_chunk_table_get_checksum_error";
-	intptr_t *value       = NULL;
+			goto on_error;
+		}
+		if( memory_map != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid memory map: %d value already set.",
+			 function,
+			 file_io_pool_entry );
 
-	if( chunk_table == NULL )
+			memory_map = NULL;
+
+			goto on_error;
+		}
+	}
+	if( libewf_memory_map_initialize(
+	     &memory_map,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk table.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create memory map.",
 		 function );
 
-		return( -1 );
+		goto on_error;
+	}
+	result = libewf_memory_map_open(
+	          memory_map,
+	          filename,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open memory map: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libewf_memory_map_free(
+		     &memory_map,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free memory map.",
+			 function );
+
+			goto on_error;
+		}
+		return( 0 );
+	}
+	if( file_io_pool_entry >= number_of_memory_maps )
+	{
+		if( libcdata_array_resize(
+		     chunk_table->memory_maps,
+		     file_io_pool_entry + 1,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_memory_map_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize memory maps array.",
+			 function );
+
+			goto on_error;
+		}
 	}
-	if( libcdata_range_list_get_range_by_index(
-	     chunk_table->checksum_errors,
-	     (int) error_index,
-	     start_sector,
-	     number_of_sectors,
-	     &value,
+	if( libcdata_array_set_entry_by_index(
+	     chunk_table->memory_maps,
+	     file_io_pool_entry,
+	     (intptr_t *) memory_map,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve checksum error: %" PRIu32 " from range list.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set memory map: %d.",
 		 function,
-		 error_index );
+		 file_io_pool_entry );
 
-		return( -1 );
+		goto on_error;
 	}
 	return( 1 );
+
+on_error:
+	if( memory_map != NULL )
+	{
+		libewf_memory_map_free(
+		 &memory_map,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Appends a checksum error
- * Returns 1 if successful or -1 on error
+/* Reads chunk data from the memory mapped segment file or the file IO pool
+ * The memory maps are only modified when opening a handle, hence no locking is required
+ * Returns the number of bytes read or -1 on error
  */
-int libewf_chunk_table_append_checksum_error(
-     libewf_chunk_table_t *chunk_table,
-     uint64_t start_sector,
-     uint64_t number_of_sectors,
-     libcerror_error_t **error )
+ssize_t libewf_chunk_table_read_chunk_data(
+         libewf_chunk_table_t *chunk_table,
+         libewf_chunk_data_t *chunk_data,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         off64_t data_offset,
+         size64_t data_size,
+         uint32_t data_flags,
+         libcerror_error_t **error )
 {
-	static char *function = "libewf_chunk_table_append_checksum_error";
-	int result            = 0;
+	libewf_memory_map_t *memory_map = NULL;
+	static char *function           = "libewf_chunk_table_read_chunk_data";
+	ssize_t read_count              = 0;
+	int number_of_memory_maps       = 0;
 
 	if( chunk_table == NULL )
 	{
@@ -513,26 +790,326 @@ int libewf_chunk_table_append_checksum_error(
 
 		return( -1 );
 	}
-	result = libcdata_range_list_insert_range(
-	          chunk_table->checksum_errors,
-	          start_sector,
-	          number_of_sectors,
-	          NULL,
-	          NULL,
-	          NULL,
-	          error );
-
-	if( result == -1 )
+	if( ( chunk_table->memory_maps != NULL )
+	 && ( file_io_pool_entry >= 0 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert checksum error in range list.",
+		if( libcdata_array_get_number_of_entries(
+		     chunk_table->memory_maps,
+		     &number_of_memory_maps,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of memory maps.",
+			 function );
+
+			return( -1 );
+		}
+		if( file_io_pool_entry < number_of_memory_maps )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     chunk_table->memory_maps,
+			     file_io_pool_entry,
+			     (intptr_t **) &memory_map,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve memory map: %d.",
+				 function,
+				 file_io_pool_entry );
+
+				return( -1 );
+			}
+		}
+	}
+	/* Chunk data outside the mapped data, for example of a segment file
+	 * that was extended after it was mapped, is read from the file IO pool
+	 */
+	if( ( memory_map != NULL )
+	 && ( memory_map->data != NULL )
+	 && ( data_offset >= 0 )
+	 && ( data_size <= (size64_t) memory_map->data_size )
+	 && ( (size64_t) data_offset <= ( (size64_t) memory_map->data_size - data_size ) ) )
+	{
+		read_count = libewf_chunk_data_read_from_memory_map(
+		              chunk_data,
+		              &( ( memory_map->data )[ data_offset ] ),
+		              (size_t) data_size,
+		              data_flags,
+		              error );
+	}
+	else
+	{
+		read_count = libewf_chunk_data_read_from_file_io_pool(
+		              chunk_data,
+		              file_io_pool,
+		              file_io_pool_entry,
+		              data_offset,
+		              data_size,
+		              data_flags,
+		              error );
+	}
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Retrieves the number of checksum errors
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_get_number_of_checksum_errors(
+     libewf_chunk_table_t *chunk_table,
+     uint32_t *number_of_errors,
+     libcerror_error_t **error )
+{
+	static char *function  = "libewf_chunk_table_get_number_of_checksum_errors";
+	int number_of_elements = 0;
+	int result             = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_errors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of errors.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_table->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libcdata_range_list_get_number_of_elements(
+	          chunk_table->checksum_errors,
+	          &number_of_elements,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of elements from range list.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_table->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	*number_of_errors = (uint32_t) number_of_elements;
+
+	return( 1 );
+}
+
+/* Retrieves a checksum error
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_get_checksum_error(
+     libewf_chunk_table_t *chunk_table,
+     uint32_t error_index,
+     uint64_t *start_sector,
+     uint64_t *number_of_sectors,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_table_get_checksum_error";
+	intptr_t *value       = NULL;
+	int result            = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_table->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libcdata_range_list_get_range_by_index(
+	          chunk_table->checksum_errors,
+	          (int) error_index,
+	          start_sector,
+	          number_of_sectors,
+	          &value,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve checksum error: %" PRIu32 " from range list.",
+		 function,
+		 error_index );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_table->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Appends a checksum error
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_append_checksum_error(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t start_sector,
+     uint64_t number_of_sectors,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_table_append_checksum_error";
+	int result            = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_table->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libcdata_range_list_insert_range(
+	          chunk_table->checksum_errors,
+	          start_sector,
+	          number_of_sectors,
+	          NULL,
+	          NULL,
+	          NULL,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert checksum error in range list.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_table->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
 		 function );
 
 		return( -1 );
 	}
+#endif
+	if( result == -1 )
+	{
+		return( -1 );
+	}
 	return( 1 );
 }
 
@@ -919,6 +1496,8 @@ int libewf_chunk_table_get_segment_file_chunk_data_by_offset(
 }
 
 /* Retrieves the chunk data of a chunk at a specific offset
+ * The chunk data remains valid until the next call
+ * This function is not multi-thread safe acquire write lock before call
  * Adds a checksum error if the data is corrupted
  * Returns 1 if successful or -1 on error
  */
@@ -933,13 +1512,8 @@ int libewf_chunk_table_get_chunk_data_by_offset(
      libewf_chunk_data_t **chunk_data,
      libcerror_error_t **error )
 {
-	libewf_chunk_data_t *safe_chunk_data = NULL;
-	static char *function                = "libewf_chunk_table_get_chunk_data_by_offset";
-	off64_t safe_chunk_data_offset       = 0;
-	uint64_t chunk_index                 = 0;
-	uint64_t number_of_sectors           = 0;
-	uint64_t start_sector                = 0;
-	int result                           = 0;
+	static char *function          = "libewf_chunk_table_get_chunk_data_by_offset";
+	off64_t safe_chunk_data_offset = 0;
 
 	if( chunk_table == NULL )
 	{
@@ -1007,89 +1581,62 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 
 		return( -1 );
 	}
-	result = libewf_chunk_table_get_segment_file_chunk_data_by_offset(
-		  chunk_table,
-		  io_handle,
-		  file_io_pool,
-	          chunk_table->chunk_data_cache,
-		  media_values,
-		  segment_table,
-		  offset,
-		  &safe_chunk_data_offset,
-		  &safe_chunk_data,
-		  0,
-		  error );
+	if( ( chunk_table->cached_chunk_data != NULL )
+	 && ( offset >= chunk_table->cached_chunk_data->range_start_offset )
+	 && ( offset < chunk_table->cached_chunk_data->range_end_offset ) )
+	{
+		*chunk_data_offset = offset - chunk_table->cached_chunk_data->range_start_offset;
+		*chunk_data        = chunk_table->cached_chunk_data;
 
-	if( result == -1 )
+		return( 1 );
+	}
+	/* The chunk data of the previous call remains referenced in the chunk cache
+	 * until the next call so that the caller can use it without releasing it
+	 */
+	if( libewf_chunk_table_release_chunk_data_concurrent(
+	     chunk_table,
+	     &( chunk_table->cached_chunk_data ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release cached chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_table_get_chunk_data_by_offset_concurrent(
+	     chunk_table,
+	     io_handle,
+	     file_io_pool,
+	     media_values,
+	     segment_table,
+	     offset,
+	     &safe_chunk_data_offset,
+	     &( chunk_table->cached_chunk_data ),
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment file chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 "%s: unable to retrieve chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
 		 function,
 		 offset,
 		 offset );
 
 		return( -1 );
 	}
-	else if( result != 0 )
-	{
-		if( libewf_chunk_data_unpack(
-		     safe_chunk_data,
-		     io_handle,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to unpack chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
-
-			return( -1 );
-		}
-		if( ( safe_chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
-		{
-			/* Add checksum error
-			 */
-			start_sector      = safe_chunk_data->range_start_offset / media_values->bytes_per_sector;
-			number_of_sectors = media_values->sectors_per_chunk;
-
-			if( ( start_sector + number_of_sectors ) > (uint64_t) media_values->number_of_sectors )
-			{
-				number_of_sectors = (uint64_t) media_values->number_of_sectors - start_sector;
-			}
-			if( libcdata_range_list_insert_range(
-			     chunk_table->checksum_errors,
-			     start_sector,
-			     number_of_sectors,
-			     NULL,
-			     NULL,
-			     NULL,
-			     error ) == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to insert checksum error in range list.",
-				 function );
+	*chunk_data_offset = safe_chunk_data_offset;
+	*chunk_data        = chunk_table->cached_chunk_data;
 
-				return( -1 );
-			}
-		}
-	}
-	if( result != 0 )
-	{
-		*chunk_data_offset = safe_chunk_data_offset;
-		*chunk_data        = safe_chunk_data;
-	}
-	return( result );
+	return( 1 );
 }
 
-/* Retrieves the chunk data of a chunk at a specific offset
+/* Retrieves the chunk data of a chunk at a specific offset without caching it
+ * The chunk table lookup is serialized with the concurrent readers by the chunk table mutex
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_table_get_chunk_data_by_offset_no_cache(
@@ -1117,6 +1664,24 @@ int libewf_chunk_table_get_chunk_data_by_offset_no_cache(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The segment file lookup changes the current chunk group and the chunk groups cache
+	 * that are shared with the read-ahead and asynchronous read workers
+	 */
+	if( libcthreads_mutex_grab(
+	     chunk_table->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	result = libewf_chunk_table_get_segment_file_chunk_data_by_offset(
 		  chunk_table,
 		  io_handle,
@@ -1140,8 +1705,6 @@ int libewf_chunk_table_get_chunk_data_by_offset_no_cache(
 		 function,
 		 offset,
 		 offset );
-
-		return( -1 );
 	}
 	else if( result != 0 )
 	{
@@ -1157,9 +1720,1541 @@ int libewf_chunk_table_get_chunk_data_by_offset_no_cache(
 			 "%s: unable to clear single chunk data cache entry: 0.",
 			 function );
 
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_table->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+
+/* Retrieves the data range of a chunk at a specific offset
+ * This function is not multi-thread safe acquire the chunk table mutex before call
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libewf_chunk_table_get_chunk_data_range_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     off64_t offset,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *chunk_data_flags,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_t *chunk_group = NULL;
+	static char *function             = "libewf_chunk_table_get_chunk_data_range_by_offset";
+	off64_t chunk_group_data_offset   = 0;
+	uint32_t segment_number           = 0;
+	int chunk_groups_list_index       = 0;
+	int chunks_list_index             = 0;
+	int result                        = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media values - chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+		  chunk_table,
+		  file_io_pool,
+		  segment_table,
+		  offset,
+		  &segment_number,
+		  &chunk_groups_list_index,
+		  &chunk_group_data_offset,
+		  &chunk_group,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file chunk group for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( chunk_group == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing chunk group: %d.",
+			 function,
+			 chunk_groups_list_index );
+
+			return( -1 );
+		}
+		chunks_list_index = (int) ( chunk_group_data_offset / media_values->chunk_size );
+
+		if( libfdata_list_get_element_by_index(
+		     chunk_group->chunks_list,
+		     chunks_list_index,
+		     file_io_pool_entry,
+		     chunk_data_offset,
+		     chunk_data_size,
+		     chunk_data_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d from chunks list of chunk group: %d in segment file: %" PRIu32 ".",
+			 function,
+			 chunks_list_index,
+			 chunk_groups_list_index,
+			 segment_number );
+
 			return( -1 );
 		}
 	}
 	return( result );
 }
 
+/* Retrieves the chunk data of a chunk from its data range
+ * This function is multi-thread safe, it can be called by multiple readers that share
+ * the handle read lock. The data range is retrieved by the caller with
+ * libewf_chunk_table_get_chunk_data_range_by_offset while holding the chunk table mutex.
+ * The chunk data must be released with libewf_chunk_table_release_chunk_data_concurrent
+ * Adds a checksum error if the data is corrupted
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_get_chunk_data_by_range_concurrent(
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     uint64_t chunk_index,
+     int file_io_pool_entry,
+     off64_t data_offset,
+     size64_t data_size,
+     uint32_t data_flags,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *safe_chunk_data = NULL;
+	static char *function                = "libewf_chunk_table_get_chunk_data_by_range_concurrent";
+	off64_t chunk_range_start_offset     = 0;
+	ssize_t read_count                   = 0;
+	uint64_t number_of_sectors           = 0;
+	uint64_t start_sector                = 0;
+	int result                           = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media values - chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	/* Another reader could have cached the chunk data since the data range was retrieved
+	 */
+	result = libewf_chunk_cache_get_chunk_data(
+	          chunk_table->chunk_cache,
+	          chunk_index,
+	          &safe_chunk_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data from cache.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		chunk_range_start_offset = (off64_t) ( chunk_index * media_values->chunk_size );
+
+		if( ( data_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported chunk: %" PRIu64 " data flags.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( libewf_chunk_data_initialize(
+		     &safe_chunk_data,
+		     io_handle->chunk_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk data.",
+			 function );
+
+			goto on_error;
+		}
+		read_count = libewf_chunk_table_read_chunk_data(
+			      chunk_table,
+			      safe_chunk_data,
+			      file_io_pool,
+			      file_io_pool_entry,
+			      data_offset,
+			      data_size,
+			      data_flags,
+			      error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		safe_chunk_data->chunk_index        = chunk_index;
+		safe_chunk_data->range_start_offset = chunk_range_start_offset;
+		safe_chunk_data->range_end_offset   = chunk_range_start_offset + media_values->chunk_size;
+
+		if( (size64_t) safe_chunk_data->range_end_offset > media_values->media_size )
+		{
+			safe_chunk_data->range_end_offset = (off64_t) media_values->media_size;
+		}
+		if( libewf_chunk_data_unpack(
+		     safe_chunk_data,
+		     io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unpack chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( ( safe_chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+		{
+			start_sector      = (uint64_t) chunk_range_start_offset / media_values->bytes_per_sector;
+			number_of_sectors = media_values->sectors_per_chunk;
+
+			if( ( start_sector + number_of_sectors ) > (uint64_t) media_values->number_of_sectors )
+			{
+				number_of_sectors = (uint64_t) media_values->number_of_sectors - start_sector;
+			}
+			if( libewf_chunk_table_append_checksum_error(
+			     chunk_table,
+			     start_sector,
+			     number_of_sectors,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append checksum error.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		/* If all cache entries are referenced by other readers the chunk data
+		 * remains owned by the caller and is freed on release
+		 */
+		if( libewf_chunk_cache_set_chunk_data(
+		     chunk_table->chunk_cache,
+		     chunk_index,
+		     &safe_chunk_data,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk: %" PRIu64 " data in cache.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+	*chunk_data = safe_chunk_data;
+
+	return( 1 );
+
+on_error:
+	if( safe_chunk_data != NULL )
+	{
+		libewf_chunk_table_release_chunk_data_concurrent(
+		 chunk_table,
+		 &safe_chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the chunk data of a chunk at a specific offset
+ * This function is multi-thread safe, it can be called by multiple readers that share
+ * the handle read lock. The chunk table lookups are serialized, the chunk data is read
+ * and unpacked outside the chunk table mutex.
+ * The chunk data must be released with libewf_chunk_table_release_chunk_data_concurrent
+ * Adds a checksum error if the data is corrupted
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libewf_chunk_table_get_chunk_data_by_offset_concurrent(
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     off64_t offset,
+     off64_t *chunk_data_offset,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *safe_chunk_data = NULL;
+	static char *function                = "libewf_chunk_table_get_chunk_data_by_offset_concurrent";
+	off64_t chunk_range_start_offset     = 0;
+	off64_t data_offset                  = 0;
+	size64_t data_size                   = 0;
+	uint64_t chunk_index                 = 0;
+	uint32_t data_flags                  = 0;
+	int file_io_pool_entry               = 0;
+	int result                           = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media values - chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_index              = (uint64_t) offset / media_values->chunk_size;
+	chunk_range_start_offset = (off64_t) ( chunk_index * media_values->chunk_size );
+
+	result = libewf_chunk_cache_get_chunk_data(
+	          chunk_table->chunk_cache,
+	          chunk_index,
+	          &safe_chunk_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data from cache.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     chunk_table->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		result = libewf_chunk_table_get_chunk_data_range_by_offset(
+		          chunk_table,
+		          file_io_pool,
+		          media_values,
+		          segment_table,
+		          offset,
+		          &file_io_pool_entry,
+		          &data_offset,
+		          &data_size,
+		          &data_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " data range.",
+			 function,
+			 chunk_index );
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     chunk_table->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		if( result != 1 )
+		{
+			goto on_error;
+		}
+		if( libewf_chunk_table_get_chunk_data_by_range_concurrent(
+		     chunk_table,
+		     io_handle,
+		     file_io_pool,
+		     media_values,
+		     chunk_index,
+		     file_io_pool_entry,
+		     data_offset,
+		     data_size,
+		     data_flags,
+		     &safe_chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+	*chunk_data_offset = offset - chunk_range_start_offset;
+	*chunk_data        = safe_chunk_data;
+
+	return( 1 );
+
+on_error:
+	if( safe_chunk_data != NULL )
+	{
+		libewf_chunk_table_release_chunk_data_concurrent(
+		 chunk_table,
+		 &safe_chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Releases chunk data retrieved by libewf_chunk_table_get_chunk_data_by_offset_concurrent
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_release_chunk_data_concurrent(
+     libewf_chunk_table_t *chunk_table,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_table_release_chunk_data_concurrent";
+	int result            = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data == NULL )
+	{
+		return( 1 );
+	}
+	result = libewf_chunk_cache_release_chunk_data(
+	          chunk_table->chunk_cache,
+	          *chunk_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk data in cache.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		/* The chunk data is not managed by the cache
+		 */
+		if( libewf_chunk_data_free(
+		     chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	*chunk_data = NULL;
+
+	return( 1 );
+}
+
+/* Reads the chunk at a specific offset directly into a buffer
+ * The offset must be the start of a chunk and the buffer must be able to contain the chunk size
+ * Chunk data that is not in the chunk cache is unpacked into the buffer without being cached
+ * This function is multi-thread safe, see libewf_chunk_table_get_chunk_data_by_offset_concurrent
+ * Adds a checksum error if the data is corrupted
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_chunk_table_read_chunk_by_offset(
+         libewf_chunk_table_t *chunk_table,
+         libewf_io_handle_t *io_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_media_values_t *media_values,
+         libewf_segment_table_t *segment_table,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_chunk_table_read_chunk_by_offset";
+	off64_t data_offset             = 0;
+	size64_t data_size              = 0;
+	size_t read_size                = 0;
+	ssize_t read_count              = 0;
+	uint64_t chunk_index            = 0;
+	uint64_t number_of_sectors      = 0;
+	uint64_t start_sector           = 0;
+	uint32_t data_flags             = 0;
+	int file_io_pool_entry          = 0;
+	int result                      = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( media_values->chunk_size == 0 )
+	 || ( media_values->chunk_size != io_handle->chunk_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media values - chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( ( (uint64_t) offset % media_values->chunk_size ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size < (size_t) media_values->chunk_size )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_index = (uint64_t) offset / media_values->chunk_size;
+
+	/* Chunk data that is already cached, for example by the read-ahead,
+	 * is copied from the chunk cache
+	 */
+	result = libewf_chunk_cache_get_chunk_data(
+	          chunk_table->chunk_cache,
+	          chunk_index,
+	          &chunk_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data from cache.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     chunk_table->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		result = libewf_chunk_table_get_chunk_data_range_by_offset(
+		          chunk_table,
+		          file_io_pool,
+		          media_values,
+		          segment_table,
+		          offset,
+		          &file_io_pool_entry,
+		          &data_offset,
+		          &data_size,
+		          &data_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " data range.",
+			 function,
+			 chunk_index );
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     chunk_table->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		if( result != 1 )
+		{
+			goto on_error;
+		}
+		if( ( data_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported chunk: %" PRIu64 " data flags.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( libewf_chunk_data_initialize(
+		     &chunk_data,
+		     io_handle->chunk_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk data.",
+			 function );
+
+			goto on_error;
+		}
+		read_count = libewf_chunk_table_read_chunk_data(
+			      chunk_table,
+			      chunk_data,
+			      file_io_pool,
+			      file_io_pool_entry,
+			      data_offset,
+			      data_size,
+			      data_flags,
+			      error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		chunk_data->chunk_index = chunk_index;
+
+		result = libewf_chunk_data_unpack_to_buffer(
+		          chunk_data,
+		          io_handle,
+		          buffer,
+		          buffer_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unpack chunk: %" PRIu64 " data into buffer.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			if( libewf_chunk_data_free(
+			     &chunk_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk data.",
+				 function );
+
+				goto on_error;
+			}
+			return( (ssize_t) media_values->chunk_size );
+		}
+		/* The chunk data could not be unpacked into the buffer, for example
+		 * because it is corrupted, unpack it as for any other read
+		 */
+		if( libewf_chunk_data_unpack(
+		     chunk_data,
+		     io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unpack chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+		{
+			start_sector      = (uint64_t) offset / media_values->bytes_per_sector;
+			number_of_sectors = media_values->sectors_per_chunk;
+
+			if( ( start_sector + number_of_sectors ) > (uint64_t) media_values->number_of_sectors )
+			{
+				number_of_sectors = (uint64_t) media_values->number_of_sectors - start_sector;
+			}
+			if( libewf_chunk_table_append_checksum_error(
+			     chunk_table,
+			     start_sector,
+			     number_of_sectors,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append checksum error.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	read_size = chunk_data->data_size;
+
+	if( read_size > buffer_size )
+	{
+		read_size = buffer_size;
+	}
+	if( memory_copy(
+	     buffer,
+	     chunk_data->data,
+	     read_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( libewf_chunk_table_release_chunk_data_concurrent(
+	     chunk_table,
+	     &chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	return( (ssize_t) read_size );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_table_release_chunk_data_concurrent(
+		 chunk_table,
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the chunk data of a chunk at a specific offset and pins it
+ * The chunk data remains valid until it is unpinned or the chunk table is freed
+ * This function can be called by multiple threads concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_pin_chunk_data_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     off64_t offset,
+     off64_t *chunk_data_offset,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *pinned_chunk_data = NULL;
+	libewf_chunk_data_t *safe_chunk_data   = NULL;
+	static char *function                  = "libewf_chunk_table_pin_chunk_data_by_offset";
+	int entry_index                        = 0;
+	int number_of_entries                  = 0;
+	int result                             = 1;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_table_get_chunk_data_by_offset_concurrent(
+	     chunk_table,
+	     io_handle,
+	     file_io_pool,
+	     media_values,
+	     segment_table,
+	     offset,
+	     chunk_data_offset,
+	     &safe_chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_table->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	/* Reuse the entry of a previously unpinned chunk data if available
+	 */
+	result = libcdata_array_get_number_of_entries(
+	          chunk_table->pinned_chunk_data,
+	          &number_of_entries,
+	          error );
+
+	for( entry_index = 0;
+	     ( result == 1 ) && ( entry_index < number_of_entries );
+	     entry_index++ )
+	{
+		result = libcdata_array_get_entry_by_index(
+		          chunk_table->pinned_chunk_data,
+		          entry_index,
+		          (intptr_t **) &pinned_chunk_data,
+		          error );
+
+		if( ( result == 1 )
+		 && ( pinned_chunk_data == NULL ) )
+		{
+			break;
+		}
+	}
+	if( result == 1 )
+	{
+		if( entry_index < number_of_entries )
+		{
+			result = libcdata_array_set_entry_by_index(
+			          chunk_table->pinned_chunk_data,
+			          entry_index,
+			          (intptr_t *) safe_chunk_data,
+			          error );
+		}
+		else
+		{
+			result = libcdata_array_append_entry(
+			          chunk_table->pinned_chunk_data,
+			          &entry_index,
+			          (intptr_t *) safe_chunk_data,
+			          error );
+		}
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set pinned chunk data.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_table->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	*chunk_data = safe_chunk_data;
+
+	return( 1 );
+
+on_error:
+	libewf_chunk_table_release_chunk_data_concurrent(
+	 chunk_table,
+	 &safe_chunk_data,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Unpins the chunk data that contains specific data
+ * This function can be called by multiple threads concurrently
+ * Returns 1 if successful, 0 if the data is not pinned or -1 on error
+ */
+int libewf_chunk_table_unpin_chunk_data(
+     libewf_chunk_table_t *chunk_table,
+     const uint8_t *data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *pinned_chunk_data = NULL;
+	static char *function                  = "libewf_chunk_table_unpin_chunk_data";
+	int entry_index                        = 0;
+	int number_of_entries                  = 0;
+	int result                             = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_table->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_get_number_of_entries(
+	     chunk_table->pinned_chunk_data,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of pinned chunk data.",
+		 function );
+
+		result = -1;
+	}
+	for( entry_index = 0;
+	     ( result == 0 ) && ( entry_index < number_of_entries );
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     chunk_table->pinned_chunk_data,
+		     entry_index,
+		     (intptr_t **) &pinned_chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve pinned chunk data: %d.",
+			 function,
+			 entry_index );
+
+			result = -1;
+		}
+		else if( ( pinned_chunk_data != NULL )
+		      && ( data >= pinned_chunk_data->data )
+		      && ( data <= &( ( pinned_chunk_data->data )[ pinned_chunk_data->data_size ] ) ) )
+		{
+			if( libcdata_array_set_entry_by_index(
+			     chunk_table->pinned_chunk_data,
+			     entry_index,
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set pinned chunk data: %d.",
+				 function,
+				 entry_index );
+
+				result = -1;
+			}
+			else
+			{
+				result = 1;
+			}
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_table->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result == 1 )
+	{
+		if( libewf_chunk_table_release_chunk_data_concurrent(
+		     chunk_table,
+		     &pinned_chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release chunk data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Unpins all pinned chunk data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_unpin_all_chunk_data(
+     libewf_chunk_table_t *chunk_table,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *pinned_chunk_data = NULL;
+	static char *function                  = "libewf_chunk_table_unpin_all_chunk_data";
+	int entry_index                        = 0;
+	int number_of_entries                  = 0;
+	int result                             = 1;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     chunk_table->pinned_chunk_data,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of pinned chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     chunk_table->pinned_chunk_data,
+		     entry_index,
+		     (intptr_t **) &pinned_chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve pinned chunk data: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( libewf_chunk_table_release_chunk_data_concurrent(
+		     chunk_table,
+		     &pinned_chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release pinned chunk data: %d.",
+			 function,
+			 entry_index );
+
+			result = -1;
+		}
+	}
+	if( libcdata_array_empty(
+	     chunk_table->pinned_chunk_data,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty pinned chunk data array.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Resizes the chunk cache
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_resize_chunk_cache(
+     libewf_chunk_table_t *chunk_table,
+     int maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_table_resize_chunk_cache";
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	/* The chunk data referenced by the last sequential read is released
+	 * so that it can be evicted when the cache shrinks
+	 */
+	if( libewf_chunk_table_release_chunk_data_concurrent(
+	     chunk_table,
+	     &( chunk_table->cached_chunk_data ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release cached chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_cache_resize(
+	     chunk_table->chunk_cache,
+	     maximum_number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
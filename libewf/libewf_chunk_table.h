@@ -25,12 +25,17 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_chunk_cache.h"
+#include "libewf_chunk_data.h"
 #include "libewf_chunk_group.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
+#include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
+#include "libewf_memory_map.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
 
@@ -58,6 +63,10 @@ struct libewf_chunk_table
 	 */
 	libewf_chunk_data_t *current_chunk_data;
 
+	/* The chunk data referenced in the chunk cache by the last sequential read
+	 */
+	libewf_chunk_data_t *cached_chunk_data;
+
 	/* The chunk size
 	 */
 	uint32_t chunk_size;
@@ -74,13 +83,27 @@ struct libewf_chunk_table
 	 */
 	libfcache_cache_t *chunk_groups_cache;
 
-	/* The chunk data cache
-	 */
-	libfcache_cache_t *chunk_data_cache;
-
 	/* The single chunk data cache
 	 */
 	libfcache_cache_t *single_chunk_data_cache;
+
+	/* The chunk cache
+	 */
+	libewf_chunk_cache_t *chunk_cache;
+
+	/* The chunk data pinned by zero-copy readers
+	 */
+	libcdata_array_t *pinned_chunk_data;
+
+	/* The memory mapped segment files, indexed by file IO pool entry
+	 */
+	libcdata_array_t *memory_maps;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex that serializes chunk table lookups of concurrent readers
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
 };
 
 int libewf_chunk_table_initialize(
@@ -97,6 +120,22 @@ int libewf_chunk_table_clone(
      libewf_chunk_table_t *source_chunk_table,
      libcerror_error_t **error );
 
+int libewf_chunk_table_set_memory_map(
+     libewf_chunk_table_t *chunk_table,
+     int file_io_pool_entry,
+     const char *filename,
+     libcerror_error_t **error );
+
+ssize_t libewf_chunk_table_read_chunk_data(
+         libewf_chunk_table_t *chunk_table,
+         libewf_chunk_data_t *chunk_data,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         off64_t data_offset,
+         size64_t data_size,
+         uint32_t data_flags,
+         libcerror_error_t **error );
+
 int libewf_chunk_table_get_number_of_checksum_errors(
      libewf_chunk_table_t *chunk_table,
      uint32_t *number_of_errors,
@@ -161,6 +200,83 @@ int libewf_chunk_table_get_chunk_data_by_offset_no_cache(
      libewf_chunk_data_t **chunk_data,
      libcerror_error_t **error );
 
+int libewf_chunk_table_get_chunk_data_range_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     off64_t offset,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *chunk_data_flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_get_chunk_data_by_range_concurrent(
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     uint64_t chunk_index,
+     int file_io_pool_entry,
+     off64_t data_offset,
+     size64_t data_size,
+     uint32_t data_flags,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_get_chunk_data_by_offset_concurrent(
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     off64_t offset,
+     off64_t *chunk_data_offset,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_release_chunk_data_concurrent(
+     libewf_chunk_table_t *chunk_table,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+ssize_t libewf_chunk_table_read_chunk_by_offset(
+         libewf_chunk_table_t *chunk_table,
+         libewf_io_handle_t *io_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_media_values_t *media_values,
+         libewf_segment_table_t *segment_table,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+int libewf_chunk_table_pin_chunk_data_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     off64_t offset,
+     off64_t *chunk_data_offset,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_unpin_chunk_data(
+     libewf_chunk_table_t *chunk_table,
+     const uint8_t *data,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_unpin_all_chunk_data(
+     libewf_chunk_table_t *chunk_table,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_resize_chunk_cache(
+     libewf_chunk_table_t *chunk_table,
+     int maximum_number_of_entries,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,1121 @@
+/*
+ * Compression context functions
+ *
+ * Copyright (C) 2006-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#include "libewf_compression.h"
+#include "libewf_compression_context.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+
+/* Creates a compression context
+ * Make sure the value compression_context is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_initialize(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_initialize";
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid compression context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*compression_context = memory_allocate_structure(
+	                        libewf_compression_context_t );
+
+	if( *compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compression context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *compression_context,
+	     0,
+	     sizeof( libewf_compression_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear compression context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *compression_context != NULL )
+	{
+		memory_free(
+		 *compression_context );
+
+		*compression_context = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a compression context
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_free(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_free";
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context != NULL )
+	{
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+		if( ( *compression_context )->deflate_stream_is_initialized != 0 )
+		{
+			deflateEnd(
+			 &( ( *compression_context )->deflate_stream ) );
+		}
+#endif
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+		if( ( *compression_context )->inflate_stream_is_initialized != 0 )
+		{
+			inflateEnd(
+			 &( ( *compression_context )->inflate_stream ) );
+		}
+#endif
+		memory_free(
+		 *compression_context );
+
+		*compression_context = NULL;
+	}
+	return( 1 );
+}
+
+/* Compresses data using the compression method
+ * For deflate the zlib stream of the compression context is reused instead of
+ * allocating and initializing a new stream for every call
+ * Returns 1 on success, 0 if buffer is too small or -1 on error
+ */
+int libewf_compression_context_compress_data(
+     libewf_compression_context_t *compression_context,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     uint16_t compression_method,
+     int8_t compression_level,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_compression_context_compress_data";
+	int result                 = 0;
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+	int zlib_compression_level = 0;
+#endif
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == uncompressed_data )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data buffer equals compressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+	/* The zlib stream can only process sizes up to UINT_MAX in a single call
+	 */
+	if( ( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
+	 && ( *compressed_data_size <= (size_t) UINT_MAX )
+	 && ( uncompressed_data_size <= (size_t) UINT_MAX ) )
+	{
+		if( ( compression_context->deflate_stream_is_initialized != 0 )
+		 && ( compression_context->deflate_compression_level != compression_level ) )
+		{
+			deflateEnd(
+			 &( compression_context->deflate_stream ) );
+
+			compression_context->deflate_stream_is_initialized = 0;
+		}
+		if( compression_context->deflate_stream_is_initialized == 0 )
+		{
+			if( compression_level == LIBEWF_COMPRESSION_LEVEL_DEFAULT )
+			{
+				zlib_compression_level = Z_DEFAULT_COMPRESSION;
+			}
+			else if( compression_level == LIBEWF_COMPRESSION_LEVEL_FAST )
+			{
+				zlib_compression_level = Z_BEST_SPEED;
+			}
+			else if( compression_level == LIBEWF_COMPRESSION_LEVEL_BEST )
+			{
+				zlib_compression_level = Z_BEST_COMPRESSION;
+			}
+			else if( compression_level == LIBEWF_COMPRESSION_LEVEL_NONE )
+			{
+				zlib_compression_level = Z_NO_COMPRESSION;
+			}
+			else
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported compression level.",
+				 function );
+
+				return( -1 );
+			}
+			if( memory_set(
+			     &( compression_context->deflate_stream ),
+			     0,
+			     sizeof( z_stream ) ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear deflate stream.",
+				 function );
+
+				return( -1 );
+			}
+			result = deflateInit(
+			          &( compression_context->deflate_stream ),
+			          zlib_compression_level );
+		}
+		else
+		{
+			result = deflateReset(
+			          &( compression_context->deflate_stream ) );
+		}
+		if( result != Z_OK )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize deflate stream with error: %d.",
+			 function,
+			 result );
+
+			return( -1 );
+		}
+		compression_context->deflate_stream_is_initialized = 1;
+		compression_context->deflate_compression_level     = compression_level;
+
+		compression_context->deflate_stream.next_in   = (Bytef *) uncompressed_data;
+		compression_context->deflate_stream.avail_in  = (uInt) uncompressed_data_size;
+		compression_context->deflate_stream.next_out  = (Bytef *) compressed_data;
+		compression_context->deflate_stream.avail_out = (uInt) *compressed_data_size;
+
+		result = deflate(
+		          &( compression_context->deflate_stream ),
+		          Z_FINISH );
+
+		if( result == Z_STREAM_END )
+		{
+			*compressed_data_size = (size_t) compression_context->deflate_stream.total_out;
+
+			result = 1;
+		}
+		else if( ( result == Z_OK )
+		      || ( result == Z_BUF_ERROR ) )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to write compressed data: target buffer too small.\n",
+				 function );
+			}
+#endif
+			*compressed_data_size = (size_t) deflateBound(
+			                                  &( compression_context->deflate_stream ),
+			                                  (uLong) uncompressed_data_size );
+
+			result = 0;
+		}
+		else
+		{
+			/* The stream is re-initialized on the next call after an error
+			 */
+			deflateEnd(
+			 &( compression_context->deflate_stream ) );
+
+			compression_context->deflate_stream_is_initialized = 0;
+
+			if( result == Z_MEM_ERROR )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to write compressed data: insufficient memory.",
+				 function );
+			}
+			else
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+				 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+				 "%s: zlib returned undefined error: %d.",
+				 function,
+				 result );
+			}
+			*compressed_data_size = 0;
+
+			result = -1;
+		}
+		return( result );
+	}
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL ) */
+
+	/* Other compression methods are handled by the single call functions
+	 */
+	result = libewf_compress_data(
+	          compressed_data,
+	          compressed_data_size,
+	          compression_method,
+	          compression_level,
+	          uncompressed_data,
+	          uncompressed_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: unable to compress data.",
+		 function );
+	}
+	return( result );
+}
+
+/* Decompresses data using the compression method
+ * For deflate the zlib stream of the compression context is reused instead of
+ * allocating and initializing a new stream for every call
+ * Returns 1 on success, 0 on failure or -1 on error
+ */
+int libewf_compression_context_decompress_data(
+     libewf_compression_context_t *compression_context,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint16_t compression_method,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_decompress_data";
+	int result            = 0;
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == compressed_data )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data buffer equals uncompressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+	/* The zlib stream can only process sizes up to UINT_MAX in a single call
+	 */
+	if( ( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
+	 && ( compressed_data_size <= (size_t) UINT_MAX )
+	 && ( *uncompressed_data_size <= (size_t) UINT_MAX ) )
+	{
+		if( compression_context->inflate_stream_is_initialized == 0 )
+		{
+			if( memory_set(
+			     &( compression_context->inflate_stream ),
+			     0,
+			     sizeof( z_stream ) ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear inflate stream.",
+				 function );
+
+				return( -1 );
+			}
+			result = inflateInit(
+			          &( compression_context->inflate_stream ) );
+		}
+		else
+		{
+			result = inflateReset(
+			          &( compression_context->inflate_stream ) );
+		}
+		if( result != Z_OK )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize inflate stream with error: %d.",
+			 function,
+			 result );
+
+			return( -1 );
+		}
+		compression_context->inflate_stream_is_initialized = 1;
+
+		compression_context->inflate_stream.next_in   = (Bytef *) compressed_data;
+		compression_context->inflate_stream.avail_in  = (uInt) compressed_data_size;
+		compression_context->inflate_stream.next_out  = (Bytef *) uncompressed_data;
+		compression_context->inflate_stream.avail_out = (uInt) *uncompressed_data_size;
+
+		result = inflate(
+		          &( compression_context->inflate_stream ),
+		          Z_FINISH );
+
+		/* Similar to uncompress, running out of input data is considered a data error
+		 */
+		if( ( ( result == Z_OK )
+		  || ( result == Z_BUF_ERROR ) )
+		 && ( compression_context->inflate_stream.avail_out != 0 ) )
+		{
+			result = Z_DATA_ERROR;
+		}
+		if( result == Z_STREAM_END )
+		{
+			*uncompressed_data_size = (size_t) compression_context->inflate_stream.total_out;
+
+			result = 1;
+		}
+		else if( ( result == Z_DATA_ERROR )
+		      || ( result == Z_NEED_DICT ) )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to read compressed data: data error.\n",
+				 function );
+			}
+#endif
+			*uncompressed_data_size = 0;
+
+			result = -1;
+		}
+		else if( ( result == Z_OK )
+		      || ( result == Z_BUF_ERROR ) )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				"%s: unable to read compressed data: target buffer too small.\n",
+				 function );
+			}
+#endif
+			/* Estimate that a factor 2 enlargement should suffice
+			 */
+			*uncompressed_data_size *= 2;
+
+			result = 0;
+		}
+		else
+		{
+			/* The stream is re-initialized on the next call after an error
+			 */
+			inflateEnd(
+			 &( compression_context->inflate_stream ) );
+
+			compression_context->inflate_stream_is_initialized = 0;
+
+			if( result == Z_MEM_ERROR )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to read compressed data: insufficient memory.",
+				 function );
+			}
+			else
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+				 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+				 "%s: zlib returned undefined error: %d.",
+				 function,
+				 result );
+			}
+			*uncompressed_data_size = 0;
+
+			result = -1;
+		}
+		return( result );
+	}
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL ) */
+
+	/* Other compression methods are handled by the single call functions
+	 */
+	result = libewf_decompress_data(
+	          compressed_data,
+	          compressed_data_size,
+	          compression_method,
+	          uncompressed_data,
+	          uncompressed_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+		 "%s: unable to decompress data.",
+		 function );
+	}
+	return( result );
+}
+
+/* Creates a compression context pool
+ * Make sure the value compression_context_pool is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_pool_initialize(
+     libewf_compression_context_pool_t **compression_context_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_pool_initialize";
+
+	if( compression_context_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid compression context pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*compression_context_pool = memory_allocate_structure(
+	                             libewf_compression_context_pool_t );
+
+	if( *compression_context_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compression context pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *compression_context_pool,
+	     0,
+	     sizeof( libewf_compression_context_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear compression context pool.",
+		 function );
+
+		memory_free(
+		 *compression_context_pool );
+
+		*compression_context_pool = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *compression_context_pool )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *compression_context_pool != NULL )
+	{
+		memory_free(
+		 *compression_context_pool );
+
+		*compression_context_pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a compression context pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_pool_free(
+     libewf_compression_context_pool_t **compression_context_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_pool_free";
+	int context_index     = 0;
+	int result            = 1;
+
+	if( compression_context_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context_pool != NULL )
+	{
+		for( context_index = 0;
+		     context_index < ( *compression_context_pool )->number_of_compression_contexts;
+		     context_index++ )
+		{
+			if( libewf_compression_context_free(
+			     &( ( *compression_context_pool )->compression_contexts[ context_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free compression context: %d.",
+				 function,
+				 context_index );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *compression_context_pool )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *compression_context_pool );
+
+		*compression_context_pool = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves a compression context from the pool
+ * A new compression context is created if the pool has none available
+ * The compression context must be released back to the pool after use
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_pool_get_context(
+     libewf_compression_context_pool_t *compression_context_pool,
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	libewf_compression_context_t *safe_compression_context = NULL;
+	static char *function                                  = "libewf_compression_context_pool_get_context";
+
+	if( compression_context_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     compression_context_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( compression_context_pool->number_of_compression_contexts > 0 )
+	{
+		compression_context_pool->number_of_compression_contexts -= 1;
+
+		safe_compression_context = compression_context_pool->compression_contexts[ compression_context_pool->number_of_compression_contexts ];
+
+		compression_context_pool->compression_contexts[ compression_context_pool->number_of_compression_contexts ] = NULL;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     compression_context_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( safe_compression_context == NULL )
+	{
+		if( libewf_compression_context_initialize(
+		     &safe_compression_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create compression context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	*compression_context = safe_compression_context;
+
+	return( 1 );
+
+on_error:
+	if( safe_compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 &safe_compression_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Releases a compression context back to the pool
+ * The compression context is freed if the pool is full
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_pool_release_context(
+     libewf_compression_context_pool_t *compression_context_pool,
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_pool_release_context";
+
+	if( compression_context_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context == NULL )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     compression_context_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( compression_context_pool->number_of_compression_contexts < LIBEWF_COMPRESSION_CONTEXT_POOL_MAXIMUM_NUMBER_OF_CONTEXTS )
+	{
+		compression_context_pool->compression_contexts[ compression_context_pool->number_of_compression_contexts ] = *compression_context;
+
+		compression_context_pool->number_of_compression_contexts += 1;
+
+		*compression_context = NULL;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     compression_context_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( *compression_context != NULL )
+	{
+		if( libewf_compression_context_free(
+		     compression_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compression context.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Compresses data using the compression method and a compression context from the pool
+ * Returns 1 on success, 0 if buffer is too small or -1 on error
+ */
+int libewf_compression_context_pool_compress_data(
+     libewf_compression_context_pool_t *compression_context_pool,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     uint16_t compression_method,
+     int8_t compression_level,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	libewf_compression_context_t *compression_context = NULL;
+	static char *function                             = "libewf_compression_context_pool_compress_data";
+	int result                                        = 0;
+
+	if( libewf_compression_context_pool_get_context(
+	     compression_context_pool,
+	     &compression_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve compression context.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_compression_context_compress_data(
+	          compression_context,
+	          compressed_data,
+	          compressed_data_size,
+	          compression_method,
+	          compression_level,
+	          uncompressed_data,
+	          uncompressed_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: unable to compress data.",
+		 function );
+	}
+	if( libewf_compression_context_pool_release_context(
+	     compression_context_pool,
+	     &compression_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release compression context.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Decompresses data using the compression method and a compression context from the pool
+ * Returns 1 on success, 0 on failure or -1 on error
+ */
+int libewf_compression_context_pool_decompress_data(
+     libewf_compression_context_pool_t *compression_context_pool,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint16_t compression_method,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	libewf_compression_context_t *compression_context = NULL;
+	static char *function                             = "libewf_compression_context_pool_decompress_data";
+	int result                                        = 0;
+
+	if( libewf_compression_context_pool_get_context(
+	     compression_context_pool,
+	     &compression_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve compression context.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_compression_context_decompress_data(
+	          compression_context,
+	          compressed_data,
+	          compressed_data_size,
+	          compression_method,
+	          uncompressed_data,
+	          uncompressed_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+		 "%s: unable to decompress data.",
+		 function );
+	}
+	if( libewf_compression_context_pool_release_context(
+	     compression_context_pool,
+	     &compression_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release compression context.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
@@ -269,6 +269,10 @@ int libewf_internal_data_chunk_set_chunk_data(
 	if( result != -1 )
 	{
 		internal_data_chunk->chunk_data = chunk_data;
+
+		/* The data size is needed to write the chunk data to another handle
+		 */
+		internal_data_chunk->data_size = (size_t) ( chunk_data->range_end_offset - chunk_data->range_start_offset );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -363,6 +367,8 @@ int libewf_data_chunk_is_corrupted(
 /* Reads a buffer from the data chunk
  * It applies decompression if necessary and validates the chunk checksum
  * This function should be used after libewf_handle_read_data_chunk
+ * If the data could be decompressed directly into the buffer the data chunk
+ * remains packed and can be passed to libewf_handle_write_data_chunk of another handle
  * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
  */
 ssize_t libewf_data_chunk_read_buffer(
@@ -374,6 +380,7 @@ ssize_t libewf_data_chunk_read_buffer(
 	libewf_internal_data_chunk_t *internal_data_chunk = NULL;
 	static char *function                             = "libewf_data_chunk_read_buffer";
 	ssize_t read_count                                = 0;
+	int result                                        = 0;
 
 	if( data_chunk == NULL )
 	{
@@ -416,24 +423,59 @@ ssize_t libewf_data_chunk_read_buffer(
 #endif
 	if( ( internal_data_chunk->chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 )
 	{
-/* TODO optimize to unpack directly to buffer */
-		if( libewf_chunk_data_unpack(
-		     internal_data_chunk->chunk_data,
-		     internal_data_chunk->io_handle,
-		     error ) != 1 )
+		/* Unpacking directly into the buffer leaves the chunk data packed
+		 * so that it can be written to another handle as-is
+		 */
+		if( buffer_size >= (size_t) internal_data_chunk->chunk_data->chunk_size )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to unpack chunk: %" PRIu64 " data.",
-			 function,
-			 internal_data_chunk->chunk_data->chunk_index );
-
-			read_count = -1;
+			result = libewf_chunk_data_unpack_to_buffer(
+			          internal_data_chunk->chunk_data,
+			          internal_data_chunk->io_handle,
+			          (uint8_t *) buffer,
+			          buffer_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to unpack chunk: %" PRIu64 " data into buffer.",
+				 function,
+				 internal_data_chunk->chunk_data->chunk_index );
+
+				read_count = -1;
+			}
+			else if( result != 0 )
+			{
+				read_count = (ssize_t) internal_data_chunk->chunk_data->chunk_size;
+			}
+		}
+		/* The chunk data could not be unpacked into the buffer, for example
+		 * because it is corrupted or smaller than the chunk size
+		 */
+		if( result == 0 )
+		{
+			if( libewf_chunk_data_unpack(
+			     internal_data_chunk->chunk_data,
+			     internal_data_chunk->io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to unpack chunk: %" PRIu64 " data.",
+				 function,
+				 internal_data_chunk->chunk_data->chunk_index );
+
+				read_count = -1;
+			}
 		}
 	}
-	if( read_count != -1 )
+	if( ( read_count != -1 )
+	 && ( result == 0 ) )
 	{
 		read_count = libewf_chunk_data_read_buffer(
 		              internal_data_chunk->chunk_data,
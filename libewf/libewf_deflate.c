@@ -25,6 +25,7 @@
 #include <types.h>
 
 #include "libewf_bit_stream.h"
+#include "libewf_checksum.h"
 #include "libewf_deflate.h"
 #include "libewf_huffman_tree.h"
 #include "libewf_libcerror.h"
@@ -458,6 +459,8 @@ int libewf_deflate_decode_huffman(
      libcerror_error_t **error )
 {
 	static char *function         = "libewf_deflate_decode_huffman";
+	size_t copy_offset            = 0;
+	size_t copy_size              = 0;
 	size_t data_offset            = 0;
 	uint32_t extra_bits           = 0;
 	uint16_t compression_offset   = 0;
@@ -590,7 +593,8 @@ int libewf_deflate_decode_huffman(
 			}
 			compression_offset = libewf_deflate_distance_codes_base[ symbol ] + (uint16_t) extra_bits;
 
-			if( compression_offset > data_offset )
+			if( ( compression_offset == 0 )
+			 || ( compression_offset > data_offset ) )
 			{
 				libcerror_error_set(
 				 error,
@@ -612,12 +616,49 @@ int libewf_deflate_decode_huffman(
 
 				return( -1 );
 			}
-			while( compression_size > 0 )
+			/* Short matches are copied byte by byte, longer matches are copied in blocks
+			 * that do not overlap, for a match that overlaps its source the size of
+			 * the non-overlapping block doubles every iteration
+			 */
+			if( compression_size < 32 )
+			{
+				while( compression_size > 0 )
+				{
+					uncompressed_data[ data_offset ] = uncompressed_data[ data_offset - compression_offset ];
+
+					data_offset++;
+					compression_size--;
+				}
+			}
+			else
 			{
-				uncompressed_data[ data_offset ] = uncompressed_data[ data_offset - compression_offset ];
+				copy_offset = data_offset - compression_offset;
 
-				data_offset++;
-				compression_size--;
+				while( compression_size > 0 )
+				{
+					copy_size = data_offset - copy_offset;
+
+					if( copy_size > (size_t) compression_size )
+					{
+						copy_size = (size_t) compression_size;
+					}
+					if( memory_copy(
+					     &( uncompressed_data[ data_offset ] ),
+					     &( uncompressed_data[ copy_offset ] ),
+					     copy_size ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+						 "%s: unable to copy match.",
+						 function );
+
+						return( -1 );
+					}
+					data_offset      += copy_size;
+					compression_size -= (uint16_t) copy_size;
+				}
 			}
 		}
 		else if( symbol != 256 )
@@ -1237,6 +1278,15 @@ int libewf_deflate_read_block(
 
 				goto on_error;
 			}
+			/* The bit buffer can contain bytes read ahead of the uncompressed data
+			 */
+			bit_stream->byte_stream_offset -= bit_stream->bit_buffer_size / 8;
+
+			/* Flush the bit stream buffer
+			 */
+			bit_stream->bit_buffer      = 0;
+			bit_stream->bit_buffer_size = 0;
+
 			if( block_size == 0 )
 			{
 				break;
@@ -1280,11 +1330,6 @@ int libewf_deflate_read_block(
 			bit_stream->byte_stream_offset += block_size;
 			safe_uncompressed_data_offset  += block_size;
 
-			/* Flush the bit stream buffer
-			 */
-			bit_stream->bit_buffer      = 0;
-			bit_stream->bit_buffer_size = 0;
-
 			break;
 
 		case LIBEWF_DEFLATE_BLOCK_TYPE_HUFFMAN_FIXED:
@@ -1536,7 +1581,8 @@ int libewf_deflate_decompress(
 
 		goto on_error;
 	}
-	while( bit_stream->byte_stream_offset < bit_stream->byte_stream_size )
+	while( ( bit_stream->byte_stream_offset < bit_stream->byte_stream_size )
+	    || ( bit_stream->bit_buffer_size >= 8 ) )
 	{
 		if( libewf_deflate_read_block_header(
 		     bit_stream,
@@ -1561,7 +1607,7 @@ int libewf_deflate_decompress(
 				if( libewf_huffman_tree_initialize(
 				     &fixed_huffman_literals_tree,
 				     288,
-				     15,
+				     9,
 				     error ) != 1 )
 				{
 					libcerror_error_set(
@@ -1576,7 +1622,7 @@ int libewf_deflate_decompress(
 				if( libewf_huffman_tree_initialize(
 				     &fixed_huffman_distances_tree,
 				     30,
-				     15,
+				     5,
 				     error ) != 1 )
 				{
 					libcerror_error_set(
@@ -1821,7 +1867,8 @@ int libewf_deflate_decompress_zlib(
 
 		goto on_error;
 	}
-	while( bit_stream->byte_stream_offset < bit_stream->byte_stream_size )
+	while( ( bit_stream->byte_stream_offset < bit_stream->byte_stream_size )
+	    || ( bit_stream->bit_buffer_size >= 8 ) )
 	{
 		if( libewf_deflate_read_block_header(
 		     bit_stream,
@@ -1846,7 +1893,7 @@ int libewf_deflate_decompress_zlib(
 				if( libewf_huffman_tree_initialize(
 				     &fixed_huffman_literals_tree,
 				     288,
-				     15,
+				     9,
 				     error ) != 1 )
 				{
 					libcerror_error_set(
@@ -1861,7 +1908,7 @@ int libewf_deflate_decompress_zlib(
 				if( libewf_huffman_tree_initialize(
 				     &fixed_huffman_distances_tree,
 				     30,
-				     15,
+				     5,
 				     error ) != 1 )
 				{
 					libcerror_error_set(
@@ -1913,18 +1960,20 @@ int libewf_deflate_decompress_zlib(
 			break;
 		}
 	}
+	/* The bit buffer can contain bytes read ahead of the checksum
+	 */
+	bit_stream->byte_stream_offset -= bit_stream->bit_buffer_size / 8;
+
+	bit_stream->bit_buffer      = 0;
+	bit_stream->bit_buffer_size = 0;
+
 	if( ( bit_stream->byte_stream_size - bit_stream->byte_stream_offset ) >= 4 )
 	{
-		while( bit_stream->bit_buffer_size >= 8 )
-		{
-			bit_stream->byte_stream_offset -= 1;
-			bit_stream->bit_buffer_size    -= 8;
-		}
 		byte_stream_copy_to_uint32_big_endian(
 		 &( bit_stream->byte_stream[ bit_stream->byte_stream_offset ] ),
 		 stored_checksum );
 
-		if( libewf_deflate_calculate_adler32(
+		if( libewf_checksum_calculate_adler32(
 		     &calculated_checksum,
 		     uncompressed_data,
 		     uncompressed_data_offset,
@@ -28,6 +28,7 @@
 #include "libewf_analytical_data.h"
 #include "libewf_case_data.h"
 #include "libewf_case_data_section.h"
+#include "libewf_async_read.h"
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_table.h"
 #include "libewf_codepage.h"
@@ -59,6 +60,9 @@
 #include "libewf_libuna.h"
 #include "libewf_ltree_section.h"
 #include "libewf_md5_hash_section.h"
+#include "libewf_parallel_read.h"
+#include "libewf_parallel_write.h"
+#include "libewf_read_ahead.h"
 #include "libewf_restart_data.h"
 #include "libewf_section.h"
 #include "libewf_section_descriptor.h"
@@ -72,6 +76,7 @@
 #include "libewf_types.h"
 #include "libewf_unused.h"
 #include "libewf_value_table.h"
+#include "libewf_vectored_read.h"
 #include "libewf_write_io_handle.h"
 
 #include "ewf_data.h"
@@ -223,6 +228,58 @@ int libewf_handle_initialize(
 
 		goto on_error;
 	}
+	if( libewf_read_ahead_initialize(
+	     &( internal_handle->read_ahead ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read-ahead.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_async_read_initialize(
+	     &( internal_handle->async_read ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create asynchronous read.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_parallel_read_initialize(
+	     &( internal_handle->parallel_read ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create parallel read.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_parallel_write_initialize(
+	     &( internal_handle->parallel_write ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create parallel write.",
+		 function );
+
+		goto on_error;
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_initialize(
 	     &( internal_handle->read_write_lock ),
@@ -240,6 +297,8 @@ int libewf_handle_initialize(
 #endif
 	internal_handle->date_format                    = LIBEWF_DATE_FORMAT_CTIME;
 	internal_handle->maximum_number_of_open_handles = LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES;
+	internal_handle->number_of_read_threads         = 1;
+	internal_handle->number_of_write_threads        = 1;
 
 	*handle = (libewf_handle_t *) internal_handle;
 
@@ -248,6 +307,30 @@ int libewf_handle_initialize(
 on_error:
 	if( internal_handle != NULL )
 	{
+		if( internal_handle->parallel_write != NULL )
+		{
+			libewf_parallel_write_free(
+			 &( internal_handle->parallel_write ),
+			 NULL );
+		}
+		if( internal_handle->parallel_read != NULL )
+		{
+			libewf_parallel_read_free(
+			 &( internal_handle->parallel_read ),
+			 NULL );
+		}
+		if( internal_handle->async_read != NULL )
+		{
+			libewf_async_read_free(
+			 &( internal_handle->async_read ),
+			 NULL );
+		}
+		if( internal_handle->read_ahead != NULL )
+		{
+			libewf_read_ahead_free(
+			 &( internal_handle->read_ahead ),
+			 NULL );
+		}
 		if( internal_handle->acquiry_errors != NULL )
 		{
 			libcdata_range_list_free(
@@ -331,6 +414,58 @@ int libewf_handle_free(
 		}
 		*handle = NULL;
 
+		if( libewf_async_read_free(
+		     &( internal_handle->async_read ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free asynchronous read.",
+			 function );
+
+			result = -1;
+		}
+		if( libewf_parallel_read_free(
+		     &( internal_handle->parallel_read ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free parallel read.",
+			 function );
+
+			result = -1;
+		}
+		if( libewf_parallel_write_free(
+		     &( internal_handle->parallel_write ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free parallel write.",
+			 function );
+
+			result = -1;
+		}
+		if( libewf_read_ahead_free(
+		     &( internal_handle->read_ahead ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead.",
+			 function );
+
+			result = -1;
+		}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 		if( libcthreads_read_write_lock_free(
 		     &( internal_handle->read_write_lock ),
@@ -737,7 +872,77 @@ int libewf_handle_clone(
 		}
 		internal_destination_handle->hash_values_parsed = internal_source_handle->hash_values_parsed;
 	}
+	if( libewf_read_ahead_initialize(
+	     &( internal_destination_handle->read_ahead ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination read-ahead.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_read_ahead_set_values(
+	     internal_destination_handle->read_ahead,
+	     internal_source_handle->read_ahead->maximum_number_of_chunks,
+	     internal_source_handle->read_ahead->number_of_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set destination read-ahead values.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_async_read_initialize(
+	     &( internal_destination_handle->async_read ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination asynchronous read.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_parallel_read_initialize(
+	     &( internal_destination_handle->parallel_read ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination parallel read.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_parallel_write_initialize(
+	     &( internal_destination_handle->parallel_write ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination parallel write.",
+		 function );
+
+		goto on_error;
+	}
 	internal_destination_handle->maximum_number_of_open_handles = internal_source_handle->maximum_number_of_open_handles;
+	internal_destination_handle->cache_memory_budget            = internal_source_handle->cache_memory_budget;
+	internal_destination_handle->number_of_read_threads         = internal_source_handle->number_of_read_threads;
+	internal_destination_handle->number_of_write_threads        = internal_source_handle->number_of_write_threads;
 	internal_destination_handle->date_format                    = internal_source_handle->date_format;
 
 	*destination_handle = (libewf_handle_t *) internal_destination_handle;
@@ -747,6 +952,30 @@ int libewf_handle_clone(
 on_error:
 	if( internal_destination_handle != NULL )
 	{
+		if( internal_destination_handle->parallel_write != NULL )
+		{
+			libewf_parallel_write_free(
+			 &( internal_destination_handle->parallel_write ),
+			 NULL );
+		}
+		if( internal_destination_handle->parallel_read != NULL )
+		{
+			libewf_parallel_read_free(
+			 &( internal_destination_handle->parallel_read ),
+			 NULL );
+		}
+		if( internal_destination_handle->async_read != NULL )
+		{
+			libewf_async_read_free(
+			 &( internal_destination_handle->async_read ),
+			 NULL );
+		}
+		if( internal_destination_handle->read_ahead != NULL )
+		{
+			libewf_read_ahead_free(
+			 &( internal_destination_handle->read_ahead ),
+			 NULL );
+		}
 		if( internal_destination_handle->hash_values != NULL )
 		{
 			libfvalue_table_free(
@@ -1197,6 +1426,46 @@ int libewf_handle_open(
 	{
 		internal_handle->file_io_pool                    = file_io_pool;
 		internal_handle->file_io_pool_created_in_library = 1;
+
+		if( ( access_flags & LIBEWF_ACCESS_FLAG_MEMORY_MAP ) != 0 )
+		{
+			/* The file IO pool entries were appended in the order of the filenames
+			 * Segment files that cannot be memory mapped are read using the file IO pool
+			 */
+			for( filename_index = 0;
+			     filename_index < number_of_filenames;
+			     filename_index++ )
+			{
+				if( libewf_chunk_table_set_memory_map(
+				     internal_handle->chunk_table,
+				     filename_index,
+				     filenames[ filename_index ],
+				     error ) == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to memory map segment file: %s.",
+					 function,
+					 filenames[ filename_index ] );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+					if( libcnotify_verbose != 0 )
+					{
+						if( ( error != NULL )
+						 && ( *error != NULL ) )
+						{
+							libcnotify_print_error_backtrace(
+							 *error );
+						}
+					}
+#endif
+					libcerror_error_free(
+					 error );
+				}
+			}
+		}
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -3445,9 +3714,11 @@ int libewf_internal_handle_open_file_io_pool(
 
 		return( -1 );
 	}
-	if( ( ( access_flags & ~( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) != 0 )
+	if( ( ( access_flags & ~( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME | LIBEWF_ACCESS_FLAG_MEMORY_MAP ) ) != 0 )
 	 || ( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	  &&  ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 ) ) )
+	  &&  ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 ) )
+	 || ( ( ( access_flags & LIBEWF_ACCESS_FLAG_MEMORY_MAP ) != 0 )
+	  &&  ( ( access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) != 0 ) ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -3506,6 +3777,19 @@ int libewf_internal_handle_open_file_io_pool(
 
 		goto on_error;
 	}
+	if( libewf_internal_handle_apply_cache_memory_budget(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to apply cache memory budget.",
+		 function );
+
+		goto on_error;
+	}
 	if( libewf_header_values_initialize(
 	     &( internal_handle->header_values ),
 	     error ) != 1 )
@@ -3817,6 +4101,19 @@ int libewf_internal_handle_open_file_io_pool(
 	internal_handle->io_handle->chunk_size   = internal_handle->media_values->chunk_size;
 	internal_handle->io_handle->access_flags = access_flags;
 
+	if( libewf_internal_handle_apply_cache_memory_budget(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to apply cache memory budget.",
+		 function );
+
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
@@ -4002,6 +4299,22 @@ int libewf_handle_close(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
+	/* Wait for the submitted reads before grabbing the write lock so that
+	 * completion callbacks can still use the handle
+	 */
+	if( libewf_async_read_wait(
+	     internal_handle->async_read,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to wait for submitted reads.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -4017,6 +4330,45 @@ int libewf_handle_close(
 		return( -1 );
 	}
 #endif
+	if( libewf_async_read_wait(
+	     internal_handle->async_read,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to wait for submitted reads.",
+		 function );
+
+		result = -1;
+	}
+	if( libewf_read_ahead_stop(
+	     internal_handle->read_ahead,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to stop read-ahead.",
+		 function );
+
+		result = -1;
+	}
+	if( libewf_parallel_read_stop(
+	     internal_handle->parallel_read,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to stop parallel read.",
+		 function );
+
+		result = -1;
+	}
 	if( ( internal_handle->write_io_handle != NULL )
 	 && ( internal_handle->write_io_handle->write_finalized == 0 ) )
 	{
@@ -4037,6 +4389,19 @@ int libewf_handle_close(
 			result = -1;
 		}
 	}
+	if( libewf_parallel_write_stop(
+	     internal_handle->parallel_write,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to stop parallel write.",
+		 function );
+
+		result = -1;
+	}
 	if( internal_handle->file_io_pool_created_in_library != 0 )
 	{
 		if( libbfio_pool_close_all(
@@ -4327,6 +4692,7 @@ ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
 	off64_t chunk_data_offset       = 0;
 	size_t buffer_offset            = 0;
 	size_t read_size                = 0;
+	ssize_t read_count              = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -4426,16 +4792,143 @@ ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
 	{
 		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
 	}
-	while( buffer_size > 0 )
-	{
-		if( libewf_chunk_table_get_chunk_data_by_offset(
-		     internal_handle->chunk_table,
-		     internal_handle->io_handle,
-		     file_io_pool,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     internal_handle->current_offset,
-		     &chunk_data_offset,
+	if( ( internal_handle->write_io_handle == NULL )
+	 && ( internal_handle->number_of_read_threads > 1 )
+	 && ( buffer_size >= ( (size_t) LIBEWF_PARALLEL_READ_MINIMUM_NUMBER_OF_CHUNKS * internal_handle->media_values->chunk_size ) ) )
+	{
+		read_count = libewf_parallel_read_buffer_at_offset(
+		              internal_handle->parallel_read,
+		              internal_handle->chunk_table,
+		              internal_handle->io_handle,
+		              file_io_pool,
+		              internal_handle->media_values,
+		              internal_handle->segment_table,
+		              internal_handle->number_of_read_threads,
+		              (uint8_t *) buffer,
+		              buffer_size,
+		              internal_handle->current_offset,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ") in parallel.",
+			 function,
+			 internal_handle->current_offset,
+			 internal_handle->current_offset );
+
+			return( -1 );
+		}
+		if( read_count > 0 )
+		{
+			internal_handle->current_offset += (off64_t) read_count;
+
+			/* Keep the sequential read detection of the read-ahead up to date
+			 */
+			if( libewf_read_ahead_schedule(
+			     internal_handle->read_ahead,
+			     internal_handle->chunk_table,
+			     internal_handle->io_handle,
+			     file_io_pool,
+			     internal_handle->media_values,
+			     internal_handle->segment_table,
+			     (uint64_t) ( internal_handle->current_offset - 1 ) / internal_handle->media_values->chunk_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to schedule read-ahead.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		return( read_count );
+	}
+	while( buffer_size > 0 )
+	{
+		/* Chunks that are fully covered by the buffer are unpacked directly
+		 * into the buffer, bypassing the chunk cache
+		 */
+		if( ( internal_handle->write_io_handle == NULL )
+		 && ( buffer_size >= (size_t) internal_handle->media_values->chunk_size )
+		 && ( ( (size64_t) internal_handle->current_offset % internal_handle->media_values->chunk_size ) == 0 ) )
+		{
+			read_count = libewf_chunk_table_read_chunk_by_offset(
+			              internal_handle->chunk_table,
+			              internal_handle->io_handle,
+			              file_io_pool,
+			              internal_handle->media_values,
+			              internal_handle->segment_table,
+			              internal_handle->current_offset,
+			              &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			              buffer_size,
+			              error );
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 internal_handle->current_offset,
+				 internal_handle->current_offset );
+
+				return( -1 );
+			}
+			if( libewf_read_ahead_schedule(
+			     internal_handle->read_ahead,
+			     internal_handle->chunk_table,
+			     internal_handle->io_handle,
+			     file_io_pool,
+			     internal_handle->media_values,
+			     internal_handle->segment_table,
+			     (uint64_t) internal_handle->current_offset / internal_handle->media_values->chunk_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to schedule read-ahead.",
+				 function );
+
+				return( -1 );
+			}
+			if( read_count == 0 )
+			{
+				break;
+			}
+			buffer_offset += (size_t) read_count;
+			buffer_size   -= (size_t) read_count;
+
+			internal_handle->current_offset += (off64_t) read_count;
+
+			if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+			{
+				break;
+			}
+			if( internal_handle->io_handle->abort != 0 )
+			{
+				break;
+			}
+			continue;
+		}
+		if( libewf_chunk_table_get_chunk_data_by_offset(
+		     internal_handle->chunk_table,
+		     internal_handle->io_handle,
+		     file_io_pool,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     internal_handle->current_offset,
+		     &chunk_data_offset,
 		     &chunk_data,
 		     error ) != 1 )
 		{
@@ -4463,6 +4956,29 @@ ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
 
 			return( -1 );
 		}
+		if( internal_handle->write_io_handle == NULL )
+		{
+			if( libewf_read_ahead_schedule(
+			     internal_handle->read_ahead,
+			     internal_handle->chunk_table,
+			     internal_handle->io_handle,
+			     file_io_pool,
+			     internal_handle->media_values,
+			     internal_handle->segment_table,
+			     chunk_data->chunk_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to schedule read-ahead of chunk: %" PRIu64 ".",
+				 function,
+				 chunk_data->chunk_index );
+
+				return( -1 );
+			}
+		}
 		if( (off64_t) chunk_data_offset > (off64_t) chunk_data->data_size )
 		{
 			libcerror_error_set(
@@ -4716,27 +5232,24 @@ ssize_t libewf_handle_read_buffer_at_offset(
 	return( read_count );
 }
 
-/* Writes (media) data at the current offset from a buffer using a Basic File IO (bfio) pool
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+/* Reads (media) data at a specific offset into a buffer using a Basic File IO (bfio) pool
+ * This function does not change the current offset and can be called by multiple
+ * threads that share the read lock
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
  */
-ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
+ssize_t libewf_internal_handle_read_buffer_at_offset_concurrent(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
-         const void *buffer,
+         void *buffer,
          size_t buffer_size,
+         off64_t offset,
          libcerror_error_t **error )
 {
-	static char *function     = "libewf_internal_handle_write_buffer_to_file_io_pool";
-	size_t buffer_offset      = 0;
-	size_t input_data_size    = 0;
-	size_t write_size         = 0;
-	ssize_t write_count       = 0;
-	off64_t chunk_data_offset = 0;
-	uint64_t chunk_index      = 0;
-	int write_chunk           = 0;
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_read_buffer_at_offset_concurrent";
+	off64_t chunk_data_offset       = 0;
+	size_t buffer_offset            = 0;
+	size_t read_size                = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -4760,32 +5273,17 @@ ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	if( internal_handle->write_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - write IO handle already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
-	{
-		if( internal_handle->chunk_data != NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: invalid handle - chunk data set.",
-			 function );
-
-			return( -1 );
-		}
-	}
 	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
@@ -4808,17 +5306,6 @@ ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->write_io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing write IO handle.",
-		 function );
-
-		return( -1 );
-	}
 	if( buffer == NULL )
 	{
 		libcerror_error_set(
@@ -4841,229 +5328,121 @@ ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	if( offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+	if( (size64_t) offset >= internal_handle->media_values->media_size )
 	{
 		return( 0 );
 	}
-	internal_handle->io_handle->abort = 0;
-
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size ) )
-	{
-		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
-	}
-	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
-
-	if( chunk_index >= (uint64_t) INT_MAX )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk index value exceeds maximum.",
-		 function );
-
-		return( -1 );
-	}
-	chunk_data_offset = chunk_index * internal_handle->media_values->chunk_size;
-	chunk_data_offset = internal_handle->current_offset - chunk_data_offset;
-
-	if( chunk_data_offset >= (off64_t) SSIZE_MAX )
+	if( (size64_t) ( offset + buffer_size ) >= internal_handle->media_values->media_size )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk data offset value exceeds maximum.",
-		 function );
-
-		return( -1 );
+		buffer_size = (size_t) ( internal_handle->media_values->media_size - offset );
 	}
 	while( buffer_size > 0 )
 	{
-		if( chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
+		if( libewf_chunk_table_get_chunk_data_by_offset_concurrent(
+		     internal_handle->chunk_table,
+		     internal_handle->io_handle,
+		     file_io_pool,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     offset,
+		     &chunk_data_offset,
+		     &chunk_data,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: chunk: %" PRIu64 " already exists.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
 			 function,
-			 chunk_index );
-
-			return( -1 );
-		}
-		if( internal_handle->write_io_handle->write_finalized != 0 )
-		{
-			break;
-		}
-		if( internal_handle->chunk_data == NULL )
-		{
-			if( libewf_chunk_data_initialize(
-			     &( internal_handle->chunk_data ),
-			     internal_handle->media_values->chunk_size,
-			     0,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create chunk: %" PRIu64 " data.",
-				 function,
-				 chunk_index );
+			 offset,
+			 offset );
 
-				return( -1 );
-			}
+			goto on_error;
 		}
-		if( internal_handle->chunk_data == NULL )
+		if( chunk_data == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: internal handle - missing chunk: %" PRIu64 " data.",
+			 "%s: missing chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
 			 function,
-			 chunk_index );
+			 offset,
+			 offset );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( chunk_data_offset > internal_handle->media_values->chunk_size )
+		if( (off64_t) chunk_data_offset > (off64_t) chunk_data->data_size )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: chunk offset exceeds chunk data size.",
-			 function );
+			 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+			 function,
+			 chunk_data->chunk_index );
 
-			return( -1 );
+			goto on_error;
 		}
-		write_size = (size_t) ( internal_handle->media_values->chunk_size - chunk_data_offset );
+		read_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
 
-		if( write_size > buffer_size )
+		if( read_size > buffer_size )
 		{
-			write_size = buffer_size;
+			read_size = buffer_size;
 		}
-		if( write_size == 0 )
+		if( read_size > 0 )
 		{
-			break;
+			if( memory_copy(
+			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			     &( ( chunk_data->data )[ chunk_data_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+				 function,
+				 chunk_data->chunk_index );
+
+				goto on_error;
+			}
 		}
-		if( memory_copy(
-		     &( ( internal_handle->chunk_data->data )[ chunk_data_offset ] ),
-		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-		     write_size ) == NULL )
+		if( libewf_chunk_table_release_chunk_data_concurrent(
+		     internal_handle->chunk_table,
+		     &chunk_data,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy buffer to chunk data.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release chunk data.",
 			 function );
 
-			return( -1 );
-		}
-		internal_handle->chunk_data->data_size = (size_t) ( chunk_data_offset + write_size );
-
-		buffer_offset += write_size;
-		buffer_size   -= write_size;
-
-		if( internal_handle->chunk_data->data_size == internal_handle->media_values->chunk_size )
-		{
-			write_chunk = 1;
-		}
-		else if( ( internal_handle->media_values->media_size != 0 )
-		      && ( ( (size64_t) internal_handle->current_offset + write_size ) == internal_handle->media_values->media_size ) )
-		{
-			write_chunk = 1;
-		}
-		else
-		{
-			write_chunk = 0;
+			goto on_error;
 		}
-		if( write_chunk != 0 )
+		if( read_size == 0 )
 		{
-			input_data_size = internal_handle->chunk_data->data_size;
-
-			if( libewf_chunk_data_pack(
-			     internal_handle->chunk_data,
-			     internal_handle->io_handle,
-			     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
-			     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
-			     internal_handle->write_io_handle->pack_flags,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GENERIC,
-				 "%s: unable to pack chunk: %" PRIu64 " data.",
-				 function,
-				 chunk_index );
-
-				return( -1 );
-			}
-			write_count = libewf_write_io_handle_write_new_chunk(
-			               internal_handle->write_io_handle,
-			               internal_handle->io_handle,
-			               file_io_pool,
-			               internal_handle->media_values,
-			               internal_handle->segment_table,
-			               internal_handle->header_values,
-			               internal_handle->hash_values,
-			               internal_handle->hash_sections,
-			               internal_handle->sessions,
-			               internal_handle->tracks,
-			               internal_handle->acquiry_errors,
-			               chunk_index,
-			               internal_handle->chunk_data,
-			               input_data_size,
-			               error );
-
-			if( write_count <= 0 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write new chunk.",
-				 function );
-
-				return( -1 );
-			}
-			if( libewf_chunk_data_free(
-			     &( internal_handle->chunk_data ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free chunk data.",
-				 function );
-
-				return( -1 );
-			}
+			break;
 		}
-		chunk_index      += 1;
-		chunk_data_offset = 0;
-
-		internal_handle->current_offset += (off64_t) write_size;
+		buffer_offset += read_size;
+		buffer_size   -= read_size;
+		offset        += (off64_t) read_size;
 
-		if( ( internal_handle->media_values->media_size != 0 )
-		 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+		if( (size64_t) offset >= internal_handle->media_values->media_size )
 		{
 			break;
 		}
@@ -5071,26 +5450,36 @@ ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
 		{
 			break;
 		}
+		chunk_data_offset = 0;
 	}
-	internal_handle->io_handle->abort = 0;
-
 	return( (ssize_t) buffer_offset );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_table_release_chunk_data_concurrent(
+		 internal_handle->chunk_table,
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Writes (media) data at the current offset
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+/* Reads (media) data at a specific offset without changing the current offset
+ * Multiple threads can call this function concurrently on the same handle,
+ * the handle cannot be opened for writing
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
  */
-ssize_t libewf_handle_write_buffer(
+ssize_t libewf_handle_read_buffer_at_offset_concurrent(
          libewf_handle_t *handle,
-         const void *buffer,
+         void *buffer,
          size_t buffer_size,
+         off64_t offset,
          libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_buffer";
-	ssize_t write_count                       = 0;
+	static char *function                     = "libewf_handle_read_buffer_at_offset_concurrent";
+	ssize_t read_count                        = 0;
 
 	if( handle == NULL )
 	{
@@ -5117,7 +5506,7 @@ ssize_t libewf_handle_write_buffer(
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -5125,54 +5514,35 @@ ssize_t libewf_handle_write_buffer(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( internal_handle->write_io_handle->values_initialized == 0 )
-	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
-			 function );
+	read_count = libewf_internal_handle_read_buffer_at_offset_concurrent(
+		      internal_handle,
+		      internal_handle->file_io_pool,
+		      buffer,
+		      buffer_size,
+		      offset,
+		      error );
 
-			write_count = -1;
-		}
-	}
-	if( write_count != -1 )
+	if( read_count == -1 )
 	{
-		write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
-		               internal_handle,
-		               internal_handle->file_io_pool,
-		               buffer,
-		               buffer_size,
-		               error );
-
-		if( write_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to write buffer.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
 
-			write_count = -1;
-		}
+		read_count = -1;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -5180,30 +5550,35 @@ ssize_t libewf_handle_write_buffer(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( write_count );
+	return( read_count );
 }
 
-/* Writes (media) data at a specific offset,
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+/* Reads (media) data at multiple offsets into multiple buffers without changing
+ * the current offset
+ * The number of bytes read into every buffer is stored in read_counts,
+ * which is 0 for an offset beyond the end of the media data
+ * Multiple threads can call this function concurrently on the same handle,
+ * the handle cannot be opened for writing
+ * Returns the total number of bytes read or -1 on error
  */
-ssize_t libewf_handle_write_buffer_at_offset(
+ssize_t libewf_handle_read_buffers_at_offsets(
          libewf_handle_t *handle,
-         const void *buffer,
-         size_t buffer_size,
-         off64_t offset,
+         uint8_t **buffers,
+         const size_t *buffer_sizes,
+         const off64_t *offsets,
+         ssize_t *read_counts,
+         int number_of_buffers,
          libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_buffer_at_offset";
-	ssize_t write_count                       = 0;
+	static char *function                     = "libewf_handle_read_buffers_at_offsets";
+	ssize_t read_count                        = 0;
 
 	if( handle == NULL )
 	{
@@ -5229,8 +5604,19 @@ ssize_t libewf_handle_write_buffer_at_offset(
 
 		return( -1 );
 	}
+	if( internal_handle->write_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - write IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -5238,98 +5624,77 @@ ssize_t libewf_handle_write_buffer_at_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( internal_handle->write_io_handle->values_initialized == 0 )
-	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
-			 function );
+	read_count = libewf_vectored_read_buffers_at_offsets(
+		      internal_handle->chunk_table,
+		      internal_handle->io_handle,
+		      internal_handle->file_io_pool,
+		      internal_handle->media_values,
+		      internal_handle->segment_table,
+		      buffers,
+		      buffer_sizes,
+		      offsets,
+		      read_counts,
+		      number_of_buffers,
+		      error );
 
-			write_count = -1;
-		}
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffers at offsets.",
+		 function );
 	}
-	if( write_count != -1 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		if( libewf_internal_handle_seek_offset(
-		     internal_handle,
-		     offset,
-		     SEEK_SET,
-		     error ) == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek offset.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
-			write_count = -1;
-		}
-	}
-	if( write_count != -1 )
-	{
-		write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
-		               internal_handle,
-		               internal_handle->file_io_pool,
-		               buffer,
-		               buffer_size,
-		               error );
-
-		if( write_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to write buffer.",
-			 function );
-
-			write_count = -1;
-		}
-	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
-		 function );
-
-		return( -1 );
+		return( -1 );
 	}
 #endif
-	return( write_count );
+	return( read_count );
 }
 
-/* Retrieves a (media) data chunk
+/* Submits an asynchronous read of (media) data at a specific offset
+ * The data is read by a worker thread without changing the current offset,
+ * after which the callback is called with the number of bytes read,
+ * 0 when no longer data can be read or -1 on error
+ * The buffer must remain valid until the callback has been called
+ * The number of worker threads is the number of read threads
+ * The handle cannot be opened for writing
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_data_chunk(
+int libewf_handle_submit_read_buffer_at_offset(
      libewf_handle_t *handle,
-     libewf_data_chunk_t **data_chunk,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback)(
+            libewf_handle_t *handle,
+            void *buffer,
+            off64_t offset,
+            ssize_t read_count,
+            void *callback_data ),
+     void *callback_data,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_data_chunk";
+	static char *function                     = "libewf_handle_submit_read_buffer_at_offset";
 	int result                                = 1;
 
 	if( handle == NULL )
@@ -5345,41 +5710,72 @@ int libewf_handle_get_data_chunk(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 "%s: invalid handle - missing file IO pool.",
 		 function );
 
 		return( -1 );
 	}
-	if( data_chunk == NULL )
+	if( internal_handle->write_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data chunk.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - write IO handle already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( *data_chunk != NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: data chunk value already set.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
+#endif
+	if( libewf_async_read_submit(
+	     internal_handle->async_read,
+	     handle,
+	     internal_handle->chunk_table,
+	     internal_handle->io_handle,
+	     internal_handle->file_io_pool,
+	     internal_handle->media_values,
+	     internal_handle->segment_table,
+	     internal_handle->number_of_read_threads,
+	     (uint8_t *) buffer,
+	     buffer_size,
+	     offset,
+	     callback,
+	     callback_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to submit read at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		result = -1;
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -5387,84 +5783,83 @@ int libewf_handle_get_data_chunk(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( ( internal_handle->write_io_handle != NULL )
-	 && ( internal_handle->write_io_handle->values_initialized == 0 ) )
-	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
-			 function );
+	return( result );
+}
 
-			result = -1;
-		}
-	}
-	if( result != -1 )
+/* Waits for the reads submitted with libewf_handle_submit_read_buffer_at_offset
+ * to complete, including their callbacks
+ * This function cannot be called from a completion callback
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_wait_for_submitted_reads(
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_wait_for_submitted_reads";
+
+	if( handle == NULL )
 	{
-		if( libewf_data_chunk_initialize(
-		     data_chunk,
-		     internal_handle->io_handle,
-		     internal_handle->write_io_handle,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create data chunk.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-			result = -1;
-		}
+		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	/* The handle lock is not grabbed since completion callbacks can use the handle
+	 */
+	if( libewf_async_read_wait(
+	     internal_handle->async_read,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to wait for submitted reads.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( result );
+	return( 1 );
 }
 
-/* Reads a (media) data chunk at the current offset
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes in the data chunk, 0 when no longer data can be read or -1 on error
+/* Pins the (media) data at a specific offset
+ * Returns a read-only pointer to the data in the chunk that contains the offset
+ * and the number of bytes available from that pointer up to the end of the chunk,
+ * without copying the data
+ * The data remains valid until it is unpinned with libewf_handle_unpin_data
+ * or the handle is closed
+ * Multiple threads can call this function concurrently on the same handle,
+ * the handle cannot be opened for writing
+ * Returns 1 if successful, 0 when no longer data can be read or -1 on error
  */
-ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         libewf_internal_data_chunk_t *internal_data_chunk,
-         libcerror_error_t **error )
+int libewf_handle_pin_data_at_offset(
+     libewf_handle_t *handle,
+     off64_t offset,
+     const uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error )
 {
-	libewf_chunk_data_t *chunk_data = NULL;
-	static char *function           = "libewf_internal_handle_read_data_chunk_from_file_io_pool";
-	off64_t chunk_data_offset       = 0;
-	size_t read_count               = 0;
+	libewf_chunk_data_t *chunk_data           = NULL;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_pin_data_at_offset";
+	off64_t chunk_data_offset                 = 0;
+	size_t safe_data_size                     = 0;
+	int result                                = 1;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -5475,134 +5870,178 @@ ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 "%s: invalid handle - missing file IO pool.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	if( offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	if( data == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+	if( data_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
 		 function );
 
 		return( -1 );
 	}
-	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
 	}
-	if( libewf_chunk_table_get_chunk_data_by_offset_no_cache(
-	     internal_handle->chunk_table,
-	     internal_handle->io_handle,
-	     file_io_pool,
-	     internal_handle->media_values,
-	     internal_handle->segment_table,
-	     internal_handle->current_offset,
-	     &chunk_data_offset,
-	     &chunk_data,
-	     error ) != 1 )
+#endif
+	if( internal_handle->write_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
-		 function,
-		 internal_handle->current_offset,
-		 internal_handle->current_offset );
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - write IO handle already set.",
+		 function );
 
-		goto on_error;
+		result = -1;
 	}
-	if( chunk_data == NULL )
+	else if( ( internal_handle->media_values == NULL )
+	      || ( internal_handle->media_values->chunk_size == 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
-		 function,
-		 internal_handle->current_offset,
-		 internal_handle->current_offset );
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
 
-		goto on_error;
+		result = -1;
 	}
-	/* data_chunk takes over management of chunk_data
-	 */
-	if( libewf_internal_data_chunk_set_chunk_data(
-	     internal_data_chunk,
-	     chunk_data,
-	     error ) != 1 )
+	else if( (size64_t) offset >= internal_handle->media_values->media_size )
+	{
+		result = 0;
+	}
+	else if( libewf_chunk_table_pin_chunk_data_by_offset(
+	          internal_handle->chunk_table,
+	          internal_handle->io_handle,
+	          internal_handle->file_io_pool,
+	          internal_handle->media_values,
+	          internal_handle->segment_table,
+	          offset,
+	          &chunk_data_offset,
+	          &chunk_data,
+	          error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set chunk: %" PRIu64 " data in data chunk.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to pin chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
 		 function,
-		 chunk_data->chunk_index );
+		 offset,
+		 offset );
 
-		goto on_error;
+		result = -1;
 	}
-	internal_handle->current_offset = chunk_data->range_end_offset;
-
-	read_count = (ssize_t) ( chunk_data->range_end_offset - chunk_data->range_start_offset );
-
-	return( read_count );
-
-on_error:
-	if( chunk_data != NULL )
+	else if( ( chunk_data == NULL )
+	      || ( chunk_data_offset >= (off64_t) chunk_data->data_size ) )
 	{
-		libewf_chunk_data_free(
-		 &chunk_data,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		if( chunk_data != NULL )
+		{
+			libewf_chunk_table_unpin_chunk_data(
+			 internal_handle->chunk_table,
+			 chunk_data->data,
+			 NULL );
+		}
+		result = -1;
 	}
-	return( -1 );
+	else
+	{
+		safe_data_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
+
+		if( (size64_t) ( offset + safe_data_size ) > internal_handle->media_values->media_size )
+		{
+			safe_data_size = (size_t) ( internal_handle->media_values->media_size - offset );
+		}
+		*data      = &( ( chunk_data->data )[ chunk_data_offset ] );
+		*data_size = safe_data_size;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
 }
 
-/* Reads a (media) data chunk at the current offset
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
- * Returns the number of bytes in the data chunk, 0 when no longer data can be read or -1 on error
+/* Unpins (media) data previously pinned with libewf_handle_pin_data_at_offset
+ * Multiple threads can call this function concurrently on the same handle
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_read_data_chunk(
-         libewf_handle_t *handle,
-         libewf_data_chunk_t *data_chunk,
-         libcerror_error_t **error )
+int libewf_handle_unpin_data(
+     libewf_handle_t *handle,
+     const uint8_t *data,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_read_data_chunk";
-	ssize_t read_count                        = 0;
+	static char *function                     = "libewf_handle_unpin_data";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -5617,19 +6056,19 @@ ssize_t libewf_handle_read_data_chunk(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
+	if( data == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -5637,31 +6076,53 @@ ssize_t libewf_handle_read_data_chunk(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	read_count = libewf_internal_handle_read_data_chunk_from_file_io_pool(
-	              internal_handle,
-	              internal_handle->file_io_pool,
-	              (libewf_internal_data_chunk_t *) data_chunk,
-	              error );
-
-	if( read_count < 0 )
+	if( internal_handle->chunk_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read data chunk.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk table.",
 		 function );
 
-		read_count = -1;
+		result = -1;
+	}
+	else
+	{
+		result = libewf_chunk_table_unpin_chunk_data(
+		          internal_handle->chunk_table,
+		          data,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to unpin chunk data.",
+			 function );
+		}
+		else if( result == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid data - data is not pinned.",
+			 function );
+
+			result = -1;
+		}
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -5669,29 +6130,33 @@ ssize_t libewf_handle_read_data_chunk(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	return( result );
 }
 
-/* Writes a (media) data chunk at the current offset
+/* Writes the chunks pending in the parallel write using a Basic File IO (bfio) pool
+ * Chunks are written in order until no more than the maximum number of pending chunks remain
  * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ * Returns the number of bytes written or -1 on error
  */
-ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
+ssize_t libewf_internal_handle_write_pending_chunks_to_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
-         libewf_internal_data_chunk_t *internal_data_chunk,
+         int maximum_number_of_pending_chunks,
          libcerror_error_t **error )
 {
-	static char *function        = "libewf_internal_handle_write_data_chunk_to_file_io_pool";
-	size_t data_size             = 0;
-	ssize_t write_count          = 0;
-	uint64_t current_chunk_index = 0;
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_write_pending_chunks_to_file_io_pool";
+	size_t input_data_size          = 0;
+	ssize_t total_write_count       = 0;
+	ssize_t write_count             = 0;
+	uint64_t chunk_index            = 0;
+	int is_duplicate                = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -5704,57 +6169,160 @@ ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->parallel_write == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 "%s: invalid handle - missing parallel write.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	if( maximum_number_of_pending_chunks < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of pending chunks value less than zero.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	while( internal_handle->parallel_write->number_of_pending_chunks > maximum_number_of_pending_chunks )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
-		 function );
+		if( libewf_parallel_write_pop_chunk(
+		     internal_handle->parallel_write,
+		     &chunk_index,
+		     &chunk_data,
+		     &input_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next pending chunk.",
+			 function );
 
-		return( -1 );
+			goto on_error;
+		}
+		is_duplicate = libewf_write_io_handle_is_duplicate_chunk(
+		                internal_handle->write_io_handle,
+		                internal_handle->io_handle,
+		                chunk_data,
+		                error );
+
+		if( is_duplicate == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if chunk: %" PRIu64 " is a duplicate.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		write_count = libewf_write_io_handle_write_new_chunk(
+		               internal_handle->write_io_handle,
+		               internal_handle->io_handle,
+		               file_io_pool,
+		               internal_handle->media_values,
+		               internal_handle->segment_table,
+		               internal_handle->header_values,
+		               internal_handle->hash_values,
+		               internal_handle->hash_sections,
+		               internal_handle->sessions,
+		               internal_handle->tracks,
+		               internal_handle->acquiry_errors,
+		               chunk_index,
+		               chunk_data,
+		               input_data_size,
+		               error );
+
+		if( ( write_count < 0 )
+		 || ( ( write_count == 0 )
+		  &&  ( is_duplicate == 0 ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		total_write_count += write_count;
+
+		if( libewf_chunk_data_free(
+		     &chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
 	}
-	if( internal_handle->media_values == NULL )
+	return( total_write_count );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Packs chunk data using the chunk at the same offset in the reference handle
+ * Only reading the reference chunk is serialized by the reference handle lock,
+ * hence this function can be called by the parallel write worker threads
+ * Returns 1 if the chunk data was packed, 0 if not or -1 on error
+ */
+int libewf_internal_handle_pack_chunk_data_from_reference(
+     libewf_internal_handle_t *internal_handle,
+     libewf_chunk_data_t *chunk_data,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *reference_chunk_data           = NULL;
+	libewf_internal_handle_t *internal_reference_handle = NULL;
+	static char *function                               = "libewf_internal_handle_pack_chunk_data_from_reference";
+	off64_t chunk_data_offset                           = 0;
+	off64_t reference_offset                            = 0;
+	int result                                          = 0;
+
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
@@ -5770,202 +6338,164 @@ ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_data_chunk == NULL )
+	if( chunk_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data chunk.",
+		 "%s: invalid chunk data.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+	if( internal_handle->reference_handle == NULL )
 	{
 		return( 0 );
 	}
-	data_size = internal_data_chunk->data_size;
+	internal_reference_handle = (libewf_internal_handle_t *) internal_handle->reference_handle;
 
-	if( internal_handle->media_values->media_size != 0 )
+	if( ( internal_reference_handle->file_io_pool == NULL )
+	 || ( internal_reference_handle->media_values == NULL ) )
 	{
-		if( (size64_t) ( internal_handle->current_offset + data_size ) > internal_handle->media_values->media_size )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: last data chunk size value out of bounds.",
-			 function );
-
-			return( -1 );
-		}
+		return( 0 );
 	}
-/* TODO remove need to calculate */
-	current_chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
-
-	internal_handle->current_offset = (off64_t) current_chunk_index * (off64_t) internal_handle->media_values->chunk_size;
+	if( internal_reference_handle->media_values->chunk_size != internal_handle->media_values->chunk_size )
+	{
+		return( 0 );
+	}
+	reference_offset = (off64_t) chunk_index * internal_handle->media_values->chunk_size;
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( (size64_t) reference_offset >= internal_reference_handle->media_values->media_size )
 	{
-		libcnotify_printf(
-		 "%s: writing chunk: %" PRIu64 " of size: %" PRIzd ".\n",
-		 function,
-		 current_chunk_index,
-		 data_size );
+		return( 0 );
 	}
-#endif
-	if( current_chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_reference_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: chunk: %" PRIu64 " already exists.",
-		 function,
-		 current_chunk_index );
-
-		return( -1 );
-	}
-	write_count = libewf_write_io_handle_write_new_chunk(
-	               internal_handle->write_io_handle,
-	               internal_handle->io_handle,
-	               file_io_pool,
-	               internal_handle->media_values,
-	               internal_handle->segment_table,
-	               internal_handle->header_values,
-	               internal_handle->hash_values,
-	               internal_handle->hash_sections,
-	               internal_handle->sessions,
-	               internal_handle->tracks,
-	               internal_handle->acquiry_errors,
-	               current_chunk_index,
-	               internal_data_chunk->chunk_data,
-	               data_size,
-	               error );
-
-	if( write_count < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write chunk data.",
-		 function );
-
-		return( -1 );
-	}
-	internal_handle->current_offset += (off64_t) data_size;
-
-	return( write_count );
-}
-
-/* Writes a (media) data chunk at the current offset
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
- */
-ssize_t libewf_handle_write_data_chunk(
-         libewf_handle_t *handle,
-         libewf_data_chunk_t *data_chunk,
-         libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_data_chunk";
-	ssize_t write_count                       = 0;
-
-	if( handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab reference read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->file_io_pool == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
-		 function );
+#endif
+	result = libewf_chunk_table_get_chunk_data_by_offset_no_cache(
+	          internal_reference_handle->chunk_table,
+	          internal_reference_handle->io_handle,
+	          internal_reference_handle->file_io_pool,
+	          internal_reference_handle->media_values,
+	          internal_reference_handle->segment_table,
+	          reference_offset,
+	          &chunk_data_offset,
+	          &reference_chunk_data,
+	          error );
 
-		return( -1 );
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_reference_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to release reference read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		result = -1;
+
+		goto on_error;
 	}
 #endif
-	write_count = libewf_internal_handle_write_data_chunk_to_file_io_pool(
-	               internal_handle,
-	               internal_handle->file_io_pool,
-	               (libewf_internal_data_chunk_t *) data_chunk,
-	               error );
+	/* A reference chunk that cannot be read is not used, the chunk is packed normally
+	 */
+	if( result != 1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to retrieve reference chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").\n",
+			 function,
+			 reference_offset,
+			 reference_offset );
+		}
+#endif
+		libcerror_error_free(
+		 error );
 
-	if( write_count < 0 )
+		result = 0;
+	}
+	else if( reference_chunk_data != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write data chunk.",
-		 function );
+		result = libewf_chunk_data_pack_from_reference(
+		          chunk_data,
+		          internal_handle->io_handle,
+		          reference_chunk_data,
+		          internal_reference_handle->io_handle,
+		          internal_handle->write_io_handle->pack_flags,
+		          error );
 
-		write_count = -1;
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pack chunk: %" PRIu64 " data from reference.",
+			 function,
+			 chunk_index );
+		}
+	}
+	else
+	{
+		result = 0;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+on_error:
+#endif
+	if( reference_chunk_data != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
-		 function );
+		if( libewf_chunk_data_free(
+		     &reference_chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free reference chunk data.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-#endif
-	return( write_count );
+	return( result );
 }
 
-/* Finalizes the write by correcting the EWF the meta data in the segment files
- * This function is required after write from stream
+/* Writes the current chunk data using a Basic File IO (bfio) pool
+ * If multiple write threads are set the chunk is packed in parallel
+ * and written once the preceding chunks have been written
+ * This function is not multi-thread safe acquire write lock before call
  * Returns the number of bytes written or -1 on error
  */
-ssize_t libewf_internal_handle_write_finalize_file_io_pool(
+ssize_t libewf_internal_handle_write_chunk_data_to_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
+         uint64_t chunk_index,
          libcerror_error_t **error )
 {
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_internal_handle_write_finalize_file_io_pool";
-	size64_t segment_file_size          = 0;
-	size_t input_data_size              = 0;
-	ssize_t write_count                 = 0;
-	ssize_t write_finalize_count        = 0;
-	uint64_t chunk_index                = 0;
-	uint32_t number_of_segments         = 0;
-	int file_io_pool_entry              = -1;
+	static char *function     = "libewf_internal_handle_write_chunk_data_to_file_io_pool";
+	size_t input_data_size    = 0;
+	ssize_t total_write_count = 0;
+	ssize_t write_count       = 0;
+	int is_duplicate          = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -5978,410 +6508,2613 @@ ssize_t libewf_internal_handle_write_finalize_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->write_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 "%s: invalid handle - missing write IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	if( internal_handle->chunk_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk data.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	input_data_size = internal_handle->chunk_data->data_size;
+
+	if( internal_handle->number_of_write_threads > 1 )
 	{
-		if( internal_handle->chunk_data != NULL )
+		/* The worker threads compare the chunk with the reference chunk before packing it
+		 */
+		if( internal_handle->parallel_write->packed_chunks == NULL )
+		{
+			if( libewf_parallel_write_start(
+			     internal_handle->parallel_write,
+			     internal_handle->io_handle,
+			     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+			     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+			     internal_handle->write_io_handle->pack_flags,
+			     (intptr_t *) internal_handle,
+			     (int (*)(intptr_t *, libewf_chunk_data_t *, uint64_t, libcerror_error_t **)) &libewf_internal_handle_pack_chunk_data_from_reference,
+			     internal_handle->number_of_write_threads,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to start parallel write.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		/* Make room for the chunk, all pending chunks are written first
+		 * if the chunk does not directly follow them
+		 */
+		if( chunk_index != ( internal_handle->parallel_write->next_chunk_index + internal_handle->parallel_write->number_of_pending_chunks ) )
+		{
+			write_count = libewf_internal_handle_write_pending_chunks_to_file_io_pool(
+			               internal_handle,
+			               file_io_pool,
+			               0,
+			               error );
+		}
+		else
+		{
+			write_count = libewf_internal_handle_write_pending_chunks_to_file_io_pool(
+			               internal_handle,
+			               file_io_pool,
+			               internal_handle->parallel_write->maximum_number_of_pending_chunks - 1,
+			               error );
+		}
+		if( write_count < 0 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: invalid handle - chunk data set.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write pending chunks.",
 			 function );
 
 			return( -1 );
 		}
-	}
-	if( internal_handle->write_io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing write IO handle.",
-		 function );
+		total_write_count += write_count;
 
-		return( -1 );
+		if( libewf_parallel_write_push_chunk(
+		     internal_handle->parallel_write,
+		     chunk_index,
+		     &( internal_handle->chunk_data ),
+		     input_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push chunk: %" PRIu64 " onto parallel write.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		return( total_write_count );
 	}
-	if( internal_handle->media_values == NULL )
+	/* An unchanged chunk is packed using the compressed data of the reference chunk
+	 */
+	if( libewf_internal_handle_pack_chunk_data_from_reference(
+	     internal_handle,
+	     internal_handle->chunk_data,
+	     chunk_index,
+	     error ) == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to pack chunk: %" PRIu64 " data from reference.",
+		 function,
+		 chunk_index );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	/* A duplicate chunk is referenced instead of written, hence it does not need to be packed
+	 */
+	is_duplicate = libewf_write_io_handle_is_duplicate_chunk(
+	                internal_handle->write_io_handle,
+	                internal_handle->io_handle,
+	                internal_handle->chunk_data,
+	                error );
+
+	if( is_duplicate == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if chunk: %" PRIu64 " is a duplicate.",
+		 function,
+		 chunk_index );
 
 		return( -1 );
 	}
-	if( internal_handle->write_io_handle->write_finalized != 0 )
-	{
-		return( 0 );
-	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
-	{
-		return( 0 );
-	}
-	if( internal_handle->chunk_data != NULL )
+	if( is_duplicate == 0 )
 	{
-		chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
-
-		if( chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
+		if( libewf_chunk_data_pack(
+		     internal_handle->chunk_data,
+		     internal_handle->io_handle,
+		     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+		     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+		     internal_handle->write_io_handle->pack_flags,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: chunk: %" PRIu64 " already exists.",
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pack chunk: %" PRIu64 " data.",
 			 function,
 			 chunk_index );
 
 			return( -1 );
 		}
-		input_data_size = internal_handle->chunk_data->data_size;
+	}
+	write_count = libewf_write_io_handle_write_new_chunk(
+	               internal_handle->write_io_handle,
+	               internal_handle->io_handle,
+	               file_io_pool,
+	               internal_handle->media_values,
+	               internal_handle->segment_table,
+	               internal_handle->header_values,
+	               internal_handle->hash_values,
+	               internal_handle->hash_sections,
+	               internal_handle->sessions,
+	               internal_handle->tracks,
+	               internal_handle->acquiry_errors,
+	               chunk_index,
+	               internal_handle->chunk_data,
+	               input_data_size,
+	               error );
 
-		if( libewf_chunk_data_pack(
-		     internal_handle->chunk_data,
-		     internal_handle->io_handle,
-		     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
-		     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
-		     internal_handle->write_io_handle->pack_flags,
-		     error ) != 1 )
+	if( ( write_count < 0 )
+	 || ( ( write_count == 0 )
+	  &&  ( is_duplicate == 0 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write new chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_data_free(
+	     &( internal_handle->chunk_data ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	return( write_count );
+}
+
+/* Writes (media) data at the current offset from a buffer using a Basic File IO (bfio) pool
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function     = "libewf_internal_handle_write_buffer_to_file_io_pool";
+	size_t buffer_offset      = 0;
+	size_t write_size         = 0;
+	off64_t chunk_data_offset = 0;
+	uint64_t chunk_index      = 0;
+	uint64_t number_of_chunks = 0;
+	int write_chunk           = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		if( internal_handle->chunk_data != NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to pack chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid handle - chunk data set.",
+			 function );
 
 			return( -1 );
 		}
-		write_count = libewf_write_io_handle_write_new_chunk(
-			       internal_handle->write_io_handle,
-			       internal_handle->io_handle,
-			       file_io_pool,
-			       internal_handle->media_values,
-			       internal_handle->segment_table,
-			       internal_handle->header_values,
-			       internal_handle->hash_values,
-			       internal_handle->hash_sections,
-			       internal_handle->sessions,
-			       internal_handle->tracks,
-			       internal_handle->acquiry_errors,
-			       chunk_index,
-			       internal_handle->chunk_data,
-			       input_data_size,
-			       error );
-
-		if( write_count <= 0 )
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+	{
+		return( 0 );
+	}
+	internal_handle->io_handle->abort = 0;
+
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size ) )
+	{
+		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
+	}
+	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+	if( chunk_index >= (uint64_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk index value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_data_offset = chunk_index * internal_handle->media_values->chunk_size;
+	chunk_data_offset = internal_handle->current_offset - chunk_data_offset;
+
+	if( chunk_data_offset >= (off64_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk data offset value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_size > 0 )
+	{
+		/* Chunks pending in the parallel write have not been written yet
+		 */
+		number_of_chunks = internal_handle->write_io_handle->number_of_chunks_written
+		                 + (uint64_t) internal_handle->parallel_write->number_of_pending_chunks;
+
+		if( chunk_index < number_of_chunks )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write new chunk.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: chunk: %" PRIu64 " already exists.",
+			 function,
+			 chunk_index );
 
 			return( -1 );
 		}
-		write_finalize_count += write_count;
+		if( internal_handle->write_io_handle->write_finalized != 0 )
+		{
+			break;
+		}
+		if( internal_handle->chunk_data == NULL )
+		{
+			if( libewf_chunk_data_initialize(
+			     &( internal_handle->chunk_data ),
+			     internal_handle->media_values->chunk_size,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
 
-		if( libewf_chunk_data_free(
-		     &( internal_handle->chunk_data ),
-		     error ) != 1 )
+				return( -1 );
+			}
+		}
+		if( internal_handle->chunk_data == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk data.",
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: internal handle - missing chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( chunk_data_offset > internal_handle->media_values->chunk_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: chunk offset exceeds chunk data size.",
+			 function );
+
+			return( -1 );
+		}
+		write_size = (size_t) ( internal_handle->media_values->chunk_size - chunk_data_offset );
+
+		if( write_size > buffer_size )
+		{
+			write_size = buffer_size;
+		}
+		if( write_size == 0 )
+		{
+			break;
+		}
+		if( memory_copy(
+		     &( ( internal_handle->chunk_data->data )[ chunk_data_offset ] ),
+		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+		     write_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy buffer to chunk data.",
+			 function );
+
+			return( -1 );
+		}
+		internal_handle->chunk_data->data_size = (size_t) ( chunk_data_offset + write_size );
+
+		buffer_offset += write_size;
+		buffer_size   -= write_size;
+
+		if( internal_handle->chunk_data->data_size == internal_handle->media_values->chunk_size )
+		{
+			write_chunk = 1;
+		}
+		else if( ( internal_handle->media_values->media_size != 0 )
+		      && ( ( (size64_t) internal_handle->current_offset + write_size ) == internal_handle->media_values->media_size ) )
+		{
+			write_chunk = 1;
+		}
+		else
+		{
+			write_chunk = 0;
+		}
+		if( write_chunk != 0 )
+		{
+			if( libewf_internal_handle_write_chunk_data_to_file_io_pool(
+			     internal_handle,
+			     file_io_pool,
+			     chunk_index,
+			     error ) < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write chunk: %" PRIu64 ".",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+		}
+		chunk_index      += 1;
+		chunk_data_offset = 0;
+
+		internal_handle->current_offset += (off64_t) write_size;
+
+		if( ( internal_handle->media_values->media_size != 0 )
+		 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+		{
+			break;
+		}
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	internal_handle->io_handle->abort = 0;
+
+	return( (ssize_t) buffer_offset );
+}
+
+/* Writes (media) data at the current offset
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_handle_write_buffer(
+         libewf_handle_t *handle,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_buffer";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->write_io_handle->values_initialized == 0 )
+	{
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
+			 function );
+
+			write_count = -1;
+		}
+	}
+	if( write_count != -1 )
+	{
+		write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
+		               internal_handle,
+		               internal_handle->file_io_pool,
+		               buffer,
+		               buffer_size,
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to write buffer.",
+			 function );
+
+			write_count = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Writes (media) data at a specific offset,
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_handle_write_buffer_at_offset(
+         libewf_handle_t *handle,
+         const void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_buffer_at_offset";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->write_io_handle->values_initialized == 0 )
+	{
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
+			 function );
+
+			write_count = -1;
+		}
+	}
+	if( write_count != -1 )
+	{
+		if( libewf_internal_handle_seek_offset(
+		     internal_handle,
+		     offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset.",
+			 function );
+
+			write_count = -1;
+		}
+	}
+	if( write_count != -1 )
+	{
+		write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
+		               internal_handle,
+		               internal_handle->file_io_pool,
+		               buffer,
+		               buffer_size,
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to write buffer.",
+			 function );
+
+			write_count = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Retrieves a (media) data chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_data_chunk(
+     libewf_handle_t *handle,
+     libewf_data_chunk_t **data_chunk,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_data_chunk";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_chunk != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: data chunk value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_handle->write_io_handle != NULL )
+	 && ( internal_handle->write_io_handle->values_initialized == 0 ) )
+	{
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result != -1 )
+	{
+		if( libewf_data_chunk_initialize(
+		     data_chunk,
+		     internal_handle->io_handle,
+		     internal_handle->write_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create data chunk.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads a (media) data chunk at the current offset
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes in the data chunk, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_internal_data_chunk_t *internal_data_chunk,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_read_data_chunk_from_file_io_pool";
+	off64_t chunk_data_offset       = 0;
+	size_t read_count               = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+	if( libewf_chunk_table_get_chunk_data_by_offset_no_cache(
+	     internal_handle->chunk_table,
+	     internal_handle->io_handle,
+	     file_io_pool,
+	     internal_handle->media_values,
+	     internal_handle->segment_table,
+	     internal_handle->current_offset,
+	     &chunk_data_offset,
+	     &chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 internal_handle->current_offset,
+		 internal_handle->current_offset );
+
+		goto on_error;
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 internal_handle->current_offset,
+		 internal_handle->current_offset );
+
+		goto on_error;
+	}
+	/* data_chunk takes over management of chunk_data
+	 */
+	if( libewf_internal_data_chunk_set_chunk_data(
+	     internal_data_chunk,
+	     chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk: %" PRIu64 " data in data chunk.",
+		 function,
+		 chunk_data->chunk_index );
+
+		goto on_error;
+	}
+	internal_handle->current_offset = chunk_data->range_end_offset;
+
+	read_count = (ssize_t) ( chunk_data->range_end_offset - chunk_data->range_start_offset );
+
+	return( read_count );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads a (media) data chunk at the current offset
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ * Returns the number of bytes in the data chunk, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_handle_read_data_chunk(
+         libewf_handle_t *handle,
+         libewf_data_chunk_t *data_chunk,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_data_chunk";
+	ssize_t read_count                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libewf_internal_handle_read_data_chunk_from_file_io_pool(
+	              internal_handle,
+	              internal_handle->file_io_pool,
+	              (libewf_internal_data_chunk_t *) data_chunk,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data chunk.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Writes a (media) data chunk at the current offset
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_internal_data_chunk_t *internal_data_chunk,
+         libcerror_error_t **error )
+{
+	static char *function        = "libewf_internal_handle_write_data_chunk_to_file_io_pool";
+	size_t data_size             = 0;
+	ssize_t write_count          = 0;
+	uint64_t current_chunk_index = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_data_chunk->chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data chunk - missing chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	/* A data chunk read from another handle can only be written as-is
+	 * if it was packed using the same chunk size
+	 */
+	if( internal_data_chunk->chunk_data->chunk_size != internal_handle->media_values->chunk_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data chunk - chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+	{
+		return( 0 );
+	}
+	data_size = internal_data_chunk->data_size;
+
+	if( internal_handle->media_values->media_size != 0 )
+	{
+		if( (size64_t) ( internal_handle->current_offset + data_size ) > internal_handle->media_values->media_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: last data chunk size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+	}
+/* TODO remove need to calculate */
+	current_chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+	internal_handle->current_offset = (off64_t) current_chunk_index * (off64_t) internal_handle->media_values->chunk_size;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: writing chunk: %" PRIu64 " of size: %" PRIzd ".\n",
+		 function,
+		 current_chunk_index,
+		 data_size );
+	}
+#endif
+	/* Chunks pending in the parallel write precede the data chunk
+	 */
+	if( internal_handle->parallel_write->number_of_pending_chunks > 0 )
+	{
+		write_count = libewf_internal_handle_write_pending_chunks_to_file_io_pool(
+		               internal_handle,
+		               file_io_pool,
+		               0,
+		               error );
+
+		if( write_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write pending chunks.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( current_chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: chunk: %" PRIu64 " already exists.",
+		 function,
+		 current_chunk_index );
+
+		return( -1 );
+	}
+	write_count = libewf_write_io_handle_write_new_chunk(
+	               internal_handle->write_io_handle,
+	               internal_handle->io_handle,
+	               file_io_pool,
+	               internal_handle->media_values,
+	               internal_handle->segment_table,
+	               internal_handle->header_values,
+	               internal_handle->hash_values,
+	               internal_handle->hash_sections,
+	               internal_handle->sessions,
+	               internal_handle->tracks,
+	               internal_handle->acquiry_errors,
+	               current_chunk_index,
+	               internal_data_chunk->chunk_data,
+	               data_size,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->current_offset += (off64_t) data_size;
+
+	return( write_count );
+}
+
+/* Writes a (media) data chunk at the current offset
+ * The data chunk can also be read from another handle with the same chunk size,
+ * in which case its packed data is written as-is
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_handle_write_data_chunk(
+         libewf_handle_t *handle,
+         libewf_data_chunk_t *data_chunk,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_data_chunk";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* The data chunk can originate from another handle, in which case
+	 * the write values have not been initialized yet
+	 */
+	if( internal_handle->write_io_handle->values_initialized == 0 )
+	{
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
+			 function );
+
+			write_count = -1;
+		}
+	}
+	if( write_count != -1 )
+	{
+		write_count = libewf_internal_handle_write_data_chunk_to_file_io_pool(
+		               internal_handle,
+		               internal_handle->file_io_pool,
+		               (libewf_internal_data_chunk_t *) data_chunk,
+		               error );
+
+		if( write_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write data chunk.",
+			 function );
+
+			write_count = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Finalizes the write by correcting the EWF the meta data in the segment files
+ * This function is required after write from stream
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_finalize_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_internal_handle_write_finalize_file_io_pool";
+	size64_t segment_file_size          = 0;
+	ssize_t write_count                 = 0;
+	ssize_t write_finalize_count        = 0;
+	uint64_t chunk_index                = 0;
+	uint64_t number_of_chunks           = 0;
+	uint32_t number_of_segments         = 0;
+	int file_io_pool_entry              = -1;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		if( internal_handle->chunk_data != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid handle - chunk data set.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle->write_finalized != 0 )
+	{
+		return( 0 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		return( 0 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+		number_of_chunks = internal_handle->write_io_handle->number_of_chunks_written
+		                 + (uint64_t) internal_handle->parallel_write->number_of_pending_chunks;
+
+		if( chunk_index < number_of_chunks )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: chunk: %" PRIu64 " already exists.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		write_count = libewf_internal_handle_write_chunk_data_to_file_io_pool(
+		               internal_handle,
+		               file_io_pool,
+		               chunk_index,
+		               error );
+
+		if( write_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+	}
+	if( internal_handle->parallel_write->number_of_pending_chunks > 0 )
+	{
+		write_count = libewf_internal_handle_write_pending_chunks_to_file_io_pool(
+		               internal_handle,
+		               file_io_pool,
+		               0,
+		               error );
+
+		if( write_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write pending chunks.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+	}
+	/* Check if all media data has been written
+	 */
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( internal_handle->write_io_handle->input_write_count < (ssize64_t) internal_handle->media_values->media_size ) )
+	{
+		return( write_finalize_count );
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_segments == 0 )
+	{
+		/* No segment file needs to be created
+		 */
+/* TODO clean up this logic: when is this triggered? */
+		if( internal_handle->media_values->media_size != 0 )
+		{
+			return( write_finalize_count );
+		}
+		/* Create the segment file if required
+		 */
+		if( libewf_write_io_handle_create_segment_file(
+		     internal_handle->io_handle,
+		     file_io_pool,
+		     internal_handle->segment_table,
+		     internal_handle->io_handle->segment_file_type,
+		     0,
+		     internal_handle->write_io_handle->maximum_number_of_segments,
+		     internal_handle->media_values->set_identifier,
+		     &file_io_pool_entry,
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to create segment file: 0.",
+			 function );
+
+			return( -1 );
+		}
+		write_count = libewf_segment_file_write_start(
+		               segment_file,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               &( internal_handle->write_io_handle->case_data ),
+		               &( internal_handle->write_io_handle->case_data_size ),
+		               &( internal_handle->write_io_handle->device_information ),
+		               &( internal_handle->write_io_handle->device_information_size ),
+		               &( internal_handle->write_io_handle->data_section ),
+		               internal_handle->media_values,
+		               internal_handle->header_values,
+		               internal_handle->write_io_handle->timestamp,
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write segment file: 0 start.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+	}
+	/* Check if the last segment file is still open for writing
+	 */
+	else if( internal_handle->write_io_handle->current_segment_file != NULL )
+	{
+		if( libewf_segment_table_get_segment_by_index(
+		     internal_handle->segment_table,
+		     internal_handle->write_io_handle->current_segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 internal_handle->write_io_handle->current_segment_number );
+
+			return( -1 );
+		}
+		/* Check if chunks section needs to be corrected
+		 */
+		if( internal_handle->write_io_handle->chunks_section_offset != 0 )
+		{
+			write_count = libewf_write_io_handle_write_chunks_section_end(
+			               internal_handle->write_io_handle,
+			               internal_handle->io_handle,
+				       file_io_pool,
+				       file_io_pool_entry,
+			               internal_handle->write_io_handle->current_segment_file,
+			               error );
+
+			if( write_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write chunks section end: %" PRIu32 ".",
+				 function,
+				 internal_handle->write_io_handle->current_segment_number );
+
+				return( -1 );
+			}
+			write_finalize_count += write_count;
+		}
+		/* Close the segment file
+		 */
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: closing last segment file: %" PRIu32 ".\n",
+			 function,
+			 internal_handle->write_io_handle->current_segment_number );
+		}
+#endif
+		write_count = libewf_segment_file_write_close(
+		               internal_handle->write_io_handle->current_segment_file,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               internal_handle->write_io_handle->number_of_chunks_written_to_segment_file,
+		               1,
+		               internal_handle->hash_sections,
+		               internal_handle->hash_values,
+		               internal_handle->media_values,
+		               internal_handle->sessions,
+		               internal_handle->tracks,
+		               internal_handle->acquiry_errors,
+		               &( internal_handle->write_io_handle->data_section ),
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to close segment file: %" PRIu32 ".",
+			 function,
+			 internal_handle->write_io_handle->current_segment_number );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+
+		internal_handle->write_io_handle->current_segment_file = NULL;
+	}
+	/* Correct the media values if streamed write was used
+	 */
+	if( internal_handle->media_values->media_size == 0 )
+	{
+		/* Determine the media values
+		 */
+		internal_handle->media_values->number_of_chunks  = internal_handle->write_io_handle->number_of_chunks_written;
+		internal_handle->media_values->number_of_sectors = (uint64_t) ( internal_handle->write_io_handle->input_write_count / internal_handle->media_values->bytes_per_sector );
+		internal_handle->media_values->media_size        = (size64_t) internal_handle->write_io_handle->input_write_count;
+
+		/* Flush the section write caches
+		 */
+		if( internal_handle->write_io_handle->case_data != NULL )
+		{
+			memory_free(
+			 internal_handle->write_io_handle->case_data );
+
+			internal_handle->write_io_handle->case_data      = NULL;
+			internal_handle->write_io_handle->case_data_size = 0;
+		}
+		if( internal_handle->write_io_handle->device_information != NULL )
+		{
+			memory_free(
+			 internal_handle->write_io_handle->device_information );
+
+			internal_handle->write_io_handle->device_information      = NULL;
+			internal_handle->write_io_handle->device_information_size = 0;
+		}
+		if( internal_handle->write_io_handle->data_section != NULL )
+		{
+			memory_free(
+			 internal_handle->write_io_handle->data_section );
+
+			internal_handle->write_io_handle->data_section = NULL;
+		}
+		/* Correct the sections in the segment files
+		 */
+		if( libewf_write_io_handle_finalize_write_sections_corrections(
+		     internal_handle->write_io_handle,
+		     file_io_pool,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     internal_handle->header_values,
+		     internal_handle->hash_values,
+		     internal_handle->hash_sections,
+		     internal_handle->sessions,
+		     internal_handle->tracks,
+		     internal_handle->acquiry_errors,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write sections corrections to segment files.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libewf_parallel_write_stop(
+	     internal_handle->parallel_write,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to stop parallel write.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->write_io_handle->write_finalized = 1;
+
+	return( write_finalize_count );
+}
+
+/* Finalizes the write by correcting the EWF the meta data in the segment files
+ * This function is required after write from stream
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_handle_write_finalize(
+         libewf_handle_t *handle,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_finalize";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	write_count = libewf_internal_handle_write_finalize_file_io_pool(
+	               internal_handle,
+	               internal_handle->file_io_pool,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to write finalize.",
+		 function );
+
+		write_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Seeks a certain offset of the (media) data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libewf_internal_handle_seek_offset(
+         libewf_internal_handle_t *internal_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_seek_offset";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{	
+		offset += internal_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{	
+		offset += (off64_t) internal_handle->media_values->media_size;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: seeking media data offset: %" PRIi64 ".\n",
+		 function,
+		 offset );
+	}
+#endif
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Seeks a certain offset of the (media) data
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libewf_handle_seek_offset(
+         libewf_handle_t *handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_seek_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	offset = libewf_internal_handle_seek_offset(
+	          internal_handle,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( offset );
+}
+
+/* Retrieves the current offset of the (media) data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_offset(
+     libewf_handle_t *handle,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*offset = internal_handle->current_offset;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum number of (concurrent) open file handles
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_maximum_number_of_open_handles(
+     libewf_handle_t *handle,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_maximum_number_of_open_handles";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->file_io_pool != NULL )
+	{
+		result = libbfio_pool_set_maximum_number_of_open_handles(
+		          internal_handle->file_io_pool,
+		          maximum_number_of_open_handles,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles in file IO pool.",
 			 function );
+		}
+	}
+	if( result == 1 )
+	{
+		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Applies the cache memory budget to the chunk and chunk group caches
+ * The chunk groups cache is shared by all segment files, hence the part of the
+ * budget reserved for chunk groups bounds the chunk groups of the entire handle
+ * The chunk cache is only resized once the chunk size is known
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_apply_cache_memory_budget(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function                     = "libewf_internal_handle_apply_cache_memory_budget";
+	size64_t chunks_memory_budget             = 0;
+	size64_t number_of_chunk_groups           = 0;
+	size64_t number_of_chunks                 = 0;
+	int maximum_number_of_cached_chunks       = LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS;
+	int maximum_number_of_cached_chunk_groups = LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNK_GROUPS;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->cache_memory_budget > 0 )
+	{
+		/* An eighth of the budget is reserved for the chunk groups
+		 */
+		number_of_chunk_groups = ( internal_handle->cache_memory_budget / 8 ) / LIBEWF_CACHE_ESTIMATED_CHUNK_GROUP_SIZE;
+
+		if( number_of_chunk_groups == 0 )
+		{
+			number_of_chunk_groups = 1;
+		}
+		else if( number_of_chunk_groups > (size64_t) LIBEWF_CACHE_MAXIMUM_NUMBER_OF_CHUNK_GROUPS )
+		{
+			number_of_chunk_groups = (size64_t) LIBEWF_CACHE_MAXIMUM_NUMBER_OF_CHUNK_GROUPS;
+		}
+		maximum_number_of_cached_chunk_groups = (int) number_of_chunk_groups;
+
+		if( internal_handle->io_handle->chunk_size > 0 )
+		{
+			if( internal_handle->cache_memory_budget > ( number_of_chunk_groups * LIBEWF_CACHE_ESTIMATED_CHUNK_GROUP_SIZE ) )
+			{
+				chunks_memory_budget = internal_handle->cache_memory_budget
+				                     - ( number_of_chunk_groups * LIBEWF_CACHE_ESTIMATED_CHUNK_GROUP_SIZE );
+			}
+			number_of_chunks = chunks_memory_budget / internal_handle->io_handle->chunk_size;
 
-			return( -1 );
+			if( number_of_chunks == 0 )
+			{
+				number_of_chunks = 1;
+			}
+			else if( number_of_chunks > (size64_t) LIBEWF_CACHE_MAXIMUM_NUMBER_OF_CHUNKS )
+			{
+				number_of_chunks = (size64_t) LIBEWF_CACHE_MAXIMUM_NUMBER_OF_CHUNKS;
+			}
+			maximum_number_of_cached_chunks = (int) number_of_chunks;
 		}
 	}
-	/* Check if all media data has been written
+	/* The chunk cache must be able to hold the read-ahead window
 	 */
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( internal_handle->write_io_handle->input_write_count < (ssize64_t) internal_handle->media_values->media_size ) )
+	if( maximum_number_of_cached_chunks < ( internal_handle->read_ahead->maximum_number_of_chunks + LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS ) )
 	{
-		return( write_finalize_count );
+		maximum_number_of_cached_chunks = internal_handle->read_ahead->maximum_number_of_chunks + LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS;
 	}
-	if( libewf_segment_table_get_number_of_segments(
-	     internal_handle->segment_table,
-	     &number_of_segments,
+	/* Resizing the chunk groups cache can free the current chunk group
+	 */
+	if( internal_handle->chunk_table != NULL )
+	{
+		internal_handle->chunk_table->current_chunk_group = NULL;
+	}
+	if( libfcache_cache_resize(
+	     internal_handle->io_handle->chunk_groups_cache,
+	     maximum_number_of_cached_chunk_groups,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of segments.",
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize chunk groups cache.",
 		 function );
 
 		return( -1 );
 	}
-	if( number_of_segments == 0 )
+	if( ( internal_handle->chunk_table != NULL )
+	 && ( internal_handle->io_handle->chunk_size > 0 ) )
 	{
-		/* No segment file needs to be created
-		 */
-/* TODO clean up this logic: when is this triggered? */
-		if( internal_handle->media_values->media_size != 0 )
-		{
-			return( write_finalize_count );
-		}
-		/* Create the segment file if required
-		 */
-		if( libewf_write_io_handle_create_segment_file(
-		     internal_handle->io_handle,
-		     file_io_pool,
-		     internal_handle->segment_table,
-		     internal_handle->io_handle->segment_file_type,
-		     0,
-		     internal_handle->write_io_handle->maximum_number_of_segments,
-		     internal_handle->media_values->set_identifier,
-		     &file_io_pool_entry,
-		     &segment_file,
+		if( libewf_chunk_table_resize_chunk_cache(
+		     internal_handle->chunk_table,
+		     maximum_number_of_cached_chunks,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_OPEN_FAILED,
-			 "%s: unable to create segment file: 0.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize chunk cache.",
 			 function );
 
 			return( -1 );
 		}
-		write_count = libewf_segment_file_write_start(
-		               segment_file,
-		               file_io_pool,
-		               file_io_pool_entry,
-		               &( internal_handle->write_io_handle->case_data ),
-		               &( internal_handle->write_io_handle->case_data_size ),
-		               &( internal_handle->write_io_handle->device_information ),
-		               &( internal_handle->write_io_handle->device_information_size ),
-		               &( internal_handle->write_io_handle->data_section ),
-		               internal_handle->media_values,
-		               internal_handle->header_values,
-		               internal_handle->write_io_handle->timestamp,
-		               error );
+	}
+	return( 1 );
+}
 
-		if( write_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write segment file: 0 start.",
-			 function );
+/* Retrieves the cache memory budget
+ * A budget of 0 represents the default cache sizes
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_cache_memory_budget(
+     libewf_handle_t *handle,
+     size64_t *cache_memory_budget,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_cache_memory_budget";
 
-			return( -1 );
-		}
-		write_finalize_count += write_count;
-	}
-	/* Check if the last segment file is still open for writing
-	 */
-	else if( internal_handle->write_io_handle->current_segment_file != NULL )
+	if( handle == NULL )
 	{
-		if( libewf_segment_table_get_segment_by_index(
-		     internal_handle->segment_table,
-		     internal_handle->write_io_handle->current_segment_number,
-		     &file_io_pool_entry,
-		     &segment_file_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
-			 function,
-			 internal_handle->write_io_handle->current_segment_number );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-			return( -1 );
-		}
-		/* Check if chunks section needs to be corrected
-		 */
-		if( internal_handle->write_io_handle->chunks_section_offset != 0 )
-		{
-			write_count = libewf_write_io_handle_write_chunks_section_end(
-			               internal_handle->write_io_handle,
-			               internal_handle->io_handle,
-				       file_io_pool,
-				       file_io_pool_entry,
-			               internal_handle->write_io_handle->current_segment_file,
-			               error );
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-			if( write_count == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write chunks section end: %" PRIu32 ".",
-				 function,
-				 internal_handle->write_io_handle->current_segment_number );
+	if( cache_memory_budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache memory budget.",
+		 function );
 
-				return( -1 );
-			}
-			write_finalize_count += write_count;
-		}
-		/* Close the segment file
-		 */
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: closing last segment file: %" PRIu32 ".\n",
-			 function,
-			 internal_handle->write_io_handle->current_segment_number );
-		}
-#endif
-		write_count = libewf_segment_file_write_close(
-		               internal_handle->write_io_handle->current_segment_file,
-		               file_io_pool,
-		               file_io_pool_entry,
-		               internal_handle->write_io_handle->number_of_chunks_written_to_segment_file,
-		               1,
-		               internal_handle->hash_sections,
-		               internal_handle->hash_values,
-		               internal_handle->media_values,
-		               internal_handle->sessions,
-		               internal_handle->tracks,
-		               internal_handle->acquiry_errors,
-		               &( internal_handle->write_io_handle->data_section ),
-		               error );
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
 
-		if( write_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to close segment file: %" PRIu32 ".",
-			 function,
-			 internal_handle->write_io_handle->current_segment_number );
+		return( -1 );
+	}
+#endif
+	*cache_memory_budget = internal_handle->cache_memory_budget;
 
-			return( -1 );
-		}
-		write_finalize_count += write_count;
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
-		internal_handle->write_io_handle->current_segment_file = NULL;
+		return( -1 );
 	}
-	/* Correct the media values if streamed write was used
-	 */
-	if( internal_handle->media_values->media_size == 0 )
+#endif
+	return( 1 );
+}
+
+/* Sets the cache memory budget
+ * The budget is the approximate number of bytes the chunk and chunk group
+ * caches are allowed to use, 0 represents the default cache sizes
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_cache_memory_budget(
+     libewf_handle_t *handle,
+     size64_t cache_memory_budget,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_cache_memory_budget";
+	size64_t previous_cache_memory_budget     = 0;
+	int result                                = 1;
+
+	if( handle == NULL )
 	{
-		/* Determine the media values
-		 */
-		internal_handle->media_values->number_of_chunks  = internal_handle->write_io_handle->number_of_chunks_written;
-		internal_handle->media_values->number_of_sectors = (uint64_t) ( internal_handle->write_io_handle->input_write_count / internal_handle->media_values->bytes_per_sector );
-		internal_handle->media_values->media_size        = (size64_t) internal_handle->write_io_handle->input_write_count;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-		/* Flush the section write caches
-		 */
-		if( internal_handle->write_io_handle->case_data != NULL )
-		{
-			memory_free(
-			 internal_handle->write_io_handle->case_data );
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-			internal_handle->write_io_handle->case_data      = NULL;
-			internal_handle->write_io_handle->case_data_size = 0;
-		}
-		if( internal_handle->write_io_handle->device_information != NULL )
-		{
-			memory_free(
-			 internal_handle->write_io_handle->device_information );
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-			internal_handle->write_io_handle->device_information      = NULL;
-			internal_handle->write_io_handle->device_information_size = 0;
-		}
-		if( internal_handle->write_io_handle->data_section != NULL )
-		{
-			memory_free(
-			 internal_handle->write_io_handle->data_section );
+		return( -1 );
+	}
+#endif
+	previous_cache_memory_budget         = internal_handle->cache_memory_budget;
+	internal_handle->cache_memory_budget = cache_memory_budget;
 
-			internal_handle->write_io_handle->data_section = NULL;
-		}
-		/* Correct the sections in the segment files
-		 */
-		if( libewf_write_io_handle_finalize_write_sections_corrections(
-		     internal_handle->write_io_handle,
-		     file_io_pool,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     internal_handle->header_values,
-		     internal_handle->hash_values,
-		     internal_handle->hash_sections,
-		     internal_handle->sessions,
-		     internal_handle->tracks,
-		     internal_handle->acquiry_errors,
-		     error ) != 1 )
+	if( internal_handle->io_handle != NULL )
+	{
+		result = libewf_internal_handle_apply_cache_memory_budget(
+		          internal_handle,
+		          error );
+
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write sections corrections to segment files.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to apply cache memory budget.",
 			 function );
 
-			return( -1 );
+			internal_handle->cache_memory_budget = previous_cache_memory_budget;
 		}
 	}
-	internal_handle->write_io_handle->write_finalized = 1;
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-	return( write_finalize_count );
+		return( -1 );
+	}
+#endif
+	return( result );
 }
 
-/* Finalizes the write by correcting the EWF the meta data in the segment files
- * This function is required after write from stream
- * Returns the number of bytes written or -1 on error
+/* Retrieves the read-ahead values
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_write_finalize(
-         libewf_handle_t *handle,
-         libcerror_error_t **error )
+int libewf_handle_get_read_ahead_values(
+     libewf_handle_t *handle,
+     int *maximum_number_of_chunks,
+     int *number_of_threads,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_finalize";
-	ssize_t write_count                       = 0;
+	static char *function                     = "libewf_handle_get_read_ahead_values";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -6396,17 +9129,83 @@ ssize_t libewf_handle_write_finalize(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_read_ahead_get_values(
+	     internal_handle->read_ahead,
+	     maximum_number_of_chunks,
+	     number_of_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve read-ahead values.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the read-ahead values
+ * When sequential reads are detected up to maximum number of chunks following
+ * the current offset are read on number of threads worker threads
+ * A maximum number of chunks of 0 disables read-ahead, which is the default
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_read_ahead_values(
+     libewf_handle_t *handle,
+     int maximum_number_of_chunks,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_read_ahead_values";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -6422,21 +9221,36 @@ ssize_t libewf_handle_write_finalize(
 		return( -1 );
 	}
 #endif
-	write_count = libewf_internal_handle_write_finalize_file_io_pool(
-	               internal_handle,
-	               internal_handle->file_io_pool,
-	               error );
-
-	if( write_count == -1 )
+	if( libewf_read_ahead_set_values(
+	     internal_handle->read_ahead,
+	     maximum_number_of_chunks,
+	     number_of_threads,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to write finalize.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set read-ahead values.",
 		 function );
 
-		write_count = -1;
+		result = -1;
+	}
+	else if( internal_handle->io_handle != NULL )
+	{
+		result = libewf_internal_handle_apply_cache_memory_budget(
+		          internal_handle,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to apply cache memory budget.",
+			 function );
+		}
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -6453,22 +9267,21 @@ ssize_t libewf_handle_write_finalize(
 		return( -1 );
 	}
 #endif
-	return( write_count );
+	return( result );
 }
 
-/* Seeks a certain offset of the (media) data
- * This function is not multi-thread safe acquire write lock before call
- * Returns the offset if seek is successful or -1 on error
+/* Retrieves the number of read threads
+ * Returns 1 if successful or -1 on error
  */
-off64_t libewf_internal_handle_seek_offset(
-         libewf_internal_handle_t *internal_handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libewf_handle_get_number_of_read_threads(
+     libewf_handle_t *handle,
+     int *number_of_read_threads,
+     libcerror_error_t **error )
 {
-	static char *function = "libewf_internal_handle_seek_offset";
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_number_of_read_threads";
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -6479,96 +9292,137 @@ off64_t libewf_internal_handle_seek_offset(
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( number_of_read_threads == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of read threads.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+#endif
+	*number_of_read_threads = internal_handle->number_of_read_threads;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( whence != SEEK_CUR )
-	 && ( whence != SEEK_END )
-	 && ( whence != SEEK_SET ) )
+#endif
+	return( 1 );
+}
+
+/* Sets the number of read threads
+ * Reads that span multiple chunks are unpacked on the read threads in parallel
+ * A number of read threads of 1 reads the chunks on the calling thread, which is the default
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_number_of_read_threads(
+     libewf_handle_t *handle,
+     int number_of_read_threads,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_number_of_read_threads";
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported whence.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( whence == SEEK_CUR )
-	{	
-		offset += internal_handle->current_offset;
-	}
-	else if( whence == SEEK_END )
-	{	
-		offset += (off64_t) internal_handle->media_values->media_size;
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( ( number_of_read_threads < 1 )
+	 || ( number_of_read_threads > LIBEWF_PARALLEL_READ_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of read threads value out of bounds.",
+		 function );
+
+		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		libcnotify_printf(
-		 "%s: seeking media data offset: %" PRIi64 ".\n",
-		 function,
-		 offset );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
 	}
 #endif
-	if( offset < 0 )
+	internal_handle->number_of_read_threads = number_of_read_threads;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->current_offset = offset;
-
-	return( offset );
+#endif
+	return( 1 );
 }
 
-/* Seeks a certain offset of the (media) data
- * Returns the offset if seek is successful or -1 on error
+/* Retrieves the number of write threads
+ * Returns 1 if successful or -1 on error
  */
-off64_t libewf_handle_seek_offset(
-         libewf_handle_t *handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libewf_handle_get_number_of_write_threads(
+     libewf_handle_t *handle,
+     int *number_of_write_threads,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_seek_offset";
+	static char *function                     = "libewf_handle_get_number_of_write_threads";
 
 	if( handle == NULL )
 	{
@@ -6583,19 +9437,19 @@ off64_t libewf_handle_seek_offset(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
+	if( number_of_write_threads == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of write threads.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -6603,29 +9457,16 @@ off64_t libewf_handle_seek_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	offset = libewf_internal_handle_seek_offset(
-	          internal_handle,
-	          offset,
-	          whence,
-	          error );
+	*number_of_write_threads = internal_handle->number_of_write_threads;
 
-	if( offset == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -6633,25 +9474,29 @@ off64_t libewf_handle_seek_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( offset );
+	return( 1 );
 }
 
-/* Retrieves the current offset of the (media) data
+/* Sets the number of write threads
+ * Chunks are packed on the write threads in parallel and written to the segment files in order
+ * A number of write threads of 1 packs the chunks on the calling thread, which is the default
+ * The number of write threads cannot be changed while chunks are pending to be written
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_offset(
+int libewf_handle_set_number_of_write_threads(
      libewf_handle_t *handle,
-     off64_t *offset,
+     int number_of_write_threads,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_offset";
+	static char *function                     = "libewf_handle_set_number_of_write_threads";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -6666,19 +9511,20 @@ int libewf_handle_get_offset(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( offset == NULL )
+	if( ( number_of_write_threads < 1 )
+	 || ( number_of_write_threads > LIBEWF_PARALLEL_WRITE_MAXIMUM_NUMBER_OF_THREADS ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of write threads value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -6686,16 +9532,45 @@ int libewf_handle_get_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	*offset = internal_handle->current_offset;
+	if( internal_handle->parallel_write->number_of_pending_chunks > 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunks pending to be written.",
+		 function );
+
+		result = -1;
+	}
+	/* The parallel write is started again with the new number of threads
+	 * when the next chunk is written
+	 */
+	else if( libewf_parallel_write_stop(
+	          internal_handle->parallel_write,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to stop parallel write.",
+		 function );
 
+		result = -1;
+	}
+	else
+	{
+		internal_handle->number_of_write_threads = number_of_write_threads;
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -6703,25 +9578,29 @@ int libewf_handle_get_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	return( result );
 }
 
-/* Sets the maximum number of (concurrent) open file handles
+/* Sets the reference handle
+ * The reference handle contains a previous image of the same media and must be opened for reading
+ * The compressed data of a reference chunk is written instead of compressing the chunk again
+ * when the data of the chunk at the same offset has not changed
+ * The reference handle must remain open until the handle is closed, a NULL value removes the reference handle
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_maximum_number_of_open_handles(
+int libewf_handle_set_reference_handle(
      libewf_handle_t *handle,
-     int maximum_number_of_open_handles,
+     libewf_handle_t *reference_handle,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_maximum_number_of_open_handles";
+	static char *function                     = "libewf_handle_set_reference_handle";
 	int result                                = 1;
 
 	if( handle == NULL )
@@ -6737,6 +9616,29 @@ int libewf_handle_set_maximum_number_of_open_handles(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
+	if( reference_handle == handle )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reference handle value same as handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( reference_handle != NULL )
+	 && ( ( (libewf_internal_handle_t *) reference_handle )->file_io_pool == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reference handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -6752,26 +9654,33 @@ int libewf_handle_set_maximum_number_of_open_handles(
 		return( -1 );
 	}
 #endif
-	if( internal_handle->file_io_pool != NULL )
+	if( internal_handle->write_io_handle == NULL )
 	{
-		result = libbfio_pool_set_maximum_number_of_open_handles(
-		          internal_handle->file_io_pool,
-		          maximum_number_of_open_handles,
-		          error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write IO handle.",
+		 function );
 
-		if( result != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set maximum number of open handles in file IO pool.",
-			 function );
-		}
+		result = -1;
 	}
-	if( result == 1 )
+	/* The parallel write worker threads read the reference handle of pending chunks
+	 */
+	else if( internal_handle->parallel_write->number_of_pending_chunks > 0 )
 	{
-		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: unable to set reference handle while chunks are pending.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		internal_handle->reference_handle = reference_handle;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -10338,7 +13247,7 @@ int libewf_handle_set_compression_values(
 
 		return( -1 );
 	}
-	if( ( compression_flags & ~( LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) ) != 0 )
+	if( ( compression_flags & ~( LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION | LIBEWF_COMPRESS_FLAG_SKIP_INCOMPRESSIBLE_DATA | LIBEWF_COMPRESS_FLAG_DEDUPLICATE_CHUNKS ) ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
@@ -10410,6 +13319,125 @@ on_error:
 	return( -1 );
 }
 
+/* Sets the compression level used to compress the chunks that are written next
+ * Unlike the compression values this can be changed while writing,
+ * the compression level stored in the segment files is not changed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_chunk_compression_level(
+     libewf_handle_t *handle,
+     int8_t compression_level,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_chunk_compression_level";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* Changing to or from no compression would change which chunks are compressed
+	 */
+	if( ( compression_level != LIBEWF_COMPRESSION_LEVEL_DEFAULT )
+	 && ( compression_level != LIBEWF_COMPRESSION_LEVEL_FAST )
+	 && ( compression_level != LIBEWF_COMPRESSION_LEVEL_BEST ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression level.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->io_handle->compression_level == LIBEWF_COMPRESSION_LEVEL_NONE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: chunk compression level cannot be changed.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_io_handle_set_chunk_compression_level(
+	     internal_handle->io_handle,
+	     compression_level,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk compression level.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
 /* Retrieves the size of the contained media data
  * Returns 1 if successful or -1 on error
  */
@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_async_read.h"
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_group.h"
 #include "libewf_chunk_table.h"
@@ -40,6 +41,9 @@
 #include "libewf_libfvalue.h"
 #include "libewf_io_handle.h"
 #include "libewf_media_values.h"
+#include "libewf_parallel_read.h"
+#include "libewf_parallel_write.h"
+#include "libewf_read_ahead.h"
 #include "libewf_read_io_handle.h"
 #include "libewf_segment_table.h"
 #include "libewf_single_files.h"
@@ -94,6 +98,38 @@ struct libewf_internal_handle
 	 */
 	int maximum_number_of_open_handles;
 
+	/* The cache memory budget, 0 represents the default cache sizes
+	 */
+	size64_t cache_memory_budget;
+
+	/* The read-ahead
+	 */
+	libewf_read_ahead_t *read_ahead;
+
+	/* The asynchronous read
+	 */
+	libewf_async_read_t *async_read;
+
+	/* The parallel read
+	 */
+	libewf_parallel_read_t *parallel_read;
+
+	/* The number of threads used to read chunks in parallel
+	 */
+	int number_of_read_threads;
+
+	/* The parallel write
+	 */
+	libewf_parallel_write_t *parallel_write;
+
+	/* The number of threads used to pack chunks in parallel
+	 */
+	int number_of_write_threads;
+
+	/* The reference handle, which contains a previous image of the same media
+	 */
+	libewf_handle_t *reference_handle;
+
 	/* The current (storage media) offset
 	 */
 	off64_t current_offset;
@@ -247,6 +283,84 @@ ssize_t libewf_handle_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+ssize_t libewf_internal_handle_read_buffer_at_offset_concurrent(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+ssize_t libewf_handle_read_buffer_at_offset_concurrent(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+ssize_t libewf_handle_read_buffers_at_offsets(
+         libewf_handle_t *handle,
+         uint8_t **buffers,
+         const size_t *buffer_sizes,
+         const off64_t *offsets,
+         ssize_t *read_counts,
+         int number_of_buffers,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_submit_read_buffer_at_offset(
+     libewf_handle_t *handle,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback)(
+            libewf_handle_t *handle,
+            void *buffer,
+            off64_t offset,
+            ssize_t read_count,
+            void *callback_data ),
+     void *callback_data,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_wait_for_submitted_reads(
+     libewf_handle_t *handle,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_pin_data_at_offset(
+     libewf_handle_t *handle,
+     off64_t offset,
+     const uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_unpin_data(
+     libewf_handle_t *handle,
+     const uint8_t *data,
+     libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_write_pending_chunks_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         int maximum_number_of_pending_chunks,
+         libcerror_error_t **error );
+
+int libewf_internal_handle_pack_chunk_data_from_reference(
+     libewf_internal_handle_t *internal_handle,
+     libewf_chunk_data_t *chunk_data,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_write_chunk_data_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint64_t chunk_index,
+         libcerror_error_t **error );
+
 ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -334,6 +448,66 @@ int libewf_handle_set_maximum_number_of_open_handles(
      int maximum_number_of_open_handles,
      libcerror_error_t **error );
 
+int libewf_internal_handle_apply_cache_memory_budget(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_cache_memory_budget(
+     libewf_handle_t *handle,
+     size64_t *cache_memory_budget,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_cache_memory_budget(
+     libewf_handle_t *handle,
+     size64_t cache_memory_budget,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_read_ahead_values(
+     libewf_handle_t *handle,
+     int *maximum_number_of_chunks,
+     int *number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_read_ahead_values(
+     libewf_handle_t *handle,
+     int maximum_number_of_chunks,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_number_of_read_threads(
+     libewf_handle_t *handle,
+     int *number_of_read_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_read_threads(
+     libewf_handle_t *handle,
+     int number_of_read_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_number_of_write_threads(
+     libewf_handle_t *handle,
+     int *number_of_write_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_write_threads(
+     libewf_handle_t *handle,
+     int number_of_write_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_reference_handle(
+     libewf_handle_t *handle,
+     libewf_handle_t *reference_handle,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_segment_files_corrupted(
      libewf_handle_t *handle,
@@ -563,6 +737,12 @@ int libewf_handle_set_compression_values(
      uint8_t compression_flags,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_set_chunk_compression_level(
+     libewf_handle_t *handle,
+     int8_t compression_level,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_get_media_size(
      libewf_handle_t *handle,
@@ -179,6 +179,44 @@ int libewf_huffman_tree_initialize(
 
 		goto on_error;
 	}
+	if( maximum_code_size < LIBEWF_HUFFMAN_TREE_LOOKUP_TABLE_MAXIMUM_NUMBER_OF_BITS )
+	{
+		( *huffman_tree )->lookup_table_number_of_bits = maximum_code_size;
+	}
+	else
+	{
+		( *huffman_tree )->lookup_table_number_of_bits = LIBEWF_HUFFMAN_TREE_LOOKUP_TABLE_MAXIMUM_NUMBER_OF_BITS;
+	}
+	array_size = sizeof( uint16_t ) << ( *huffman_tree )->lookup_table_number_of_bits;
+
+	( *huffman_tree )->lookup_table = (uint16_t *) memory_allocate(
+	                                                array_size );
+
+	if( ( *huffman_tree )->lookup_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create lookup table.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *huffman_tree )->lookup_table,
+	     0,
+	     array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear lookup table.",
+		 function );
+
+		goto on_error;
+	}
 	( *huffman_tree )->maximum_code_size = maximum_code_size;
 
 	return( 1 );
@@ -186,6 +224,11 @@ int libewf_huffman_tree_initialize(
 on_error:
 	if( *huffman_tree != NULL )
 	{
+		if( ( *huffman_tree )->lookup_table != NULL )
+		{
+			memory_free(
+			 ( *huffman_tree )->lookup_table );
+		}
 		if( ( *huffman_tree )->code_size_counts != NULL )
 		{
 			memory_free(
@@ -226,6 +269,11 @@ int libewf_huffman_tree_free(
 	}
 	if( *huffman_tree != NULL )
 	{
+		if( ( *huffman_tree )->lookup_table != NULL )
+		{
+			memory_free(
+			 ( *huffman_tree )->lookup_table );
+		}
 		if( ( *huffman_tree )->code_size_counts != NULL )
 		{
 			memory_free(
@@ -253,14 +301,20 @@ int libewf_huffman_tree_build(
      int number_of_code_sizes,
      libcerror_error_t **error )
 {
-	int *symbol_offsets   = NULL;
-	static char *function = "libewf_huffman_tree_build";
-	size_t array_size     = 0;
-	uint16_t symbol       = 0;
-	uint8_t bit_index     = 0;
-	uint8_t code_size     = 0;
-	int code_offset       = 0;
-	int left_value        = 0;
+	int *symbol_offsets            = NULL;
+	static char *function          = "libewf_huffman_tree_build";
+	size_t array_size              = 0;
+	uint32_t huffman_code          = 0;
+	uint32_t reversed_huffman_code = 0;
+	uint16_t lookup_table_entry    = 0;
+	uint16_t symbol                = 0;
+	uint8_t bit_index              = 0;
+	uint8_t code_size              = 0;
+	int code_offset                = 0;
+	int first_index                = 0;
+	int left_value                 = 0;
+	int lookup_table_index         = 0;
+	int lookup_table_size          = 0;
 
 	if( huffman_tree == NULL )
 	{
@@ -314,6 +368,22 @@ int libewf_huffman_tree_build(
 
 		goto on_error;
 	}
+	lookup_table_size = (int) 1 << huffman_tree->lookup_table_number_of_bits;
+
+	if( memory_set(
+	     huffman_tree->lookup_table,
+	     0,
+	     sizeof( uint16_t ) * lookup_table_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear lookup table.",
+		 function );
+
+		goto on_error;
+	}
 	for( symbol = 0;
 	     symbol < (uint16_t) number_of_code_sizes;
 	     symbol++ )
@@ -437,6 +507,46 @@ int libewf_huffman_tree_build(
 	memory_free(
 	 symbol_offsets );
 
+	symbol_offsets = NULL;
+
+	/* Fill the lookup table with the canonical Huffman codes that fit in the table.
+	 * The bit stream stores the Huffman codes with the most significant bit first,
+	 * hence the lookup table is indexed by the bit reversed Huffman code and every
+	 * entry that starts with the same code size bits refers to the same symbol
+	 */
+	first_index  = 0;
+	huffman_code = 0;
+
+	for( bit_index = 1;
+	     bit_index <= huffman_tree->lookup_table_number_of_bits;
+	     bit_index++ )
+	{
+		for( code_offset = first_index;
+		     code_offset < ( first_index + huffman_tree->code_size_counts[ bit_index ] );
+		     code_offset++ )
+		{
+			reversed_huffman_code = 0;
+
+			for( code_size = 0;
+			     code_size < bit_index;
+			     code_size++ )
+			{
+				reversed_huffman_code <<= 1;
+				reversed_huffman_code  |= ( huffman_code >> code_size ) & 0x00000001UL;
+			}
+			lookup_table_entry = (uint16_t) ( ( huffman_tree->symbols[ code_offset ] << 4 ) | bit_index );
+
+			for( lookup_table_index = (int) reversed_huffman_code;
+			     lookup_table_index < lookup_table_size;
+			     lookup_table_index += (int) 1 << bit_index )
+			{
+				huffman_tree->lookup_table[ lookup_table_index ] = lookup_table_entry;
+			}
+			huffman_code++;
+		}
+		first_index   += huffman_tree->code_size_counts[ bit_index ];
+		huffman_code <<= 1;
+	}
 	return( 1 );
 
 on_error:
@@ -457,15 +567,17 @@ int libewf_huffman_tree_get_symbol_from_bit_stream(
      uint16_t *symbol,
      libcerror_error_t **error )
 {
-	static char *function  = "libewf_huffman_tree_get_symbol_from_bit_stream";
-	uint32_t value_32bit   = 0;
-	uint16_t safe_symbol   = 0;
-	uint8_t bit_index      = 0;
-	int code_size_count    = 0;
-	int first_huffman_code = 0;
-	int first_index        = 0;
-	int huffman_code       = 0;
-	int result             = 0;
+	static char *function       = "libewf_huffman_tree_get_symbol_from_bit_stream";
+	uint64_t bit_buffer         = 0;
+	uint32_t value_32bit        = 0;
+	uint16_t lookup_table_entry = 0;
+	uint16_t safe_symbol        = 0;
+	uint8_t bit_index           = 0;
+	int code_size_count         = 0;
+	int first_huffman_code      = 0;
+	int first_index             = 0;
+	int huffman_code            = 0;
+	int result                  = 0;
 
 	if( huffman_tree == NULL )
 	{
@@ -500,43 +612,109 @@ int libewf_huffman_tree_get_symbol_from_bit_stream(
 
 		return( -1 );
 	}
-/* TODO get maximum_code_size of bits into local bit buffer */
-
-	for( bit_index = 1;
-	     bit_index <= huffman_tree->maximum_code_size;
-	     bit_index++ )
+	if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
 	{
-		if( libewf_bit_stream_get_value(
-		     bit_stream,
-		     1,
-		     &value_32bit,
-		     error ) != 1 )
+		if( bit_stream->bit_buffer_size < huffman_tree->maximum_code_size )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from bit stream.",
-			 function );
-
-			return( -1 );
+			if( libewf_bit_stream_read(
+			     bit_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read bits.",
+				 function );
+
+				return( -1 );
+			}
 		}
-		huffman_code <<= 1;
-		huffman_code  |= (int) value_32bit;
+		bit_buffer = bit_stream->bit_buffer;
+
+		lookup_table_entry = huffman_tree->lookup_table[ bit_buffer & ~( (uint64_t) 0xffffffffffffffffULL << huffman_tree->lookup_table_number_of_bits ) ];
 
-		code_size_count = huffman_tree->code_size_counts[ bit_index ];
+		bit_index = (uint8_t) ( lookup_table_entry & 0x000f );
 
-		if( ( huffman_code - code_size_count ) < first_huffman_code )
+		if( ( bit_index > 0 )
+		 && ( bit_index <= bit_stream->bit_buffer_size ) )
 		{
-			safe_symbol = huffman_tree->symbols[ first_index + ( huffman_code - first_huffman_code ) ];
+			safe_symbol = lookup_table_entry >> 4;
 
 			result = 1;
-
-			break;
 		}
-		first_huffman_code  += code_size_count;
-		first_huffman_code <<= 1;
-		first_index         += code_size_count;
+		else
+		{
+			/* The Huffman code is longer than the lookup table number of bits
+			 * or the Huffman code is not valid
+			 */
+			for( bit_index = 1;
+			     ( bit_index <= huffman_tree->maximum_code_size ) && ( bit_index <= bit_stream->bit_buffer_size );
+			     bit_index++ )
+			{
+				huffman_code <<= 1;
+				huffman_code  |= (int) ( bit_buffer & 0x00000001UL );
+				bit_buffer   >>= 1;
+
+				code_size_count = huffman_tree->code_size_counts[ bit_index ];
+
+				if( ( huffman_code - code_size_count ) < first_huffman_code )
+				{
+					safe_symbol = huffman_tree->symbols[ first_index + ( huffman_code - first_huffman_code ) ];
+
+					result = 1;
+
+					break;
+				}
+				first_huffman_code  += code_size_count;
+				first_huffman_code <<= 1;
+				first_index         += code_size_count;
+			}
+		}
+		if( result == 1 )
+		{
+			bit_stream->bit_buffer     >>= bit_index;
+			bit_stream->bit_buffer_size -= bit_index;
+		}
+	}
+	else
+	{
+		for( bit_index = 1;
+		     bit_index <= huffman_tree->maximum_code_size;
+		     bit_index++ )
+		{
+			if( libewf_bit_stream_get_value(
+			     bit_stream,
+			     1,
+			     &value_32bit,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve value from bit stream.",
+				 function );
+
+				return( -1 );
+			}
+			huffman_code <<= 1;
+			huffman_code  |= (int) value_32bit;
+
+			code_size_count = huffman_tree->code_size_counts[ bit_index ];
+
+			if( ( huffman_code - code_size_count ) < first_huffman_code )
+			{
+				safe_symbol = huffman_tree->symbols[ first_index + ( huffman_code - first_huffman_code ) ];
+
+				result = 1;
+
+				break;
+			}
+			first_huffman_code  += code_size_count;
+			first_huffman_code <<= 1;
+			first_index         += code_size_count;
+		}
 	}
 	if( result != 1 )
 	{
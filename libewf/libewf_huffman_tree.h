@@ -32,6 +32,10 @@
 extern "C" {
 #endif
 
+/* The maximum number of bits of the Huffman code lookup table
+ */
+#define LIBEWF_HUFFMAN_TREE_LOOKUP_TABLE_MAXIMUM_NUMBER_OF_BITS	10
+
 typedef struct libewf_huffman_tree libewf_huffman_tree_t;
 
 struct libewf_huffman_tree
@@ -47,6 +51,16 @@ struct libewf_huffman_tree
 	/* The code size counts array
 	 */
 	int *code_size_counts;
+
+	/* The number of bits of the lookup table
+	 */
+	uint8_t lookup_table_number_of_bits;
+
+	/* The lookup table
+	 * Each entry contains the symbol in the upper 12 bits and the code size in the lower 4 bits
+	 * or 0 if the Huffman code is longer than the lookup table number of bits
+	 */
+	uint16_t *lookup_table;
 };
 
 int libewf_huffman_tree_initialize(
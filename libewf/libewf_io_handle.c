@@ -24,9 +24,12 @@
 #include <types.h>
 
 #include "libewf_codepage.h"
+#include "libewf_compression_context.h"
 #include "libewf_definitions.h"
 #include "libewf_io_handle.h"
 #include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libfcache.h"
 
 /* Creates an IO handle
  * Make sure the value io_handle is referencing, is set to NULL
@@ -97,11 +100,68 @@ int libewf_io_handle_initialize(
 	( *io_handle )->zero_on_error      = 1;
 	( *io_handle )->header_codepage    = LIBEWF_CODEPAGE_ASCII;
 
+	if( libewf_compression_context_pool_initialize(
+	     &( ( *io_handle )->compression_context_pool ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create compression context pool.",
+		 function );
+
+		goto on_error;
+	}
+	/* The chunk groups cache is shared by all segment files so that the number
+	 * of cached chunk groups is bounded for the handle and not per segment file
+	 */
+	if( libfcache_cache_initialize(
+	     &( ( *io_handle )->chunk_groups_cache ),
+	     LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNK_GROUPS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk groups cache.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *io_handle )->chunk_compression_level_read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize chunk compression level read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	return( 1 );
 
 on_error:
 	if( *io_handle != NULL )
 	{
+		if( ( *io_handle )->chunk_groups_cache != NULL )
+		{
+			libfcache_cache_free(
+			 &( ( *io_handle )->chunk_groups_cache ),
+			 NULL );
+		}
+		if( ( *io_handle )->compression_context_pool != NULL )
+		{
+			libewf_compression_context_pool_free(
+			 &( ( *io_handle )->compression_context_pool ),
+			 NULL );
+		}
 		memory_free(
 		 *io_handle );
 
@@ -146,6 +206,47 @@ int libewf_io_handle_free(
 
 			result = -1;
 		}
+		if( libewf_compression_context_pool_free(
+		     &( ( *io_handle )->compression_context_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compression context pool.",
+			 function );
+
+			result = -1;
+		}
+		if( libfcache_cache_free(
+		     &( ( *io_handle )->chunk_groups_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk groups cache.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *io_handle )->chunk_compression_level_read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk compression level read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 *io_handle );
 
@@ -161,7 +262,13 @@ int libewf_io_handle_clear(
      libewf_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_io_handle_clear";
+	libewf_compression_context_pool_t *compression_context_pool = NULL;
+	libfcache_cache_t *chunk_groups_cache                       = NULL;
+	static char *function                                       = "libewf_io_handle_clear";
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_t *read_write_lock              = NULL;
+#endif
 
 	if( io_handle == NULL )
 	{
@@ -174,6 +281,35 @@ int libewf_io_handle_clear(
 
 		return( -1 );
 	}
+	/* The chunk groups of the segment files that are no longer used are removed
+	 * from the chunk groups cache
+	 */
+	if( io_handle->chunk_groups_cache != NULL )
+	{
+		if( libfcache_cache_empty(
+		     io_handle->chunk_groups_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty chunk groups cache.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* The compression context pool, chunk groups cache and read/write lock
+	 * do not contain format specific values and are retained
+	 */
+	compression_context_pool = io_handle->compression_context_pool;
+	chunk_groups_cache       = io_handle->chunk_groups_cache;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	read_write_lock = io_handle->chunk_compression_level_read_write_lock;
+#endif
+
 	if( memory_set(
 	     io_handle,
 	     0,
@@ -197,6 +333,12 @@ int libewf_io_handle_clear(
 	io_handle->zero_on_error      = 1;
 	io_handle->header_codepage    = LIBEWF_CODEPAGE_ASCII;
 
+	io_handle->compression_context_pool = compression_context_pool;
+	io_handle->chunk_groups_cache       = chunk_groups_cache;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	io_handle->chunk_compression_level_read_write_lock = read_write_lock;
+#endif
 	return( 1 );
 }
 
@@ -266,13 +408,73 @@ int libewf_io_handle_clone(
 
 		goto on_error;
 	}
-	( *destination_io_handle )->zero_on_error = source_io_handle->zero_on_error;
+	( *destination_io_handle )->zero_on_error            = source_io_handle->zero_on_error;
+	( *destination_io_handle )->compression_context_pool = NULL;
+	( *destination_io_handle )->chunk_groups_cache       = NULL;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	( *destination_io_handle )->chunk_compression_level_read_write_lock = NULL;
+#endif
+
+	if( libewf_compression_context_pool_initialize(
+	     &( ( *destination_io_handle )->compression_context_pool ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination compression context pool.",
+		 function );
 
+		goto on_error;
+	}
+	if( libfcache_cache_clone(
+	     &( ( *destination_io_handle )->chunk_groups_cache ),
+	     source_io_handle->chunk_groups_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination chunk groups cache.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *destination_io_handle )->chunk_compression_level_read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize destination chunk compression level read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	return( 1 );
 
 on_error:
 	if( *destination_io_handle != NULL )
 	{
+		if( ( *destination_io_handle )->chunk_groups_cache != NULL )
+		{
+			libfcache_cache_free(
+			 &( ( *destination_io_handle )->chunk_groups_cache ),
+			 NULL );
+		}
+		if( ( *destination_io_handle )->compression_context_pool != NULL )
+		{
+			libewf_compression_context_pool_free(
+			 &( ( *destination_io_handle )->compression_context_pool ),
+			 NULL );
+		}
 		memory_free(
 		 *destination_io_handle );
 
@@ -281,3 +483,128 @@ on_error:
 	return( -1 );
 }
 
+/* Retrieves the compression level used to compress chunk data
+ * LIBEWF_COMPRESSION_LEVEL_NONE represents not set
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_io_handle_get_chunk_compression_level(
+     libewf_io_handle_t *io_handle,
+     int8_t *compression_level,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_io_handle_get_chunk_compression_level";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_level == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression level.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     io_handle->chunk_compression_level_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*compression_level = io_handle->chunk_compression_level;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     io_handle->chunk_compression_level_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the compression level used to compress chunk data
+ * The chunk data can be packed by other threads while the compression level is changed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_io_handle_set_chunk_compression_level(
+     libewf_io_handle_t *io_handle,
+     int8_t compression_level,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_io_handle_set_chunk_compression_level";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     io_handle->chunk_compression_level_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	io_handle->chunk_compression_level = compression_level;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     io_handle->chunk_compression_level_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
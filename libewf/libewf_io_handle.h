@@ -25,7 +25,10 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_compression_context.h"
 #include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libfcache.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -67,6 +70,12 @@ struct libewf_io_handle
 	 */
 	uint8_t compression_flags;
 
+	/* The compression level used to compress chunk data, which can differ
+	 * from the compression level stored in the segment files
+	 * LIBEWF_COMPRESSION_LEVEL_NONE represents not set
+	 */
+	int8_t chunk_compression_level;
+
 	/* Value to indicate the data and some metadata is encrypted
 	 */
 	uint8_t is_encrypted;
@@ -83,9 +92,23 @@ struct libewf_io_handle
 	 */
 	int header_codepage;
 
+	/* The chunk groups cache, shared by the segment files
+	 */
+	libfcache_cache_t *chunk_groups_cache;
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
+
+	/* The compression context pool
+	 */
+	libewf_compression_context_pool_t *compression_context_pool;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The chunk compression level read/write lock
+	 */
+	libcthreads_read_write_lock_t *chunk_compression_level_read_write_lock;
+#endif
 };
 
 int libewf_io_handle_initialize(
@@ -105,6 +128,16 @@ int libewf_io_handle_clone(
      libewf_io_handle_t *source_io_handle,
      libcerror_error_t **error );
 
+int libewf_io_handle_get_chunk_compression_level(
+     libewf_io_handle_t *io_handle,
+     int8_t *compression_level,
+     libcerror_error_t **error );
+
+int libewf_io_handle_set_chunk_compression_level(
+     libewf_io_handle_t *io_handle,
+     int8_t compression_level,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,938 @@
+/*
+ * Parallel read functions
+ *
+ * Copyright (C) 2006-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_table.h"
+#include "libewf_definitions.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_media_values.h"
+#include "libewf_parallel_read.h"
+#include "libewf_segment_table.h"
+
+/* Creates a parallel read
+ * Make sure the value parallel_read is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_read_initialize(
+     libewf_parallel_read_t **parallel_read,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_parallel_read_initialize";
+
+	if( parallel_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel read.",
+		 function );
+
+		return( -1 );
+	}
+	if( *parallel_read != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid parallel read value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*parallel_read = memory_allocate_structure(
+	                  libewf_parallel_read_t );
+
+	if( *parallel_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create parallel read.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *parallel_read,
+	     0,
+	     sizeof( libewf_parallel_read_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear parallel read.",
+		 function );
+
+		memory_free(
+		 *parallel_read );
+
+		*parallel_read = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *parallel_read )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *parallel_read )->pending_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize pending condition.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *parallel_read != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *parallel_read )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *parallel_read )->mutex ),
+			 NULL );
+		}
+#endif
+		memory_free(
+		 *parallel_read );
+
+		*parallel_read = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a parallel read
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_read_free(
+     libewf_parallel_read_t **parallel_read,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_parallel_read_free";
+	int result            = 1;
+
+	if( parallel_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel read.",
+		 function );
+
+		return( -1 );
+	}
+	if( *parallel_read != NULL )
+	{
+		if( libewf_parallel_read_stop(
+		     *parallel_read,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to stop parallel read.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_condition_free(
+		     &( ( *parallel_read )->pending_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free pending condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *parallel_read )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *parallel_read );
+
+		*parallel_read = NULL;
+	}
+	return( result );
+}
+
+/* Stops the parallel read
+ * Joins the worker threads, which are started again by the next parallel read
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_read_stop(
+     libewf_parallel_read_t *parallel_read,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_parallel_read_stop";
+	int result            = 1;
+
+	if( parallel_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel read.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( parallel_read->thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( parallel_read->thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
+	parallel_read->number_of_threads        = 0;
+	parallel_read->number_of_pending_chunks = 0;
+	parallel_read->abort                    = 0;
+	parallel_read->chunk_table              = NULL;
+	parallel_read->io_handle                = NULL;
+	parallel_read->file_io_pool             = NULL;
+	parallel_read->media_values             = NULL;
+	parallel_read->segment_table            = NULL;
+
+	return( result );
+}
+
+/* Reads the chunk of a parallel read chunk into its buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_read_chunk_read(
+     libewf_parallel_read_chunk_t *parallel_read_chunk,
+     libewf_parallel_read_t *parallel_read,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_parallel_read_chunk_read";
+	off64_t chunk_data_offset       = 0;
+	size_t read_size                = 0;
+	ssize_t read_count              = 0;
+
+	if( parallel_read_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel read chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( parallel_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel read.",
+		 function );
+
+		return( -1 );
+	}
+	parallel_read_chunk->read_count = 0;
+	parallel_read_chunk->result     = -1;
+
+	/* A chunk that is fully covered by the buffer is unpacked directly into the buffer
+	 */
+	if( ( parallel_read_chunk->buffer_size == (size_t) parallel_read->media_values->chunk_size )
+	 && ( ( (size64_t) parallel_read_chunk->offset % parallel_read->media_values->chunk_size ) == 0 ) )
+	{
+		read_count = libewf_chunk_table_read_chunk_by_offset(
+		              parallel_read->chunk_table,
+		              parallel_read->io_handle,
+		              parallel_read->file_io_pool,
+		              parallel_read->media_values,
+		              parallel_read->segment_table,
+		              parallel_read_chunk->offset,
+		              parallel_read_chunk->buffer,
+		              parallel_read_chunk->buffer_size,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 parallel_read_chunk->offset,
+			 parallel_read_chunk->offset );
+
+			return( -1 );
+		}
+		parallel_read_chunk->read_count = (size_t) read_count;
+		parallel_read_chunk->result     = 1;
+
+		return( 1 );
+	}
+	if( libewf_chunk_table_get_chunk_data_by_offset_concurrent(
+	     parallel_read->chunk_table,
+	     parallel_read->io_handle,
+	     parallel_read->file_io_pool,
+	     parallel_read->media_values,
+	     parallel_read->segment_table,
+	     parallel_read_chunk->offset,
+	     &chunk_data_offset,
+	     &chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 parallel_read_chunk->offset,
+		 parallel_read_chunk->offset );
+
+		goto on_error;
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 parallel_read_chunk->offset,
+		 parallel_read_chunk->offset );
+
+		goto on_error;
+	}
+	if( (off64_t) chunk_data_offset > (off64_t) chunk_data->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+		 function,
+		 chunk_data->chunk_index );
+
+		goto on_error;
+	}
+	read_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
+
+	if( read_size > parallel_read_chunk->buffer_size )
+	{
+		read_size = parallel_read_chunk->buffer_size;
+	}
+	if( read_size > 0 )
+	{
+		if( memory_copy(
+		     parallel_read_chunk->buffer,
+		     &( ( chunk_data->data )[ chunk_data_offset ] ),
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+			 function,
+			 chunk_data->chunk_index );
+
+			goto on_error;
+		}
+	}
+	if( libewf_chunk_table_release_chunk_data_concurrent(
+	     parallel_read->chunk_table,
+	     &chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	parallel_read_chunk->read_count = read_size;
+	parallel_read_chunk->result     = 1;
+
+	return( 1 );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_table_release_chunk_data_concurrent(
+		 parallel_read->chunk_table,
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Reads the chunk of a parallel read chunk into its buffer
+ * Errors are not reported since a failed chunk is read again by the caller
+ * The remaining chunks of the read are skipped after the first failed chunk
+ * Callback function for the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_read_chunk_callback(
+     libewf_parallel_read_chunk_t *parallel_read_chunk,
+     libewf_parallel_read_t *parallel_read )
+{
+	libcerror_error_t *error = NULL;
+	int abort_read           = 0;
+	int result               = 1;
+
+	if( parallel_read == NULL )
+	{
+		return( -1 );
+	}
+	if( parallel_read_chunk == NULL )
+	{
+		result = -1;
+	}
+	else
+	{
+		if( libcthreads_mutex_grab(
+		     parallel_read->mutex,
+		     NULL ) == 1 )
+		{
+			abort_read = parallel_read->abort;
+
+			libcthreads_mutex_release(
+			 parallel_read->mutex,
+			 NULL );
+		}
+		if( ( abort_read == 0 )
+		 && ( parallel_read->io_handle->abort == 0 ) )
+		{
+			result = libewf_parallel_read_chunk_read(
+			          parallel_read_chunk,
+			          parallel_read,
+			          &error );
+
+			if( error != NULL )
+			{
+				libcerror_error_free(
+				 &error );
+			}
+		}
+	}
+	/* The chunk is no longer pending even if it failed to read
+	 */
+	if( libcthreads_mutex_grab(
+	     parallel_read->mutex,
+	     NULL ) == 1 )
+	{
+		if( result != 1 )
+		{
+			parallel_read->abort = 1;
+		}
+		parallel_read->number_of_pending_chunks -= 1;
+
+		if( parallel_read->number_of_pending_chunks == 0 )
+		{
+			libcthreads_condition_broadcast(
+			 parallel_read->pending_condition,
+			 NULL );
+		}
+		libcthreads_mutex_release(
+		 parallel_read->mutex,
+		 NULL );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Reads (media) data at a specific offset into a buffer
+ * The chunks covered by the buffer are read and unpacked on number of threads
+ * worker threads, each directly into its part of the buffer
+ * The worker threads are started on first use and retained for subsequent reads
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_parallel_read_buffer_at_offset(
+         libewf_parallel_read_t *parallel_read,
+         libewf_chunk_table_t *chunk_table,
+         libewf_io_handle_t *io_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_media_values_t *media_values,
+         libewf_segment_table_t *segment_table,
+         int number_of_threads,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_parallel_read_chunk_t *parallel_read_chunks = NULL;
+	static char *function                              = "libewf_parallel_read_buffer_at_offset";
+	size_t buffer_offset                               = 0;
+	size_t read_size                                   = 0;
+	uint64_t chunk_index                               = 0;
+	uint64_t first_chunk_index                         = 0;
+	uint64_t number_of_chunks                          = 0;
+	off64_t chunk_offset                               = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	uint64_t number_of_pushed_chunks                   = 0;
+	int result                                         = 1;
+#endif
+
+	if( parallel_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel read.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media values - chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads < 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( (size64_t) offset >= media_values->media_size ) )
+	{
+		return( 0 );
+	}
+	if( (size64_t) ( offset + buffer_size ) >= media_values->media_size )
+	{
+		buffer_size = (size_t) ( media_values->media_size - offset );
+	}
+	first_chunk_index = (uint64_t) offset / media_values->chunk_size;
+	number_of_chunks  = ( ( (uint64_t) offset + buffer_size - 1 ) / media_values->chunk_size ) - first_chunk_index + 1;
+
+	if( number_of_chunks > (uint64_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libewf_parallel_read_chunk_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of chunks value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	parallel_read_chunks = (libewf_parallel_read_chunk_t *) memory_allocate(
+	                                                         sizeof( libewf_parallel_read_chunk_t ) * (size_t) number_of_chunks );
+
+	if( parallel_read_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create parallel read chunks.",
+		 function );
+
+		return( -1 );
+	}
+	/* No chunks are pending at this point, hence the worker threads
+	 * do not access these values
+	 */
+	parallel_read->chunk_table   = chunk_table;
+	parallel_read->io_handle     = io_handle;
+	parallel_read->file_io_pool  = file_io_pool;
+	parallel_read->media_values  = media_values;
+	parallel_read->segment_table = segment_table;
+
+	chunk_offset = offset;
+
+	for( chunk_index = 0;
+	     chunk_index < number_of_chunks;
+	     chunk_index++ )
+	{
+		read_size = (size_t) ( ( ( first_chunk_index + chunk_index + 1 ) * media_values->chunk_size ) - chunk_offset );
+
+		if( read_size > ( buffer_size - buffer_offset ) )
+		{
+			read_size = buffer_size - buffer_offset;
+		}
+		parallel_read_chunks[ chunk_index ].offset      = chunk_offset;
+		parallel_read_chunks[ chunk_index ].buffer      = &( buffer[ buffer_offset ] );
+		parallel_read_chunks[ chunk_index ].buffer_size = read_size;
+		parallel_read_chunks[ chunk_index ].read_count  = 0;
+		parallel_read_chunks[ chunk_index ].result      = 0;
+
+		buffer_offset += read_size;
+		chunk_offset  += (off64_t) read_size;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( ( number_of_threads > 1 )
+	 && ( number_of_chunks > 1 ) )
+	{
+		if( ( parallel_read->thread_pool != NULL )
+		 && ( parallel_read->number_of_threads != number_of_threads ) )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( parallel_read->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( parallel_read->thread_pool == NULL )
+		{
+			if( libcthreads_thread_pool_create(
+			     &( parallel_read->thread_pool ),
+			     NULL,
+			     number_of_threads,
+			     number_of_threads * 4,
+			     (int (*)(intptr_t *, void *)) &libewf_parallel_read_chunk_callback,
+			     (void *) parallel_read,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create thread pool.",
+				 function );
+
+				goto on_error;
+			}
+			parallel_read->number_of_threads = number_of_threads;
+		}
+		if( libcthreads_mutex_grab(
+		     parallel_read->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		parallel_read->number_of_pending_chunks = (int) number_of_chunks;
+		parallel_read->abort                    = 0;
+
+		if( libcthreads_mutex_release(
+		     parallel_read->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+		for( number_of_pushed_chunks = 0;
+		     number_of_pushed_chunks < number_of_chunks;
+		     number_of_pushed_chunks++ )
+		{
+			if( libcthreads_thread_pool_push(
+			     parallel_read->thread_pool,
+			     (intptr_t *) &( parallel_read_chunks[ number_of_pushed_chunks ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to push chunk: %" PRIu64 " onto thread pool queue.",
+				 function,
+				 first_chunk_index + number_of_pushed_chunks );
+
+				result = -1;
+
+				break;
+			}
+		}
+		/* Wait for the pushed chunks to be read, since the parallel read chunks
+		 * and the buffer are no longer valid after this function returns.
+		 * If waiting fails the worker threads are joined instead.
+		 */
+		if( libcthreads_mutex_grab(
+		     parallel_read->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			libewf_parallel_read_stop(
+			 parallel_read,
+			 NULL );
+
+			goto on_error;
+		}
+		parallel_read->number_of_pending_chunks -= (int) ( number_of_chunks - number_of_pushed_chunks );
+
+		while( parallel_read->number_of_pending_chunks > 0 )
+		{
+			if( libcthreads_condition_wait(
+			     parallel_read->pending_condition,
+			     parallel_read->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to wait for pending condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 parallel_read->mutex,
+				 NULL );
+
+				libewf_parallel_read_stop(
+				 parallel_read,
+				 NULL );
+
+				goto on_error;
+			}
+		}
+		if( libcthreads_mutex_release(
+		     parallel_read->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( result != 1 )
+		{
+			goto on_error;
+		}
+	}
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+	/* Chunks that were not read by a worker thread, or that failed to read,
+	 * are read on the calling thread so that errors are reported to the caller
+	 */
+	buffer_offset = 0;
+
+	for( chunk_index = 0;
+	     chunk_index < number_of_chunks;
+	     chunk_index++ )
+	{
+		if( io_handle->abort != 0 )
+		{
+			break;
+		}
+		if( parallel_read_chunks[ chunk_index ].result != 1 )
+		{
+			if( libewf_parallel_read_chunk_read(
+			     &( parallel_read_chunks[ chunk_index ] ),
+			     parallel_read,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk: %" PRIu64 ".",
+				 function,
+				 first_chunk_index + chunk_index );
+
+				goto on_error;
+			}
+		}
+		buffer_offset += parallel_read_chunks[ chunk_index ].read_count;
+
+		if( parallel_read_chunks[ chunk_index ].read_count < parallel_read_chunks[ chunk_index ].buffer_size )
+		{
+			break;
+		}
+	}
+	memory_free(
+	 parallel_read_chunks );
+
+	return( (ssize_t) buffer_offset );
+
+on_error:
+	memory_free(
+	 parallel_read_chunks );
+
+	return( -1 );
+}
+
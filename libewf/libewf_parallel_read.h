@@ -0,0 +1,165 @@
+/*
+ * Parallel read functions
+ *
+ * Copyright (C) 2006-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_PARALLEL_READ_H )
+#define _LIBEWF_PARALLEL_READ_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_table.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_media_values.h"
+#include "libewf_segment_table.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_parallel_read libewf_parallel_read_t;
+
+/* The parallel read reads the chunks covered by a buffer on worker threads
+ * The worker threads are retained between reads and stopped when the handle is closed
+ */
+struct libewf_parallel_read
+{
+	/* The number of worker threads
+	 */
+	int number_of_threads;
+
+	/* The number of chunks pending in the thread pool
+	 */
+	int number_of_pending_chunks;
+
+	/* Value to indicate the worker threads should stop reading chunks
+	 * of the current read, set when a chunk fails to read
+	 */
+	int abort;
+
+	/* The chunk table
+	 */
+	libewf_chunk_table_t *chunk_table;
+
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The file IO pool
+	 */
+	libbfio_pool_t *file_io_pool;
+
+	/* The media values
+	 */
+	libewf_media_values_t *media_values;
+
+	/* The segment table
+	 */
+	libewf_segment_table_t *segment_table;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when no more chunks are pending
+	 */
+	libcthreads_condition_t *pending_condition;
+#endif
+};
+
+typedef struct libewf_parallel_read_chunk libewf_parallel_read_chunk_t;
+
+/* The part of the buffer that is filled from a single chunk
+ */
+struct libewf_parallel_read_chunk
+{
+	/* The (storage media) offset
+	 */
+	off64_t offset;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The number of bytes read
+	 */
+	size_t read_count;
+
+	/* The result of the read, 0 if not read
+	 */
+	int result;
+};
+
+int libewf_parallel_read_initialize(
+     libewf_parallel_read_t **parallel_read,
+     libcerror_error_t **error );
+
+int libewf_parallel_read_free(
+     libewf_parallel_read_t **parallel_read,
+     libcerror_error_t **error );
+
+int libewf_parallel_read_stop(
+     libewf_parallel_read_t *parallel_read,
+     libcerror_error_t **error );
+
+int libewf_parallel_read_chunk_read(
+     libewf_parallel_read_chunk_t *parallel_read_chunk,
+     libewf_parallel_read_t *parallel_read,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_parallel_read_chunk_callback(
+     libewf_parallel_read_chunk_t *parallel_read_chunk,
+     libewf_parallel_read_t *parallel_read );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+ssize_t libewf_parallel_read_buffer_at_offset(
+         libewf_parallel_read_t *parallel_read,
+         libewf_chunk_table_t *chunk_table,
+         libewf_io_handle_t *io_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_media_values_t *media_values,
+         libewf_segment_table_t *segment_table,
+         int number_of_threads,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_PARALLEL_READ_H ) */
+
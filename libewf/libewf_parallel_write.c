@@ -0,0 +1,949 @@
+/*
+ * Parallel write functions
+ *
+ * Copyright (C) 2006-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_definitions.h"
+#include "libewf_io_handle.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_parallel_write.h"
+
+/* Frees a parallel write chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_write_chunk_free(
+     libewf_parallel_write_chunk_t **parallel_write_chunk,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_parallel_write_chunk_free";
+	int result            = 1;
+
+	if( parallel_write_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel write chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( *parallel_write_chunk != NULL )
+	{
+		if( ( *parallel_write_chunk )->chunk_data != NULL )
+		{
+			if( libewf_chunk_data_free(
+			     &( ( *parallel_write_chunk )->chunk_data ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk data.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *parallel_write_chunk )->error != NULL )
+		{
+			libcerror_error_free(
+			 &( ( *parallel_write_chunk )->error ) );
+		}
+		memory_free(
+		 *parallel_write_chunk );
+
+		*parallel_write_chunk = NULL;
+	}
+	return( result );
+}
+
+/* Creates a parallel write
+ * Make sure the value parallel_write is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_write_initialize(
+     libewf_parallel_write_t **parallel_write,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_parallel_write_initialize";
+
+	if( parallel_write == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel write.",
+		 function );
+
+		return( -1 );
+	}
+	if( *parallel_write != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid parallel write value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*parallel_write = memory_allocate_structure(
+	                   libewf_parallel_write_t );
+
+	if( *parallel_write == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create parallel write.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     *parallel_write,
+	     0,
+	     sizeof( libewf_parallel_write_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear parallel write.",
+		 function );
+
+		memory_free(
+		 *parallel_write );
+
+		*parallel_write = NULL;
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Frees a parallel write
+ * Chunks that are still pending are discarded
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_write_free(
+     libewf_parallel_write_t **parallel_write,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_parallel_write_free";
+	int result            = 1;
+
+	if( parallel_write == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel write.",
+		 function );
+
+		return( -1 );
+	}
+	if( *parallel_write != NULL )
+	{
+		if( libewf_parallel_write_stop(
+		     *parallel_write,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to stop parallel write.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *parallel_write );
+
+		*parallel_write = NULL;
+	}
+	return( result );
+}
+
+/* Starts the parallel write
+ * The pack from reference function is called by the worker threads before
+ * a chunk is packed, it must be safe to call from multiple threads
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_write_start(
+     libewf_parallel_write_t *parallel_write,
+     libewf_io_handle_t *io_handle,
+     uint8_t *compressed_zero_byte_empty_block,
+     size_t compressed_zero_byte_empty_block_size,
+     uint8_t pack_flags,
+     intptr_t *handle,
+     int (*pack_chunk_data_from_reference)(
+            intptr_t *handle,
+            libewf_chunk_data_t *chunk_data,
+            uint64_t chunk_index,
+            libcerror_error_t **error ),
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function                = "libewf_parallel_write_start";
+	int maximum_number_of_pending_chunks = 0;
+
+	if( parallel_write == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel write.",
+		 function );
+
+		return( -1 );
+	}
+	if( parallel_write->packed_chunks != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid parallel write - packed chunks value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads < 1 )
+	 || ( number_of_threads > LIBEWF_PARALLEL_WRITE_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	maximum_number_of_pending_chunks = number_of_threads * LIBEWF_PARALLEL_WRITE_NUMBER_OF_PENDING_CHUNKS_PER_THREAD;
+
+	parallel_write->packed_chunks = (libewf_parallel_write_chunk_t **) memory_allocate(
+	                                                                    sizeof( libewf_parallel_write_chunk_t * ) * maximum_number_of_pending_chunks );
+
+	if( parallel_write->packed_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create packed chunks.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     parallel_write->packed_chunks,
+	     0,
+	     sizeof( libewf_parallel_write_chunk_t * ) * maximum_number_of_pending_chunks ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear packed chunks.",
+		 function );
+
+		goto on_error;
+	}
+	parallel_write->number_of_threads                     = number_of_threads;
+	parallel_write->maximum_number_of_pending_chunks      = maximum_number_of_pending_chunks;
+	parallel_write->number_of_pending_chunks              = 0;
+	parallel_write->next_chunk_index                      = 0;
+	parallel_write->io_handle                             = io_handle;
+	parallel_write->compressed_zero_byte_empty_block      = compressed_zero_byte_empty_block;
+	parallel_write->compressed_zero_byte_empty_block_size = compressed_zero_byte_empty_block_size;
+	parallel_write->pack_flags                            = pack_flags;
+	parallel_write->handle                                = handle;
+	parallel_write->pack_chunk_data_from_reference        = pack_chunk_data_from_reference;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( parallel_write->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( parallel_write->packed_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize packed condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( parallel_write->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     maximum_number_of_pending_chunks,
+	     (int (*)(intptr_t *, void *)) &libewf_parallel_write_pack_chunk_callback,
+	     (void *) parallel_write,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( parallel_write->packed_condition != NULL )
+	{
+		libcthreads_condition_free(
+		 &( parallel_write->packed_condition ),
+		 NULL );
+	}
+	if( parallel_write->mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( parallel_write->mutex ),
+		 NULL );
+	}
+#endif
+	if( parallel_write->packed_chunks != NULL )
+	{
+		memory_free(
+		 parallel_write->packed_chunks );
+
+		parallel_write->packed_chunks = NULL;
+	}
+	parallel_write->maximum_number_of_pending_chunks = 0;
+
+	return( -1 );
+}
+
+/* Stops the parallel write
+ * Waits for the worker threads to finish, chunks that are still pending are discarded
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_write_stop(
+     libewf_parallel_write_t *parallel_write,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_parallel_write_stop";
+	int chunk_slot        = 0;
+	int result            = 1;
+
+	if( parallel_write == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel write.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( parallel_write->thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( parallel_write->thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( parallel_write->packed_condition != NULL )
+	{
+		if( libcthreads_condition_free(
+		     &( parallel_write->packed_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free packed condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( parallel_write->mutex != NULL )
+	{
+		if( libcthreads_mutex_free(
+		     &( parallel_write->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
+	if( parallel_write->packed_chunks != NULL )
+	{
+		for( chunk_slot = 0;
+		     chunk_slot < parallel_write->maximum_number_of_pending_chunks;
+		     chunk_slot++ )
+		{
+			if( libewf_parallel_write_chunk_free(
+			     &( parallel_write->packed_chunks[ chunk_slot ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free packed chunk: %d.",
+				 function,
+				 chunk_slot );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 parallel_write->packed_chunks );
+
+		parallel_write->packed_chunks = NULL;
+	}
+	parallel_write->number_of_threads                     = 0;
+	parallel_write->maximum_number_of_pending_chunks      = 0;
+	parallel_write->number_of_pending_chunks              = 0;
+	parallel_write->next_chunk_index                      = 0;
+	parallel_write->io_handle                             = NULL;
+	parallel_write->compressed_zero_byte_empty_block      = NULL;
+	parallel_write->compressed_zero_byte_empty_block_size = 0;
+	parallel_write->pack_flags                            = 0;
+	parallel_write->handle                                = NULL;
+	parallel_write->pack_chunk_data_from_reference        = NULL;
+
+	return( result );
+}
+
+/* Pushes a chunk to be packed
+ * The chunk must directly follow the chunks that are pending, or no chunks must be pending
+ * On success the parallel write takes over management of the chunk data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_write_push_chunk(
+     libewf_parallel_write_t *parallel_write,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     size_t input_data_size,
+     libcerror_error_t **error )
+{
+	libewf_parallel_write_chunk_t *parallel_write_chunk = NULL;
+	static char *function                               = "libewf_parallel_write_push_chunk";
+
+	if( parallel_write == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel write.",
+		 function );
+
+		return( -1 );
+	}
+	if( parallel_write->packed_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid parallel write - missing packed chunks.",
+		 function );
+
+		return( -1 );
+	}
+	if( parallel_write->number_of_pending_chunks >= parallel_write->maximum_number_of_pending_chunks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid parallel write - number of pending chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: missing chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( parallel_write->number_of_pending_chunks == 0 )
+	{
+		parallel_write->next_chunk_index = chunk_index;
+	}
+	else if( chunk_index != ( parallel_write->next_chunk_index + parallel_write->number_of_pending_chunks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index: %" PRIu64 " value out of bounds.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	parallel_write_chunk = memory_allocate_structure(
+	                        libewf_parallel_write_chunk_t );
+
+	if( parallel_write_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create parallel write chunk.",
+		 function );
+
+		return( -1 );
+	}
+	parallel_write_chunk->chunk_index     = chunk_index;
+	parallel_write_chunk->chunk_data      = *chunk_data;
+	parallel_write_chunk->input_data_size = input_data_size;
+	parallel_write_chunk->result          = 0;
+	parallel_write_chunk->error           = NULL;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_thread_pool_push(
+	     parallel_write->thread_pool,
+	     (intptr_t *) parallel_write_chunk,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push chunk: %" PRIu64 " onto thread pool queue.",
+		 function,
+		 chunk_index );
+
+		memory_free(
+		 parallel_write_chunk );
+
+		return( -1 );
+	}
+#else
+	/* Without multi-thread support the chunk is packed when it is popped
+	 */
+	parallel_write->packed_chunks[ chunk_index % parallel_write->maximum_number_of_pending_chunks ] = parallel_write_chunk;
+#endif
+	parallel_write->number_of_pending_chunks += 1;
+
+	*chunk_data = NULL;
+
+	return( 1 );
+}
+
+/* Packs the chunk data of a parallel write chunk
+ * An unchanged chunk is packed using the compressed data of the reference chunk
+ * otherwise the chunk data is compressed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_write_pack_chunk(
+     libewf_parallel_write_t *parallel_write,
+     libewf_parallel_write_chunk_t *parallel_write_chunk,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_parallel_write_pack_chunk";
+	int result            = 0;
+
+	if( parallel_write == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel write.",
+		 function );
+
+		return( -1 );
+	}
+	if( parallel_write_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel write chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( parallel_write->pack_chunk_data_from_reference != NULL )
+	{
+		result = parallel_write->pack_chunk_data_from_reference(
+		          parallel_write->handle,
+		          parallel_write_chunk->chunk_data,
+		          parallel_write_chunk->chunk_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pack chunk: %" PRIu64 " data from reference.",
+			 function,
+			 parallel_write_chunk->chunk_index );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			return( 1 );
+		}
+	}
+	if( libewf_chunk_data_pack(
+	     parallel_write_chunk->chunk_data,
+	     parallel_write->io_handle,
+	     parallel_write->compressed_zero_byte_empty_block,
+	     parallel_write->compressed_zero_byte_empty_block_size,
+	     parallel_write->pack_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to pack chunk: %" PRIu64 " data.",
+		 function,
+		 parallel_write_chunk->chunk_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Pops the next chunk to be written
+ * Waits until the chunk has been packed by a worker thread
+ * On success the caller takes over management of the chunk data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if no chunks are pending or -1 on error
+ */
+int libewf_parallel_write_pop_chunk(
+     libewf_parallel_write_t *parallel_write,
+     uint64_t *chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     size_t *input_data_size,
+     libcerror_error_t **error )
+{
+	libewf_parallel_write_chunk_t *parallel_write_chunk = NULL;
+	static char *function                               = "libewf_parallel_write_pop_chunk";
+	int chunk_slot                                      = 0;
+
+	if( parallel_write == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallel write.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( parallel_write->number_of_pending_chunks == 0 )
+	{
+		return( 0 );
+	}
+	chunk_slot = (int) ( parallel_write->next_chunk_index % parallel_write->maximum_number_of_pending_chunks );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The worker threads hand back the chunks in the order they were packed
+	 * wait until the next chunk has been handed back
+	 */
+	if( libcthreads_mutex_grab(
+	     parallel_write->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( parallel_write->packed_chunks[ chunk_slot ] == NULL )
+	{
+		if( libcthreads_condition_wait(
+		     parallel_write->packed_condition,
+		     parallel_write->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for packed condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 parallel_write->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	parallel_write_chunk = parallel_write->packed_chunks[ chunk_slot ];
+
+	parallel_write->packed_chunks[ chunk_slot ] = NULL;
+
+	if( libcthreads_mutex_release(
+	     parallel_write->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+#else
+	parallel_write_chunk = parallel_write->packed_chunks[ chunk_slot ];
+
+	if( parallel_write_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing packed chunk: %d.",
+		 function,
+		 chunk_slot );
+
+		return( -1 );
+	}
+	parallel_write->packed_chunks[ chunk_slot ] = NULL;
+#endif
+	parallel_write->next_chunk_index         += 1;
+	parallel_write->number_of_pending_chunks -= 1;
+
+#if !defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	parallel_write_chunk->result = libewf_parallel_write_pack_chunk(
+	                                parallel_write,
+	                                parallel_write_chunk,
+	                                &( parallel_write_chunk->error ) );
+#endif
+	if( parallel_write_chunk->result != 1 )
+	{
+		/* Hand the error of the worker thread over to the caller
+		 */
+		if( ( error != NULL )
+		 && ( *error == NULL ) )
+		{
+			*error = parallel_write_chunk->error;
+
+			parallel_write_chunk->error = NULL;
+		}
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to pack chunk: %" PRIu64 " data.",
+		 function,
+		 parallel_write_chunk->chunk_index );
+
+		goto on_error;
+	}
+	*chunk_index     = parallel_write_chunk->chunk_index;
+	*chunk_data      = parallel_write_chunk->chunk_data;
+	*input_data_size = parallel_write_chunk->input_data_size;
+
+	memory_free(
+	 parallel_write_chunk );
+
+	return( 1 );
+
+on_error:
+	libewf_parallel_write_chunk_free(
+	 &parallel_write_chunk,
+	 NULL );
+
+	return( -1 );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Packs a chunk and hands it back in its packed chunks slot
+ * Errors are kept with the chunk and reported when the chunk is popped
+ * Callback function for the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_write_pack_chunk_callback(
+     libewf_parallel_write_chunk_t *parallel_write_chunk,
+     libewf_parallel_write_t *parallel_write )
+{
+	int chunk_slot = 0;
+
+	if( ( parallel_write_chunk == NULL )
+	 || ( parallel_write == NULL ) )
+	{
+		return( -1 );
+	}
+	parallel_write_chunk->result = libewf_parallel_write_pack_chunk(
+	                                parallel_write,
+	                                parallel_write_chunk,
+	                                &( parallel_write_chunk->error ) );
+
+	/* Since the number of pending chunks is limited to the number of packed chunks slots
+	 * the pending chunks map onto distinct slots, the chunk is handed back even if
+	 * it failed to pack so that the error is reported when the chunk is popped
+	 */
+	chunk_slot = (int) ( parallel_write_chunk->chunk_index % parallel_write->maximum_number_of_pending_chunks );
+
+	if( libcthreads_mutex_grab(
+	     parallel_write->mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	parallel_write->packed_chunks[ chunk_slot ] = parallel_write_chunk;
+
+	libcthreads_condition_broadcast(
+	 parallel_write->packed_condition,
+	 NULL );
+
+	libcthreads_mutex_release(
+	 parallel_write->mutex,
+	 NULL );
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,199 @@
+/*
+ * Parallel write functions
+ *
+ * Copyright (C) 2006-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_PARALLEL_WRITE_H )
+#define _LIBEWF_PARALLEL_WRITE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_io_handle.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_parallel_write_chunk libewf_parallel_write_chunk_t;
+
+/* A chunk that is packed by a worker thread
+ */
+struct libewf_parallel_write_chunk
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The chunk data
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The size of the chunk data before packing
+	 */
+	size_t input_data_size;
+
+	/* The result of the pack, 0 if not packed
+	 */
+	int result;
+
+	/* The error of the pack
+	 */
+	libcerror_error_t *error;
+};
+
+typedef struct libewf_parallel_write libewf_parallel_write_t;
+
+/* The parallel write packs consecutive chunks on worker threads
+ * and hands them back in chunk order, so that the chunks can be
+ * written to the segment files by the calling thread
+ */
+struct libewf_parallel_write
+{
+	/* The number of worker threads
+	 */
+	int number_of_threads;
+
+	/* The maximum number of chunks pending to be written
+	 */
+	int maximum_number_of_pending_chunks;
+
+	/* The number of chunks pending to be written
+	 */
+	int number_of_pending_chunks;
+
+	/* The index of the next chunk to be written
+	 */
+	uint64_t next_chunk_index;
+
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The compressed zero byte empty block
+	 */
+	uint8_t *compressed_zero_byte_empty_block;
+
+	/* The compressed zero byte empty block size
+	 */
+	size_t compressed_zero_byte_empty_block_size;
+
+	/* The pack flags
+	 */
+	uint8_t pack_flags;
+
+	/* The handle that is passed to the pack from reference function
+	 */
+	intptr_t *handle;
+
+	/* The function to pack a chunk using the reference chunk, NULL if not set
+	 */
+	int (*pack_chunk_data_from_reference)(
+	       intptr_t *handle,
+	       libewf_chunk_data_t *chunk_data,
+	       uint64_t chunk_index,
+	       libcerror_error_t **error );
+
+	/* The packed chunks that cannot be written yet, indexed by chunk index
+	 * modulo the maximum number of pending chunks
+	 */
+	libewf_parallel_write_chunk_t **packed_chunks;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex that protects the packed chunks
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when a worker thread hands back a chunk
+	 */
+	libcthreads_condition_t *packed_condition;
+#endif
+};
+
+int libewf_parallel_write_chunk_free(
+     libewf_parallel_write_chunk_t **parallel_write_chunk,
+     libcerror_error_t **error );
+
+int libewf_parallel_write_initialize(
+     libewf_parallel_write_t **parallel_write,
+     libcerror_error_t **error );
+
+int libewf_parallel_write_free(
+     libewf_parallel_write_t **parallel_write,
+     libcerror_error_t **error );
+
+int libewf_parallel_write_start(
+     libewf_parallel_write_t *parallel_write,
+     libewf_io_handle_t *io_handle,
+     uint8_t *compressed_zero_byte_empty_block,
+     size_t compressed_zero_byte_empty_block_size,
+     uint8_t pack_flags,
+     intptr_t *handle,
+     int (*pack_chunk_data_from_reference)(
+            intptr_t *handle,
+            libewf_chunk_data_t *chunk_data,
+            uint64_t chunk_index,
+            libcerror_error_t **error ),
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libewf_parallel_write_stop(
+     libewf_parallel_write_t *parallel_write,
+     libcerror_error_t **error );
+
+int libewf_parallel_write_push_chunk(
+     libewf_parallel_write_t *parallel_write,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     size_t input_data_size,
+     libcerror_error_t **error );
+
+int libewf_parallel_write_pack_chunk(
+     libewf_parallel_write_t *parallel_write,
+     libewf_parallel_write_chunk_t *parallel_write_chunk,
+     libcerror_error_t **error );
+
+int libewf_parallel_write_pop_chunk(
+     libewf_parallel_write_t *parallel_write,
+     uint64_t *chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     size_t *input_data_size,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_parallel_write_pack_chunk_callback(
+     libewf_parallel_write_chunk_t *parallel_write_chunk,
+     libewf_parallel_write_t *parallel_write );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_PARALLEL_WRITE_H ) */
+
@@ -0,0 +1,647 @@
+/*
+ * Read-ahead functions
+ *
+ * Copyright (C) 2006-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_table.h"
+#include "libewf_definitions.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_media_values.h"
+#include "libewf_read_ahead.h"
+#include "libewf_segment_table.h"
+
+/* Creates a read-ahead
+ * Make sure the value read_ahead is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_initialize(
+     libewf_read_ahead_t **read_ahead,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_initialize";
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_ahead != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read-ahead value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*read_ahead = memory_allocate_structure(
+	               libewf_read_ahead_t );
+
+	if( *read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read-ahead.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_ahead,
+	     0,
+	     sizeof( libewf_read_ahead_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read-ahead.",
+		 function );
+
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *read_ahead )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *read_ahead )->number_of_threads = 1;
+	( *read_ahead )->last_chunk_index  = (uint64_t) -1;
+
+	return( 1 );
+
+on_error:
+	if( *read_ahead != NULL )
+	{
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a read-ahead
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_free(
+     libewf_read_ahead_t **read_ahead,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_free";
+	int result            = 1;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_ahead != NULL )
+	{
+		if( libewf_read_ahead_stop(
+		     *read_ahead,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to stop read-ahead.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *read_ahead )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the read-ahead values
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_get_values(
+     libewf_read_ahead_t *read_ahead,
+     int *maximum_number_of_chunks,
+     int *number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_get_values";
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of chunks.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of threads.",
+		 function );
+
+		return( -1 );
+	}
+	*maximum_number_of_chunks = read_ahead->maximum_number_of_chunks;
+	*number_of_threads        = read_ahead->number_of_threads;
+
+	return( 1 );
+}
+
+/* Sets the read-ahead values
+ * A maximum number of chunks of 0 disables read-ahead
+ * Pending read-ahead is stopped before the values are changed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_set_values(
+     libewf_read_ahead_t *read_ahead,
+     int maximum_number_of_chunks,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_set_values";
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_chunks < 0 )
+	 || ( maximum_number_of_chunks > LIBEWF_READ_AHEAD_MAXIMUM_NUMBER_OF_CHUNKS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBEWF_READ_AHEAD_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_read_ahead_stop(
+	     read_ahead,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to stop read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	read_ahead->maximum_number_of_chunks = maximum_number_of_chunks;
+	read_ahead->number_of_threads        = number_of_threads;
+
+	return( 1 );
+}
+
+/* Schedules the chunks following a specific chunk to be read ahead
+ * Read-ahead starts once a number of consecutive chunks have been read,
+ * any other access pattern resets the detection
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_schedule(
+     libewf_read_ahead_t *read_ahead,
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libewf_read_ahead_chunk_t *read_ahead_chunk = NULL;
+	uint64_t end_chunk_index                    = 0;
+	int is_full                                 = 0;
+#endif
+	static char *function                       = "libewf_read_ahead_schedule";
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ahead->maximum_number_of_chunks == 0 )
+	{
+		return( 1 );
+	}
+	if( chunk_index == ( read_ahead->last_chunk_index + 1 ) )
+	{
+		if( read_ahead->number_of_sequential_reads < LIBEWF_READ_AHEAD_SEQUENTIAL_THRESHOLD )
+		{
+			read_ahead->number_of_sequential_reads += 1;
+		}
+	}
+	else if( chunk_index != read_ahead->last_chunk_index )
+	{
+		read_ahead->number_of_sequential_reads = 0;
+		read_ahead->next_chunk_index           = chunk_index + 1;
+	}
+	read_ahead->last_chunk_index = chunk_index;
+
+	if( read_ahead->number_of_sequential_reads < LIBEWF_READ_AHEAD_SEQUENTIAL_THRESHOLD )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( read_ahead->next_chunk_index <= chunk_index )
+	{
+		read_ahead->next_chunk_index = chunk_index + 1;
+	}
+	end_chunk_index = chunk_index + 1 + (uint64_t) read_ahead->maximum_number_of_chunks;
+
+	if( end_chunk_index > media_values->number_of_chunks )
+	{
+		end_chunk_index = media_values->number_of_chunks;
+	}
+	if( read_ahead->next_chunk_index >= end_chunk_index )
+	{
+		return( 1 );
+	}
+	if( read_ahead->thread_pool == NULL )
+	{
+		read_ahead->chunk_table   = chunk_table;
+		read_ahead->io_handle     = io_handle;
+		read_ahead->file_io_pool  = file_io_pool;
+		read_ahead->media_values  = media_values;
+		read_ahead->segment_table = segment_table;
+
+		if( libcthreads_thread_pool_create(
+		     &( read_ahead->thread_pool ),
+		     NULL,
+		     read_ahead->number_of_threads,
+		     read_ahead->maximum_number_of_chunks,
+		     (int (*)(intptr_t *, void *)) &libewf_read_ahead_read_chunk_callback,
+		     (void *) read_ahead,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	while( read_ahead->next_chunk_index < end_chunk_index )
+	{
+		/* The number of pending chunks is bounded by the queue size
+		 * so that pushing a chunk never blocks the reader
+		 */
+		if( libcthreads_mutex_grab(
+		     read_ahead->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		is_full = (int) ( read_ahead->number_of_pending_chunks >= read_ahead->maximum_number_of_chunks );
+
+		if( is_full == 0 )
+		{
+			read_ahead->number_of_pending_chunks += 1;
+		}
+		if( libcthreads_mutex_release(
+		     read_ahead->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+		if( is_full != 0 )
+		{
+			break;
+		}
+		read_ahead_chunk = memory_allocate_structure(
+		                    libewf_read_ahead_chunk_t );
+
+		if( read_ahead_chunk == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create read-ahead chunk.",
+			 function );
+
+			goto on_error;
+		}
+		read_ahead_chunk->offset = (off64_t) ( read_ahead->next_chunk_index * media_values->chunk_size );
+
+		if( libcthreads_thread_pool_push(
+		     read_ahead->thread_pool,
+		     (intptr_t *) read_ahead_chunk,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push read-ahead chunk onto thread pool queue.",
+			 function );
+
+			goto on_error;
+		}
+		read_ahead_chunk = NULL;
+
+		read_ahead->next_chunk_index += 1;
+	}
+	return( 1 );
+
+on_error:
+	if( read_ahead_chunk != NULL )
+	{
+		memory_free(
+		 read_ahead_chunk );
+	}
+	if( libcthreads_mutex_grab(
+	     read_ahead->mutex,
+	     NULL ) == 1 )
+	{
+		read_ahead->number_of_pending_chunks -= 1;
+
+		libcthreads_mutex_release(
+		 read_ahead->mutex,
+		 NULL );
+	}
+	return( -1 );
+#else
+	return( 1 );
+#endif
+}
+
+/* Stops the read-ahead
+ * Waits for pending chunks to be read and resets the sequential read detection
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_stop(
+     libewf_read_ahead_t *read_ahead,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_stop";
+	int result            = 1;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( read_ahead->thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( read_ahead->thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
+	read_ahead->last_chunk_index           = (uint64_t) -1;
+	read_ahead->number_of_sequential_reads = 0;
+	read_ahead->next_chunk_index           = 0;
+	read_ahead->number_of_pending_chunks   = 0;
+	read_ahead->chunk_table                = NULL;
+	read_ahead->io_handle                  = NULL;
+	read_ahead->file_io_pool               = NULL;
+	read_ahead->media_values               = NULL;
+	read_ahead->segment_table              = NULL;
+
+	return( result );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Reads a chunk ahead into the chunk cache
+ * Errors are not reported since the chunk is read again by the reader
+ * Callback function for the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_read_chunk_callback(
+     libewf_read_ahead_chunk_t *read_ahead_chunk,
+     libewf_read_ahead_t *read_ahead )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_chunk_data_t *chunk_data = NULL;
+	off64_t chunk_data_offset       = 0;
+	int result                      = 1;
+
+	if( read_ahead_chunk == NULL )
+	{
+		return( -1 );
+	}
+	if( read_ahead == NULL )
+	{
+		memory_free(
+		 read_ahead_chunk );
+
+		return( -1 );
+	}
+	if( read_ahead->io_handle->abort == 0 )
+	{
+		if( libewf_chunk_table_get_chunk_data_by_offset_concurrent(
+		     read_ahead->chunk_table,
+		     read_ahead->io_handle,
+		     read_ahead->file_io_pool,
+		     read_ahead->media_values,
+		     read_ahead->segment_table,
+		     read_ahead_chunk->offset,
+		     &chunk_data_offset,
+		     &chunk_data,
+		     &error ) == 1 )
+		{
+			/* The chunk data remains in the chunk cache after its reference is released
+			 */
+			libewf_chunk_table_release_chunk_data_concurrent(
+			 read_ahead->chunk_table,
+			 &chunk_data,
+			 &error );
+		}
+	}
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	memory_free(
+	 read_ahead_chunk );
+
+	if( libcthreads_mutex_grab(
+	     read_ahead->mutex,
+	     NULL ) == 1 )
+	{
+		read_ahead->number_of_pending_chunks -= 1;
+
+		if( libcthreads_mutex_release(
+		     read_ahead->mutex,
+		     NULL ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	else
+	{
+		result = -1;
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
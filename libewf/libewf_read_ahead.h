@@ -0,0 +1,158 @@
+/*
+ * Read-ahead functions
+ *
+ * Copyright (C) 2006-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_READ_AHEAD_H )
+#define _LIBEWF_READ_AHEAD_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_table.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_media_values.h"
+#include "libewf_segment_table.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_read_ahead_chunk libewf_read_ahead_chunk_t;
+
+struct libewf_read_ahead_chunk
+{
+	/* The (storage media) offset of the chunk
+	 */
+	off64_t offset;
+};
+
+typedef struct libewf_read_ahead libewf_read_ahead_t;
+
+/* The read-ahead detects sequential reads and reads the chunks ahead of the
+ * current offset on worker threads. The chunks are staged in the chunk cache.
+ */
+struct libewf_read_ahead
+{
+	/* The maximum number of chunks to read ahead, 0 if disabled
+	 */
+	int maximum_number_of_chunks;
+
+	/* The number of worker threads
+	 */
+	int number_of_threads;
+
+	/* The index of the last chunk read
+	 */
+	uint64_t last_chunk_index;
+
+	/* The number of consecutive sequential chunk reads
+	 */
+	int number_of_sequential_reads;
+
+	/* The index of the next chunk to read ahead
+	 */
+	uint64_t next_chunk_index;
+
+	/* The number of chunks pending in the thread pool
+	 */
+	int number_of_pending_chunks;
+
+	/* The chunk table
+	 */
+	libewf_chunk_table_t *chunk_table;
+
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The file IO pool
+	 */
+	libbfio_pool_t *file_io_pool;
+
+	/* The media values
+	 */
+	libewf_media_values_t *media_values;
+
+	/* The segment table
+	 */
+	libewf_segment_table_t *segment_table;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libewf_read_ahead_initialize(
+     libewf_read_ahead_t **read_ahead,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_free(
+     libewf_read_ahead_t **read_ahead,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_get_values(
+     libewf_read_ahead_t *read_ahead,
+     int *maximum_number_of_chunks,
+     int *number_of_threads,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_set_values(
+     libewf_read_ahead_t *read_ahead,
+     int maximum_number_of_chunks,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_schedule(
+     libewf_read_ahead_t *read_ahead,
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_stop(
+     libewf_read_ahead_t *read_ahead,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_read_ahead_read_chunk_callback(
+     libewf_read_ahead_chunk_t *read_ahead_chunk,
+     libewf_read_ahead_t *read_ahead );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_READ_AHEAD_H ) */
+
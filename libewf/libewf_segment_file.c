@@ -186,20 +186,6 @@ int libewf_segment_file_initialize(
 
 		goto on_error;
 	}
-	if( libfcache_cache_initialize(
-	     &( ( *segment_file )->chunk_groups_cache ),
-	     LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNK_GROUPS,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create chunk groups cache.",
-		 function );
-
-		goto on_error;
-	}
 	( *segment_file )->io_handle                        = io_handle;
 	( *segment_file )->device_information_section_index = -1;
 	( *segment_file )->previous_last_chunk_filled       = -1;
@@ -282,18 +268,10 @@ int libewf_segment_file_free(
 
 			result = -1;
 		}
-		if( libfcache_cache_free(
-		     &( ( *segment_file )->chunk_groups_cache ),
-		     error ) != 1 )
+		if( ( *segment_file )->write_buffer != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk groups cache.",
-			 function );
-
-			result = -1;
+			memory_free(
+			 ( *segment_file )->write_buffer );
 		}
 		memory_free(
 		 *segment_file );
@@ -384,8 +362,9 @@ int libewf_segment_file_clone(
 	}
 	( *destination_segment_file )->sections_list             = NULL;
 	( *destination_segment_file )->chunk_groups_list         = NULL;
-	( *destination_segment_file )->chunk_groups_cache        = NULL;
 	( *destination_segment_file )->current_chunk_group_index = 0;
+	( *destination_segment_file )->write_buffer              = NULL;
+	( *destination_segment_file )->write_buffer_data_size    = 0;
 
 	if( libfdata_list_initialize(
 	     &( ( *destination_segment_file )->sections_list ),
@@ -556,20 +535,6 @@ int libewf_segment_file_clone(
 			goto on_error;
 		}
 	}
-	if( libfcache_cache_clone(
-	     &( ( *destination_segment_file )->chunk_groups_cache ),
-	     source_segment_file->chunk_groups_cache,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create destination chunk groups cache.",
-		 function );
-
-		goto on_error;
-	}
 	return( 1 );
 
 on_error:
@@ -3738,6 +3703,25 @@ ssize_t libewf_segment_file_write_chunks_section_end(
 
 		return( -1 );
 	}
+	/* The buffered chunk data precedes the sections that are written next
+	 */
+	write_count = libewf_segment_file_flush_write_buffer(
+	               segment_file,
+	               file_io_pool,
+	               file_io_pool_entry,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush write buffer.",
+		 function );
+
+		goto on_error;
+	}
 /* TODO what about linen 7 */
 	if( ( segment_file->io_handle->format == LIBEWF_FORMAT_ENCASE6 )
 	 || ( segment_file->io_handle->format == LIBEWF_FORMAT_ENCASE7 )
@@ -4227,6 +4211,65 @@ on_error:
 	return( -1 );
 }
 
+/* Flushes the write buffer of a segment file
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_segment_file_flush_write_buffer(
+         libewf_segment_file_t *segment_file,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_flush_write_buffer";
+	ssize_t write_count   = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->write_buffer_data_size == 0 )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: flushing %" PRIzd " bytes of buffered chunk data.\n",
+		 function,
+		 segment_file->write_buffer_data_size );
+	}
+#endif
+	write_count = libbfio_pool_write_buffer(
+	               file_io_pool,
+	               file_io_pool_entry,
+	               segment_file->write_buffer,
+	               segment_file->write_buffer_data_size,
+	               error );
+
+	if( write_count != (ssize_t) segment_file->write_buffer_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffered chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	segment_file->write_buffer_data_size = 0;
+
+	return( write_count );
+}
+
 /* Write a chunk of data to a segment file and update the chunk table
  * Returns the number of bytes written or -1 on error
  */
@@ -4406,12 +4449,81 @@ ssize_t libewf_segment_file_write_chunk_data(
 	}
 #endif /* defined( HAVE_DEBUG_OUTPUT ) */
 
-	write_count = libewf_chunk_data_write(
-	               chunk_data,
-	               file_io_pool,
-	               file_io_pool_entry,
-	               error );
+	/* Chunks are combined in the write buffer so that they are written
+	 * to the segment file in large sequential writes
+	 */
+	if( chunk_write_size <= LIBEWF_SEGMENT_FILE_WRITE_BUFFER_SIZE )
+	{
+		if( segment_file->write_buffer == NULL )
+		{
+			segment_file->write_buffer = (uint8_t *) memory_allocate(
+			                                          sizeof( uint8_t ) * LIBEWF_SEGMENT_FILE_WRITE_BUFFER_SIZE );
+
+			if( segment_file->write_buffer == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create write buffer.",
+				 function );
+
+				return( -1 );
+			}
+			segment_file->write_buffer_data_size = 0;
+		}
+		if( chunk_write_size > ( LIBEWF_SEGMENT_FILE_WRITE_BUFFER_SIZE - segment_file->write_buffer_data_size ) )
+		{
+			if( libewf_segment_file_flush_write_buffer(
+			     segment_file,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     error ) < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to flush write buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		write_count = libewf_chunk_data_copy_to_buffer(
+		               chunk_data,
+		               &( segment_file->write_buffer[ segment_file->write_buffer_data_size ] ),
+		               LIBEWF_SEGMENT_FILE_WRITE_BUFFER_SIZE - segment_file->write_buffer_data_size,
+		               error );
+
+		if( write_count > 0 )
+		{
+			segment_file->write_buffer_data_size += (size_t) write_count;
+		}
+	}
+	else
+	{
+		if( libewf_segment_file_flush_write_buffer(
+		     segment_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     error ) < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush write buffer.",
+			 function );
 
+			return( -1 );
+		}
+		write_count = libewf_chunk_data_write(
+		               chunk_data,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               error );
+	}
 	if( write_count != (ssize_t) chunk_write_size )
 	{
 		libcerror_error_set(
@@ -4962,6 +5074,34 @@ ssize_t libewf_segment_file_write_close(
 
 		return( -1 );
 	}
+	/* The buffered chunk data precedes the sections that are written next
+	 */
+	write_count = libewf_segment_file_flush_write_buffer(
+	               segment_file,
+	               file_io_pool,
+	               file_io_pool_entry,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush write buffer.",
+		 function );
+
+		goto on_error;
+	}
+	/* The write buffer is no longer needed after the chunks have been written
+	 */
+	if( segment_file->write_buffer != NULL )
+	{
+		memory_free(
+		 segment_file->write_buffer );
+
+		segment_file->write_buffer = NULL;
+	}
 	if( last_segment_file != 0 )
 	{
 		/* Write the data section for a single segment file only for EWF-E01
@@ -7258,6 +7398,17 @@ int libewf_segment_file_get_chunk_group_by_offset(
 
 		return( -1 );
 	}
+	if( segment_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
 	if( chunk_group_index == NULL )
 	{
 		libcerror_error_set(
@@ -7294,7 +7445,7 @@ int libewf_segment_file_get_chunk_group_by_offset(
 	result = libfdata_list_get_element_value_at_offset(
 		  segment_file->chunk_groups_list,
 		  (intptr_t *) file_io_pool,
-		  (libfdata_cache_t *) segment_file->chunk_groups_cache,
+		  (libfdata_cache_t *) segment_file->io_handle->chunk_groups_cache,
 		  offset,
 		  &safe_chunk_group_index,
 		  &safe_chunk_group_data_offset,
@@ -147,9 +147,13 @@ struct libewf_segment_file
 	 */
 	off64_t range_end_offset;
 
-	/* The chunk groups cache
+	/* The write buffer, used to combine chunk writes
 	 */
-	libfcache_cache_t *chunk_groups_cache;
+	uint8_t *write_buffer;
+
+	/* The write buffer data size
+	 */
+	size_t write_buffer_data_size;
 };
 
 int libewf_segment_file_initialize(
@@ -327,6 +331,12 @@ ssize_t libewf_segment_file_write_chunks_section_end(
          uint64_t base_offset,
          libcerror_error_t **error );
 
+ssize_t libewf_segment_file_flush_write_buffer(
+         libewf_segment_file_t *segment_file,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         libcerror_error_t **error );
+
 ssize_t libewf_segment_file_write_chunk_data(
          libewf_segment_file_t *segment_file,
          libbfio_pool_t *file_io_pool,
@@ -53,6 +53,14 @@ int libewf_get_access_flags_read(
 	return( (int) LIBEWF_ACCESS_FLAG_READ );
 }
 
+/* Returns the access flags for reading using memory mapped segment files
+ */
+int libewf_get_access_flags_read_memory_map(
+     void )
+{
+	return( (int) ( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_MEMORY_MAP ) );
+}
+
 /* Returns the access flags for reading and writing
  */
 int libewf_get_access_flags_read_write(
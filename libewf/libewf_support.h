@@ -43,6 +43,10 @@ LIBEWF_EXTERN \
 int libewf_get_access_flags_read(
      void );
 
+LIBEWF_EXTERN \
+int libewf_get_access_flags_read_memory_map(
+     void );
+
 LIBEWF_EXTERN \
 int libewf_get_access_flags_read_write(
      void );
@@ -0,0 +1,619 @@
+/*
+ * Vectored read functions
+ *
+ * Copyright (C) 2006-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_table.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_media_values.h"
+#include "libewf_segment_table.h"
+#include "libewf_vectored_read.h"
+
+/* Compares two vectored read segments by their chunk index
+ * Returns -1 if the first segment sorts before the second, 1 if after or 0 if equal
+ */
+int libewf_vectored_read_compare_segments(
+     const void *first_segment,
+     const void *second_segment )
+{
+	const libewf_vectored_read_segment_t *first_vectored_read_segment  = (const libewf_vectored_read_segment_t *) first_segment;
+	const libewf_vectored_read_segment_t *second_vectored_read_segment = (const libewf_vectored_read_segment_t *) second_segment;
+
+	if( first_vectored_read_segment->chunk_index < second_vectored_read_segment->chunk_index )
+	{
+		return( -1 );
+	}
+	else if( first_vectored_read_segment->chunk_index > second_vectored_read_segment->chunk_index )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Compares two vectored read chunks by the location of their data in the segment files
+ * Returns -1 if the first chunk sorts before the second, 1 if after or 0 if equal
+ */
+int libewf_vectored_read_compare_chunks(
+     const void *first_chunk,
+     const void *second_chunk )
+{
+	const libewf_vectored_read_chunk_t *first_vectored_read_chunk  = (const libewf_vectored_read_chunk_t *) first_chunk;
+	const libewf_vectored_read_chunk_t *second_vectored_read_chunk = (const libewf_vectored_read_chunk_t *) second_chunk;
+
+	if( first_vectored_read_chunk->file_io_pool_entry < second_vectored_read_chunk->file_io_pool_entry )
+	{
+		return( -1 );
+	}
+	else if( first_vectored_read_chunk->file_io_pool_entry > second_vectored_read_chunk->file_io_pool_entry )
+	{
+		return( 1 );
+	}
+	if( first_vectored_read_chunk->data_offset < second_vectored_read_chunk->data_offset )
+	{
+		return( -1 );
+	}
+	else if( first_vectored_read_chunk->data_offset > second_vectored_read_chunk->data_offset )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Reads (media) data at multiple offsets into multiple buffers
+ * The requested ranges are split into per chunk segments and grouped by chunk,
+ * so that every chunk is retrieved and unpacked only once. The chunk data
+ * ranges are looked up in a single pass and the chunks are read in order of
+ * their segment file and offset.
+ * The number of bytes read into every buffer is stored in read_counts,
+ * which is 0 for an offset beyond the end of the media data
+ * This function does not change the current offset and can be called by multiple
+ * threads that share the read lock
+ * Returns the total number of bytes read or -1 on error
+ */
+ssize_t libewf_vectored_read_buffers_at_offsets(
+         libewf_chunk_table_t *chunk_table,
+         libewf_io_handle_t *io_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_media_values_t *media_values,
+         libewf_segment_table_t *segment_table,
+         uint8_t **buffers,
+         const size_t *buffer_sizes,
+         const off64_t *offsets,
+         ssize_t *read_counts,
+         int number_of_buffers,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data                        = NULL;
+	libewf_vectored_read_chunk_t *vectored_read_chunk      = NULL;
+	libewf_vectored_read_chunk_t *vectored_read_chunks     = NULL;
+	libewf_vectored_read_segment_t *vectored_read_segment  = NULL;
+	libewf_vectored_read_segment_t *vectored_read_segments = NULL;
+	static char *function                                  = "libewf_vectored_read_buffers_at_offsets";
+	size64_t total_read_count                              = 0;
+	size_t buffer_offset                                   = 0;
+	size_t buffer_size                                     = 0;
+	size_t chunk_iterator                                  = 0;
+	size_t number_of_chunks                                = 0;
+	size_t read_size                                       = 0;
+	size_t segment_index                                   = 0;
+	uint64_t chunk_index                                   = 0;
+	uint64_t number_of_segments                            = 0;
+	off64_t offset                                         = 0;
+	int buffer_index                                       = 0;
+	int result                                             = 1;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media values - chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_counts == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read counts.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_buffers < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of buffers value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	/* Determine the number of bytes to read into every buffer
+	 * and the number of chunk segments needed
+	 */
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		buffer_size = buffer_sizes[ buffer_index ];
+		offset      = offsets[ buffer_index ];
+
+		if( buffers[ buffer_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid buffer: %d.",
+			 function,
+			 buffer_index );
+
+			return( -1 );
+		}
+		if( buffer_size > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid buffer: %d size value exceeds maximum.",
+			 function,
+			 buffer_index );
+
+			return( -1 );
+		}
+		if( offset < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+			 "%s: invalid offset: %d value less than zero.",
+			 function,
+			 buffer_index );
+
+			return( -1 );
+		}
+		if( ( buffer_size == 0 )
+		 || ( (size64_t) offset >= media_values->media_size ) )
+		{
+			read_counts[ buffer_index ] = 0;
+
+			continue;
+		}
+		if( (size64_t) ( offset + buffer_size ) >= media_values->media_size )
+		{
+			buffer_size = (size_t) ( media_values->media_size - offset );
+		}
+		read_counts[ buffer_index ] = (ssize_t) buffer_size;
+
+		total_read_count   += buffer_size;
+		number_of_segments += ( ( (uint64_t) offset + buffer_size - 1 ) / media_values->chunk_size )
+		                    - ( (uint64_t) offset / media_values->chunk_size ) + 1;
+	}
+	if( total_read_count > (size64_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid total buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_segments == 0 )
+	{
+		return( 0 );
+	}
+	if( number_of_segments > (uint64_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libewf_vectored_read_segment_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of segments value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	vectored_read_segments = (libewf_vectored_read_segment_t *) memory_allocate(
+	                                                             sizeof( libewf_vectored_read_segment_t ) * (size_t) number_of_segments );
+
+	if( vectored_read_segments == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create vectored read segments.",
+		 function );
+
+		goto on_error;
+	}
+	/* Split the buffers into chunk segments
+	 */
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		buffer_offset = 0;
+		buffer_size   = (size_t) read_counts[ buffer_index ];
+		offset        = offsets[ buffer_index ];
+
+		while( buffer_size > 0 )
+		{
+			vectored_read_segment = &( vectored_read_segments[ segment_index++ ] );
+
+			chunk_index = (uint64_t) offset / media_values->chunk_size;
+
+			vectored_read_segment->chunk_index       = chunk_index;
+			vectored_read_segment->chunk_data_offset = (size_t) ( offset - (off64_t) ( chunk_index * media_values->chunk_size ) );
+			vectored_read_segment->buffer            = &( ( buffers[ buffer_index ] )[ buffer_offset ] );
+
+			read_size = (size_t) ( media_values->chunk_size - vectored_read_segment->chunk_data_offset );
+
+			if( read_size > buffer_size )
+			{
+				read_size = buffer_size;
+			}
+			vectored_read_segment->buffer_size = read_size;
+
+			buffer_offset += read_size;
+			buffer_size   -= read_size;
+			offset        += (off64_t) read_size;
+		}
+	}
+	qsort(
+	 vectored_read_segments,
+	 (size_t) number_of_segments,
+	 sizeof( libewf_vectored_read_segment_t ),
+	 &libewf_vectored_read_compare_segments );
+
+	/* Group the segments by chunk
+	 */
+	number_of_chunks = 1;
+
+	for( segment_index = 1;
+	     segment_index < (size_t) number_of_segments;
+	     segment_index++ )
+	{
+		if( vectored_read_segments[ segment_index ].chunk_index != vectored_read_segments[ segment_index - 1 ].chunk_index )
+		{
+			number_of_chunks++;
+		}
+	}
+	vectored_read_chunks = (libewf_vectored_read_chunk_t *) memory_allocate(
+	                                                         sizeof( libewf_vectored_read_chunk_t ) * number_of_chunks );
+
+	if( vectored_read_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create vectored read chunks.",
+		 function );
+
+		goto on_error;
+	}
+	vectored_read_chunk = NULL;
+	chunk_iterator      = 0;
+
+	for( segment_index = 0;
+	     segment_index < (size_t) number_of_segments;
+	     segment_index++ )
+	{
+		if( ( vectored_read_chunk == NULL )
+		 || ( vectored_read_chunk->chunk_index != vectored_read_segments[ segment_index ].chunk_index ) )
+		{
+			vectored_read_chunk = &( vectored_read_chunks[ chunk_iterator++ ] );
+
+			vectored_read_chunk->chunk_index         = vectored_read_segments[ segment_index ].chunk_index;
+			vectored_read_chunk->file_io_pool_entry  = -1;
+			vectored_read_chunk->data_offset         = 0;
+			vectored_read_chunk->data_size           = 0;
+			vectored_read_chunk->data_flags          = 0;
+			vectored_read_chunk->first_segment_index = segment_index;
+			vectored_read_chunk->number_of_segments  = 0;
+		}
+		vectored_read_chunk->number_of_segments += 1;
+	}
+	/* Look up the chunk data ranges in a single pass over the chunk table
+	 */
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_table->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	for( chunk_iterator = 0;
+	     chunk_iterator < number_of_chunks;
+	     chunk_iterator++ )
+	{
+		vectored_read_chunk = &( vectored_read_chunks[ chunk_iterator ] );
+
+		result = libewf_chunk_table_get_chunk_data_range_by_offset(
+		          chunk_table,
+		          file_io_pool,
+		          media_values,
+		          segment_table,
+		          (off64_t) ( vectored_read_chunk->chunk_index * media_values->chunk_size ),
+		          &( vectored_read_chunk->file_io_pool_entry ),
+		          &( vectored_read_chunk->data_offset ),
+		          &( vectored_read_chunk->data_size ),
+		          &( vectored_read_chunk->data_flags ),
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " data range.",
+			 function,
+			 vectored_read_chunk->chunk_index );
+
+			result = -1;
+
+			break;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_table->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	qsort(
+	 vectored_read_chunks,
+	 number_of_chunks,
+	 sizeof( libewf_vectored_read_chunk_t ),
+	 &libewf_vectored_read_compare_chunks );
+
+	/* Read every chunk once and fill all the segments that need it
+	 */
+	for( chunk_iterator = 0;
+	     chunk_iterator < number_of_chunks;
+	     chunk_iterator++ )
+	{
+		vectored_read_chunk = &( vectored_read_chunks[ chunk_iterator ] );
+
+		if( libewf_chunk_table_get_chunk_data_by_range_concurrent(
+		     chunk_table,
+		     io_handle,
+		     file_io_pool,
+		     media_values,
+		     vectored_read_chunk->chunk_index,
+		     vectored_read_chunk->file_io_pool_entry,
+		     vectored_read_chunk->data_offset,
+		     vectored_read_chunk->data_size,
+		     vectored_read_chunk->data_flags,
+		     &chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " data.",
+			 function,
+			 vectored_read_chunk->chunk_index );
+
+			goto on_error;
+		}
+		if( chunk_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing chunk: %" PRIu64 " data.",
+			 function,
+			 vectored_read_chunk->chunk_index );
+
+			goto on_error;
+		}
+		for( segment_index = vectored_read_chunk->first_segment_index;
+		     segment_index < ( vectored_read_chunk->first_segment_index + vectored_read_chunk->number_of_segments );
+		     segment_index++ )
+		{
+			vectored_read_segment = &( vectored_read_segments[ segment_index ] );
+
+			if( ( vectored_read_segment->chunk_data_offset > chunk_data->data_size )
+			 || ( vectored_read_segment->buffer_size > ( chunk_data->data_size - vectored_read_segment->chunk_data_offset ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: chunk: %" PRIu64 " segment exceeds data size.",
+				 function,
+				 vectored_read_chunk->chunk_index );
+
+				goto on_error;
+			}
+			if( memory_copy(
+			     vectored_read_segment->buffer,
+			     &( ( chunk_data->data )[ vectored_read_segment->chunk_data_offset ] ),
+			     vectored_read_segment->buffer_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+				 function,
+				 vectored_read_chunk->chunk_index );
+
+				goto on_error;
+			}
+		}
+		if( libewf_chunk_table_release_chunk_data_concurrent(
+		     chunk_table,
+		     &chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release chunk data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 vectored_read_chunks );
+
+	memory_free(
+	 vectored_read_segments );
+
+	return( (ssize_t) total_read_count );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_table_release_chunk_data_concurrent(
+		 chunk_table,
+		 &chunk_data,
+		 NULL );
+	}
+	if( vectored_read_chunks != NULL )
+	{
+		memory_free(
+		 vectored_read_chunks );
+	}
+	if( vectored_read_segments != NULL )
+	{
+		memory_free(
+		 vectored_read_segments );
+	}
+	return( -1 );
+}
+
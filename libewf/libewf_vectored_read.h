@@ -0,0 +1,123 @@
+/*
+ * Vectored read functions
+ *
+ * Copyright (C) 2006-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_VECTORED_READ_H )
+#define _LIBEWF_VECTORED_READ_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_table.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_media_values.h"
+#include "libewf_segment_table.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_vectored_read_segment libewf_vectored_read_segment_t;
+
+/* The part of a buffer that is filled from a single chunk
+ */
+struct libewf_vectored_read_segment
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The offset relative to the start of the chunk
+	 */
+	size_t chunk_data_offset;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+};
+
+typedef struct libewf_vectored_read_chunk libewf_vectored_read_chunk_t;
+
+/* A chunk that is needed by one or more vectored read segments
+ */
+struct libewf_vectored_read_chunk
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The file IO pool entry of the chunk data
+	 */
+	int file_io_pool_entry;
+
+	/* The (segment file) offset of the chunk data
+	 */
+	off64_t data_offset;
+
+	/* The size of the chunk data
+	 */
+	size64_t data_size;
+
+	/* The chunk data flags
+	 */
+	uint32_t data_flags;
+
+	/* The index of the first segment that is filled from the chunk
+	 */
+	size_t first_segment_index;
+
+	/* The number of segments that are filled from the chunk
+	 */
+	size_t number_of_segments;
+};
+
+int libewf_vectored_read_compare_segments(
+     const void *first_segment,
+     const void *second_segment );
+
+int libewf_vectored_read_compare_chunks(
+     const void *first_chunk,
+     const void *second_chunk );
+
+ssize_t libewf_vectored_read_buffers_at_offsets(
+         libewf_chunk_table_t *chunk_table,
+         libewf_io_handle_t *io_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_media_values_t *media_values,
+         libewf_segment_table_t *segment_table,
+         uint8_t **buffers,
+         const size_t *buffer_sizes,
+         const off64_t *offsets,
+         ssize_t *read_counts,
+         int number_of_buffers,
+         libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_VECTORED_READ_H ) */
+
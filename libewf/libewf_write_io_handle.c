@@ -33,6 +33,7 @@
 
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_descriptor.h"
+#include "libewf_chunk_hash_index.h"
 #include "libewf_chunk_table.h"
 #include "libewf_compression.h"
 #include "libewf_definitions.h"
@@ -251,6 +252,22 @@ int libewf_write_io_handle_free(
 				result = -1;
 			}
 		}
+		if( ( *write_io_handle )->chunk_hash_index != NULL )
+		{
+			if( libewf_chunk_hash_index_free(
+			     &( ( *write_io_handle )->chunk_hash_index ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk hash index.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 *write_io_handle );
 
@@ -339,6 +356,7 @@ int libewf_write_io_handle_clone(
 	( *destination_write_io_handle )->current_file_io_pool_entry = -1;
 	( *destination_write_io_handle )->current_segment_file       = NULL;
 	( *destination_write_io_handle )->managed_segment_file       = NULL;
+	( *destination_write_io_handle )->chunk_hash_index           = NULL;
 
 	if( source_write_io_handle->case_data != NULL )
 	{
@@ -486,11 +504,38 @@ int libewf_write_io_handle_clone(
 
 		goto on_error;
 	}
+	/* The chunks referenced by the chunk hash index are not cloned,
+	 * hence the destination starts with an empty chunk hash index
+	 */
+	if( source_write_io_handle->chunk_hash_index != NULL )
+	{
+		if( libewf_chunk_hash_index_initialize(
+		     &( ( *destination_write_io_handle )->chunk_hash_index ),
+		     source_write_io_handle->chunk_hash_index->maximum_number_of_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination chunk hash index.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	return( 1 );
 
 on_error:
 	if( *destination_write_io_handle != NULL )
 	{
+		if( ( *destination_write_io_handle )->chunks_section != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *destination_write_io_handle )->chunks_section ),
+			 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_descriptor_free,
+			 NULL );
+		}
 		if( ( *destination_write_io_handle )->table_section_data != NULL )
 		{
 			memory_free(
@@ -902,6 +947,32 @@ int libewf_write_io_handle_initialize_values(
 			zero_byte_empty_block = NULL;
 		}
 	}
+	/* Chunk deduplication requires the EWF version 2 table entries, which
+	 * contain the offset and size of every chunk. The size of a chunk in
+	 * EWF version 1 is derived from the offset of the next table entry.
+	 */
+	if( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_DEDUPLICATE_CHUNKS ) != 0 )
+	 && ( io_handle->major_version == 2 ) )
+	{
+		if( write_io_handle->chunk_hash_index == NULL )
+		{
+			if( libewf_chunk_hash_index_initialize(
+			     &( write_io_handle->chunk_hash_index ),
+			     LIBEWF_CHUNK_HASH_INDEX_MAXIMUM_NUMBER_OF_ENTRIES,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create chunk hash index.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		write_io_handle->pack_flags |= LIBEWF_PACK_FLAG_CALCULATE_DIGEST;
+	}
 	write_io_handle->timestamp = time( NULL );
 
 	/* Flag that the write values were initialized
@@ -3470,8 +3541,117 @@ ssize_t libewf_write_io_handle_write_new_chunk_create_chunks_section(
 	return( write_count );
 }
 
-/* Creates a new chunks section
- * Returns the number of bytes written, 0 when no longer bytes can be written or -1 on error
+/* Determines if the chunk data was previously written to the current segment file
+ * The digest of unpacked chunk data is calculated if needed
+ * Returns 1 if the chunk is a duplicate, 0 if not or -1 on error
+ */
+int libewf_write_io_handle_is_duplicate_chunk(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_hash_index_entry_t *chunk_hash_index_entry = NULL;
+	static char *function                                   = "libewf_write_io_handle_is_duplicate_chunk";
+	uint8_t pack_flags                                      = 0;
+	int result                                              = 0;
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( write_io_handle->chunk_hash_index == NULL )
+	 || ( write_io_handle->current_segment_file == NULL ) )
+	{
+		return( 0 );
+	}
+	if( ( chunk_data->digest_is_set == 0 )
+	 && ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) == 0 ) )
+	{
+		/* Chunk data that is stored as an empty block or pattern fill
+		 * is not deduplicated
+		 */
+		pack_flags = write_io_handle->pack_flags;
+
+		if( libewf_chunk_data_pack_determine_pack_flags(
+		     chunk_data,
+		     io_handle,
+		     &pack_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine pack flags.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( pack_flags & ( LIBEWF_PACK_FLAG_USE_EMPTY_BLOCK_COMPRESSION | LIBEWF_PACK_FLAG_USE_PATTERN_FILL_COMPRESSION ) ) != 0 )
+		{
+			return( 0 );
+		}
+		if( libewf_chunk_data_calculate_digest(
+		     chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to calculate digest.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( chunk_data->digest_is_set == 0 )
+	{
+		return( 0 );
+	}
+	result = libewf_chunk_hash_index_get_entry_by_digest(
+	          write_io_handle->chunk_hash_index,
+	          chunk_data->digest,
+	          write_io_handle->current_segment_file->segment_number,
+	          &chunk_hash_index_entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk hash index entry.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Creates a new chunk
+ * A chunk that was previously written to the segment file is referenced instead of written again
+ * Returns the number of bytes written or -1 on error
  */
 ssize_t libewf_write_io_handle_write_new_chunk_create_chunk(
          libewf_write_io_handle_t *write_io_handle,
@@ -3483,11 +3663,13 @@ ssize_t libewf_write_io_handle_write_new_chunk_create_chunk(
          size_t input_data_size,
          libcerror_error_t **error )
 {
-	libewf_chunk_descriptor_t *chunk_descriptor = NULL;
-	static char *function                       = "libewf_write_io_handle_write_new_chunk_create_chunk";
-	ssize_t write_count                         = 0;
-	off64_t chunk_offset                        = 0;
-	int entry_index                             = 0;
+	libewf_chunk_descriptor_t *chunk_descriptor             = NULL;
+	libewf_chunk_hash_index_entry_t *chunk_hash_index_entry = NULL;
+	static char *function                                   = "libewf_write_io_handle_write_new_chunk_create_chunk";
+	ssize_t write_count                                     = 0;
+	off64_t chunk_offset                                    = 0;
+	int entry_index                                         = 0;
+	int result                                              = 0;
 
 	if( write_io_handle == NULL )
 	{
@@ -3522,38 +3704,27 @@ ssize_t libewf_write_io_handle_write_new_chunk_create_chunk(
 
 		return( -1 );
 	}
-	chunk_offset = write_io_handle->current_segment_file->current_offset;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( ( write_io_handle->chunk_hash_index != NULL )
+	 && ( chunk_data->digest_is_set != 0 ) )
 	{
-		libcnotify_printf(
-		 "%s: writing chunk: %" PRIu64 " data of size: %" PRIzd " to segment file: %" PRIu32 " at offset: 0x%08" PRIx64 ".\n",
-		 function,
-		 chunk_index,
-		 chunk_data->data_size,
-		 segment_file->segment_number,
-		 chunk_offset );
-	}
-#endif
-	write_count = libewf_segment_file_write_chunk_data(
-		       segment_file,
-		       file_io_pool,
-		       file_io_pool_entry,
-		       chunk_index,
-		       chunk_data,
-	               error );
+		result = libewf_chunk_hash_index_get_entry_by_digest(
+		          write_io_handle->chunk_hash_index,
+		          chunk_data->digest,
+		          segment_file->segment_number,
+		          &chunk_hash_index_entry,
+		          error );
 
-	if( write_count < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write chunk data.",
-		 function );
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk hash index entry.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
 	if( libewf_chunk_descriptor_initialize(
 	     &chunk_descriptor,
@@ -3568,11 +3739,101 @@ ssize_t libewf_write_io_handle_write_new_chunk_create_chunk(
 
 		goto on_error;
 	}
-	chunk_descriptor->data_offset = chunk_offset;
-	chunk_descriptor->data_size   = (size64_t) write_count - chunk_data->padding_size;
-	chunk_descriptor->range_flags = chunk_data->range_flags;
+	if( result != 0 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: chunk: %" PRIu64 " is a duplicate of the chunk in segment file: %" PRIu32 " at offset: 0x%08" PRIx64 ".\n",
+			 function,
+			 chunk_index,
+			 segment_file->segment_number,
+			 chunk_hash_index_entry->data_offset );
+		}
+#endif
+		chunk_descriptor->data_offset = chunk_hash_index_entry->data_offset;
+		chunk_descriptor->data_size   = chunk_hash_index_entry->data_size;
+		chunk_descriptor->range_flags = chunk_hash_index_entry->range_flags;
+	}
+	else
+	{
+		if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid chunk data - data is not packed.",
+			 function );
+
+			goto on_error;
+		}
+		chunk_offset = write_io_handle->current_segment_file->current_offset;
 
-	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) != 0 )
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: writing chunk: %" PRIu64 " data of size: %" PRIzd " to segment file: %" PRIu32 " at offset: 0x%08" PRIx64 ".\n",
+			 function,
+			 chunk_index,
+			 chunk_data->data_size,
+			 segment_file->segment_number,
+			 chunk_offset );
+		}
+#endif
+		write_count = libewf_segment_file_write_chunk_data(
+			       segment_file,
+			       file_io_pool,
+			       file_io_pool_entry,
+			       chunk_index,
+			       chunk_data,
+			       error );
+
+		if( write_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write chunk data.",
+			 function );
+
+			goto on_error;
+		}
+		chunk_descriptor->data_offset = chunk_offset;
+		chunk_descriptor->data_size   = (size64_t) write_count - chunk_data->padding_size;
+		chunk_descriptor->range_flags = chunk_data->range_flags;
+
+		write_io_handle->chunks_section_padding_size += (uint32_t) chunk_data->padding_size;
+
+		if( ( write_io_handle->chunk_hash_index != NULL )
+		 && ( chunk_data->digest_is_set != 0 )
+		 && ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) == 0 ) )
+		{
+			if( libewf_chunk_hash_index_insert_entry(
+			     write_io_handle->chunk_hash_index,
+			     chunk_data->digest,
+			     segment_file->segment_number,
+			     chunk_descriptor->data_offset,
+			     chunk_descriptor->data_size,
+			     chunk_descriptor->range_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to insert chunk: %" PRIu64 " into chunk hash index.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+	}
+	if( ( chunk_descriptor->range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) != 0 )
 	{
 		if( memory_copy(
 		     chunk_descriptor->pattern_fill,
@@ -3609,7 +3870,6 @@ ssize_t libewf_write_io_handle_write_new_chunk_create_chunk(
 
 	write_io_handle->input_write_count                        += input_data_size;
 	write_io_handle->chunks_section_write_count               += write_count;
-	write_io_handle->chunks_section_padding_size              += (uint32_t) chunk_data->padding_size;
 	write_io_handle->remaining_segment_file_size              -= write_count;
 	write_io_handle->number_of_chunks_written_to_segment_file += 1;
 	write_io_handle->number_of_chunks_written_to_section      += 1;
@@ -33,6 +33,7 @@
 
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_group.h"
+#include "libewf_chunk_hash_index.h"
 #include "libewf_chunk_table.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
@@ -220,6 +221,10 @@ struct libewf_write_io_handle
 	/* The size of the compressed zero byte empty block
 	 */
 	size_t compressed_zero_byte_empty_block_size;
+
+	/* The chunk hash index used for chunk deduplication
+	 */
+	libewf_chunk_hash_index_t *chunk_hash_index;
 };
 
 int libewf_write_io_handle_initialize(
@@ -343,6 +348,12 @@ ssize_t libewf_write_io_handle_write_new_chunk_create_chunks_section(
          libewf_segment_file_t *segment_file,
          libcerror_error_t **error );
 
+int libewf_write_io_handle_is_duplicate_chunk(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error );
+
 ssize_t libewf_write_io_handle_write_new_chunk_create_chunk(
          libewf_write_io_handle_t *write_io_handle,
          libbfio_pool_t *file_io_pool,
@@ -153,6 +153,15 @@ AC_DEFUN([AX_LIBFUSE_CHECK_LIB],
         ])
       ])
 
+    dnl Check if the maximum number of threads of the libfuse3 multi-threaded loop can be set
+    AS_IF(
+      [test "x$ac_cv_libfuse" = xlibfuse3],
+      [backup_LIBS="$LIBS"
+      LIBS="$ac_cv_libfuse_LIBADD $LIBS"
+      AC_CHECK_FUNCS([fuse_loop_cfg_set_max_threads])
+      LIBS="$backup_LIBS"
+      ])
+
     AS_IF(
       [test "x$ac_cv_libfuse" != xyes && test "x$ac_cv_with_libfuse" != x && test "x$ac_cv_with_libfuse" != xauto-detect && test "x$ac_cv_with_libfuse" != xyes],
       [AC_MSG_FAILURE(
@@ -626,6 +626,317 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_checksum_calculate_adler32_and_compare_64_bit_pattern function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_checksum_calculate_adler32_and_compare_64_bit_pattern(
+     void )
+{
+	uint8_t data[ 4100 ];
+
+	libcerror_error_t *error   = NULL;
+	size_t data_offset         = 0;
+	uint32_t checksum          = 0;
+	uint32_t expected_checksum = 0;
+	uint8_t pattern_matches    = 0;
+	int result                 = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_checksum_calculate_adler32_and_compare_64_bit_pattern(
+	          &checksum,
+	          ewf_test_checksum_uncompressed_byte_stream,
+	          7640,
+	          1,
+	          &pattern_matches,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "checksum",
+	 checksum,
+	 (uint32_t) 0x304a56a4UL );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "pattern_matches",
+	 pattern_matches,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_offset = 0;
+	     data_offset < 4100;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( 0x41 + ( data_offset % 8 ) );
+	}
+	result = libewf_deflate_calculate_adler32(
+	          &expected_checksum,
+	          data,
+	          4100,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_checksum_calculate_adler32_and_compare_64_bit_pattern(
+	          &checksum,
+	          data,
+	          4100,
+	          1,
+	          &pattern_matches,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "checksum",
+	 checksum,
+	 expected_checksum );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "pattern_matches",
+	 pattern_matches,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a mismatch in the first block, the last block and the trailing bytes
+	 */
+	for( data_offset = 9;
+	     data_offset < 4100;
+	     data_offset += 2045 )
+	{
+		data[ data_offset ] = 0;
+
+		result = libewf_checksum_calculate_adler32_and_compare_64_bit_pattern(
+		          &checksum,
+		          data,
+		          4100,
+		          1,
+		          &pattern_matches,
+		          &error );
+
+		data[ data_offset ] = (uint8_t) ( 0x41 + ( data_offset % 8 ) );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_UINT8(
+		 "pattern_matches",
+		 pattern_matches,
+		 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libewf_checksum_calculate_adler32_and_compare_64_bit_pattern(
+	          NULL,
+	          data,
+	          4100,
+	          1,
+	          &pattern_matches,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_checksum_calculate_adler32_and_compare_64_bit_pattern(
+	          &checksum,
+	          NULL,
+	          4100,
+	          1,
+	          &pattern_matches,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_checksum_calculate_adler32_and_compare_64_bit_pattern(
+	          &checksum,
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          1,
+	          &pattern_matches,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_checksum_calculate_adler32_and_compare_64_bit_pattern(
+	          &checksum,
+	          data,
+	          4100,
+	          1,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD_SUPPORT )
+
+/* Tests the libewf_checksum_calculate_adler32_sse2, libewf_checksum_calculate_adler32_ssse3
+ * and libewf_checksum_calculate_adler32_avx2 functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_checksum_calculate_adler32_simd(
+     void )
+{
+	libcerror_error_t *error     = NULL;
+	size_t data_offset           = 0;
+	size_t data_size             = 0;
+	uint32_t calculated_checksum = 0;
+	uint32_t expected_checksum   = 0;
+	int result                   = 0;
+
+	/* Test regular cases
+	 * Compare against the scalar implementation for a range of sizes and unaligned data
+	 */
+	for( data_size = 0;
+	     data_size < 7640;
+	     data_size += 7 )
+	{
+		data_offset = data_size % 61;
+
+		if( ( data_offset + data_size ) > 7640 )
+		{
+			data_offset = 7640 - data_size;
+		}
+		result = libewf_deflate_calculate_adler32(
+		          &expected_checksum,
+		          &( ewf_test_checksum_uncompressed_byte_stream[ data_offset ] ),
+		          data_size,
+		          0x304a56a4UL,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		calculated_checksum = libewf_checksum_calculate_adler32_sse2(
+		                       &( ewf_test_checksum_uncompressed_byte_stream[ data_offset ] ),
+		                       data_size,
+		                       0x304a56a4UL );
+
+		EWF_TEST_ASSERT_EQUAL_UINT32(
+		 "calculated_checksum",
+		 calculated_checksum,
+		 expected_checksum );
+
+		if( __builtin_cpu_supports( "ssse3" ) )
+		{
+			calculated_checksum = libewf_checksum_calculate_adler32_ssse3(
+			                       &( ewf_test_checksum_uncompressed_byte_stream[ data_offset ] ),
+			                       data_size,
+			                       0x304a56a4UL );
+
+			EWF_TEST_ASSERT_EQUAL_UINT32(
+			 "calculated_checksum",
+			 calculated_checksum,
+			 expected_checksum );
+		}
+		if( __builtin_cpu_supports( "avx2" ) )
+		{
+			calculated_checksum = libewf_checksum_calculate_adler32_avx2(
+			                       &( ewf_test_checksum_uncompressed_byte_stream[ data_offset ] ),
+			                       data_size,
+			                       0x304a56a4UL );
+
+			EWF_TEST_ASSERT_EQUAL_UINT32(
+			 "calculated_checksum",
+			 calculated_checksum,
+			 expected_checksum );
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD_SUPPORT ) */
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 /* The main program
@@ -657,6 +968,18 @@ int main(
 	 "libewf_checksum_calculate_adler32",
 	 ewf_test_checksum_calculate_adler32 );
 
+	EWF_TEST_RUN(
+	 "libewf_checksum_calculate_adler32_and_compare_64_bit_pattern",
+	 ewf_test_checksum_calculate_adler32_and_compare_64_bit_pattern );
+
+#if defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_checksum_calculate_adler32_simd",
+	 ewf_test_checksum_calculate_adler32_simd );
+
+#endif /* defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD_SUPPORT ) */
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
@@ -0,0 +1,1381 @@
+/*
+ * Library chunk_cache type test program
+ *
+ * Copyright (C) 2006-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_chunk_cache.h"
+#include "../libewf/libewf_chunk_data.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_chunk_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_initialize(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_cache_t *chunk_cache = NULL;
+	int result                        = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests   = 2;
+	int number_of_memset_fail_tests   = 2;
+	int test_number                   = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_initialize(
+	          NULL,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	chunk_cache = (libewf_chunk_cache_t *) 0x12345678UL;
+
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          4,
+	          &error );
+
+	chunk_cache = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_cache_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_chunk_cache_initialize(
+		          &chunk_cache,
+		          4,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( chunk_cache != NULL )
+			{
+				libewf_chunk_cache_free(
+				 &chunk_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_cache",
+			 chunk_cache );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_cache_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_chunk_cache_initialize(
+		          &chunk_cache,
+		          4,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( chunk_cache != NULL )
+			{
+				libewf_chunk_cache_free(
+				 &chunk_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_cache",
+			 chunk_cache );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_cache_get_chunk_data, libewf_chunk_cache_set_chunk_data
+ * and libewf_chunk_cache_release_chunk_data functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_get_set_release_chunk_data(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libewf_chunk_cache_t *chunk_cache     = NULL;
+	libewf_chunk_data_t *cached_data      = NULL;
+	libewf_chunk_data_t *chunk_data       = NULL;
+	libewf_chunk_data_t *first_chunk_data = NULL;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_cache_get_chunk_data(
+	          chunk_cache,
+	          0,
+	          &cached_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          512,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	first_chunk_data = chunk_data;
+
+	result = libewf_chunk_cache_set_chunk_data(
+	          chunk_cache,
+	          0,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data",
+	 (int) ( chunk_data == first_chunk_data ),
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_get_chunk_data(
+	          chunk_cache,
+	          0,
+	          &cached_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "cached_data",
+	 (int) ( cached_data == first_chunk_data ),
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a referenced entry is not reused
+	 */
+	chunk_data = NULL;
+
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          512,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_set_chunk_data(
+	          chunk_cache,
+	          1,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_release_chunk_data(
+	          chunk_cache,
+	          chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Release both references to the cached chunk data
+	 */
+	result = libewf_chunk_cache_release_chunk_data(
+	          chunk_cache,
+	          cached_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_release_chunk_data(
+	          chunk_cache,
+	          first_chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The unreferenced entry can now be reused
+	 */
+	result = libewf_chunk_cache_set_chunk_data(
+	          chunk_cache,
+	          1,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_release_chunk_data(
+	          chunk_cache,
+	          chunk_data,
+	          &error );
+
+	chunk_data = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_get_chunk_data(
+	          NULL,
+	          0,
+	          &cached_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_get_chunk_data(
+	          chunk_cache,
+	          0,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_set_chunk_data(
+	          chunk_cache,
+	          0,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_release_chunk_data(
+	          NULL,
+	          first_chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Creates chunk data and sets it in the chunk cache without retaining a reference
+ * Returns 1 if successful, 0 if no entry is available or -1 on error
+ */
+int ewf_test_chunk_cache_set_unreferenced_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	int result                      = 0;
+
+	if( libewf_chunk_data_initialize(
+	     &chunk_data,
+	     512,
+	     1,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	result = libewf_chunk_cache_set_chunk_data(
+	          chunk_cache,
+	          chunk_index,
+	          &chunk_data,
+	          error );
+
+	if( result == 1 )
+	{
+		result = libewf_chunk_cache_release_chunk_data(
+		          chunk_cache,
+		          chunk_data,
+		          error );
+	}
+	else
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( result );
+}
+
+/* Tests the libewf_chunk_cache_resize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_resize(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_cache_t *chunk_cache = NULL;
+	libewf_chunk_data_t *chunk_data   = NULL;
+	libewf_chunk_data_t *chunk_data2  = NULL;
+	uint64_t chunk_index              = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( chunk_index = 0;
+	     chunk_index < 4;
+	     chunk_index++ )
+	{
+		result = ewf_test_chunk_cache_set_unreferenced_chunk_data(
+		          chunk_cache,
+		          chunk_index,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test shrinking the cache, which evicts the oldest entries
+	 */
+	result = libewf_chunk_cache_resize(
+	          chunk_cache,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_get_chunk_data(
+	          chunk_cache,
+	          0,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_get_chunk_data(
+	          chunk_cache,
+	          2,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_get_chunk_data(
+	          chunk_cache,
+	          3,
+	          &chunk_data2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the cache cannot shrink below the number of referenced entries
+	 */
+	result = libewf_chunk_cache_resize(
+	          chunk_cache,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test growing the cache, which retains referenced entries
+	 */
+	result = libewf_chunk_cache_resize(
+	          chunk_cache,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_release_chunk_data(
+	          chunk_cache,
+	          chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_release_chunk_data(
+	          chunk_cache,
+	          chunk_data2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( chunk_index = 4;
+	     chunk_index < 10;
+	     chunk_index++ )
+	{
+		result = ewf_test_chunk_cache_set_unreferenced_chunk_data(
+		          chunk_cache,
+		          chunk_index,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libewf_chunk_cache_get_chunk_data(
+	          chunk_cache,
+	          2,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_release_chunk_data(
+	          chunk_cache,
+	          chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_resize(
+	          NULL,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_resize(
+	          chunk_cache,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests that a sequential scan does not evict protected entries
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_scan_resistance(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_cache_t *chunk_cache = NULL;
+	libewf_chunk_data_t *chunk_data   = NULL;
+	uint64_t chunk_index              = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Fill the cache so that chunk 0 is evicted from the probationary queue
+	 */
+	for( chunk_index = 0;
+	     chunk_index < 5;
+	     chunk_index++ )
+	{
+		result = ewf_test_chunk_cache_set_unreferenced_chunk_data(
+		          chunk_cache,
+		          chunk_index,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libewf_chunk_cache_get_chunk_data(
+	          chunk_cache,
+	          0,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reading chunk 0 again promotes it to the protected queue
+	 */
+	result = ewf_test_chunk_cache_set_unreferenced_chunk_data(
+	          chunk_cache,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A sequential scan only cycles through the probationary queue
+	 */
+	for( chunk_index = 5;
+	     chunk_index < 64;
+	     chunk_index++ )
+	{
+		result = ewf_test_chunk_cache_set_unreferenced_chunk_data(
+		          chunk_cache,
+		          chunk_index,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libewf_chunk_cache_get_chunk_data(
+	          chunk_cache,
+	          0,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_release_chunk_data(
+	          chunk_cache,
+	          chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_get_chunk_data(
+	          chunk_cache,
+	          5,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that emptying the cache removes the protected entries
+	 */
+	result = libewf_chunk_cache_empty(
+	          chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_get_chunk_data(
+	          chunk_cache,
+	          0,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the ghost entries
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_ghost_entries(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_cache_t *chunk_cache = NULL;
+	uint64_t chunk_index              = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_cache->maximum_number_of_ghost_entries",
+	 chunk_cache->maximum_number_of_ghost_entries,
+	 4 );
+
+	/* Test ghost entries with the same hash
+	 */
+	for( chunk_index = 0;
+	     chunk_index < 12;
+	     chunk_index += 4 )
+	{
+		libewf_chunk_cache_append_ghost_entry(
+		 chunk_cache,
+		 chunk_index );
+	}
+	libewf_chunk_cache_append_ghost_entry(
+	 chunk_cache,
+	 1 );
+
+	result = libewf_chunk_cache_remove_ghost_entry(
+	          chunk_cache,
+	          4 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_chunk_cache_remove_ghost_entry(
+	          chunk_cache,
+	          4 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test that the oldest ghost entry is overwritten
+	 */
+	libewf_chunk_cache_append_ghost_entry(
+	 chunk_cache,
+	 12 );
+
+	result = libewf_chunk_cache_remove_ghost_entry(
+	          chunk_cache,
+	          0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libewf_chunk_cache_remove_ghost_entry(
+	          chunk_cache,
+	          8 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_chunk_cache_remove_ghost_entry(
+	          chunk_cache,
+	          12 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_chunk_cache_remove_ghost_entry(
+	          chunk_cache,
+	          1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_chunk_cache_remove_ghost_entry(
+	          chunk_cache,
+	          1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_initialize",
+	 ewf_test_chunk_cache_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_free",
+	 ewf_test_chunk_cache_free );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_get_chunk_data",
+	 ewf_test_chunk_cache_get_set_release_chunk_data );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_resize",
+	 ewf_test_chunk_cache_resize );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_scan_resistance",
+	 ewf_test_chunk_cache_scan_resistance );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_remove_ghost_entry",
+	 ewf_test_chunk_cache_ghost_entries );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+}
+
@@ -911,6 +911,44 @@ int ewf_test_chunk_data_pack_determine_pack_flags(
 	 "error",
 	 error );
 
+	/* Test if the checksum is calculated together with the empty block check
+	 */
+	io_handle->compression_level = LIBEWF_COMPRESSION_LEVEL_NONE;
+
+	chunk_data->data[ 0 ] = 1;
+	chunk_data->checksum  = 0;
+
+	pack_flags = LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM;
+
+	result = libewf_chunk_data_pack_determine_pack_flags(
+	          chunk_data,
+	          io_handle,
+	          &pack_flags,
+	          &error );
+
+	chunk_data->data[ 0 ] = 0;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	expected_pack_flags = LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM | LIBEWF_PACK_FLAG_CHECKSUM_CALCULATED;
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "pack_flags",
+	 pack_flags,
+	 expected_pack_flags );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "chunk_data->checksum",
+	 chunk_data->checksum,
+	 (uint32_t) 0x04000002UL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	/* Test error cases
 	 */
 	result = libewf_chunk_data_pack_determine_pack_flags(
@@ -2976,22 +3014,33 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_chunk_data_unpack function
+/* Tests the libewf_chunk_data_pack_from_reference function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_chunk_data_unpack(
+int ewf_test_chunk_data_pack_from_reference(
      void )
 {
-	libcerror_error_t *error        = NULL;
-	libewf_chunk_data_t *chunk_data = NULL;
-	libewf_io_handle_t *io_handle   = NULL;
-	uint8_t *data                   = NULL;
-	void *memcpy_result             = NULL;
-	uint32_t expected_range_flags   = 0;
-	int result                      = 0;
+	uint8_t compressed_zero_byte_empty_block[ 32 ];
+
+	libcerror_error_t *error                  = NULL;
+	libewf_chunk_data_t *chunk_data           = NULL;
+	libewf_chunk_data_t *reference_chunk_data = NULL;
+	libewf_io_handle_t *io_handle             = NULL;
+	void *memset_result                       = NULL;
+	size_t data_offset                        = 0;
+	int result                                = 0;
 
 	/* Initialize test
 	 */
+	memset_result = memory_set(
+	                 compressed_zero_byte_empty_block,
+	                 0,
+	                 32 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "memset_result",
+	 memset_result );
+
 	result = libewf_io_handle_initialize(
 	          &io_handle,
 	          &error );
@@ -3009,7 +3058,27 @@ int ewf_test_chunk_data_unpack(
 	 "error",
 	 error );
 
-	io_handle->zero_on_error = 1;
+	io_handle->compression_level = LIBEWF_COMPRESSION_LEVEL_DEFAULT;
+	io_handle->compression_flags = 0;
+
+	result = libewf_chunk_data_initialize(
+	          &reference_chunk_data,
+	          512,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "reference_chunk_data",
+	 reference_chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	result = libewf_chunk_data_initialize(
 	          &chunk_data,
@@ -3030,15 +3099,46 @@ int ewf_test_chunk_data_unpack(
 	 "error",
 	 error );
 
-	chunk_data->data_size = 512;
+	for( data_offset = 0;
+	     data_offset < 512;
+	     data_offset++ )
+	{
+		reference_chunk_data->data[ data_offset ] = (uint8_t) ( data_offset % 251 );
+		chunk_data->data[ data_offset ]           = (uint8_t) ( data_offset % 251 );
+	}
+	reference_chunk_data->data_size = 512;
+	chunk_data->data_size           = 512;
+
+	result = libewf_chunk_data_pack(
+	          reference_chunk_data,
+	          io_handle,
+	          compressed_zero_byte_empty_block,
+	          32,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "reference_chunk_data->range_flags",
+	 reference_chunk_data->range_flags,
+	 (uint32_t) ( LIBEWF_RANGE_FLAG_IS_PACKED | LIBEWF_RANGE_FLAG_IS_COMPRESSED ) );
 
 	/* Test regular cases
 	 */
-	chunk_data->range_flags = 0;
-
-	result = libewf_chunk_data_unpack(
+	result = libewf_chunk_data_pack_from_reference(
 	          chunk_data,
 	          io_handle,
+	          reference_chunk_data,
+	          io_handle,
+	          0,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3050,56 +3150,45 @@ int ewf_test_chunk_data_unpack(
 	 "error",
 	 error );
 
-	expected_range_flags = 0;
-
 	EWF_TEST_ASSERT_EQUAL_UINT32(
 	 "chunk_data->range_flags",
 	 chunk_data->range_flags,
-	 expected_range_flags );
+	 (uint32_t) ( LIBEWF_RANGE_FLAG_IS_PACKED | LIBEWF_RANGE_FLAG_IS_COMPRESSED ) );
 
 	EWF_TEST_ASSERT_EQUAL_SIZE(
 	 "chunk_data->data_size",
 	 chunk_data->data_size,
-	 (size_t) 512 );
-
-	memcpy_result = memory_copy(
-	                 chunk_data->data,
-	                 ewf_test_chunk_data_deflate_uncompressed_data1,
-	                 68 );
+	 reference_chunk_data->data_size );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "memcpy_result",
-	 memcpy_result );
+	result = memory_compare(
+	          chunk_data->data,
+	          reference_chunk_data->data,
+	          chunk_data->data_size );
 
-	chunk_data->data_size   = 68;
-	chunk_data->range_flags = LIBEWF_RANGE_FLAG_IS_PACKED | LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
 
-	result = libewf_chunk_data_unpack(
+	/* Test that a packed chunk is not packed again
+	 */
+	result = libewf_chunk_data_pack_from_reference(
 	          chunk_data,
 	          io_handle,
+	          reference_chunk_data,
+	          io_handle,
+	          0,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 0 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	expected_range_flags = LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
-
-	EWF_TEST_ASSERT_EQUAL_UINT32(
-	 "chunk_data->range_flags",
-	 chunk_data->range_flags,
-	 expected_range_flags );
-
-	EWF_TEST_ASSERT_EQUAL_SIZE(
-	 "chunk_data->data_size",
-	 chunk_data->data_size,
-	 (size_t) 64 );
-
 	/* Clean up
 	 */
 	result = libewf_chunk_data_free(
@@ -3119,7 +3208,7 @@ int ewf_test_chunk_data_unpack(
 	 "error",
 	 error );
 
-	/* Initialize test
+	/* Test that a chunk with different data is not packed
 	 */
 	result = libewf_chunk_data_initialize(
 	          &chunk_data,
@@ -3140,134 +3229,151 @@ int ewf_test_chunk_data_unpack(
 	 "error",
 	 error );
 
+	for( data_offset = 0;
+	     data_offset < 512;
+	     data_offset++ )
+	{
+		chunk_data->data[ data_offset ] = (uint8_t) ( data_offset % 241 );
+	}
 	chunk_data->data_size = 512;
 
-	/* Test regular case where checksum is invalid
-	 */
-	memcpy_result = memory_copy(
-	                 chunk_data->data,
-	                 ewf_test_chunk_data_deflate_uncompressed_data1,
-	                 68 );
-
-	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "memcpy_result",
-	 memcpy_result );
-
-	byte_stream_copy_from_uint32_little_endian(
-	 &( chunk_data->data[ 64 ] ),
-	 0xffffffffUL );
-
-	chunk_data->data_size   = 68;
-	chunk_data->range_flags = LIBEWF_RANGE_FLAG_IS_PACKED | LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
-
-	result = libewf_chunk_data_unpack(
+	result = libewf_chunk_data_pack_from_reference(
 	          chunk_data,
 	          io_handle,
+	          reference_chunk_data,
+	          io_handle,
+	          0,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 0 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	expected_range_flags = LIBEWF_RANGE_FLAG_HAS_CHECKSUM | LIBEWF_RANGE_FLAG_IS_CORRUPTED;
-
 	EWF_TEST_ASSERT_EQUAL_UINT32(
 	 "chunk_data->range_flags",
 	 chunk_data->range_flags,
-	 expected_range_flags );
-
-	EWF_TEST_ASSERT_EQUAL_SIZE(
-	 "chunk_data->data_size",
-	 chunk_data->data_size,
-	 (size_t) 512 );
+	 (uint32_t) 0 );
 
-	/* Clean up
+	/* Test that a reference chunk that cannot be unpacked is not used
 	 */
-	result = libewf_chunk_data_free(
-	          &chunk_data,
+	for( data_offset = 0;
+	     data_offset < 512;
+	     data_offset++ )
+	{
+		chunk_data->data[ data_offset ] = (uint8_t) ( data_offset % 251 );
+	}
+	reference_chunk_data->data[ 4 ] ^= 0xff;
+
+	result = libewf_chunk_data_pack_from_reference(
+	          chunk_data,
+	          io_handle,
+	          reference_chunk_data,
+	          io_handle,
+	          0,
 	          &error );
 
+	reference_chunk_data->data[ 4 ] ^= 0xff;
+
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
-
-	EWF_TEST_ASSERT_IS_NULL(
-	 "chunk_data",
-	 chunk_data );
+	 0 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Initialize test
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "chunk_data->range_flags",
+	 chunk_data->range_flags,
+	 (uint32_t) 0 );
+
+	/* Test error cases
 	 */
-	result = libewf_chunk_data_initialize(
-	          &chunk_data,
-	          512,
-	          1,
+	result = libewf_chunk_data_pack_from_reference(
+	          NULL,
+	          io_handle,
+	          reference_chunk_data,
+	          io_handle,
+	          0,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "chunk_data",
-	 chunk_data );
-
-	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	chunk_data->data_size = 512;
+	libcerror_error_free(
+	 &error );
 
-	/* Test regular cases
-	 */
-	memcpy_result = memory_copy(
-	                 chunk_data->data,
-	                 ewf_test_chunk_data_deflate_compressed_data1,
-	                 52 );
+	result = libewf_chunk_data_pack_from_reference(
+	          chunk_data,
+	          NULL,
+	          reference_chunk_data,
+	          io_handle,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "memcpy_result",
-	 memcpy_result );
+	 "error",
+	 error );
 
-	chunk_data->chunk_size  = 32768;
-	chunk_data->data_size   = 52;
-	chunk_data->range_flags = LIBEWF_RANGE_FLAG_IS_PACKED | LIBEWF_RANGE_FLAG_IS_COMPRESSED;
+	libcerror_error_free(
+	 &error );
 
-	result = libewf_chunk_data_unpack(
+	result = libewf_chunk_data_pack_from_reference(
 	          chunk_data,
 	          io_handle,
+	          NULL,
+	          io_handle,
+	          0,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
+	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	expected_range_flags = LIBEWF_RANGE_FLAG_IS_COMPRESSED;
-
-	EWF_TEST_ASSERT_EQUAL_UINT32(
-	 "chunk_data->range_flags",
-	 chunk_data->range_flags,
-	 expected_range_flags );
+	libcerror_error_free(
+	 &error );
 
-	EWF_TEST_ASSERT_EQUAL_SIZE(
-	 "chunk_data->data_size",
-	 chunk_data->data_size,
-	 (size_t) 32768 );
+	result = libewf_chunk_data_pack_from_reference(
+	          chunk_data,
+	          io_handle,
+	          reference_chunk_data,
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
 
 	/* Clean up
 	 */
@@ -3288,8 +3394,104 @@ int ewf_test_chunk_data_unpack(
 	 "error",
 	 error );
 
+	result = libewf_chunk_data_free(
+	          &reference_chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "reference_chunk_data",
+	 reference_chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( reference_chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &reference_chunk_data,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_unpack function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_unpack(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_chunk_data_t *chunk_data = NULL;
+	libewf_io_handle_t *io_handle   = NULL;
+	uint8_t *data                   = NULL;
+	void *memcpy_result             = NULL;
+	uint32_t expected_range_flags   = 0;
+	int result                      = 0;
+
 	/* Initialize test
 	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->zero_on_error = 1;
+
 	result = libewf_chunk_data_initialize(
 	          &chunk_data,
 	          512,
@@ -3313,18 +3515,45 @@ int ewf_test_chunk_data_unpack(
 
 	/* Test regular cases
 	 */
+	chunk_data->range_flags = 0;
+
+	result = libewf_chunk_data_unpack(
+	          chunk_data,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	expected_range_flags = 0;
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "chunk_data->range_flags",
+	 chunk_data->range_flags,
+	 expected_range_flags );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "chunk_data->data_size",
+	 chunk_data->data_size,
+	 (size_t) 512 );
+
 	memcpy_result = memory_copy(
 	                 chunk_data->data,
-	                 ewf_test_chunk_data_64_bit_pattern_fill_compressed_data1,
-	                 8 );
+	                 ewf_test_chunk_data_deflate_uncompressed_data1,
+	                 68 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "memcpy_result",
 	 memcpy_result );
 
-	chunk_data->chunk_size  = 32768;
-	chunk_data->data_size   = 8;
-	chunk_data->range_flags = LIBEWF_RANGE_FLAG_IS_PACKED | LIBEWF_RANGE_FLAG_IS_COMPRESSED | LIBEWF_RANGE_FLAG_USES_PATTERN_FILL;
+	chunk_data->data_size   = 68;
+	chunk_data->range_flags = LIBEWF_RANGE_FLAG_IS_PACKED | LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
 
 	result = libewf_chunk_data_unpack(
 	          chunk_data,
@@ -3340,7 +3569,7 @@ int ewf_test_chunk_data_unpack(
 	 "error",
 	 error );
 
-	expected_range_flags = LIBEWF_RANGE_FLAG_IS_COMPRESSED | LIBEWF_RANGE_FLAG_USES_PATTERN_FILL;
+	expected_range_flags = LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
 
 	EWF_TEST_ASSERT_EQUAL_UINT32(
 	 "chunk_data->range_flags",
@@ -3350,7 +3579,12 @@ int ewf_test_chunk_data_unpack(
 	EWF_TEST_ASSERT_EQUAL_SIZE(
 	 "chunk_data->data_size",
 	 chunk_data->data_size,
-	 (size_t) 32768 );
+	 (size_t) 64 );
+
+	EWF_TEST_ASSERT_EQUAL_INTPTR(
+	 "chunk_data->data",
+	 (intptr_t) chunk_data->data,
+	 (intptr_t) ewf_test_chunk_data_deflate_uncompressed_data1 );
 
 	/* Clean up
 	 */
@@ -3394,86 +3628,94 @@ int ewf_test_chunk_data_unpack(
 
 	chunk_data->data_size = 512;
 
-	/* Test error cases
+	/* Test regular case where checksum is invalid
 	 */
-	result = libewf_chunk_data_unpack(
-	          NULL,
-	          io_handle,
-	          &error );
-
-	EWF_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
+	memcpy_result = memory_copy(
+	                 chunk_data->data,
+	                 ewf_test_chunk_data_deflate_uncompressed_data1,
+	                 68 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
-
-	libcerror_error_free(
-	 &error );
+	 "memcpy_result",
+	 memcpy_result );
 
-	data = chunk_data->data;
+	byte_stream_copy_from_uint32_little_endian(
+	 &( chunk_data->data[ 64 ] ),
+	 0xffffffffUL );
 
-	chunk_data->data = NULL;
+	chunk_data->data_size   = 68;
+	chunk_data->range_flags = LIBEWF_RANGE_FLAG_IS_PACKED | LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
 
 	result = libewf_chunk_data_unpack(
 	          chunk_data,
 	          io_handle,
 	          &error );
 
-	chunk_data->data = data;
-
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
+	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	expected_range_flags = LIBEWF_RANGE_FLAG_HAS_CHECKSUM | LIBEWF_RANGE_FLAG_IS_CORRUPTED;
 
-	result = libewf_chunk_data_unpack(
-	          chunk_data,
-	          NULL,
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "chunk_data->range_flags",
+	 chunk_data->range_flags,
+	 expected_range_flags );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "chunk_data->data_size",
+	 chunk_data->data_size,
+	 (size_t) 512 );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_free(
+	          &chunk_data,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	chunk_data->chunk_size = 0;
-
-	result = libewf_chunk_data_unpack(
-	          chunk_data,
-	          io_handle,
+	/* Initialize test
+	 */
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          512,
+	          1,
 	          &error );
 
-	chunk_data->chunk_size = 512;
-
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	chunk_data->data_size = 512;
 
+	/* Test regular cases
+	 */
 	memcpy_result = memory_copy(
 	                 chunk_data->data,
 	                 ewf_test_chunk_data_deflate_compressed_data1,
@@ -3483,29 +3725,273 @@ int ewf_test_chunk_data_unpack(
 	 "memcpy_result",
 	 memcpy_result );
 
+	chunk_data->chunk_size  = 32768;
 	chunk_data->data_size   = 52;
 	chunk_data->range_flags = LIBEWF_RANGE_FLAG_IS_PACKED | LIBEWF_RANGE_FLAG_IS_COMPRESSED;
 
-	chunk_data->compressed_data = (uint8_t *) 0x12345678UL;
-
 	result = libewf_chunk_data_unpack(
 	          chunk_data,
 	          io_handle,
 	          &error );
 
-	chunk_data->compressed_data = NULL;
-
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
+	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	expected_range_flags = LIBEWF_RANGE_FLAG_IS_COMPRESSED;
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "chunk_data->range_flags",
+	 chunk_data->range_flags,
+	 expected_range_flags );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "chunk_data->data_size",
+	 chunk_data->data_size,
+	 (size_t) 32768 );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          512,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	chunk_data->data_size = 512;
+
+	/* Test regular cases
+	 */
+	memcpy_result = memory_copy(
+	                 chunk_data->data,
+	                 ewf_test_chunk_data_64_bit_pattern_fill_compressed_data1,
+	                 8 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "memcpy_result",
+	 memcpy_result );
+
+	chunk_data->chunk_size  = 32768;
+	chunk_data->data_size   = 8;
+	chunk_data->range_flags = LIBEWF_RANGE_FLAG_IS_PACKED | LIBEWF_RANGE_FLAG_IS_COMPRESSED | LIBEWF_RANGE_FLAG_USES_PATTERN_FILL;
+
+	result = libewf_chunk_data_unpack(
+	          chunk_data,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	expected_range_flags = LIBEWF_RANGE_FLAG_IS_COMPRESSED | LIBEWF_RANGE_FLAG_USES_PATTERN_FILL;
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "chunk_data->range_flags",
+	 chunk_data->range_flags,
+	 expected_range_flags );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "chunk_data->data_size",
+	 chunk_data->data_size,
+	 (size_t) 32768 );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          512,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	chunk_data->data_size = 512;
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_unpack(
+	          NULL,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	data = chunk_data->data;
+
+	chunk_data->data = NULL;
+
+	result = libewf_chunk_data_unpack(
+	          chunk_data,
+	          io_handle,
+	          &error );
+
+	chunk_data->data = data;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_unpack(
+	          chunk_data,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	chunk_data->chunk_size = 0;
+
+	result = libewf_chunk_data_unpack(
+	          chunk_data,
+	          io_handle,
+	          &error );
+
+	chunk_data->chunk_size = 512;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	memcpy_result = memory_copy(
+	                 chunk_data->data,
+	                 ewf_test_chunk_data_deflate_compressed_data1,
+	                 52 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "memcpy_result",
+	 memcpy_result );
+
+	chunk_data->data_size   = 52;
+	chunk_data->range_flags = LIBEWF_RANGE_FLAG_IS_PACKED | LIBEWF_RANGE_FLAG_IS_COMPRESSED;
+
+	chunk_data->compressed_data = (uint8_t *) 0x12345678UL;
+
+	result = libewf_chunk_data_unpack(
+	          chunk_data,
+	          io_handle,
+	          &error );
+
+	chunk_data->compressed_data = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
 
 #if defined( HAVE_EWF_TEST_MEMORY ) && defined( OPTIMIZATION_DISABLED )
 
@@ -3630,34 +4116,44 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_chunk_data_check_for_empty_block function
+/* Tests the libewf_chunk_data_unpack_to_buffer function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_chunk_data_check_for_empty_block(
+int ewf_test_chunk_data_unpack_to_buffer(
      void )
 {
-	uint8_t buffer[ 512 ];
-
-	libcerror_error_t *error = NULL;
-	void *memset_result      = NULL;
-	int result               = 0;
+	uint8_t buffer[ 32768 ];
 
-	/* Initialize test
+	libcerror_error_t *error        = NULL;
+	libewf_chunk_data_t *chunk_data = NULL;
+	libewf_io_handle_t *io_handle   = NULL;
+	void *memcpy_result             = NULL;
+	uint32_t expected_range_flags   = 0;
+	int result                      = 0;
+
+	/* Initialize test
 	 */
-	memset_result = memory_set(
-	                 buffer,
-	                 0,
-	                 512 );
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "memset_result",
-	 memset_result );
+	 "io_handle",
+	 io_handle );
 
-	/* Test regular cases
-	 */
-	result = libewf_chunk_data_check_for_empty_block(
-	          buffer,
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
 	          512,
+	          1,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3665,13 +4161,39 @@ int ewf_test_chunk_data_check_for_empty_block(
 	 result,
 	 1 );
 
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	result = libewf_chunk_data_check_for_empty_block(
-	          &( buffer[ 1 ] ),
-	          512 - 1,
+	/* Test regular cases
+	 */
+	memcpy_result = memory_copy(
+	                 chunk_data->data,
+	                 ewf_test_chunk_data_deflate_compressed_data1,
+	                 52 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "memcpy_result",
+	 memcpy_result );
+
+	chunk_data->chunk_size  = 32768;
+	chunk_data->data_size   = 52;
+	chunk_data->range_flags = LIBEWF_RANGE_FLAG_IS_PACKED | LIBEWF_RANGE_FLAG_IS_COMPRESSED;
+
+	memory_set(
+	 buffer,
+	 0xff,
+	 32768 );
+
+	result = libewf_chunk_data_unpack_to_buffer(
+	          chunk_data,
+	          io_handle,
+	          buffer,
+	          32768,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3683,27 +4205,72 @@ int ewf_test_chunk_data_check_for_empty_block(
 	 "error",
 	 error );
 
-	buffer[ 500 ] = (uint8_t) 'A';
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 0 );
 
-	result = libewf_chunk_data_check_for_empty_block(
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 32767 ]",
+	 buffer[ 32767 ],
+	 0 );
+
+	/* The chunk data should not be modified
+	 */
+	expected_range_flags = LIBEWF_RANGE_FLAG_IS_PACKED | LIBEWF_RANGE_FLAG_IS_COMPRESSED;
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "chunk_data->range_flags",
+	 chunk_data->range_flags,
+	 expected_range_flags );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "chunk_data->data_size",
+	 chunk_data->data_size,
+	 (size_t) 52 );
+
+	/* Test chunk data with a checksum
+	 */
+	memcpy_result = memory_copy(
+	                 chunk_data->data,
+	                 ewf_test_chunk_data_deflate_uncompressed_data1,
+	                 68 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "memcpy_result",
+	 memcpy_result );
+
+	chunk_data->chunk_size  = 64;
+	chunk_data->data_size   = 68;
+	chunk_data->range_flags = LIBEWF_RANGE_FLAG_IS_PACKED | LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
+
+	result = libewf_chunk_data_unpack_to_buffer(
+	          chunk_data,
+	          io_handle,
 	          buffer,
-	          512,
+	          64,
 	          &error );
 
-	buffer[ 500 ] = 0;
-
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 0 );
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	result = libewf_chunk_data_check_for_empty_block(
+	/* Test chunk data with an invalid checksum
+	 */
+	byte_stream_copy_from_uint32_little_endian(
+	 &( chunk_data->data[ 64 ] ),
+	 0xffffffffUL );
+
+	result = libewf_chunk_data_unpack_to_buffer(
+	          chunk_data,
+	          io_handle,
 	          buffer,
-	          0,
+	          64,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3715,15 +4282,21 @@ int ewf_test_chunk_data_check_for_empty_block(
 	 "error",
 	 error );
 
-	result = libewf_chunk_data_check_for_empty_block(
+	/* Test chunk data that uses pattern fill
+	 */
+	chunk_data->range_flags = LIBEWF_RANGE_FLAG_IS_PACKED | LIBEWF_RANGE_FLAG_IS_COMPRESSED | LIBEWF_RANGE_FLAG_USES_PATTERN_FILL;
+
+	result = libewf_chunk_data_unpack_to_buffer(
+	          chunk_data,
+	          io_handle,
 	          buffer,
-	          1,
+	          64,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 0 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
@@ -3731,9 +4304,11 @@ int ewf_test_chunk_data_check_for_empty_block(
 
 	/* Test error cases
 	 */
-	result = libewf_chunk_data_check_for_empty_block(
+	result = libewf_chunk_data_unpack_to_buffer(
 	          NULL,
-	          512,
+	          io_handle,
+	          buffer,
+	          64,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3748,9 +4323,49 @@ int ewf_test_chunk_data_check_for_empty_block(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_chunk_data_check_for_empty_block(
+	result = libewf_chunk_data_unpack_to_buffer(
+	          chunk_data,
+	          NULL,
 	          buffer,
-	          (size_t) SSIZE_MAX + 1,
+	          64,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_unpack_to_buffer(
+	          chunk_data,
+	          io_handle,
+	          NULL,
+	          64,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_unpack_to_buffer(
+	          chunk_data,
+	          io_handle,
+	          buffer,
+	          63,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3765,6 +4380,42 @@ int ewf_test_chunk_data_check_for_empty_block(
 	libcerror_error_free(
 	 &error );
 
+	/* Clean up
+	 */
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	return( 1 );
 
 on_error:
@@ -3773,27 +4424,38 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
 	return( 0 );
 }
 
-/* Tests the libewf_chunk_data_check_for_64_bit_pattern_fill function
+/* Tests the libewf_chunk_data_check_for_empty_block function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_chunk_data_check_for_64_bit_pattern_fill(
+int ewf_test_chunk_data_check_for_empty_block(
      void )
 {
 	uint8_t buffer[ 512 ];
 
 	libcerror_error_t *error = NULL;
 	void *memset_result      = NULL;
-	uint64_t pattern         = 0;
 	int result               = 0;
 
 	/* Initialize test
 	 */
 	memset_result = memory_set(
 	                 buffer,
-	                 'X',
+	                 0,
 	                 512 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
@@ -3802,12 +4464,9 @@ int ewf_test_chunk_data_check_for_64_bit_pattern_fill(
 
 	/* Test regular cases
 	 */
-	pattern = 0;
-
-	result = libewf_chunk_data_check_for_64_bit_pattern_fill(
+	result = libewf_chunk_data_check_for_empty_block(
 	          buffer,
 	          512,
-	          &pattern,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3815,21 +4474,13 @@ int ewf_test_chunk_data_check_for_64_bit_pattern_fill(
 	 result,
 	 1 );
 
-	EWF_TEST_ASSERT_EQUAL_UINT64(
-	 "pattern",
-	 pattern,
-	 (uint64_t) 0x5858585858585858UL );
-
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	pattern = 0;
-
-	result = libewf_chunk_data_check_for_64_bit_pattern_fill(
+	result = libewf_chunk_data_check_for_empty_block(
 	          &( buffer[ 1 ] ),
-	          512 - 8,
-	          &pattern,
+	          512 - 1,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3837,42 +4488,200 @@ int ewf_test_chunk_data_check_for_64_bit_pattern_fill(
 	 result,
 	 1 );
 
-	EWF_TEST_ASSERT_EQUAL_UINT64(
-	 "pattern",
-	 pattern,
-	 (uint64_t) 0x5858585858585858UL );
-
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	pattern = 0;
-
-	buffer[ 3 ] = (uint8_t) 'A';
+	buffer[ 500 ] = (uint8_t) 'A';
 
-	result = libewf_chunk_data_check_for_64_bit_pattern_fill(
-	          &( buffer[ 1 ] ),
-	          512 - 8,
-	          &pattern,
+	result = libewf_chunk_data_check_for_empty_block(
+	          buffer,
+	          512,
 	          &error );
 
-	buffer[ 3 ] = (uint8_t) 'X';
+	buffer[ 500 ] = 0;
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 0 );
 
-	EWF_TEST_ASSERT_EQUAL_UINT64(
-	 "pattern",
-	 pattern,
-	 (uint64_t) 0 );
-
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	pattern = 0;
+	result = libewf_chunk_data_check_for_empty_block(
+	          buffer,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_check_for_empty_block(
+	          buffer,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_check_for_empty_block(
+	          NULL,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_check_for_empty_block(
+	          buffer,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_check_for_64_bit_pattern_fill function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_check_for_64_bit_pattern_fill(
+     void )
+{
+	uint8_t buffer[ 512 ];
+
+	libcerror_error_t *error = NULL;
+	void *memset_result      = NULL;
+	uint64_t pattern         = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	memset_result = memory_set(
+	                 buffer,
+	                 'X',
+	                 512 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "memset_result",
+	 memset_result );
+
+	/* Test regular cases
+	 */
+	pattern = 0;
+
+	result = libewf_chunk_data_check_for_64_bit_pattern_fill(
+	          buffer,
+	          512,
+	          &pattern,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "pattern",
+	 pattern,
+	 (uint64_t) 0x5858585858585858UL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	pattern = 0;
+
+	result = libewf_chunk_data_check_for_64_bit_pattern_fill(
+	          &( buffer[ 1 ] ),
+	          512 - 8,
+	          &pattern,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "pattern",
+	 pattern,
+	 (uint64_t) 0x5858585858585858UL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	pattern = 0;
+
+	buffer[ 3 ] = (uint8_t) 'A';
+
+	result = libewf_chunk_data_check_for_64_bit_pattern_fill(
+	          &( buffer[ 1 ] ),
+	          512 - 8,
+	          &pattern,
+	          &error );
+
+	buffer[ 3 ] = (uint8_t) 'X';
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "pattern",
+	 pattern,
+	 (uint64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	pattern = 0;
 
 	buffer[ sizeof( intptr_t ) + 3 ] = (uint8_t) 'A';
 
@@ -4047,27 +4856,34 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_chunk_data_write function
+/* Tests the libewf_chunk_data_check_for_incompressible_data function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_chunk_data_write(
+int ewf_test_chunk_data_check_for_incompressible_data(
      void )
 {
-	uint8_t file_data[ 516 ];
+	uint8_t buffer[ 32768 ];
 
-	libbfio_pool_t *file_io_pool    = NULL;
-	libcerror_error_t *error        = NULL;
-	libewf_chunk_data_t *chunk_data = NULL;
-	ssize_t write_count             = 0;
-	off64_t offset                  = 0;
-	int result                      = 0;
+	libcerror_error_t *error = NULL;
+	uint32_t random_value    = 0x12345678UL;
+	size_t buffer_index      = 0;
+	int result               = 0;
 
 	/* Initialize test
 	 */
-	result = libewf_chunk_data_initialize(
-	          &chunk_data,
-	          512,
-	          1,
+	for( buffer_index = 0;
+	     buffer_index < 32768;
+	     buffer_index++ )
+	{
+		random_value = ( random_value * 1103515245UL ) + 12345;
+
+		buffer[ buffer_index ] = (uint8_t) ( random_value >> 24 );
+	}
+	/* Test regular cases
+	 */
+	result = libewf_chunk_data_check_for_incompressible_data(
+	          buffer,
+	          32768,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -4075,23 +4891,13 @@ int ewf_test_chunk_data_write(
 	 result,
 	 1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "chunk_data",
-	 chunk_data );
-
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	chunk_data->data_size = 512;
-
-	/* Initialize file IO pool
-	 */
-	result = ewf_test_open_file_io_pool(
-	          &file_io_pool,
-	          file_data,
-	          516,
-	          LIBBFIO_OPEN_WRITE,
+	result = libewf_chunk_data_check_for_incompressible_data(
+	          buffer,
+	          2048,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -4099,57 +4905,196 @@ int ewf_test_chunk_data_write(
 	 result,
 	 1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "file_io_pool",
-	 file_io_pool );
-
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test regular cases
+	/* Too few bytes to predict the compressibility
 	 */
-	chunk_data->chunk_io_flags = 0;
-	chunk_data->range_flags    = LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
-
-	write_count = libewf_chunk_data_write(
-	               chunk_data,
-	               file_io_pool,
-	               0,
-	               &error );
+	result = libewf_chunk_data_check_for_incompressible_data(
+	          buffer,
+	          256,
+	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_SSIZE(
-	 "write_count",
-	 write_count,
-	 (ssize_t) 512 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	offset = libbfio_pool_seek_offset(
-	          file_io_pool,
-	          0,
-	          0,
-	          SEEK_SET,
+	for( buffer_index = 0;
+	     buffer_index < 32768;
+	     buffer_index++ )
+	{
+		buffer[ buffer_index ] = (uint8_t) ( 'a' + ( buffer_index % 26 ) );
+	}
+	result = libewf_chunk_data_check_for_incompressible_data(
+	          buffer,
+	          32768,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 0 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	chunk_data->chunk_io_flags = LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET;
-	chunk_data->range_flags    = LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_check_for_incompressible_data(
+	          NULL,
+	          32768,
+	          &error );
 
-	write_count = libewf_chunk_data_write(
-	               chunk_data,
-	               file_io_pool,
-	               0,
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_check_for_incompressible_data(
+	          buffer,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_write function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_write(
+     void )
+{
+	uint8_t file_data[ 516 ];
+
+	libbfio_pool_t *file_io_pool    = NULL;
+	libcerror_error_t *error        = NULL;
+	libewf_chunk_data_t *chunk_data = NULL;
+	ssize_t write_count             = 0;
+	off64_t offset                  = 0;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          512,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	chunk_data->data_size = 512;
+
+	/* Initialize file IO pool
+	 */
+	result = ewf_test_open_file_io_pool(
+	          &file_io_pool,
+	          file_data,
+	          516,
+	          LIBBFIO_OPEN_WRITE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_pool",
+	 file_io_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	chunk_data->chunk_io_flags = 0;
+	chunk_data->range_flags    = LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
+
+	write_count = libewf_chunk_data_write(
+	               chunk_data,
+	               file_io_pool,
+	               0,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 512 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libbfio_pool_seek_offset(
+	          file_io_pool,
+	          0,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	chunk_data->chunk_io_flags = LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET;
+	chunk_data->range_flags    = LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
+
+	write_count = libewf_chunk_data_write(
+	               chunk_data,
+	               file_io_pool,
+	               0,
 	               &error );
 
 	EWF_TEST_ASSERT_EQUAL_SSIZE(
@@ -4215,19 +5160,359 @@ int ewf_test_chunk_data_write(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	libcerror_error_free(
+	 &error );
+
+	write_count = libewf_chunk_data_write(
+	               chunk_data,
+	               file_io_pool,
+	               -1,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up file IO pool
+	 */
+	result = ewf_test_close_file_io_pool(
+	          &file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_copy_to_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_copy_to_buffer(
+     void )
+{
+	uint8_t buffer[ 516 ];
+
+	libcerror_error_t *error        = NULL;
+	libewf_chunk_data_t *chunk_data = NULL;
+	ssize_t copy_count              = 0;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          512,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	chunk_data->data_size = 512;
+	chunk_data->checksum  = 0x78563412UL;
+
+	/* Test regular cases
+	 */
+	chunk_data->chunk_io_flags = 0;
+	chunk_data->range_flags    = LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
+
+	copy_count = libewf_chunk_data_copy_to_buffer(
+	              chunk_data,
+	              buffer,
+	              516,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "copy_count",
+	 copy_count,
+	 (ssize_t) 512 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	chunk_data->chunk_io_flags = LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET;
+	chunk_data->range_flags    = LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
+
+	copy_count = libewf_chunk_data_copy_to_buffer(
+	              chunk_data,
+	              buffer,
+	              516,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "copy_count",
+	 copy_count,
+	 (ssize_t) 516 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 512 ]",
+	 buffer[ 512 ],
+	 (uint8_t) 0x12 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 515 ]",
+	 buffer[ 515 ],
+	 (uint8_t) 0x78 );
+
+	/* Test error cases
+	 */
+	copy_count = libewf_chunk_data_copy_to_buffer(
+	              NULL,
+	              buffer,
+	              516,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "copy_count",
+	 copy_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	copy_count = libewf_chunk_data_copy_to_buffer(
+	              chunk_data,
+	              NULL,
+	              516,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "copy_count",
+	 copy_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	copy_count = libewf_chunk_data_copy_to_buffer(
+	              chunk_data,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "copy_count",
+	 copy_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	copy_count = libewf_chunk_data_copy_to_buffer(
+	              chunk_data,
+	              buffer,
+	              512,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "copy_count",
+	 copy_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_calculate_digest function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_calculate_digest(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_chunk_data_t *chunk_data = NULL;
+	size_t data_offset              = 0;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          512,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_offset = 0;
+	     data_offset < 512;
+	     data_offset++ )
+	{
+		chunk_data->data[ data_offset ] = (uint8_t) ( data_offset % 256 );
+	}
+	chunk_data->data_size = 512;
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_data_calculate_digest(
+	          chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "chunk_data->digest_is_set",
+	 chunk_data->digest_is_set,
+	 (uint8_t) 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "chunk_data->digest[ 0 ]",
+	 chunk_data->digest[ 0 ],
+	 (uint8_t) 0x11 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "chunk_data->digest[ 31 ]",
+	 chunk_data->digest[ 31 ],
+	 (uint8_t) 0x9b );
 
-	write_count = libewf_chunk_data_write(
-	               chunk_data,
-	               file_io_pool,
-	               -1,
-	               &error );
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_calculate_digest(
+	          NULL,
+	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_SSIZE(
-	 "write_count",
-	 write_count,
-	 (ssize_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -4236,21 +5521,26 @@ int ewf_test_chunk_data_write(
 	libcerror_error_free(
 	 &error );
 
-	/* Clean up file IO pool
-	 */
-	result = ewf_test_close_file_io_pool(
-	          &file_io_pool,
+	chunk_data->range_flags = LIBEWF_RANGE_FLAG_IS_PACKED;
+
+	result = libewf_chunk_data_calculate_digest(
+	          chunk_data,
 	          &error );
 
+	chunk_data->range_flags = 0;
+
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 0 );
+	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
+	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
+	libcerror_error_free(
+	 &error );
+
 	/* Clean up
 	 */
 	result = libewf_chunk_data_free(
@@ -4278,12 +5568,6 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( file_io_pool != NULL )
-	{
-		libbfio_pool_free(
-		 &file_io_pool,
-		 NULL );
-	}
 	if( chunk_data != NULL )
 	{
 		libewf_chunk_data_free(
@@ -4618,29 +5902,250 @@ int ewf_test_chunk_data_get_checksum(
 	          &checksum,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	chunk_data->range_flags = 0;
+
+	result = libewf_chunk_data_get_checksum(
+	          NULL,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          &checksum,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_get_checksum(
+	          chunk_data,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_read_from_file_io_pool function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_read_from_file_io_pool(
+     void )
+{
+	uint8_t file_data[ 512 ];
+
+	libbfio_pool_t *file_io_pool    = NULL;
+	libcerror_error_t *error        = NULL;
+	libewf_chunk_data_t *chunk_data = NULL;
+	ssize_t read_count              = 0;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          512,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	chunk_data->data_size = 512;
+
+	/* Initialize file IO pool
+	 */
+	result = ewf_test_open_file_io_pool(
+	          &file_io_pool,
+	          file_data,
+	          512,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_pool",
+	 file_io_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	read_count = libewf_chunk_data_read_from_file_io_pool(
+	              chunk_data,
+	              file_io_pool,
+	              0,
+	              0,
+	              512,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	read_count = libewf_chunk_data_read_from_file_io_pool(
+	              NULL,
+	              file_io_pool,
+	              0,
+	              0,
+	              512,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_chunk_data_read_from_file_io_pool(
+	              chunk_data,
+	              file_io_pool,
+	              0,
+	              0,
+	              (size64_t) SSIZE_MAX + 1,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_chunk_data_read_from_file_io_pool(
+	              chunk_data,
+	              file_io_pool,
+	              0,
+	              0,
+	              0,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
+	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	chunk_data->range_flags = 0;
+	libcerror_error_free(
+	 &error );
 
-	result = libewf_chunk_data_get_checksum(
-	          NULL,
-	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
-	          &checksum,
-	          &error );
+	/* Test libewf_chunk_data_read_from_file_io_pool with libbfio_pool_read_buffer_at_offset failing
+	 */
+	read_count = libewf_chunk_data_read_from_file_io_pool(
+	              chunk_data,
+	              file_io_pool,
+	              0,
+	              -1,
+	              512,
+	              0,
+	              &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -4649,24 +6154,21 @@ int ewf_test_chunk_data_get_checksum(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_chunk_data_get_checksum(
-	          chunk_data,
-	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
-	          NULL,
+	/* Clean up file IO pool
+	 */
+	result = ewf_test_close_file_io_pool(
+	          &file_io_pool,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 0 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
+	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
 	/* Clean up
 	 */
 	result = libewf_chunk_data_free(
@@ -4694,6 +6196,12 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
 	if( chunk_data != NULL )
 	{
 		libewf_chunk_data_free(
@@ -4703,22 +6211,39 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_chunk_data_read_from_file_io_pool function
+/* Tests the libewf_chunk_data_read_from_memory_map function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_chunk_data_read_from_file_io_pool(
+int ewf_test_chunk_data_read_from_memory_map(
      void )
 {
-	uint8_t file_data[ 512 ];
-
-	libbfio_pool_t *file_io_pool    = NULL;
 	libcerror_error_t *error        = NULL;
 	libewf_chunk_data_t *chunk_data = NULL;
+	libewf_io_handle_t *io_handle   = NULL;
 	ssize_t read_count              = 0;
 	int result                      = 0;
 
 	/* Initialize test
 	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->compression_method = LIBEWF_COMPRESSION_METHOD_DEFLATE;
+
 	result = libewf_chunk_data_initialize(
 	          &chunk_data,
 	          512,
@@ -4738,15 +6263,39 @@ int ewf_test_chunk_data_read_from_file_io_pool(
 	 "error",
 	 error );
 
-	chunk_data->data_size = 512;
+	/* Test regular cases
+	 */
+	read_count = libewf_chunk_data_read_from_memory_map(
+	              chunk_data,
+	              ewf_test_chunk_data_deflate_compressed_data1,
+	              52,
+	              LIBEWF_RANGE_FLAG_IS_COMPRESSED,
+	              &error );
 
-	/* Initialize file IO pool
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 52 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data->flags",
+	 (int) chunk_data->flags,
+	 (int) LIBEWF_CHUNK_DATA_ITEM_FLAG_NON_MANAGED_DATA );
+
+	EWF_TEST_ASSERT_EQUAL_INTPTR(
+	 "chunk_data->data",
+	 (intptr_t) chunk_data->data,
+	 (intptr_t) ewf_test_chunk_data_deflate_compressed_data1 );
+
+	/* Unpacking compressed data stores the uncompressed data in managed data
 	 */
-	result = ewf_test_open_file_io_pool(
-	          &file_io_pool,
-	          file_data,
-	          512,
-	          LIBBFIO_OPEN_READ,
+	result = libewf_chunk_data_unpack(
+	          chunk_data,
+	          io_handle,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -4754,43 +6303,103 @@ int ewf_test_chunk_data_read_from_file_io_pool(
 	 result,
 	 1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "file_io_pool",
-	 file_io_pool );
-
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test regular cases
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data->flags",
+	 (int) chunk_data->flags,
+	 (int) LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data->compressed_data",
+	 chunk_data->compressed_data );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "chunk_data->data_size",
+	 chunk_data->data_size,
+	 (size_t) 512 );
+
+	/* Unpacking uncompressed data with a valid checksum keeps referencing the mapped data
 	 */
-	read_count = libewf_chunk_data_read_from_file_io_pool(
+	read_count = libewf_chunk_data_read_from_memory_map(
 	              chunk_data,
-	              file_io_pool,
-	              0,
-	              0,
-	              512,
-	              0,
+	              ewf_test_chunk_data_deflate_uncompressed_data1,
+	              68,
+	              LIBEWF_RANGE_FLAG_HAS_CHECKSUM,
 	              &error );
 
 	EWF_TEST_ASSERT_EQUAL_SSIZE(
 	 "read_count",
 	 read_count,
-	 (ssize_t) 512 );
+	 (ssize_t) 68 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_unpack(
+	          chunk_data,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data->flags",
+	 (int) chunk_data->flags,
+	 (int) LIBEWF_CHUNK_DATA_ITEM_FLAG_NON_MANAGED_DATA );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "chunk_data->data_size",
+	 chunk_data->data_size,
+	 (size_t) 64 );
+
+	/* Test libewf_chunk_data_copy_to_managed_data
+	 */
+	result = libewf_chunk_data_copy_to_managed_data(
+	          chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data->flags",
+	 (int) chunk_data->flags,
+	 (int) LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA );
+
+	result = memory_compare(
+	          chunk_data->data,
+	          ewf_test_chunk_data_deflate_uncompressed_data1,
+	          64 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
 	/* Test error cases
 	 */
-	read_count = libewf_chunk_data_read_from_file_io_pool(
+	read_count = libewf_chunk_data_read_from_memory_map(
 	              NULL,
-	              file_io_pool,
-	              0,
-	              0,
-	              512,
-	              0,
+	              ewf_test_chunk_data_deflate_compressed_data1,
+	              52,
+	              LIBEWF_RANGE_FLAG_IS_COMPRESSED,
 	              &error );
 
 	EWF_TEST_ASSERT_EQUAL_SSIZE(
@@ -4805,13 +6414,11 @@ int ewf_test_chunk_data_read_from_file_io_pool(
 	libcerror_error_free(
 	 &error );
 
-	read_count = libewf_chunk_data_read_from_file_io_pool(
+	read_count = libewf_chunk_data_read_from_memory_map(
 	              chunk_data,
-	              file_io_pool,
-	              0,
-	              0,
-	              (size64_t) SSIZE_MAX + 1,
-	              0,
+	              NULL,
+	              52,
+	              LIBEWF_RANGE_FLAG_IS_COMPRESSED,
 	              &error );
 
 	EWF_TEST_ASSERT_EQUAL_SSIZE(
@@ -4826,13 +6433,11 @@ int ewf_test_chunk_data_read_from_file_io_pool(
 	libcerror_error_free(
 	 &error );
 
-	read_count = libewf_chunk_data_read_from_file_io_pool(
+	read_count = libewf_chunk_data_read_from_memory_map(
 	              chunk_data,
-	              file_io_pool,
-	              0,
-	              0,
-	              0,
+	              ewf_test_chunk_data_deflate_compressed_data1,
 	              0,
+	              LIBEWF_RANGE_FLAG_IS_COMPRESSED,
 	              &error );
 
 	EWF_TEST_ASSERT_EQUAL_SSIZE(
@@ -4847,15 +6452,11 @@ int ewf_test_chunk_data_read_from_file_io_pool(
 	libcerror_error_free(
 	 &error );
 
-	/* Test libewf_chunk_data_read_from_file_io_pool with libbfio_pool_read_buffer_at_offset failing
-	 */
-	read_count = libewf_chunk_data_read_from_file_io_pool(
+	read_count = libewf_chunk_data_read_from_memory_map(
 	              chunk_data,
-	              file_io_pool,
-	              0,
-	              -1,
-	              512,
-	              0,
+	              ewf_test_chunk_data_deflate_compressed_data1,
+	              chunk_data->allocated_data_size + 1,
+	              LIBEWF_RANGE_FLAG_IS_COMPRESSED,
 	              &error );
 
 	EWF_TEST_ASSERT_EQUAL_SSIZE(
@@ -4870,21 +6471,22 @@ int ewf_test_chunk_data_read_from_file_io_pool(
 	libcerror_error_free(
 	 &error );
 
-	/* Clean up file IO pool
-	 */
-	result = ewf_test_close_file_io_pool(
-	          &file_io_pool,
+	result = libewf_chunk_data_copy_to_managed_data(
+	          NULL,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 0 );
+	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
+	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
+	libcerror_error_free(
+	 &error );
+
 	/* Clean up
 	 */
 	result = libewf_chunk_data_free(
@@ -4904,6 +6506,23 @@ int ewf_test_chunk_data_read_from_file_io_pool(
 	 "error",
 	 error );
 
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	return( 1 );
 
 on_error:
@@ -4912,18 +6531,18 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( file_io_pool != NULL )
-	{
-		libbfio_pool_free(
-		 &file_io_pool,
-		 NULL );
-	}
 	if( chunk_data != NULL )
 	{
 		libewf_chunk_data_free(
 		 &chunk_data,
 		 NULL );
 	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
 	return( 0 );
 }
 
@@ -5260,12 +6879,20 @@ int main(
 	 "libewf_chunk_data_pack",
 	 ewf_test_chunk_data_pack );
 
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_pack_from_reference",
+	 ewf_test_chunk_data_pack_from_reference );
+
 #endif /* defined( HAVE_WRITE_SUPPORT ) */
 
 	EWF_TEST_RUN(
 	 "libewf_chunk_data_unpack",
 	 ewf_test_chunk_data_unpack );
 
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_unpack_to_buffer",
+	 ewf_test_chunk_data_unpack_to_buffer );
+
 	EWF_TEST_RUN(
 	 "libewf_chunk_data_check_for_empty_block",
 	 ewf_test_chunk_data_check_for_empty_block );
@@ -5274,10 +6901,22 @@ int main(
 	 "libewf_chunk_data_check_for_64_bit_pattern_fill",
 	 ewf_test_chunk_data_check_for_64_bit_pattern_fill );
 
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_check_for_incompressible_data",
+	 ewf_test_chunk_data_check_for_incompressible_data );
+
 	EWF_TEST_RUN(
 	 "libewf_chunk_data_write",
 	 ewf_test_chunk_data_write );
 
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_copy_to_buffer",
+	 ewf_test_chunk_data_copy_to_buffer );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_calculate_digest",
+	 ewf_test_chunk_data_calculate_digest );
+
 	EWF_TEST_RUN(
 	 "libewf_chunk_data_get_write_size",
 	 ewf_test_chunk_data_get_write_size );
@@ -5290,6 +6929,10 @@ int main(
 	 "libewf_chunk_data_read_from_file_io_pool",
 	 ewf_test_chunk_data_read_from_file_io_pool );
 
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_read_from_memory_map",
+	 ewf_test_chunk_data_read_from_memory_map );
+
 	EWF_TEST_RUN(
 	 "libewf_chunk_data_read_element_data",
 	 ewf_test_chunk_data_read_element_data );
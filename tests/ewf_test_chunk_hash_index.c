@@ -0,0 +1,737 @@
+/*
+ * Library chunk_hash_index type test program
+ *
+ * Copyright (C) 2006-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_chunk_data.h"
+#include "../libewf/libewf_chunk_hash_index.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_chunk_hash_index_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_hash_index_initialize(
+     void )
+{
+	libcerror_error_t *error                    = NULL;
+	libewf_chunk_hash_index_t *chunk_hash_index = NULL;
+	int result                                  = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests             = 3;
+	int number_of_memset_fail_tests             = 2;
+	int test_number                             = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_hash_index_initialize(
+	          &chunk_hash_index,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_hash_index",
+	 chunk_hash_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_hash_index_free(
+	          &chunk_hash_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_hash_index",
+	 chunk_hash_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_hash_index_initialize(
+	          NULL,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	chunk_hash_index = (libewf_chunk_hash_index_t *) 0x12345678UL;
+
+	result = libewf_chunk_hash_index_initialize(
+	          &chunk_hash_index,
+	          4,
+	          &error );
+
+	chunk_hash_index = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_hash_index_initialize(
+	          &chunk_hash_index,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_hash_index_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_chunk_hash_index_initialize(
+		          &chunk_hash_index,
+		          4,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( chunk_hash_index != NULL )
+			{
+				libewf_chunk_hash_index_free(
+				 &chunk_hash_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_hash_index",
+			 chunk_hash_index );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_hash_index_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_chunk_hash_index_initialize(
+		          &chunk_hash_index,
+		          4,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( chunk_hash_index != NULL )
+			{
+				libewf_chunk_hash_index_free(
+				 &chunk_hash_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_hash_index",
+			 chunk_hash_index );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_hash_index != NULL )
+	{
+		libewf_chunk_hash_index_free(
+		 &chunk_hash_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_hash_index_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_hash_index_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_hash_index_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_hash_index_get_entry_by_digest and libewf_chunk_hash_index_insert_entry functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_hash_index_get_insert_entry(
+     void )
+{
+	uint8_t first_digest[ LIBEWF_CHUNK_DATA_DIGEST_SIZE ];
+	uint8_t second_digest[ LIBEWF_CHUNK_DATA_DIGEST_SIZE ];
+	uint8_t third_digest[ LIBEWF_CHUNK_DATA_DIGEST_SIZE ];
+
+	libcerror_error_t *error                    = NULL;
+	libewf_chunk_hash_index_entry_t *entry      = NULL;
+	libewf_chunk_hash_index_t *chunk_hash_index = NULL;
+	int result                                  = 0;
+
+	/* Initialize test
+	 */
+	memory_set(
+	 first_digest,
+	 0,
+	 LIBEWF_CHUNK_DATA_DIGEST_SIZE );
+
+	/* The second digest maps onto the same hash table index as the first
+	 */
+	memory_set(
+	 second_digest,
+	 0,
+	 LIBEWF_CHUNK_DATA_DIGEST_SIZE );
+
+	second_digest[ 0 ] = 2;
+
+	memory_set(
+	 third_digest,
+	 0,
+	 LIBEWF_CHUNK_DATA_DIGEST_SIZE );
+
+	third_digest[ 0 ] = 1;
+
+	result = libewf_chunk_hash_index_initialize(
+	          &chunk_hash_index,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_hash_index",
+	 chunk_hash_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_hash_index_get_entry_by_digest(
+	          chunk_hash_index,
+	          first_digest,
+	          1,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_hash_index_insert_entry(
+	          chunk_hash_index,
+	          first_digest,
+	          1,
+	          100,
+	          50,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_hash_index_get_entry_by_digest(
+	          chunk_hash_index,
+	          first_digest,
+	          1,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "entry",
+	 entry );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "entry->data_offset",
+	 (int64_t) entry->data_offset,
+	 (int64_t) 100 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "entry->data_size",
+	 (uint64_t) entry->data_size,
+	 (uint64_t) 50 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that an entry is not returned for another segment file
+	 */
+	result = libewf_chunk_hash_index_get_entry_by_digest(
+	          chunk_hash_index,
+	          first_digest,
+	          2,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test an entry that shares the hash table index of another entry
+	 */
+	result = libewf_chunk_hash_index_insert_entry(
+	          chunk_hash_index,
+	          second_digest,
+	          1,
+	          200,
+	          60,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_hash_index_get_entry_by_digest(
+	          chunk_hash_index,
+	          second_digest,
+	          1,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "entry",
+	 entry );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "entry->data_offset",
+	 (int64_t) entry->data_offset,
+	 (int64_t) 200 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the oldest entry is replaced when the index is full
+	 */
+	result = libewf_chunk_hash_index_insert_entry(
+	          chunk_hash_index,
+	          third_digest,
+	          1,
+	          300,
+	          70,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_hash_index_get_entry_by_digest(
+	          chunk_hash_index,
+	          first_digest,
+	          1,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_hash_index_get_entry_by_digest(
+	          chunk_hash_index,
+	          second_digest,
+	          1,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_hash_index_get_entry_by_digest(
+	          chunk_hash_index,
+	          third_digest,
+	          1,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "entry",
+	 entry );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "entry->data_offset",
+	 (int64_t) entry->data_offset,
+	 (int64_t) 300 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_hash_index_get_entry_by_digest(
+	          NULL,
+	          first_digest,
+	          1,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_hash_index_get_entry_by_digest(
+	          chunk_hash_index,
+	          NULL,
+	          1,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_hash_index_get_entry_by_digest(
+	          chunk_hash_index,
+	          first_digest,
+	          1,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_hash_index_insert_entry(
+	          NULL,
+	          first_digest,
+	          1,
+	          100,
+	          50,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_hash_index_insert_entry(
+	          chunk_hash_index,
+	          NULL,
+	          1,
+	          100,
+	          50,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_hash_index_free(
+	          &chunk_hash_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_hash_index",
+	 chunk_hash_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_hash_index != NULL )
+	{
+		libewf_chunk_hash_index_free(
+		 &chunk_hash_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_hash_index_initialize",
+	 ewf_test_chunk_hash_index_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_hash_index_free",
+	 ewf_test_chunk_hash_index_free );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_hash_index_get_entry_by_digest",
+	 ewf_test_chunk_hash_index_get_insert_entry );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+}
+
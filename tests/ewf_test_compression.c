@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -33,6 +34,7 @@
 #include "ewf_test_unused.h"
 
 #include "../libewf/libewf_compression.h"
+#include "../libewf/libewf_compression_context.h"
 
 uint8_t ewf_test_compression_deflate_compressed_data1[ 2627 ] = {
 	0x78, 0xda, 0xbd, 0x59, 0x6d, 0x8f, 0xdb, 0xb8, 0x11, 0xfe, 0x7c, 0xfa, 0x15, 0xc4, 0x7e, 0xb9,
@@ -1253,6 +1255,655 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_compression_context_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_context_initialize(
+     void )
+{
+	libcerror_error_t *error                          = NULL;
+	libewf_compression_context_t *compression_context = NULL;
+	int result                                        = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_compression_context_initialize(
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_context",
+	 compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_context_free(
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "compression_context",
+	 compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_compression_context_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	compression_context = (libewf_compression_context_t *) 0x12345678UL;
+
+	result = libewf_compression_context_initialize(
+	          &compression_context,
+	          &error );
+
+	compression_context = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 &compression_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_WRITE_SUPPORT )
+
+/* Tests the libewf_compression_context_compress_data and libewf_compression_context_decompress_data functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_context_compress_data(
+     void )
+{
+	uint8_t compressed_data[ 8192 ];
+	uint8_t expected_compressed_data[ 8192 ];
+	uint8_t uncompressed_data[ 8192 ];
+
+	libcerror_error_t *error                          = NULL;
+	libewf_compression_context_t *compression_context = NULL;
+	size_t compressed_data_size                       = 0;
+	size_t expected_compressed_data_size              = 0;
+	size_t uncompressed_data_size                     = 0;
+	int iterator                                      = 0;
+	int result                                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_compression_context_initialize(
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_context",
+	 compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	expected_compressed_data_size = 8192;
+
+	result = libewf_compress_data(
+	          expected_compressed_data,
+	          &expected_compressed_data_size,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          LIBEWF_COMPRESSION_LEVEL_DEFAULT,
+	          ewf_test_compression_uncompressed_data1,
+	          7640,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * The streams of the compression context are reused on the second iteration
+	 */
+	for( iterator = 0;
+	     iterator < 2;
+	     iterator++ )
+	{
+		compressed_data_size = 8192;
+
+		result = libewf_compression_context_compress_data(
+		          compression_context,
+		          compressed_data,
+		          &compressed_data_size,
+		          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+		          LIBEWF_COMPRESSION_LEVEL_DEFAULT,
+		          ewf_test_compression_uncompressed_data1,
+		          7640,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_SIZE(
+		 "compressed_data_size",
+		 compressed_data_size,
+		 expected_compressed_data_size );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          compressed_data,
+		          expected_compressed_data,
+		          expected_compressed_data_size );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		uncompressed_data_size = 8192;
+
+		result = libewf_compression_context_decompress_data(
+		          compression_context,
+		          compressed_data,
+		          compressed_data_size,
+		          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+		          uncompressed_data,
+		          &uncompressed_data_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_SIZE(
+		 "uncompressed_data_size",
+		 uncompressed_data_size,
+		 (size_t) 7640 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          uncompressed_data,
+		          ewf_test_compression_uncompressed_data1,
+		          7640 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test with a compressed data buffer that is too small
+	 */
+	compressed_data_size = 16;
+
+	result = libewf_compression_context_compress_data(
+	          compression_context,
+	          compressed_data,
+	          &compressed_data_size,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          LIBEWF_COMPRESSION_LEVEL_DEFAULT,
+	          ewf_test_compression_uncompressed_data1,
+	          7640,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "compressed_data_size",
+	 (int) compressed_data_size,
+	 16 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with an uncompressed data buffer that is too small
+	 */
+	uncompressed_data_size = 16;
+
+	result = libewf_compression_context_decompress_data(
+	          compression_context,
+	          expected_compressed_data,
+	          expected_compressed_data_size,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "uncompressed_data_size",
+	 uncompressed_data_size,
+	 (size_t) 32 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	compressed_data_size = 8192;
+
+	result = libewf_compression_context_compress_data(
+	          NULL,
+	          compressed_data,
+	          &compressed_data_size,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          LIBEWF_COMPRESSION_LEVEL_DEFAULT,
+	          ewf_test_compression_uncompressed_data1,
+	          7640,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	uncompressed_data_size = 8192;
+
+	result = libewf_compression_context_decompress_data(
+	          NULL,
+	          expected_compressed_data,
+	          expected_compressed_data_size,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with truncated compressed data
+	 */
+	uncompressed_data_size = 8192;
+
+	result = libewf_compression_context_decompress_data(
+	          compression_context,
+	          expected_compressed_data,
+	          expected_compressed_data_size / 2,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	/* Clean up
+	 */
+	result = libewf_compression_context_free(
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "compression_context",
+	 compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 &compression_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_WRITE_SUPPORT ) */
+
+/* Tests the libewf_compression_context_pool_get_context and libewf_compression_context_pool_release_context functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_context_pool_get_context(
+     void )
+{
+	libcerror_error_t *error                                    = NULL;
+	libewf_compression_context_pool_t *compression_context_pool = NULL;
+	libewf_compression_context_t *compression_context1          = NULL;
+	libewf_compression_context_t *compression_context2          = NULL;
+	libewf_compression_context_t *released_compression_context  = NULL;
+	int result                                                  = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_compression_context_pool_initialize(
+	          &compression_context_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_context_pool",
+	 compression_context_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * Contexts retrieved at the same time are distinct
+	 */
+	result = libewf_compression_context_pool_get_context(
+	          compression_context_pool,
+	          &compression_context1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_context1",
+	 compression_context1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_context_pool_get_context(
+	          compression_context_pool,
+	          &compression_context2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_context2",
+	 compression_context2 );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INTPTR(
+	 "compression_context2",
+	 (intptr_t) compression_context2,
+	 (intptr_t) compression_context1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A released context is reused
+	 */
+	released_compression_context = compression_context2;
+
+	result = libewf_compression_context_pool_release_context(
+	          compression_context_pool,
+	          &compression_context2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "compression_context2",
+	 compression_context2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_context_pool_get_context(
+	          compression_context_pool,
+	          &compression_context2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INTPTR(
+	 "compression_context2",
+	 (intptr_t) compression_context2,
+	 (intptr_t) released_compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_context_pool_release_context(
+	          compression_context_pool,
+	          &compression_context2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_context_pool_release_context(
+	          compression_context_pool,
+	          &compression_context1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_compression_context_pool_get_context(
+	          NULL,
+	          &compression_context1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_context_pool_get_context(
+	          compression_context_pool,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_context_pool_release_context(
+	          NULL,
+	          &compression_context1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_compression_context_pool_free(
+	          &compression_context_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "compression_context_pool",
+	 compression_context_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compression_context2 != NULL )
+	{
+		libewf_compression_context_free(
+		 &compression_context2,
+		 NULL );
+	}
+	if( compression_context1 != NULL )
+	{
+		libewf_compression_context_free(
+		 &compression_context1,
+		 NULL );
+	}
+	if( compression_context_pool != NULL )
+	{
+		libewf_compression_context_pool_free(
+		 &compression_context_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 /* The main program
@@ -1284,6 +1935,22 @@ int main(
 	 "libewf_decompress_data",
 	 ewf_test_decompress_data );
 
+	EWF_TEST_RUN(
+	 "libewf_compression_context_initialize",
+	 ewf_test_compression_context_initialize );
+
+#if defined( HAVE_WRITE_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_compression_context_compress_data",
+	 ewf_test_compression_context_compress_data );
+
+#endif /* defined( HAVE_WRITE_SUPPORT ) */
+
+	EWF_TEST_RUN(
+	 "libewf_compression_context_pool_get_context",
+	 ewf_test_compression_context_pool_get_context );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
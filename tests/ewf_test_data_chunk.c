@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -36,6 +37,8 @@
 
 #include "../libewf/libewf_chunk_data.h"
 #include "../libewf/libewf_data_chunk.h"
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_io_handle.h"
 
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
 
@@ -544,6 +547,326 @@ on_error:
 	return( 0 );
 }
 
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_data_chunk_read_buffer function with packed chunk data
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_data_chunk_read_buffer_packed(
+     void )
+{
+	uint8_t buffer[ 512 ];
+	uint8_t compressed_zero_byte_empty_block[ 32 ];
+	uint8_t data[ 512 ];
+
+	libcerror_error_t *error        = NULL;
+	libewf_chunk_data_t *chunk_data = NULL;
+	libewf_data_chunk_t *data_chunk = NULL;
+	libewf_io_handle_t *io_handle   = NULL;
+	void *memcpy_result             = NULL;
+	void *memset_result             = NULL;
+	ssize_t read_count              = 0;
+	size_t data_offset              = 0;
+	size_t packed_data_size         = 0;
+	uint32_t packed_range_flags     = 0;
+	int read_iterator               = 0;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	for( data_offset = 0;
+	     data_offset < 512;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( data_offset % 7 );
+	}
+	memset_result = memory_set(
+	                 compressed_zero_byte_empty_block,
+	                 0,
+	                 32 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "memset_result",
+	 memset_result );
+
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->compression_level = LIBEWF_COMPRESSION_LEVEL_DEFAULT;
+	io_handle->compression_flags = 0;
+
+	result = libewf_data_chunk_initialize(
+	          &data_chunk,
+	          io_handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "data_chunk",
+	 data_chunk );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          512,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memcpy_result = memory_copy(
+	                 chunk_data->data,
+	                 data,
+	                 512 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "memcpy_result",
+	 memcpy_result );
+
+	chunk_data->data_size = 512;
+
+	result = libewf_chunk_data_pack(
+	          chunk_data,
+	          io_handle,
+	          compressed_zero_byte_empty_block,
+	          32,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED",
+	 (int) ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ),
+	 0 );
+
+	packed_data_size   = chunk_data->data_size;
+	packed_range_flags = chunk_data->range_flags;
+
+	result = libewf_internal_data_chunk_set_chunk_data(
+	          (libewf_internal_data_chunk_t *) data_chunk,
+	          chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The data chunk now manages the chunk data
+	 */
+	chunk_data = ( (libewf_internal_data_chunk_t *) data_chunk )->chunk_data;
+
+	/* Test regular cases
+	 * A buffer of the chunk size is decompressed into directly on every read
+	 * and the chunk data remains packed so that it can be written as-is
+	 */
+	for( read_iterator = 0;
+	     read_iterator < 2;
+	     read_iterator++ )
+	{
+		memset_result = memory_set(
+		                 buffer,
+		                 0xff,
+		                 512 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "memset_result",
+		 memset_result );
+
+		read_count = libewf_data_chunk_read_buffer(
+		              data_chunk,
+		              buffer,
+		              512,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 512 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          buffer,
+		          data,
+		          512 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		EWF_TEST_ASSERT_EQUAL_UINT32(
+		 "chunk_data->range_flags",
+		 chunk_data->range_flags,
+		 packed_range_flags );
+
+		EWF_TEST_ASSERT_EQUAL_SIZE(
+		 "chunk_data->data_size",
+		 chunk_data->data_size,
+		 packed_data_size );
+	}
+	/* A buffer smaller than the chunk size requires the chunk data to be unpacked
+	 */
+	memset_result = memory_set(
+	                 buffer,
+	                 0xff,
+	                 512 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "memset_result",
+	 memset_result );
+
+	read_count = libewf_data_chunk_read_buffer(
+	              data_chunk,
+	              buffer,
+	              256,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 256 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          data,
+	          256 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED",
+	 (int) ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ),
+	 0 );
+
+	/* Clean up
+	 */
+	chunk_data = NULL;
+
+	result = libewf_data_chunk_free(
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "data_chunk",
+	 data_chunk );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_chunk != NULL )
+	{
+		if( ( (libewf_internal_data_chunk_t *) data_chunk )->chunk_data == chunk_data )
+		{
+			chunk_data = NULL;
+		}
+		libewf_data_chunk_free(
+		 &data_chunk,
+		 NULL );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
 /* Tests the libewf_data_chunk_write_buffer function
  * Returns 1 if successful or 0 if not
  */
@@ -623,6 +946,14 @@ int main(
 	 "libewf_data_chunk_read_buffer",
 	 ewf_test_data_chunk_read_buffer );
 
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_data_chunk_read_buffer_packed",
+	 ewf_test_data_chunk_read_buffer_packed );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
 	EWF_TEST_RUN(
 	 "libewf_data_chunk_write_buffer",
 	 ewf_test_data_chunk_write_buffer );
@@ -43,6 +43,7 @@
 #include "ewf_test_libewf.h"
 #include "ewf_test_macros.h"
 #include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
 
 #include "../libewf/libewf_handle.h"
 
@@ -2399,21 +2400,2273 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_handle_read_buffer_at_offset_concurrent function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_read_buffer_at_offset_concurrent(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+	uint8_t reference_buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+
+	libcerror_error_t *error      = NULL;
+	size64_t media_size           = 0;
+	size64_t remaining_media_size = 0;
+	size_t read_size              = 0;
+	ssize_t read_count            = 0;
+	off64_t current_offset        = 0;
+	off64_t offset                = 0;
+	off64_t read_offset           = 0;
+	int number_of_tests           = 256;
+	int random_number             = 0;
+	int result                    = 0;
+	int test_number               = 0;
+
+	/* Determine size
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_offset(
+	          handle,
+	          &current_offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( test_number = 0;
+	     test_number < number_of_tests;
+	     test_number++ )
+	{
+		random_number = rand();
+
+		EWF_TEST_ASSERT_GREATER_THAN_INT(
+		 "random_number",
+		 random_number,
+		 -1 );
+
+		if( media_size > 0 )
+		{
+			read_offset = (off64_t) random_number % media_size;
+		}
+		read_size = (size_t) random_number % EWF_TEST_HANDLE_READ_BUFFER_SIZE;
+
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              reference_buffer,
+		              read_size,
+		              read_offset,
+		              &error );
+
+		EWF_TEST_ASSERT_NOT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_handle_get_offset(
+		          handle,
+		          &current_offset,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_count = libewf_handle_read_buffer_at_offset_concurrent(
+		              handle,
+		              buffer,
+		              read_size,
+		              read_offset,
+		              &error );
+
+		remaining_media_size = media_size - read_offset;
+
+		if( read_size > remaining_media_size )
+		{
+			read_size = (size_t) remaining_media_size;
+		}
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) read_size );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          buffer,
+		          reference_buffer,
+		          read_size );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		/* The current offset should not be changed
+		 */
+		result = libewf_handle_get_offset(
+		          handle,
+		          &offset,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 offset,
+		 current_offset );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Read buffer beyond media_size boundary
+	 */
+	read_count = libewf_handle_read_buffer_at_offset_concurrent(
+	              handle,
+	              buffer,
+	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	              media_size + 8,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	read_count = libewf_handle_read_buffer_at_offset_concurrent(
+	              NULL,
+	              buffer,
+	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffer_at_offset_concurrent(
+	              handle,
+	              NULL,
+	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffer_at_offset_concurrent(
+	              handle,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffer_at_offset_concurrent(
+	              handle,
+	              buffer,
+	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	              -1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_RWLOCK )
+
+	/* Test libewf_handle_read_buffer_at_offset_concurrent with pthread_rwlock_rdlock failing in libcthreads_read_write_lock_grab_for_read
+	 */
+	ewf_test_pthread_rwlock_rdlock_attempts_before_fail = 0;
+
+	read_count = libewf_handle_read_buffer_at_offset_concurrent(
+	              handle,
+	              buffer,
+	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	              0,
+	              &error );
+
+	if( ewf_test_pthread_rwlock_rdlock_attempts_before_fail != -1 )
+	{
+		ewf_test_pthread_rwlock_rdlock_attempts_before_fail = -1;
+	}
+	else
+	{
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+#endif /* defined( HAVE_EWF_TEST_RWLOCK ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_read_buffers_at_offsets function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_read_buffers_at_offsets(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer_data[ 4 ][ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+	uint8_t reference_buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+	uint8_t *buffers[ 4 ];
+	size_t buffer_sizes[ 4 ];
+	off64_t offsets[ 4 ];
+	ssize_t read_counts[ 4 ];
+
+	libcerror_error_t *error      = NULL;
+	size64_t media_size           = 0;
+	size64_t remaining_media_size = 0;
+	size_t read_size              = 0;
+	ssize_t read_count            = 0;
+	ssize_t total_read_count      = 0;
+	int buffer_index              = 0;
+	int number_of_tests           = 64;
+	int random_number             = 0;
+	int result                    = 0;
+	int test_number               = 0;
+
+	/* Determine size
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( buffer_index = 0;
+	     buffer_index < 4;
+	     buffer_index++ )
+	{
+		buffers[ buffer_index ] = buffer_data[ buffer_index ];
+	}
+	/* Test regular cases
+	 */
+	for( test_number = 0;
+	     test_number < number_of_tests;
+	     test_number++ )
+	{
+		for( buffer_index = 0;
+		     buffer_index < 3;
+		     buffer_index++ )
+		{
+			random_number = rand();
+
+			EWF_TEST_ASSERT_GREATER_THAN_INT(
+			 "random_number",
+			 random_number,
+			 -1 );
+
+			offsets[ buffer_index ] = 0;
+
+			if( media_size > 0 )
+			{
+				offsets[ buffer_index ] = (off64_t) random_number % media_size;
+			}
+			buffer_sizes[ buffer_index ] = (size_t) random_number % EWF_TEST_HANDLE_READ_BUFFER_SIZE;
+		}
+		/* Read the same data as the first buffer into the last buffer
+		 */
+		offsets[ 3 ]      = offsets[ 0 ];
+		buffer_sizes[ 3 ] = buffer_sizes[ 0 ];
+
+		read_count = libewf_handle_read_buffers_at_offsets(
+		              handle,
+		              buffers,
+		              buffer_sizes,
+		              offsets,
+		              read_counts,
+		              4,
+		              &error );
+
+		EWF_TEST_ASSERT_NOT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		total_read_count = read_count;
+
+		for( buffer_index = 0;
+		     buffer_index < 4;
+		     buffer_index++ )
+		{
+			read_size            = buffer_sizes[ buffer_index ];
+			remaining_media_size = media_size - offsets[ buffer_index ];
+
+			if( read_size > remaining_media_size )
+			{
+				read_size = (size_t) remaining_media_size;
+			}
+			EWF_TEST_ASSERT_EQUAL_SSIZE(
+			 "read_counts[ buffer_index ]",
+			 read_counts[ buffer_index ],
+			 (ssize_t) read_size );
+
+			total_read_count -= read_counts[ buffer_index ];
+
+			read_count = libewf_handle_read_buffer_at_offset(
+			              handle,
+			              reference_buffer,
+			              read_size,
+			              offsets[ buffer_index ],
+			              &error );
+
+			EWF_TEST_ASSERT_EQUAL_SSIZE(
+			 "read_count",
+			 read_count,
+			 (ssize_t) read_size );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = memory_compare(
+			          buffers[ buffer_index ],
+			          reference_buffer,
+			          read_size );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+		/* The total number of bytes read should match the sum of the read counts
+		 */
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "total_read_count",
+		 total_read_count,
+		 (ssize_t) 0 );
+	}
+	/* Read buffers beyond media_size boundary
+	 */
+	buffer_sizes[ 0 ] = EWF_TEST_HANDLE_READ_BUFFER_SIZE;
+	offsets[ 0 ]      = media_size + 8;
+
+	read_count = libewf_handle_read_buffers_at_offsets(
+	              handle,
+	              buffers,
+	              buffer_sizes,
+	              offsets,
+	              read_counts,
+	              1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_counts[ 0 ]",
+	 read_counts[ 0 ],
+	 (ssize_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	offsets[ 0 ] = 0;
+
+	read_count = libewf_handle_read_buffers_at_offsets(
+	              NULL,
+	              buffers,
+	              buffer_sizes,
+	              offsets,
+	              read_counts,
+	              1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffers_at_offsets(
+	              handle,
+	              NULL,
+	              buffer_sizes,
+	              offsets,
+	              read_counts,
+	              1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffers_at_offsets(
+	              handle,
+	              buffers,
+	              NULL,
+	              offsets,
+	              read_counts,
+	              1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffers_at_offsets(
+	              handle,
+	              buffers,
+	              buffer_sizes,
+	              NULL,
+	              read_counts,
+	              1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffers_at_offsets(
+	              handle,
+	              buffers,
+	              buffer_sizes,
+	              offsets,
+	              NULL,
+	              1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffers_at_offsets(
+	              handle,
+	              buffers,
+	              buffer_sizes,
+	              offsets,
+	              read_counts,
+	              -1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	buffers[ 0 ] = NULL;
+
+	read_count = libewf_handle_read_buffers_at_offsets(
+	              handle,
+	              buffers,
+	              buffer_sizes,
+	              offsets,
+	              read_counts,
+	              1,
+	              &error );
+
+	buffers[ 0 ] = buffer_data[ 0 ];
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offsets[ 0 ] = -1;
+
+	read_count = libewf_handle_read_buffers_at_offsets(
+	              handle,
+	              buffers,
+	              buffer_sizes,
+	              offsets,
+	              read_counts,
+	              1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+typedef struct ewf_test_handle_submitted_read ewf_test_handle_submitted_read_t;
+
+struct ewf_test_handle_submitted_read
+{
+	/* The offset reported by the callback
+	 */
+	off64_t offset;
+
+	/* The read count reported by the callback
+	 */
+	ssize_t read_count;
+
+	/* The number of times the callback was called
+	 */
+	int number_of_callbacks;
+};
+
+/* Completion callback for the libewf_handle_submit_read_buffer_at_offset tests
+ */
+void ewf_test_handle_submitted_read_callback(
+      libewf_handle_t *handle EWF_TEST_ATTRIBUTE_UNUSED,
+      void *buffer EWF_TEST_ATTRIBUTE_UNUSED,
+      off64_t offset,
+      ssize_t read_count,
+      void *callback_data )
+{
+	ewf_test_handle_submitted_read_t *submitted_read = (ewf_test_handle_submitted_read_t *) callback_data;
+
+	EWF_TEST_UNREFERENCED_PARAMETER( handle )
+	EWF_TEST_UNREFERENCED_PARAMETER( buffer )
+
+	submitted_read->offset               = offset;
+	submitted_read->read_count           = read_count;
+	submitted_read->number_of_callbacks += 1;
+}
+
+/* Tests the libewf_handle_submit_read_buffer_at_offset and libewf_handle_wait_for_submitted_reads functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_submit_read_buffer_at_offset(
+     libewf_handle_t *handle )
+{
+	ewf_test_handle_submitted_read_t submitted_reads[ 4 ];
+	uint8_t buffers[ 4 ][ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+	uint8_t reference_buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+	off64_t offsets[ 4 ];
+	size_t read_sizes[ 4 ];
+
+	libcerror_error_t *error      = NULL;
+	size64_t media_size           = 0;
+	size64_t remaining_media_size = 0;
+	ssize_t read_count            = 0;
+	int random_number             = 0;
+	int read_index                = 0;
+	int result                    = 0;
+
+	/* Determine size
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( read_index = 0;
+	     read_index < 4;
+	     read_index++ )
+	{
+		random_number = rand();
+
+		EWF_TEST_ASSERT_GREATER_THAN_INT(
+		 "random_number",
+		 random_number,
+		 -1 );
+
+		offsets[ read_index ] = 0;
+
+		if( media_size > 0 )
+		{
+			offsets[ read_index ] = (off64_t) random_number % media_size;
+		}
+		read_sizes[ read_index ] = (size_t) random_number % EWF_TEST_HANDLE_READ_BUFFER_SIZE;
+
+		submitted_reads[ read_index ].offset              = -1;
+		submitted_reads[ read_index ].read_count          = -1;
+		submitted_reads[ read_index ].number_of_callbacks = 0;
+	}
+	/* The last read is beyond the media size boundary
+	 */
+	offsets[ 3 ]    = media_size + 8;
+	read_sizes[ 3 ] = EWF_TEST_HANDLE_READ_BUFFER_SIZE;
+
+	for( read_index = 0;
+	     read_index < 4;
+	     read_index++ )
+	{
+		result = libewf_handle_submit_read_buffer_at_offset(
+		          handle,
+		          buffers[ read_index ],
+		          read_sizes[ read_index ],
+		          offsets[ read_index ],
+		          &ewf_test_handle_submitted_read_callback,
+		          &( submitted_reads[ read_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libewf_handle_wait_for_submitted_reads(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( read_index = 0;
+	     read_index < 4;
+	     read_index++ )
+	{
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "submitted_reads[ read_index ].number_of_callbacks",
+		 submitted_reads[ read_index ].number_of_callbacks,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "submitted_reads[ read_index ].offset",
+		 submitted_reads[ read_index ].offset,
+		 offsets[ read_index ] );
+
+		if( (size64_t) offsets[ read_index ] >= media_size )
+		{
+			EWF_TEST_ASSERT_EQUAL_SSIZE(
+			 "submitted_reads[ read_index ].read_count",
+			 submitted_reads[ read_index ].read_count,
+			 (ssize_t) 0 );
+
+			continue;
+		}
+		remaining_media_size = media_size - offsets[ read_index ];
+
+		if( read_sizes[ read_index ] > remaining_media_size )
+		{
+			read_sizes[ read_index ] = (size_t) remaining_media_size;
+		}
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "submitted_reads[ read_index ].read_count",
+		 submitted_reads[ read_index ].read_count,
+		 (ssize_t) read_sizes[ read_index ] );
+
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              reference_buffer,
+		              read_sizes[ read_index ],
+		              offsets[ read_index ],
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) read_sizes[ read_index ] );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          buffers[ read_index ],
+		          reference_buffer,
+		          read_sizes[ read_index ] );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = libewf_handle_submit_read_buffer_at_offset(
+	          NULL,
+	          buffers[ 0 ],
+	          EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	          0,
+	          &ewf_test_handle_submitted_read_callback,
+	          &( submitted_reads[ 0 ] ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_submit_read_buffer_at_offset(
+	          handle,
+	          NULL,
+	          EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	          0,
+	          &ewf_test_handle_submitted_read_callback,
+	          &( submitted_reads[ 0 ] ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_submit_read_buffer_at_offset(
+	          handle,
+	          buffers[ 0 ],
+	          EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	          -1,
+	          &ewf_test_handle_submitted_read_callback,
+	          &( submitted_reads[ 0 ] ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_submit_read_buffer_at_offset(
+	          handle,
+	          buffers[ 0 ],
+	          EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	          0,
+	          NULL,
+	          &( submitted_reads[ 0 ] ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_wait_for_submitted_reads(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	libewf_handle_wait_for_submitted_reads(
+	 handle,
+	 NULL );
+
+	return( 0 );
+}
+
+typedef struct ewf_test_handle_resubmitted_read ewf_test_handle_resubmitted_read_t;
+
+struct ewf_test_handle_resubmitted_read
+{
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The number of times the read is still to be resubmitted
+	 */
+	int number_of_resubmits;
+
+	/* The result of the last resubmit
+	 */
+	int resubmit_result;
+
+	/* The number of times the callback was called
+	 */
+	int number_of_callbacks;
+};
+
+/* Completion callback that resubmits the read for the libewf_handle_submit_read_buffer_at_offset tests
+ */
+void ewf_test_handle_resubmitted_read_callback(
+      libewf_handle_t *handle,
+      void *buffer,
+      off64_t offset,
+      ssize_t read_count EWF_TEST_ATTRIBUTE_UNUSED,
+      void *callback_data )
+{
+	ewf_test_handle_resubmitted_read_t *resubmitted_read = (ewf_test_handle_resubmitted_read_t *) callback_data;
+
+	EWF_TEST_UNREFERENCED_PARAMETER( read_count )
+
+	resubmitted_read->number_of_callbacks += 1;
+
+	if( resubmitted_read->number_of_resubmits > 0 )
+	{
+		resubmitted_read->number_of_resubmits -= 1;
+
+		resubmitted_read->resubmit_result = libewf_handle_submit_read_buffer_at_offset(
+		                                     handle,
+		                                     buffer,
+		                                     resubmitted_read->buffer_size,
+		                                     offset,
+		                                     &ewf_test_handle_resubmitted_read_callback,
+		                                     callback_data,
+		                                     NULL );
+	}
+}
+
+/* Tests the libewf_handle_submit_read_buffer_at_offset function with a callback that resubmits
+ * More reads are submitted than fit in the queue so that resubmits happen while the queue is full
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_submit_read_buffer_at_offset_from_callback(
+     libewf_handle_t *handle )
+{
+	ewf_test_handle_resubmitted_read_t resubmitted_reads[ 320 ];
+	uint8_t buffers[ 320 ][ 64 ];
+
+	libcerror_error_t *error = NULL;
+	int read_index           = 0;
+	int result               = 0;
+
+	for( read_index = 0;
+	     read_index < 320;
+	     read_index++ )
+	{
+		resubmitted_reads[ read_index ].buffer_size         = 64;
+		resubmitted_reads[ read_index ].number_of_resubmits = 1;
+		resubmitted_reads[ read_index ].resubmit_result     = 0;
+		resubmitted_reads[ read_index ].number_of_callbacks = 0;
+	}
+	for( read_index = 0;
+	     read_index < 320;
+	     read_index++ )
+	{
+		result = libewf_handle_submit_read_buffer_at_offset(
+		          handle,
+		          buffers[ read_index ],
+		          64,
+		          (off64_t) read_index * 64,
+		          &ewf_test_handle_resubmitted_read_callback,
+		          &( resubmitted_reads[ read_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* The reads resubmitted while waiting are not waited for by the first wait
+	 */
+	result = libewf_handle_wait_for_submitted_reads(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_wait_for_submitted_reads(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( read_index = 0;
+	     read_index < 320;
+	     read_index++ )
+	{
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "resubmitted_reads[ read_index ].resubmit_result",
+		 resubmitted_reads[ read_index ].resubmit_result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "resubmitted_reads[ read_index ].number_of_callbacks",
+		 resubmitted_reads[ read_index ].number_of_callbacks,
+		 2 );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	libewf_handle_wait_for_submitted_reads(
+	 handle,
+	 NULL );
+	libewf_handle_wait_for_submitted_reads(
+	 handle,
+	 NULL );
+
+	return( 0 );
+}
+
+/* Tests the libewf_handle_pin_data_at_offset and libewf_handle_unpin_data functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_pin_data_at_offset(
+     libewf_handle_t *handle )
+{
+	uint8_t reference_buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+
+	libcerror_error_t *error  = NULL;
+	const uint8_t *data       = NULL;
+	const uint8_t *other_data = NULL;
+	size64_t media_size       = 0;
+	size_t data_size          = 0;
+	size_t other_data_size    = 0;
+	size_t read_size          = 0;
+	ssize_t read_count        = 0;
+	int result                = 0;
+
+	/* Determine size
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( media_size < 2 )
+	{
+		return( 1 );
+	}
+	/* Test regular cases
+	 */
+	result = libewf_handle_pin_data_at_offset(
+	          handle,
+	          0,
+	          &data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "data_size",
+	 (int) data_size,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_size = data_size;
+
+	if( read_size > EWF_TEST_HANDLE_READ_BUFFER_SIZE )
+	{
+		read_size = EWF_TEST_HANDLE_READ_BUFFER_SIZE;
+	}
+	read_count = libewf_handle_read_buffer_at_offset_concurrent(
+	              handle,
+	              reference_buffer,
+	              read_size,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          reference_buffer,
+	          read_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Pin the same chunk a second time at a different offset
+	 */
+	result = libewf_handle_pin_data_at_offset(
+	          handle,
+	          1,
+	          &other_data,
+	          &other_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "other_data_size",
+	 other_data_size,
+	 data_size - 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          other_data,
+	          &( reference_buffer[ 1 ] ),
+	          read_size - 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libewf_handle_unpin_data(
+	          handle,
+	          other_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_unpin_data(
+	          handle,
+	          data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Pin data beyond media_size boundary
+	 */
+	result = libewf_handle_pin_data_at_offset(
+	          handle,
+	          (off64_t) media_size,
+	          &data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_pin_data_at_offset(
+	          NULL,
+	          0,
+	          &data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_pin_data_at_offset(
+	          handle,
+	          -1,
+	          &data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_pin_data_at_offset(
+	          handle,
+	          0,
+	          NULL,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_pin_data_at_offset(
+	          handle,
+	          0,
+	          &data,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_unpin_data(
+	          NULL,
+	          reference_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_unpin_data(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test unpinning data that is not pinned
+	 */
+	result = libewf_handle_unpin_data(
+	          handle,
+	          reference_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the libewf_handle_get_data_chunk function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_data_chunk(
+int ewf_test_handle_get_data_chunk(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_data_chunk_t *data_chunk = NULL;
+	int result                      = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_data_chunk(
+	          handle,
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "data_chunk",
+	 data_chunk );
+
+	result = libewf_data_chunk_free(
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_data_chunk(
+	          NULL,
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "data_chunk",
+	 data_chunk );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_data_chunk(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "data_chunk",
+	 data_chunk );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_chunk != NULL )
+	{
+		libewf_data_chunk_free(
+		 &data_chunk,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_seek_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_seek_offset(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	off64_t offset           = 0;
+
+	/* Test regular cases
+	 */
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_END,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	size = (size64_t) offset;
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          1024,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 1024 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          -512,
+	          SEEK_CUR,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 512 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          (off64_t) ( size + 512 ),
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) ( size + 512 ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reset offset to 0
+	 */
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	offset = libewf_handle_seek_offset(
+	          NULL,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          -1,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          -1,
+	          SEEK_CUR,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          (off64_t) ( -1 * ( size + 1 ) ),
+	          SEEK_END,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_RWLOCK )
+
+	/* Test libewf_handle_seek_offset with pthread_rwlock_wrlock failing in libcthreads_read_write_lock_grab_for_write
+	 */
+	ewf_test_pthread_rwlock_wrlock_attempts_before_fail = 0;
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	if( ewf_test_pthread_rwlock_wrlock_attempts_before_fail != -1 )
+	{
+		ewf_test_pthread_rwlock_wrlock_attempts_before_fail = -1;
+	}
+	else
+	{
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 (int64_t) offset,
+		 (int64_t) -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	/* Test libewf_handle_seek_offset with pthread_rwlock_unlock failing in libcthreads_read_write_lock_release_for_write
+	 */
+	ewf_test_pthread_rwlock_unlock_attempts_before_fail = 0;
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	if( ewf_test_pthread_rwlock_unlock_attempts_before_fail != -1 )
+	{
+		ewf_test_pthread_rwlock_unlock_attempts_before_fail = -1;
+	}
+	else
+	{
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 (int64_t) offset,
+		 (int64_t) -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+#endif /* defined( HAVE_EWF_TEST_RWLOCK ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_offset(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	off64_t offset           = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_offset(
+	          handle,
+	          &offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_offset(
+	          NULL,
+	          &offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_offset(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_cache_memory_budget and libewf_handle_set_cache_memory_budget functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_set_cache_memory_budget(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error     = NULL;
+	size64_t cache_memory_budget = 0;
+	ssize_t read_count           = 0;
+	int result                   = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_set_cache_memory_budget(
+	          handle,
+	          4 * 1024 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_cache_memory_budget(
+	          handle,
+	          &cache_memory_budget,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "cache_memory_budget",
+	 (uint64_t) cache_memory_budget,
+	 (uint64_t) 4 * 1024 * 1024 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              16,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 16 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Restore the default cache sizes
+	 */
+	result = libewf_handle_set_cache_memory_budget(
+	          handle,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_cache_memory_budget(
+	          NULL,
+	          &cache_memory_budget,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_cache_memory_budget(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_cache_memory_budget(
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_read_ahead_values and libewf_handle_set_read_ahead_values functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_set_read_ahead_values(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ 4096 ];
+
+	libcerror_error_t *error     = NULL;
+	off64_t offset               = 0;
+	ssize_t read_count           = 0;
+	int maximum_number_of_chunks = 0;
+	int number_of_threads        = 0;
+	int read_iterator            = 0;
+	int result                   = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_set_read_ahead_values(
+	          handle,
+	          8,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_read_ahead_values(
+	          handle,
+	          &maximum_number_of_chunks,
+	          &number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "maximum_number_of_chunks",
+	 maximum_number_of_chunks,
+	 8 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_threads",
+	 number_of_threads,
+	 2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Read sequentially to trigger the read-ahead
+	 */
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( read_iterator = 0;
+	     read_iterator < 16;
+	     read_iterator++ )
+	{
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              buffer,
+		              4096,
+		              &error );
+
+		EWF_TEST_ASSERT_NOT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Disable the read-ahead
+	 */
+	result = libewf_handle_set_read_ahead_values(
+	          handle,
+	          0,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_read_ahead_values(
+	          NULL,
+	          &maximum_number_of_chunks,
+	          &number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_read_ahead_values(
+	          handle,
+	          NULL,
+	          &number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_read_ahead_values(
+	          handle,
+	          &maximum_number_of_chunks,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_read_ahead_values(
+	          NULL,
+	          0,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_read_ahead_values(
+	          handle,
+	          -1,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_read_ahead_values(
+	          handle,
+	          0,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_number_of_read_threads and libewf_handle_set_number_of_read_threads functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_set_number_of_read_threads(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error        = NULL;
-	libewf_data_chunk_t *data_chunk = NULL;
-	int result                      = 0;
+	libcerror_error_t *error   = NULL;
+	uint8_t *buffer            = NULL;
+	uint8_t *reference_buffer  = NULL;
+	size_t buffer_size         = 256 * 1024;
+	ssize_t read_count         = 0;
+	ssize_t reference_count    = 0;
+	int number_of_read_threads = 0;
+	int result                 = 0;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * buffer_size );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer",
+	 buffer );
+
+	reference_buffer = (uint8_t *) memory_allocate(
+	                                sizeof( uint8_t ) * buffer_size );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "reference_buffer",
+	 reference_buffer );
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_data_chunk(
+	result = libewf_handle_get_number_of_read_threads(
 	          handle,
-	          &data_chunk,
+	          &number_of_read_threads,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2421,16 +4674,142 @@ int ewf_test_handle_get_data_chunk(
 	 result,
 	 1 );
 
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_read_threads",
+	 number_of_read_threads,
+	 1 );
+
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "data_chunk",
-	 data_chunk );
+	reference_count = libewf_handle_read_buffer_at_offset(
+	                   handle,
+	                   reference_buffer,
+	                   buffer_size,
+	                   0,
+	                   &error );
 
-	result = libewf_data_chunk_free(
-	          &data_chunk,
+	EWF_TEST_ASSERT_NOT_EQUAL_SSIZE(
+	 "reference_count",
+	 reference_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_number_of_read_threads(
+	          handle,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_number_of_read_threads(
+	          handle,
+	          &number_of_read_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_read_threads",
+	 number_of_read_threads,
+	 4 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The chunks read in parallel should match the chunks read sequentially
+	 */
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              buffer_size,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 reference_count );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          reference_buffer,
+	          (size_t) read_count );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* The worker threads are retained between reads and restarted
+	 * when the number of threads changes
+	 */
+	for( number_of_read_threads = 4;
+	     number_of_read_threads >= 2;
+	     number_of_read_threads -= 2 )
+	{
+		result = libewf_handle_set_number_of_read_threads(
+		          handle,
+		          number_of_read_threads,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              buffer_size,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 reference_count );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          buffer,
+		          reference_buffer,
+		          (size_t) read_count );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	result = libewf_handle_set_number_of_read_threads(
+	          handle,
+	          1,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2444,9 +4823,9 @@ int ewf_test_handle_get_data_chunk(
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_data_chunk(
+	result = libewf_handle_get_number_of_read_threads(
 	          NULL,
-	          &data_chunk,
+	          &number_of_read_threads,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2454,10 +4833,6 @@ int ewf_test_handle_get_data_chunk(
 	 result,
 	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "data_chunk",
-	 data_chunk );
-
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -2465,7 +4840,7 @@ int ewf_test_handle_get_data_chunk(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_data_chunk(
+	result = libewf_handle_get_number_of_read_threads(
 	          handle,
 	          NULL,
 	          &error );
@@ -2475,9 +4850,39 @@ int ewf_test_handle_get_data_chunk(
 	 result,
 	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "data_chunk",
-	 data_chunk );
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_number_of_read_threads(
+	          NULL,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_number_of_read_threads(
+	          handle,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2486,6 +4891,12 @@ int ewf_test_handle_get_data_chunk(
 	libcerror_error_free(
 	 &error );
 
+	memory_free(
+	 reference_buffer );
+
+	memory_free(
+	 buffer );
+
 	return( 1 );
 
 on_error:
@@ -2494,101 +4905,97 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( data_chunk != NULL )
+	if( reference_buffer != NULL )
 	{
-		libewf_data_chunk_free(
-		 &data_chunk,
-		 NULL );
+		memory_free(
+		 reference_buffer );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
 	}
+	libewf_handle_set_number_of_read_threads(
+	 handle,
+	 1,
+	 NULL );
+
 	return( 0 );
 }
 
-/* Tests the libewf_handle_seek_offset function
+/* Tests the libewf_handle_get_number_of_write_threads and libewf_handle_set_number_of_write_threads functions
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_seek_offset(
+int ewf_test_handle_get_set_number_of_write_threads(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error = NULL;
-	size64_t size            = 0;
-	off64_t offset           = 0;
+	libcerror_error_t *error    = NULL;
+	int number_of_write_threads = 0;
+	int result                  = 0;
 
 	/* Test regular cases
 	 */
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_get_number_of_write_threads(
 	          handle,
-	          0,
-	          SEEK_END,
+	          &number_of_write_threads,
 	          &error );
 
-	EWF_TEST_ASSERT_NOT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
-
-	EWF_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
-
-	size = (size64_t) offset;
-
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          1024,
-	          SEEK_SET,
-	          &error );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 1024 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_write_threads",
+	 number_of_write_threads,
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_set_number_of_write_threads(
 	          handle,
-	          -512,
-	          SEEK_CUR,
+	          4,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 512 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_get_number_of_write_threads(
 	          handle,
-	          (off64_t) ( size + 512 ),
-	          SEEK_SET,
+	          &number_of_write_threads,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) ( size + 512 ) );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_write_threads",
+	 number_of_write_threads,
+	 4 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Reset offset to 0
-	 */
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_set_number_of_write_threads(
 	          handle,
-	          0,
-	          SEEK_SET,
+	          1,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 0 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
@@ -2596,16 +5003,15 @@ int ewf_test_handle_seek_offset(
 
 	/* Test error cases
 	 */
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_get_number_of_write_threads(
 	          NULL,
-	          0,
-	          SEEK_SET,
+	          &number_of_write_threads,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2614,16 +5020,15 @@ int ewf_test_handle_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_get_number_of_write_threads(
 	          handle,
-	          -1,
-	          SEEK_SET,
+	          NULL,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2632,31 +5037,32 @@ int ewf_test_handle_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          -1,
-	          SEEK_CUR,
+	result = libewf_handle_set_number_of_write_threads(
+	          NULL,
+	          1,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	offset = libewf_handle_seek_offset(
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_number_of_write_threads(
 	          handle,
-	          (off64_t) ( -1 * ( size + 1 ) ),
-	          SEEK_END,
+	          0,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2665,65 +5071,22 @@ int ewf_test_handle_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-#if defined( HAVE_EWF_TEST_RWLOCK )
-
-	/* Test libewf_handle_seek_offset with pthread_rwlock_wrlock failing in libcthreads_read_write_lock_grab_for_write
-	 */
-	ewf_test_pthread_rwlock_wrlock_attempts_before_fail = 0;
-
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          0,
-	          SEEK_SET,
-	          &error );
-
-	if( ewf_test_pthread_rwlock_wrlock_attempts_before_fail != -1 )
-	{
-		ewf_test_pthread_rwlock_wrlock_attempts_before_fail = -1;
-	}
-	else
-	{
-		EWF_TEST_ASSERT_EQUAL_INT64(
-		 "offset",
-		 (int64_t) offset,
-		 (int64_t) -1 );
-
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-	}
-	/* Test libewf_handle_seek_offset with pthread_rwlock_unlock failing in libcthreads_read_write_lock_release_for_write
-	 */
-	ewf_test_pthread_rwlock_unlock_attempts_before_fail = 0;
-
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_set_number_of_write_threads(
 	          handle,
-	          0,
-	          SEEK_SET,
+	          1024,
 	          &error );
 
-	if( ewf_test_pthread_rwlock_unlock_attempts_before_fail != -1 )
-	{
-		ewf_test_pthread_rwlock_unlock_attempts_before_fail = -1;
-	}
-	else
-	{
-		EWF_TEST_ASSERT_EQUAL_INT64(
-		 "offset",
-		 (int64_t) offset,
-		 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-		libcerror_error_free(
-		 &error );
-	}
-#endif /* defined( HAVE_EWF_TEST_RWLOCK ) */
+	libcerror_error_free(
+	 &error );
 
 	return( 1 );
 
@@ -2733,40 +5096,45 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	libewf_handle_set_number_of_write_threads(
+	 handle,
+	 1,
+	 NULL );
+
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_offset function
+/* Tests the libewf_handle_set_reference_handle function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_offset(
+int ewf_test_handle_set_reference_handle(
      libewf_handle_t *handle )
 {
 	libcerror_error_t *error = NULL;
-	off64_t offset           = 0;
 	int result               = 0;
 
-	/* Test regular cases
+	/* Test error cases
 	 */
-	result = libewf_handle_get_offset(
-	          handle,
-	          &offset,
+	result = libewf_handle_set_reference_handle(
+	          NULL,
+	          NULL,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
+	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	result = libewf_handle_get_offset(
-	          NULL,
-	          &offset,
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_reference_handle(
+	          handle,
+	          handle,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2781,7 +5149,9 @@ int ewf_test_handle_get_offset(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_offset(
+	/* Test a handle that was not opened for writing
+	 */
+	result = libewf_handle_set_reference_handle(
 	          handle,
 	          NULL,
 	          &error );
@@ -3832,6 +6202,81 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_handle_set_chunk_compression_level function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_set_chunk_compression_level(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_handle_set_chunk_compression_level(
+	          NULL,
+	          LIBEWF_COMPRESSION_LEVEL_BEST,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_chunk_compression_level(
+	          handle,
+	          LIBEWF_COMPRESSION_LEVEL_NONE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test handle opened for reading
+	 */
+	result = libewf_handle_set_chunk_compression_level(
+	          handle,
+	          LIBEWF_COMPRESSION_LEVEL_BEST,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the libewf_handle_get_media_size function
  * Returns 1 if successful or 0 if not
  */
@@ -4900,6 +7345,31 @@ int main(
 		 ewf_test_handle_read_buffer_at_offset,
 		 handle );
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_read_buffer_at_offset_concurrent",
+		 ewf_test_handle_read_buffer_at_offset_concurrent,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_read_buffers_at_offsets",
+		 ewf_test_handle_read_buffers_at_offsets,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_submit_read_buffer_at_offset",
+		 ewf_test_handle_submit_read_buffer_at_offset,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_submit_read_buffer_at_offset_from_callback",
+		 ewf_test_handle_submit_read_buffer_at_offset_from_callback,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_pin_data_at_offset",
+		 ewf_test_handle_pin_data_at_offset,
+		 handle );
+
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
 
 		/* TODO: add tests for libewf_internal_handle_write_buffer_to_file_io_pool */
@@ -4957,6 +7427,31 @@ int main(
 
 		/* TODO: add tests for libewf_handle_set_maximum_number_of_open_handles */
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_cache_memory_budget",
+		 ewf_test_handle_get_set_cache_memory_budget,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_read_ahead_values",
+		 ewf_test_handle_get_set_read_ahead_values,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_number_of_read_threads",
+		 ewf_test_handle_get_set_number_of_read_threads,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_number_of_write_threads",
+		 ewf_test_handle_get_set_number_of_write_threads,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_reference_handle",
+		 ewf_test_handle_set_reference_handle,
+		 handle );
+
 		/* TODO: add tests for libewf_handle_segment_files_corrupted */
 
 		/* TODO: add tests for libewf_handle_segment_files_encrypted */
@@ -5090,6 +7585,11 @@ int main(
 
 		/* TODO: add tests for libewf_handle_set_compression_values */
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_chunk_compression_level",
+		 ewf_test_handle_set_chunk_compression_level,
+		 handle );
+
 		EWF_TEST_RUN_WITH_ARGS(
 		 "libewf_handle_get_media_size",
 		 ewf_test_handle_get_media_size,
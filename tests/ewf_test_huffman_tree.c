@@ -525,6 +525,32 @@ int ewf_test_huffman_tree_build(
 	 "error",
 	 error );
 
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "huffman_tree->lookup_table_number_of_bits",
+	 huffman_tree->lookup_table_number_of_bits,
+	 (uint8_t) 10 );
+
+	/* Huffman code: 0000000 (symbol: 256)
+	 */
+	EWF_TEST_ASSERT_EQUAL_UINT16(
+	 "huffman_tree->lookup_table[ 0x0000 ]",
+	 huffman_tree->lookup_table[ 0x0000 ],
+	 (uint16_t) ( ( 256 << 4 ) | 7 ) );
+
+	/* Huffman code: 00110000 (symbol: 0)
+	 */
+	EWF_TEST_ASSERT_EQUAL_UINT16(
+	 "huffman_tree->lookup_table[ 0x000c ]",
+	 huffman_tree->lookup_table[ 0x000c ],
+	 (uint16_t) ( ( 0 << 4 ) | 8 ) );
+
+	/* Huffman code: 110010000 (symbol: 144)
+	 */
+	EWF_TEST_ASSERT_EQUAL_UINT16(
+	 "huffman_tree->lookup_table[ 0x0213 ]",
+	 huffman_tree->lookup_table[ 0x0213 ],
+	 (uint16_t) ( ( 144 << 4 ) | 9 ) );
+
 	/* Test error cases
 	 */
 	result = libewf_huffman_tree_build(
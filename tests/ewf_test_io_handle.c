@@ -667,6 +667,179 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_io_handle_get_chunk_compression_level and libewf_io_handle_set_chunk_compression_level functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_io_handle_get_set_chunk_compression_level(
+     void )
+{
+	libcerror_error_t *error      = NULL;
+	libewf_io_handle_t *io_handle = NULL;
+	int8_t compression_level      = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_io_handle_get_chunk_compression_level(
+	          io_handle,
+	          &compression_level,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "compression_level",
+	 (int) compression_level,
+	 (int) LIBEWF_COMPRESSION_LEVEL_NONE );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_set_chunk_compression_level(
+	          io_handle,
+	          LIBEWF_COMPRESSION_LEVEL_BEST,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_get_chunk_compression_level(
+	          io_handle,
+	          &compression_level,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "compression_level",
+	 (int) compression_level,
+	 (int) LIBEWF_COMPRESSION_LEVEL_BEST );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_io_handle_get_chunk_compression_level(
+	          NULL,
+	          &compression_level,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_io_handle_get_chunk_compression_level(
+	          io_handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_io_handle_set_chunk_compression_level(
+	          NULL,
+	          LIBEWF_COMPRESSION_LEVEL_BEST,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 /* The main program
@@ -702,6 +875,10 @@ int main(
 	 "libewf_io_handle_clone",
 	 ewf_test_io_handle_clone );
 
+	EWF_TEST_RUN(
+	 "libewf_io_handle_get_chunk_compression_level",
+	 ewf_test_io_handle_get_set_chunk_compression_level );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
@@ -1278,6 +1278,8 @@ int main(
 
 	/* TODO: add tests for libewf_segment_file_write_chunks_section_end */
 
+	/* TODO: add tests for libewf_segment_file_flush_write_buffer */
+
 	/* TODO: add tests for libewf_segment_file_write_chunk_data */
 
 	/* TODO: add tests for libewf_segment_file_write_hash_sections */
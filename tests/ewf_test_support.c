@@ -99,6 +99,27 @@ on_error:
 }
 
 
+/* Tests the libewf_get_access_flags_read_memory_map function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_get_access_flags_read_memory_map(
+     void )
+{
+	int access_flags = 0;
+
+	access_flags = libewf_get_access_flags_read_memory_map();
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "access_flags",
+	 access_flags,
+	 ( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_MEMORY_MAP ) );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
 /* Tests the libewf_get_access_flags_read_write function
  * Returns 1 if successful or 0 if not
  */
@@ -2411,6 +2432,10 @@ int main(
 	 "libewf_get_access_flags_read",
 	 ewf_test_get_access_flags_read );
 
+	EWF_TEST_RUN(
+	 "libewf_get_access_flags_read_memory_map",
+	 ewf_test_get_access_flags_read_memory_map );
+
 	EWF_TEST_RUN(
 	 "libewf_get_access_flags_read_write",
 	 ewf_test_get_access_flags_read_write );
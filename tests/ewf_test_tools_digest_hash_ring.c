@@ -0,0 +1,687 @@
+/*
+ * Tools digest_hash_ring type test program
+ *
+ * Copyright (C) 2006-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/digest_hash_ring.h"
+
+#define EWF_TEST_DIGEST_HASH_RING_DATA_SIZE	65536
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Tests the digest_hash_ring_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_hash_ring_initialize(
+     void )
+{
+	digest_hash_ring_t *digest_hash_ring = NULL;
+	libcerror_error_t *error             = NULL;
+	libhmac_md5_context_t *md5_context   = NULL;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libhmac_md5_initialize(
+	          &md5_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "md5_context",
+	 md5_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = digest_hash_ring_initialize(
+	          &digest_hash_ring,
+	          md5_context,
+	          NULL,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "digest_hash_ring",
+	 digest_hash_ring );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "digest_hash_ring->number_of_digests",
+	 digest_hash_ring->number_of_digests,
+	 1 );
+
+	result = digest_hash_ring_free(
+	          &digest_hash_ring,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "digest_hash_ring",
+	 digest_hash_ring );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = digest_hash_ring_initialize(
+	          NULL,
+	          md5_context,
+	          NULL,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	digest_hash_ring = (digest_hash_ring_t *) 0x12345678UL;
+
+	result = digest_hash_ring_initialize(
+	          &digest_hash_ring,
+	          md5_context,
+	          NULL,
+	          NULL,
+	          &error );
+
+	digest_hash_ring = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libhmac_md5_free(
+	          &md5_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "md5_context",
+	 md5_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest_hash_ring != NULL )
+	{
+		digest_hash_ring_free(
+		 &digest_hash_ring,
+		 NULL );
+	}
+	if( md5_context != NULL )
+	{
+		libhmac_md5_free(
+		 &md5_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the digest_hash_ring_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_hash_ring_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = digest_hash_ring_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the digest_hash_ring_update function
+ * Compares the digests calculated by the ring with single-threaded calculated digests
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_hash_ring_update(
+     void )
+{
+	uint8_t data[ EWF_TEST_DIGEST_HASH_RING_DATA_SIZE ];
+	uint8_t calculated_md5_hash[ LIBHMAC_MD5_HASH_SIZE ];
+	uint8_t calculated_sha1_hash[ LIBHMAC_SHA1_HASH_SIZE ];
+	uint8_t calculated_sha256_hash[ LIBHMAC_SHA256_HASH_SIZE ];
+	uint8_t expected_md5_hash[ LIBHMAC_MD5_HASH_SIZE ];
+	uint8_t expected_sha1_hash[ LIBHMAC_SHA1_HASH_SIZE ];
+	uint8_t expected_sha256_hash[ LIBHMAC_SHA256_HASH_SIZE ];
+
+	digest_hash_ring_t *digest_hash_ring     = NULL;
+	libcerror_error_t *error                 = NULL;
+	libhmac_md5_context_t *md5_context       = NULL;
+	libhmac_sha1_context_t *sha1_context     = NULL;
+	libhmac_sha256_context_t *sha256_context = NULL;
+	size_t data_offset                       = 0;
+	size_t data_size                         = 0;
+	int buffer_index                         = 0;
+	int result                               = 0;
+
+	/* Initialize test
+	 */
+	for( data_offset = 0;
+	     data_offset < EWF_TEST_DIGEST_HASH_RING_DATA_SIZE;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( ( data_offset * 31 ) + ( data_offset >> 8 ) );
+	}
+	result = libhmac_md5_calculate(
+	          data,
+	          EWF_TEST_DIGEST_HASH_RING_DATA_SIZE,
+	          expected_md5_hash,
+	          LIBHMAC_MD5_HASH_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libhmac_sha1_calculate(
+	          data,
+	          EWF_TEST_DIGEST_HASH_RING_DATA_SIZE,
+	          expected_sha1_hash,
+	          LIBHMAC_SHA1_HASH_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libhmac_sha256_calculate(
+	          data,
+	          EWF_TEST_DIGEST_HASH_RING_DATA_SIZE,
+	          expected_sha256_hash,
+	          LIBHMAC_SHA256_HASH_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libhmac_md5_initialize(
+	          &md5_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libhmac_sha1_initialize(
+	          &sha1_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libhmac_sha256_initialize(
+	          &sha256_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = digest_hash_ring_initialize(
+	          &digest_hash_ring,
+	          md5_context,
+	          sha1_context,
+	          sha256_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "digest_hash_ring",
+	 digest_hash_ring );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "digest_hash_ring->number_of_digests",
+	 digest_hash_ring->number_of_digests,
+	 3 );
+
+	/* Test regular cases
+	 * The buffers vary in size and outnumber the slots so that the slots are reused
+	 */
+	data_offset = 0;
+
+	while( data_offset < EWF_TEST_DIGEST_HASH_RING_DATA_SIZE )
+	{
+		data_size = 1 + ( ( buffer_index * 509 ) % 2048 );
+
+		if( data_size > ( EWF_TEST_DIGEST_HASH_RING_DATA_SIZE - data_offset ) )
+		{
+			data_size = EWF_TEST_DIGEST_HASH_RING_DATA_SIZE - data_offset;
+		}
+		result = digest_hash_ring_update(
+		          digest_hash_ring,
+		          &( data[ data_offset ] ),
+		          data_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		data_offset  += data_size;
+		buffer_index += 1;
+	}
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "buffer_index",
+	 buffer_index,
+	 DIGEST_HASH_RING_NUMBER_OF_SLOTS );
+
+	result = digest_hash_ring_join(
+	          digest_hash_ring,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libhmac_md5_finalize(
+	          md5_context,
+	          calculated_md5_hash,
+	          LIBHMAC_MD5_HASH_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          calculated_md5_hash,
+	          expected_md5_hash,
+	          LIBHMAC_MD5_HASH_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libhmac_sha1_finalize(
+	          sha1_context,
+	          calculated_sha1_hash,
+	          LIBHMAC_SHA1_HASH_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          calculated_sha1_hash,
+	          expected_sha1_hash,
+	          LIBHMAC_SHA1_HASH_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libhmac_sha256_finalize(
+	          sha256_context,
+	          calculated_sha256_hash,
+	          LIBHMAC_SHA256_HASH_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          calculated_sha256_hash,
+	          expected_sha256_hash,
+	          LIBHMAC_SHA256_HASH_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = digest_hash_ring_update(
+	          NULL,
+	          data,
+	          EWF_TEST_DIGEST_HASH_RING_DATA_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = digest_hash_ring_update(
+	          digest_hash_ring,
+	          NULL,
+	          EWF_TEST_DIGEST_HASH_RING_DATA_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = digest_hash_ring_free(
+	          &digest_hash_ring,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "digest_hash_ring",
+	 digest_hash_ring );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libhmac_sha256_free(
+	          &sha256_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libhmac_sha1_free(
+	          &sha1_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libhmac_md5_free(
+	          &md5_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest_hash_ring != NULL )
+	{
+		digest_hash_ring_free(
+		 &digest_hash_ring,
+		 NULL );
+	}
+	if( sha256_context != NULL )
+	{
+		libhmac_sha256_free(
+		 &sha256_context,
+		 NULL );
+	}
+	if( sha1_context != NULL )
+	{
+		libhmac_sha1_free(
+		 &sha1_context,
+		 NULL );
+	}
+	if( md5_context != NULL )
+	{
+		libhmac_md5_free(
+		 &md5_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "digest_hash_ring_initialize",
+	 ewf_test_tools_digest_hash_ring_initialize );
+
+	EWF_TEST_RUN(
+	 "digest_hash_ring_free",
+	 ewf_test_tools_digest_hash_ring_free );
+
+	EWF_TEST_RUN(
+	 "digest_hash_ring_update",
+	 ewf_test_tools_digest_hash_ring_update );
+
+	/* TODO add tests for digest_hash_ring_join */
+
+	/* TODO add tests for digest_hash_ring_release_slot */
+
+	/* TODO add tests for digest_hash_ring_digest_callback */
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+}
+
@@ -478,6 +478,10 @@ int main(
 
 	/* TODO add tests for export_handle_get_output_chunk_size */
 
+	/* TODO add tests for export_handle_determine_pass_through_chunks */
+
+	/* TODO add tests for export_handle_write_packed_chunk */
+
 	/* TODO add tests for export_handle_prompt_for_string */
 
 	/* TODO add tests for export_handle_prompt_for_compression_method */
@@ -532,7 +536,7 @@ int main(
 
 	/* TODO add tests for export_handle_output_storage_media_buffer_callback */
 
-	/* TODO add tests for export_handle_empty_output_list */
+	/* TODO add tests for export_handle_empty_output_buffers */
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
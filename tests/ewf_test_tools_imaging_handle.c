@@ -420,10 +420,16 @@ int main(
 
 	/* TODO add tests for imaging_handle_output_storage_media_buffer_callback */
 
-	/* TODO add tests for imaging_handle_empty_output_list */
+	/* TODO add tests for imaging_handle_empty_output_buffers */
+
+	/* TODO add tests for imaging_handle_push_storage_media_buffer */
+
+	/* TODO add tests for imaging_handle_adjust_compression_level */
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
+	/* TODO add tests for imaging_handle_set_adaptive_compression_level */
+
 	/* TODO add tests for imaging_handle_get_process_buffer_size */
 
 	/* TODO add tests for imaging_handle_prompt_for_string */
@@ -478,6 +484,8 @@ int main(
 
 	/* TODO add tests for imaging_handle_set_process_buffer_size */
 
+	/* TODO add tests for imaging_handle_set_piecewise_hash_window_size */
+
 	/* TODO add tests for imaging_handle_set_number_of_threads */
 
 	/* TODO add tests for imaging_handle_set_additional_digest_types */
@@ -506,6 +514,8 @@ int main(
 
 	/* TODO add tests for imaging_handle_print_hashes */
 
+	/* TODO add tests for imaging_handle_print_compression_levels */
+
 	/* Clean up
 	 */
 	result = imaging_handle_free(
@@ -0,0 +1,863 @@
+/*
+ * Tools piecewise_hash type test program
+ *
+ * Copyright (C) 2006-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/piecewise_hash.h"
+
+#define EWF_TEST_PIECEWISE_HASH_DATA_SIZE	4500
+#define EWF_TEST_PIECEWISE_HASH_WINDOW_SIZE	1024
+
+/* The MD5 and SHA256 digest hashes of the windows of the test data
+ */
+const char *ewf_test_piecewise_hash_expected_lines[ 5 ] = {
+	"0 - 1023 (size: 1024)\tMD5: f4cd1641040a17288bb6104d9e66bdb5\tSHA256: e577987572edcdbaa752f9bdcbbe6e86dfe78063e6ee15125c6f8a19d517ac17\n",
+	"1024 - 2047 (size: 1024)\tMD5: 5de480542d911d2df51bd8d206d66522\tSHA256: b87c2abf496b7da0e59e2d4ad767b605485d0ec3b598a4b2db61b44110420f1c\n",
+	"2048 - 3071 (size: 1024)\tMD5: 95f0e20cbce09dcea718e14a055f5a6f\tSHA256: 6691a5904ba60545021b0a381ef3214ed376c9f82ba6b16796beb2b430d7fb56\n",
+	"3072 - 4095 (size: 1024)\tMD5: 6395663e45b0de40161cbe1a0e7ae72c\tSHA256: 8ffe926471162d60cfbd0e9a42f195e2c6db2d2eabaef3cfd83ced8bd885e793\n",
+	"4096 - 4499 (size: 404)\tMD5: c7ca86993dbb59be4f729b6a50f1c221\tSHA256: f0c8db2add8ced5dfac92c0d1dc90911d8f56bba8eb8fc51380c954944262889\n" };
+
+/* Fills the test data
+ */
+void ewf_test_tools_piecewise_hash_fill_data(
+      uint8_t *data )
+{
+	size_t data_offset = 0;
+
+	for( data_offset = 0;
+	     data_offset < EWF_TEST_PIECEWISE_HASH_DATA_SIZE;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( ( data_offset * 31 ) + ( data_offset >> 8 ) );
+	}
+}
+
+/* Compares the lines printed to a stream with the expected lines
+ * Returns 1 if the lines match, 0 if not or -1 on error
+ */
+int ewf_test_tools_piecewise_hash_compare_stream(
+     FILE *stream,
+     const char **expected_lines,
+     int number_of_expected_lines )
+{
+	char line[ 256 ];
+
+	size_t line_length = 0;
+	int line_index     = 0;
+
+	if( file_stream_seek_offset(
+	     stream,
+	     0,
+	     SEEK_SET ) != 0 )
+	{
+		return( -1 );
+	}
+	for( line_index = 0;
+	     line_index < number_of_expected_lines;
+	     line_index++ )
+	{
+		if( file_stream_get_string(
+		     stream,
+		     line,
+		     256 ) == NULL )
+		{
+			return( 0 );
+		}
+		line_length = narrow_string_length(
+		               expected_lines[ line_index ] );
+
+		if( narrow_string_length(
+		     line ) != line_length )
+		{
+			return( 0 );
+		}
+		if( memory_compare(
+		     line,
+		     expected_lines[ line_index ],
+		     line_length ) != 0 )
+		{
+			return( 0 );
+		}
+	}
+	if( file_stream_get_string(
+	     stream,
+	     line,
+	     256 ) != NULL )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Tests the piecewise_hash_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_piecewise_hash_initialize(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	piecewise_hash_t *piecewise_hash = NULL;
+	int result                       = 0;
+
+	/* Test regular cases
+	 */
+	result = piecewise_hash_initialize(
+	          &piecewise_hash,
+	          EWF_TEST_PIECEWISE_HASH_WINDOW_SIZE,
+	          1,
+	          0,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "piecewise_hash",
+	 piecewise_hash );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = piecewise_hash_free(
+	          &piecewise_hash,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "piecewise_hash",
+	 piecewise_hash );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = piecewise_hash_initialize(
+	          NULL,
+	          EWF_TEST_PIECEWISE_HASH_WINDOW_SIZE,
+	          1,
+	          0,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	piecewise_hash = (piecewise_hash_t *) 0x12345678UL;
+
+	result = piecewise_hash_initialize(
+	          &piecewise_hash,
+	          EWF_TEST_PIECEWISE_HASH_WINDOW_SIZE,
+	          1,
+	          0,
+	          1,
+	          &error );
+
+	piecewise_hash = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = piecewise_hash_initialize(
+	          &piecewise_hash,
+	          0,
+	          1,
+	          0,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "piecewise_hash",
+	 piecewise_hash );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = piecewise_hash_initialize(
+	          &piecewise_hash,
+	          (size_t) SSIZE_MAX + 1,
+	          1,
+	          0,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "piecewise_hash",
+	 piecewise_hash );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( piecewise_hash != NULL )
+	{
+		piecewise_hash_free(
+		 &piecewise_hash,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the piecewise_hash_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_piecewise_hash_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = piecewise_hash_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the piecewise_hash_update, piecewise_hash_fprint and piecewise_hash_finalize functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_piecewise_hash_update(
+     void )
+{
+	uint8_t data[ EWF_TEST_PIECEWISE_HASH_DATA_SIZE ];
+
+	libcerror_error_t *error         = NULL;
+	piecewise_hash_t *piecewise_hash = NULL;
+	FILE *stream                     = NULL;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	ewf_test_tools_piecewise_hash_fill_data(
+	 data );
+
+	result = piecewise_hash_initialize(
+	          &piecewise_hash,
+	          EWF_TEST_PIECEWISE_HASH_WINDOW_SIZE,
+	          1,
+	          0,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "piecewise_hash",
+	 piecewise_hash );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a buffer that crosses a window boundary
+	 * only the first window is complete
+	 */
+	result = piecewise_hash_update(
+	          piecewise_hash,
+	          0,
+	          data,
+	          1500,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	stream = tmpfile();
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	result = piecewise_hash_fprint(
+	          piecewise_hash,
+	          stream,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_tools_piecewise_hash_compare_stream(
+	          stream,
+	          &( ewf_test_piecewise_hash_expected_lines[ 0 ] ),
+	          1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	file_stream_close(
+	 stream );
+
+	stream = NULL;
+
+	/* Test a buffer that completes the second window and contains several windows
+	 */
+	result = piecewise_hash_update(
+	          piecewise_hash,
+	          1500,
+	          &( data[ 1500 ] ),
+	          EWF_TEST_PIECEWISE_HASH_DATA_SIZE - 1500,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	stream = tmpfile();
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	result = piecewise_hash_fprint(
+	          piecewise_hash,
+	          stream,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_tools_piecewise_hash_compare_stream(
+	          stream,
+	          &( ewf_test_piecewise_hash_expected_lines[ 1 ] ),
+	          3 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	file_stream_close(
+	 stream );
+
+	stream = NULL;
+
+	/* Test the last partial window is printed at finalize
+	 */
+	stream = tmpfile();
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	result = piecewise_hash_finalize(
+	          piecewise_hash,
+	          stream,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_tools_piecewise_hash_compare_stream(
+	          stream,
+	          &( ewf_test_piecewise_hash_expected_lines[ 4 ] ),
+	          1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	file_stream_close(
+	 stream );
+
+	stream = NULL;
+
+	/* Test error cases
+	 */
+	result = piecewise_hash_update(
+	          NULL,
+	          0,
+	          data,
+	          EWF_TEST_PIECEWISE_HASH_DATA_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = piecewise_hash_update(
+	          piecewise_hash,
+	          0,
+	          NULL,
+	          EWF_TEST_PIECEWISE_HASH_DATA_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = piecewise_hash_free(
+	          &piecewise_hash,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "piecewise_hash",
+	 piecewise_hash );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream != NULL )
+	{
+		file_stream_close(
+		 stream );
+	}
+	if( piecewise_hash != NULL )
+	{
+		piecewise_hash_free(
+		 &piecewise_hash,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+#define EWF_TEST_PIECEWISE_HASH_NUMBER_OF_BUFFERS	9
+
+typedef struct ewf_test_piecewise_hash_buffer ewf_test_piecewise_hash_buffer_t;
+
+/* A buffer that is hashed by a thread of the thread pool
+ */
+struct ewf_test_piecewise_hash_buffer
+{
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The data
+	 */
+	const uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The result of the update
+	 */
+	int result;
+};
+
+/* Hashes a buffer
+ * Callback function for the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_tools_piecewise_hash_update_callback(
+     ewf_test_piecewise_hash_buffer_t *buffer,
+     piecewise_hash_t *piecewise_hash )
+{
+	buffer->result = piecewise_hash_update(
+	                  piecewise_hash,
+	                  buffer->offset,
+	                  buffer->data,
+	                  buffer->data_size,
+	                  NULL );
+
+	return( buffer->result );
+}
+
+/* Tests the piecewise_hash_update function with buffers that are hashed concurrently
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_piecewise_hash_update_threaded(
+     void )
+{
+	uint8_t data[ EWF_TEST_PIECEWISE_HASH_DATA_SIZE ];
+
+	ewf_test_piecewise_hash_buffer_t buffers[ EWF_TEST_PIECEWISE_HASH_NUMBER_OF_BUFFERS ];
+
+	libcerror_error_t *error                = NULL;
+	libcthreads_thread_pool_t *thread_pool = NULL;
+	piecewise_hash_t *piecewise_hash        = NULL;
+	FILE *stream                            = NULL;
+	int buffer_index                        = 0;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	ewf_test_tools_piecewise_hash_fill_data(
+	 data );
+
+	result = piecewise_hash_initialize(
+	          &piecewise_hash,
+	          EWF_TEST_PIECEWISE_HASH_WINDOW_SIZE,
+	          1,
+	          0,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "piecewise_hash",
+	 piecewise_hash );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_pool_create(
+	          &thread_pool,
+	          NULL,
+	          4,
+	          EWF_TEST_PIECEWISE_HASH_NUMBER_OF_BUFFERS,
+	          (int (*)(intptr_t *, void *)) &ewf_test_tools_piecewise_hash_update_callback,
+	          (void *) piecewise_hash,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * The buffers are smaller than the window size, hence most windows are covered by multiple buffers
+	 */
+	for( buffer_index = 0;
+	     buffer_index < EWF_TEST_PIECEWISE_HASH_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		buffers[ buffer_index ].offset    = (off64_t) buffer_index * 500;
+		buffers[ buffer_index ].data      = &( data[ buffer_index * 500 ] );
+		buffers[ buffer_index ].data_size = 500;
+		buffers[ buffer_index ].result    = 0;
+
+		result = libcthreads_thread_pool_push(
+		          thread_pool,
+		          (intptr_t *) &( buffers[ buffer_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libcthreads_thread_pool_join(
+	          &thread_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( buffer_index = 0;
+	     buffer_index < EWF_TEST_PIECEWISE_HASH_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "buffers[ buffer_index ].result",
+		 buffers[ buffer_index ].result,
+		 1 );
+	}
+	stream = tmpfile();
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	result = piecewise_hash_finalize(
+	          piecewise_hash,
+	          stream,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_tools_piecewise_hash_compare_stream(
+	          stream,
+	          ewf_test_piecewise_hash_expected_lines,
+	          5 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	file_stream_close(
+	 stream );
+
+	stream = NULL;
+
+	/* Clean up
+	 */
+	result = piecewise_hash_free(
+	          &piecewise_hash,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "piecewise_hash",
+	 piecewise_hash );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream != NULL )
+	{
+		file_stream_close(
+		 stream );
+	}
+	if( thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+	if( piecewise_hash != NULL )
+	{
+		piecewise_hash_free(
+		 &piecewise_hash,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "piecewise_hash_initialize",
+	 ewf_test_tools_piecewise_hash_initialize );
+
+	EWF_TEST_RUN(
+	 "piecewise_hash_free",
+	 ewf_test_tools_piecewise_hash_free );
+
+	EWF_TEST_RUN(
+	 "piecewise_hash_update",
+	 ewf_test_tools_piecewise_hash_update );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "piecewise_hash_update_threaded",
+	 ewf_test_tools_piecewise_hash_update_threaded );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -22,6 +22,8 @@
 #include <common.h>
 #include <file_stream.h>
 #include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -36,6 +38,12 @@
 
 #include "../ewftools/verification_handle.h"
 
+#define EWF_TEST_VERIFY_CHUNKS_CHUNK_SIZE		32768
+#define EWF_TEST_VERIFY_CHUNKS_NUMBER_OF_CHUNKS		8
+#define EWF_TEST_VERIFY_CHUNKS_MEDIA_SIZE		( EWF_TEST_VERIFY_CHUNKS_NUMBER_OF_CHUNKS * EWF_TEST_VERIFY_CHUNKS_CHUNK_SIZE )
+#define EWF_TEST_VERIFY_CHUNKS_MARKER_SIZE		15
+#define EWF_TEST_VERIFY_CHUNKS_MAXIMUM_FILE_SIZE	1048576
+
 /* Tests the verification_handle_initialize function
  * Returns 1 if successful or 0 if not
  */
@@ -327,6 +335,801 @@ on_error:
 	return( 0 );
 }
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Writes an uncompressed test image of EWF_TEST_VERIFY_CHUNKS_NUMBER_OF_CHUNKS chunks
+ * Every chunk starts with a marker that contains the chunk index
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_tools_verification_handle_write_image(
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *handle = NULL;
+	uint8_t *buffer         = NULL;
+	static char *function   = "ewf_test_tools_verification_handle_write_image";
+	size_t buffer_offset    = 0;
+	ssize_t write_count     = 0;
+	uint32_t value          = 1;
+	int chunk_index         = 0;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * EWF_TEST_VERIFY_CHUNKS_MEDIA_SIZE );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	/* Pseudo random data is used so that the chunks are not stored as empty blocks
+	 */
+	for( buffer_offset = 0;
+	     buffer_offset < EWF_TEST_VERIFY_CHUNKS_MEDIA_SIZE;
+	     buffer_offset++ )
+	{
+		value = ( value * 1103515245UL ) + 12345;
+
+		buffer[ buffer_offset ] = (uint8_t) ( value >> 16 );
+	}
+	for( chunk_index = 0;
+	     chunk_index < EWF_TEST_VERIFY_CHUNKS_NUMBER_OF_CHUNKS;
+	     chunk_index++ )
+	{
+		narrow_string_snprintf(
+		 (char *) &( buffer[ chunk_index * EWF_TEST_VERIFY_CHUNKS_CHUNK_SIZE ] ),
+		 EWF_TEST_VERIFY_CHUNKS_MARKER_SIZE,
+		 "EWFTESTCHUNK%02d",
+		 chunk_index );
+	}
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     (wchar_t * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     (char * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_media_size(
+	     handle,
+	     EWF_TEST_VERIFY_CHUNKS_MEDIA_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_sectors_per_chunk(
+	     handle,
+	     EWF_TEST_VERIFY_CHUNKS_CHUNK_SIZE / 512,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set sectors per chunk.",
+		 function );
+
+		goto on_error;
+	}
+	/* Uncompressed chunks are stored with their checksum directly after the chunk data
+	 */
+	if( libewf_handle_set_compression_values(
+	     handle,
+	     LIBEWF_COMPRESSION_NONE,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set compression values.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libewf_handle_write_buffer(
+	               handle,
+	               buffer,
+	               EWF_TEST_VERIFY_CHUNKS_MEDIA_SIZE,
+	               error );
+
+	if( write_count != (ssize_t) EWF_TEST_VERIFY_CHUNKS_MEDIA_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffer.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
+
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
+
+/* Flips a bit in the checksum of a chunk of the test image
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_tools_verification_handle_flip_checksum(
+     const char *filename,
+     int chunk_index,
+     libcerror_error_t **error )
+{
+	char marker[ EWF_TEST_VERIFY_CHUNKS_MARKER_SIZE ];
+
+	FILE *file_stream     = NULL;
+	uint8_t *data         = NULL;
+	static char *function = "ewf_test_tools_verification_handle_flip_checksum";
+	size_t data_offset    = 0;
+	size_t data_size      = 0;
+	size_t write_count    = 0;
+
+	narrow_string_snprintf(
+	 marker,
+	 EWF_TEST_VERIFY_CHUNKS_MARKER_SIZE,
+	 "EWFTESTCHUNK%02d",
+	 chunk_index );
+
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * EWF_TEST_VERIFY_CHUNKS_MAXIMUM_FILE_SIZE );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	file_stream = file_stream_open(
+	               filename,
+	               FILE_STREAM_BINARY_OPEN_READ );
+
+	if( file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	data_size = file_stream_read(
+	             file_stream,
+	             data,
+	             EWF_TEST_VERIFY_CHUNKS_MAXIMUM_FILE_SIZE );
+
+	file_stream_close(
+	 file_stream );
+
+	file_stream = NULL;
+
+	/* The checksum of an uncompressed chunk directly follows the chunk data
+	 */
+	for( data_offset = 0;
+	     ( data_offset + EWF_TEST_VERIFY_CHUNKS_CHUNK_SIZE + 4 ) <= data_size;
+	     data_offset++ )
+	{
+		if( memory_compare(
+		     &( data[ data_offset ] ),
+		     marker,
+		     EWF_TEST_VERIFY_CHUNKS_MARKER_SIZE - 1 ) == 0 )
+		{
+			break;
+		}
+	}
+	if( ( data_offset + EWF_TEST_VERIFY_CHUNKS_CHUNK_SIZE + 4 ) > data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: unable to find chunk: %d.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	data[ data_offset + EWF_TEST_VERIFY_CHUNKS_CHUNK_SIZE ] ^= 0x01;
+
+	file_stream = file_stream_open(
+	               filename,
+	               FILE_STREAM_BINARY_OPEN_WRITE );
+
+	if( file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	write_count = file_stream_write(
+	               file_stream,
+	               data,
+	               data_size );
+
+	file_stream_close(
+	 file_stream );
+
+	file_stream = NULL;
+
+	if( write_count != data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	memory_free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( -1 );
+}
+
+/* Verifies the chunks of the test image and captures the report
+ * The number of unreadable chunks are added beyond the end of the image
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_tools_verification_handle_verify_chunks(
+     const system_character_t *filename,
+     int number_of_unreadable_chunks,
+     char *report,
+     size_t report_size,
+     uint64_t *number_of_corrupted_chunks,
+     uint64_t *number_of_chunks_to_verify,
+     libcerror_error_t **error )
+{
+	system_character_t *filenames[ 1 ]         = { NULL };
+	verification_handle_t *verification_handle = NULL;
+	FILE *notify_stream                        = NULL;
+	static char *function                      = "ewf_test_tools_verification_handle_verify_chunks";
+	size_t read_count                          = 0;
+
+	filenames[ 0 ] = (system_character_t *) filename;
+
+	notify_stream = tmpfile();
+
+	if( notify_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to create notify stream.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle_initialize(
+	     &verification_handle,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create verification handle.",
+		 function );
+
+		goto on_error;
+	}
+	verification_handle->notify_stream = notify_stream;
+
+	if( verification_handle_set_verify_chunks_concurrently(
+	     verification_handle,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set verify chunks concurrently.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle_open_input(
+	     verification_handle,
+	     filenames,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_media_size(
+	     verification_handle->input_handle,
+	     &( verification_handle->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	/* The chunks beyond the end of the image cannot be read
+	 */
+	verification_handle->media_size += (size64_t) number_of_unreadable_chunks * verification_handle->chunk_size;
+
+	if( verification_handle_start_chunk_verification(
+	     verification_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to start chunk verification.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle_stop_chunk_verification(
+	     verification_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to stop chunk verification.",
+		 function );
+
+		goto on_error;
+	}
+	*number_of_corrupted_chunks = verification_handle->number_of_corrupted_chunks;
+	*number_of_chunks_to_verify = verification_handle->number_of_chunks_to_verify;
+
+	if( verification_handle_close(
+	     verification_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close verification handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle_free(
+	     &verification_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free verification handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_stream_seek_offset(
+	     notify_stream,
+	     0,
+	     SEEK_SET ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek start of notify stream.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = file_stream_read(
+	              notify_stream,
+	              report,
+	              report_size - 1 );
+
+	report[ read_count ] = 0;
+
+	file_stream_close(
+	 notify_stream );
+
+	return( 1 );
+
+on_error:
+	if( verification_handle != NULL )
+	{
+		verification_handle_close(
+		 verification_handle,
+		 NULL );
+		verification_handle_free(
+		 &verification_handle,
+		 NULL );
+	}
+	if( notify_stream != NULL )
+	{
+		file_stream_close(
+		 notify_stream );
+	}
+	return( -1 );
+}
+
+/* Counts the number of corrupted chunks in a chunk verification report
+ * Returns the number of corrupted chunks
+ */
+int ewf_test_tools_verification_handle_count_reported_chunks(
+     const char *report )
+{
+	const char *line = report;
+	int count        = 0;
+
+	while( line != NULL )
+	{
+		line = narrow_string_search_string(
+		        line,
+		        " error in chunk: ",
+		        0 );
+
+		if( line != NULL )
+		{
+			count += 1;
+			line  += 1;
+		}
+	}
+	return( count );
+}
+
+/* Tests the verification_handle_start_chunk_verification function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_verification_handle_start_chunk_verification(
+     void )
+{
+	char report[ 1024 ];
+
+	libcerror_error_t *error            = NULL;
+	char *string                        = NULL;
+	uint64_t number_of_chunks_to_verify = 0;
+	uint64_t number_of_corrupted_chunks = 0;
+	int number_of_reported_chunks       = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = ewf_test_tools_verification_handle_write_image(
+	          _SYSTEM_STRING( "ewf_test_verify_chunks" ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test clean input
+	 */
+	result = ewf_test_tools_verification_handle_verify_chunks(
+	          _SYSTEM_STRING( "ewf_test_verify_chunks.E01" ),
+	          0,
+	          report,
+	          1024,
+	          &number_of_corrupted_chunks,
+	          &number_of_chunks_to_verify,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_chunks_to_verify",
+	 number_of_chunks_to_verify,
+	 (uint64_t) EWF_TEST_VERIFY_CHUNKS_NUMBER_OF_CHUNKS );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_corrupted_chunks",
+	 number_of_corrupted_chunks,
+	 (uint64_t) 0 );
+
+	number_of_reported_chunks = ewf_test_tools_verification_handle_count_reported_chunks(
+	                             report );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_reported_chunks",
+	 number_of_reported_chunks,
+	 0 );
+
+	string = narrow_string_search_string(
+	          report,
+	          "Chunk verification completed: 0 of 8 chunks corrupted.\n",
+	          0 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "string",
+	 string );
+
+	/* Test a range that cannot be read
+	 */
+	result = ewf_test_tools_verification_handle_verify_chunks(
+	          _SYSTEM_STRING( "ewf_test_verify_chunks.E01" ),
+	          2,
+	          report,
+	          1024,
+	          &number_of_corrupted_chunks,
+	          &number_of_chunks_to_verify,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_chunks_to_verify",
+	 number_of_chunks_to_verify,
+	 (uint64_t) EWF_TEST_VERIFY_CHUNKS_NUMBER_OF_CHUNKS + 2 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_corrupted_chunks",
+	 number_of_corrupted_chunks,
+	 (uint64_t) 2 );
+
+	number_of_reported_chunks = ewf_test_tools_verification_handle_count_reported_chunks(
+	                             report );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_reported_chunks",
+	 number_of_reported_chunks,
+	 2 );
+
+	string = narrow_string_search_string(
+	          report,
+	          "Read error in chunk: 8 at offset: 262144 (0x00040000).\n",
+	          0 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "string",
+	 string );
+
+	string = narrow_string_search_string(
+	          report,
+	          "Read error in chunk: 9 at offset: 294912 (0x00048000).\n",
+	          0 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "string",
+	 string );
+
+	string = narrow_string_search_string(
+	          report,
+	          "Chunk verification completed: 2 of 10 chunks corrupted.\n",
+	          0 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "string",
+	 string );
+
+	/* Test a chunk with a flipped checksum
+	 */
+	result = ewf_test_tools_verification_handle_flip_checksum(
+	          "ewf_test_verify_chunks.E01",
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_tools_verification_handle_verify_chunks(
+	          _SYSTEM_STRING( "ewf_test_verify_chunks.E01" ),
+	          0,
+	          report,
+	          1024,
+	          &number_of_corrupted_chunks,
+	          &number_of_chunks_to_verify,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_corrupted_chunks",
+	 number_of_corrupted_chunks,
+	 (uint64_t) 1 );
+
+	number_of_reported_chunks = ewf_test_tools_verification_handle_count_reported_chunks(
+	                             report );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_reported_chunks",
+	 number_of_reported_chunks,
+	 1 );
+
+	string = narrow_string_search_string(
+	          report,
+	          "Checksum error in chunk: 2 at offset: 65536 (0x00010000).\n",
+	          0 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "string",
+	 string );
+
+	string = narrow_string_search_string(
+	          report,
+	          "Chunk verification completed: 1 of 8 chunks corrupted.\n",
+	          0 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "string",
+	 string );
+
+	/* Clean up
+	 */
+	remove(
+	 "ewf_test_verify_chunks.E01" );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	remove(
+	 "ewf_test_verify_chunks.E01" );
+
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -354,6 +1157,14 @@ int main(
 	 "verification_handle_free",
 	 ewf_test_tools_verification_handle_free );
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "verification_handle_start_chunk_verification",
+	 ewf_test_tools_verification_handle_start_chunk_verification );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 #if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
 	/* Initialize info handle for tests
 	 */
@@ -434,6 +434,663 @@ on_error:
 	return( -1 );
 }
 
+/* Opens the EWF file(s) of which the first segment file is filename for reading
+ * Return 1 if successful or -1 on error
+ */
+int ewf_test_write_chunk_open_for_reading(
+     libewf_handle_t *handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	wchar_t **filenames     = NULL;
+#else
+	char **filenames        = NULL;
+#endif
+	static char *function   = "ewf_test_write_chunk_open_for_reading";
+	int number_of_filenames = 0;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide(
+	     filename,
+	     wide_string_length(
+	      filename ),
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     error ) != 1 )
+#else
+	if( libewf_glob(
+	     filename,
+	     narrow_string_length(
+	      filename ),
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to glob filenames.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide_free(
+	     filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+#else
+	if( libewf_glob_free(
+	     filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free globbed filenames.",
+		 function );
+
+		filenames = NULL;
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( filenames != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	return( -1 );
+}
+
+/* Tests writing the data chunks read from the EWF file(s) written by ewf_test_write_chunk
+ * to another EWF file, which passes the packed chunk data through as-is
+ * Return 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_write_chunk_from_handle(
+     const system_character_t *filename,
+     int8_t compression_level,
+     uint8_t compression_flags,
+     libcerror_error_t **error )
+{
+	system_character_t destination_filename[ 256 ];
+	system_character_t destination_segment_filename[ 256 ];
+	system_character_t source_segment_filename[ 256 ];
+
+	libewf_data_chunk_t *data_chunk      = NULL;
+	libewf_handle_t *destination_handle  = NULL;
+	libewf_handle_t *source_handle       = NULL;
+	const system_character_t *filenames  = NULL;
+	uint8_t *destination_buffer          = NULL;
+	uint8_t *source_buffer               = NULL;
+	static char *function                = "ewf_test_write_chunk_from_handle";
+	size64_t destination_media_size      = 0;
+	size64_t media_size                  = 0;
+	size32_t chunk_size                  = 0;
+	ssize_t read_count                   = 0;
+	ssize_t write_count                  = 0;
+	int print_count                      = 0;
+	int result                           = 1;
+
+	print_count = system_string_sprintf(
+	               source_segment_filename,
+	               256,
+	               _SYSTEM_STRING( "%" PRIs_SYSTEM ".E01" ),
+	               filename );
+
+	if( ( print_count < 0 )
+	 || ( print_count >= 256 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set source segment filename.",
+		 function );
+
+		goto on_error;
+	}
+	print_count = system_string_sprintf(
+	               destination_filename,
+	               256,
+	               _SYSTEM_STRING( "%" PRIs_SYSTEM "_copy" ),
+	               filename );
+
+	if( ( print_count < 0 )
+	 || ( print_count >= 256 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set destination filename.",
+		 function );
+
+		goto on_error;
+	}
+	print_count = system_string_sprintf(
+	               destination_segment_filename,
+	               256,
+	               _SYSTEM_STRING( "%" PRIs_SYSTEM "_copy.E01" ),
+	               filename );
+
+	if( ( print_count < 0 )
+	 || ( print_count >= 256 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set destination segment filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_initialize(
+	     &source_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create source handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_test_write_chunk_open_for_reading(
+	     source_handle,
+	     source_segment_filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open source handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_media_size(
+	     source_handle,
+	     &media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_chunk_size(
+	     source_handle,
+	     &chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_initialize(
+	     &destination_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination handle.",
+		 function );
+
+		goto on_error;
+	}
+	filenames = destination_filename;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     destination_handle,
+	     (wchar_t * const *) &filenames,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     destination_handle,
+	     (char * const *) &filenames,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open destination handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_media_size(
+	     destination_handle,
+	     media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_compression_values(
+	     destination_handle,
+	     compression_level,
+	     compression_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set compression values.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_sectors_per_chunk(
+	     destination_handle,
+	     chunk_size / 512,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set sectors per chunk.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_data_chunk(
+	     source_handle,
+	     &data_chunk,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to retrieve data chunk.",
+		 function );
+
+		goto on_error;
+	}
+	/* The data chunks read from the source handle are written
+	 * to the destination handle without being unpacked
+	 */
+	do
+	{
+		read_count = libewf_handle_read_data_chunk(
+		              source_handle,
+		              data_chunk,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable read data chunk from source handle.",
+			 function );
+
+			goto on_error;
+		}
+		else if( read_count == 0 )
+		{
+			break;
+		}
+		write_count = libewf_handle_write_data_chunk(
+		               destination_handle,
+		               data_chunk,
+		               error );
+
+		if( write_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable write data chunk to destination handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	while( write_count > 0 );
+
+	if( libewf_data_chunk_free(
+	     &data_chunk,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free data chunk.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     destination_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close destination handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &destination_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free destination handle.",
+		 function );
+
+		goto on_error;
+	}
+	/* Compare the media data of the destination with that of the source
+	 */
+	if( libewf_handle_initialize(
+	     &destination_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_test_write_chunk_open_for_reading(
+	     destination_handle,
+	     destination_segment_filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open destination handle for reading.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_media_size(
+	     destination_handle,
+	     &destination_media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve destination media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( destination_media_size != media_size )
+	{
+		result = 0;
+	}
+	if( libewf_handle_seek_offset(
+	     source_handle,
+	     0,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek source offset.",
+		 function );
+
+		goto on_error;
+	}
+	source_buffer = (uint8_t *) memory_allocate(
+	                             sizeof( uint8_t ) * chunk_size );
+
+	destination_buffer = (uint8_t *) memory_allocate(
+	                                  sizeof( uint8_t ) * chunk_size );
+
+	if( ( source_buffer == NULL )
+	 || ( destination_buffer == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffers.",
+		 function );
+
+		goto on_error;
+	}
+	while( ( result == 1 )
+	    && ( media_size > 0 ) )
+	{
+		read_count = libewf_handle_read_buffer(
+		              source_handle,
+		              source_buffer,
+		              (size_t) chunk_size,
+		              error );
+
+		if( read_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable read buffer from source handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_handle_read_buffer(
+		     destination_handle,
+		     destination_buffer,
+		     (size_t) read_count,
+		     error ) != read_count )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable read buffer from destination handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_compare(
+		     source_buffer,
+		     destination_buffer,
+		     (size_t) read_count ) != 0 )
+		{
+			result = 0;
+		}
+		media_size -= read_count;
+	}
+	memory_free(
+	 destination_buffer );
+
+	destination_buffer = NULL;
+
+	memory_free(
+	 source_buffer );
+
+	source_buffer = NULL;
+
+	if( libewf_handle_close(
+	     destination_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close destination handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &destination_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free destination handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     source_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close source handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &source_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free source handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( destination_buffer != NULL )
+	{
+		memory_free(
+		 destination_buffer );
+	}
+	if( source_buffer != NULL )
+	{
+		memory_free(
+		 source_buffer );
+	}
+	if( data_chunk != NULL )
+	{
+		libewf_data_chunk_free(
+		 &data_chunk,
+		 NULL );
+	}
+	if( destination_handle != NULL )
+	{
+		libewf_handle_close(
+		 destination_handle,
+		 NULL );
+		libewf_handle_free(
+		 &destination_handle,
+		 NULL );
+	}
+	if( source_handle != NULL )
+	{
+		libewf_handle_close(
+		 source_handle,
+		 NULL );
+		libewf_handle_free(
+		 &source_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -454,6 +1111,7 @@ int main( int argc, char * const argv[] )
 	size_t string_length                            = 0;
 	uint8_t compression_flags                       = 0;
 	int8_t compression_level                        = LIBEWF_COMPRESSION_NONE;
+	int result                                      = 0;
 
 	while( ( option = ewf_test_getopt(
 	                   argc,
@@ -610,6 +1268,28 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	result = ewf_test_write_chunk_from_handle(
+	          argv[ optind ],
+	          compression_level,
+	          compression_flags,
+	          &error );
+
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test write of data chunks from another handle.\n" );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Data chunks written from another handle do not match.\n" );
+
+		goto on_error;
+	}
 	return( EXIT_SUCCESS );
 
 on_error:
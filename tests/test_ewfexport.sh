@@ -61,6 +61,62 @@ test_callback()
 	return ${RESULT};
 }
 
+# Tests that exporting EWF to EWF with the input compression values, which
+# passes the packed chunks through, results in the same MD5 as recompressing
+test_export_pass_through()
+{
+	local TMPDIR="tmp$$";
+
+	rm -rf ${TMPDIR};
+	mkdir ${TMPDIR};
+
+	# Mix compressible and incompressible data so that both compressed
+	# and uncompressed chunks are passed through
+	(seq 1 200000 && head -c 262144 /dev/urandom && seq 1 200000) > ${TMPDIR}/input.raw;
+
+	if test "${PLATFORM}" = "Darwin";
+	then
+		local INPUT_HASH=`md5 -q ${TMPDIR}/input.raw`;
+	else
+		local INPUT_HASH=`md5sum ${TMPDIR}/input.raw | cut -d ' ' -f 1`;
+	fi
+	run_test_with_input_and_arguments "${ACQUIRE_TOOL}" "" -cdeflate:fast -fencase6 -j0 -q -t${TMPDIR}/acquire < ${TMPDIR}/input.raw > /dev/null;
+	local RESULT=$?;
+
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		run_test_with_input_and_arguments "${TEST_EXECUTABLE}" ${TMPDIR}/acquire.E01 -cdeflate:fast -fencase6 -j0 -q -t${TMPDIR}/pass_through -u > /dev/null;
+		RESULT=$?;
+	fi
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		run_test_with_input_and_arguments "${TEST_EXECUTABLE}" ${TMPDIR}/acquire.E01 -cdeflate:best -fencase6 -j0 -q -t${TMPDIR}/recompressed -u > /dev/null;
+		RESULT=$?;
+	fi
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		local PASS_THROUGH_HASH=`run_test_with_input_and_arguments "${VERIFY_TOOL}" ${TMPDIR}/pass_through.E01 -q | grep "MD5 hash calculated over data" | sed 's/^.*:[[:space:]]*//'`;
+
+		local RECOMPRESSED_HASH=`run_test_with_input_and_arguments "${VERIFY_TOOL}" ${TMPDIR}/recompressed.E01 -q | grep "MD5 hash calculated over data" | sed 's/^.*:[[:space:]]*//'`;
+
+		if test -z "${PASS_THROUGH_HASH}" || test "${PASS_THROUGH_HASH}" != "${INPUT_HASH}" || test "${RECOMPRESSED_HASH}" != "${INPUT_HASH}";
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+	fi
+	rm -rf ${TMPDIR};
+
+	echo -n "Testing ewfexport pass-through of packed chunks";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
 if test -n "${SKIP_TOOLS_TESTS}" || test -n "${SKIP_TOOLS_END_TO_END_TESTS}";
 then
 	exit ${EXIT_IGNORE};
@@ -94,6 +150,20 @@ then
 	exit ${EXIT_FAILURE};
 fi
 
+ACQUIRE_TOOL="../ewftools/ewfacquirestream";
+
+if ! test -x "${ACQUIRE_TOOL}";
+then
+	ACQUIRE_TOOL="../ewftools/ewfacquirestream.exe";
+fi
+
+if ! test -x "${ACQUIRE_TOOL}";
+then
+	echo "Missing executable: ${ACQUIRE_TOOL}";
+
+	exit ${EXIT_FAILURE};
+fi
+
 TEST_DIRECTORY=`dirname $0`;
 
 TEST_RUNNER="${TEST_DIRECTORY}/test_runner.sh";
@@ -116,6 +186,14 @@ else
 	assert_availability_binary md5sum;
 fi
 
+test_export_pass_through;
+RESULT=$?;
+
+if test ${RESULT} -ne ${EXIT_SUCCESS};
+then
+	exit ${RESULT};
+fi
+
 if ! test -d "input";
 then
 	echo "Test input directory not found.";